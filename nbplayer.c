@@ -8,6 +8,9 @@
 #define K_DEBUG             //if defined, internal debug code is enabled
 //#define K_USE_NATIVE_PRINTF //if defined, K_LOG method is mapped to 'printf()'; this allows compilation time warnings for printf-string-formats.
 #define K_USE_MPLANE        //if defined, _MPLANE buffers are used instead of single-plane (NOTE: '_MPLANE' seems not to work with G_CROP ctl)
+#define K_USE_IO_URING      //if defined, the io_uring src-ingest backend is available with '--ioUring 1' (requires <linux/io_uring.h>, kernel 5.6+)
+#define K_USE_SIMD_NAL_SCAN //if defined, Annex-B start-codes are searched 16-32 bytes at a time with NEON or SSE2 (when the compiler targets them), else with memchr()
+#define K_USE_LIBJPEG       //if defined, MJPEG streams are decoded at the CPU by libjpeg(-turbo, SIMD IDCT and color conversion) when the decoder device has no MJPEG support (requires <jpeglib.h>, link with '-ljpeg')
 
 #define _GNU_SOURCE         //for <netdb.h>
 
@@ -43,6 +46,30 @@
 #include <fcntl.h>          //for O_NONBLOCK
 #include <poll.h>           //for poll()
 #include <signal.h>         //for signal() and interrputs
+#include <sys/eventfd.h>    //for eventfd() (async dns completion)
+#include <sys/un.h>         //for sockaddr_un (shm ring source)
+#include <sys/stat.h>       //for fstat() (shm ring source, mapped files)
+#ifdef K_USE_IO_URING
+#   include <linux/io_uring.h> //for io_uring structs (raw syscalls, no liburing dependency)
+#   include <sys/syscall.h>    //for syscall()
+#   ifndef __NR_io_uring_setup
+#       define __NR_io_uring_setup  425
+#   endif
+#   ifndef __NR_io_uring_enter
+#       define __NR_io_uring_enter  426
+#   endif
+#endif
+#ifdef K_USE_SIMD_NAL_SCAN
+#   if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#       include <arm_neon.h>    //for vceqq_u8 (start-codes scanning)
+#   elif defined(__SSE2__)
+#       include <emmintrin.h>   //for _mm_cmpeq_epi8 (start-codes scanning)
+#   endif
+#endif
+#ifdef K_USE_LIBJPEG
+#   include <setjmp.h>      //for setjmp() (libjpeg errors)
+#   include <jpeglib.h>     //for jpeg_decompress_struct (cpu MJPEG decoding), requires '-ljpeg' at compilation.
+#endif
 
 //
 #ifdef K_DEBUG
@@ -62,15 +89,59 @@
 #define K_DEF_THREADS_EXTRA_AMM     0       //ammount of extra threads (for rendering). Note: best efficiency is '0 extra threads' (single thread), best performance is '1 extra thread' dual-threads.
 #define K_DEF_CONN_TIMEOUT_SECS     60      //seconds to wait for connection-inactivity-timeout.
 #define K_DEF_CONN_RETRY_WAIT_SECS  5       //seconds to wait before trying to connect again.
+#define K_DEF_CONN_RETRY_WAIT_MAX_SECS 60   //max seconds to wait before trying to connect again (the wait doubles after each failed attempt).
+#define K_DEF_CONN_PENDING_PER_SERVER 2     //max simultaneous connection attempts (resolving or waiting response) per server:port (0 = unlimited).
+#define K_DEF_CONN_PENDING_MAX      4       //max simultaneous connection attempts (resolving or waiting response) for all servers (0 = unlimited).
+#define K_DEF_DNS_CACHE_SECS        60      //seconds to reuse a resolved server address before resolving it again.
+#define K_DEF_NET_POOL_IDLE_MAX     2       //warm connections kept per server:port (replacing the ones closed by out-of-screen streams).
+#define K_DEF_NET_POOL_IDLE_SECS    30      //seconds a warm connection is kept before closing it.
+#define K_DEF_IO_URING_ENTRIES      128     //io_uring submission-queue size (when '--ioUring 1').
+#define K_DEF_NET_READ_BUDGET_KB    256     //max KBs to recv per stream per wakeup before yielding to other streams (0 = until drained).
+#define K_DEF_NET_READ_BUDGET_FRAMES 4      //max frames to complete per stream per wakeup before yielding to other streams (0 = until drained).
+#define K_DEF_RTP_JITTER_MS         40      //ms an out-of-order udp rtp packet waits for the missing ones before they are considered lost.
+#define K_DEF_NET_BUFF_ADAPT        1       //ingest buffer and SO_RCVBUF sized by each stream's observed bitrate.
+#define K_DEF_NET_TCP_NODELAY       0       //TCP_NODELAY at streams' sockets.
+#define K_DEF_NET_TCP_QUICKACK      0       //TCP_QUICKACK re-armed at each read wakeup.
+#define K_DEF_NET_RCVLOWAT_MS       0       //SO_RCVLOWAT as this ms of the stream's bitrate, to batch wakeups (0 = disabled).
+#define K_DEF_STREAM_MAX_LATENCY_MS 3000    //ms since arrival a live stream's queued frame can wait for the decoder before the queue is trimmed to its newest IDR (0 = unbounded).
+#define K_DEF_STREAM_GOP_CACHE_KB   4096    //KBs of the newest IDR and its followers a live stream keeps queued while its decoder is closed (0 = unbounded).
 #define K_DEF_DECODER_TIMEOUT_SECS  5       //seconds to wait for decoder-inactivity-timeout (frames are arriving from src, decoder is explicit-on but not producing output).
 #define K_DEF_DECODER_RETRY_WAIT_SECS  5    //seconds to wait before trying to open device again.
 #define K_DEF_DECODERS_MAX_AMM      16       //ammount of maximun simultaneous opened decoders.
+#define K_DEF_DECODER_POOL          1       //decoders of streams leaving the screen are kept opened (stopped, buffers mapped) for the next stream opening the same device, counted as opened decoders.
 #define K_DEF_DECODERS_PEEK_MAX_SECS 2      //seconds max to allow a decoder to be in peek state (peek should take milliseconds if IDR-frame is available)
 #define K_DEF_ANIM_WAIT_SECS        10      //seconds to wait between streams position animations.
 #define K_DEF_ANIM_PRE_RENDER_SECS  2       //seconds to start rendering offscree-stream before next streams position animations (to ensure something will be rendered before entering to screen).
 #define K_DEF_FRAMES_PER_SEC        25      //fps / screen-refreshs-per-second. Note: frames decoding is done as fast as posible, screen-refreshs draws the latest decoded frames to the screen.
 #define K_DEF_DRAW_MODE             ENPlayerDrawMode_Src
 
+#define K_HTTP_LINE_MAX             256     //http response status-line and headers are parsed up to this size (the rest of the line is ignored).
+#define K_HTTP_BOUNDARY_MAX         80      //multipart delimiter max size ('\r\n--' + boundary of up to 70 chars + NUL).
+#define K_HTTP_PART_MAX             (8 * 1024 * 1024) //multipart part (JPEG) max size, bigger parts are dropped.
+#define K_RTSP_SESSION_TIMEOUT_SECS 60      //rtsp session timeout when not specified by the server (keep-alive requests are sent at half of it).
+#define K_RTP_PKT_MAX               2048    //udp rtp datagram max size (bigger datagrams are truncated and dropped).
+#define K_RTP_UDP_BATCH             16      //udp rtp datagrams received per 'recvmmsg()' call.
+#define K_RTP_JITTER_SLOTS          256     //udp rtp reorder window, in packets (must divide 65536).
+#define K_FILE_MAP_PARSE_MAX        (1024 * 1024) //mapped files are parsed by up to this size per call, until a frame is completed.
+#define K_FILE_MAP_FRAMES_PER_TICK  8       //max frames parsed per tick from a mapped file catching up with its deadlines.
+#define K_FILE_MAP_RESYNC_MS        1000    //a mapped file this late (flushing, stalled) restarts its deadlines from now instead of catching up.
+#define K_NET_CONN_DEFER_MS         250     //wait before evaluating again a connection attempt deferred by the pending-connections limits (plus jitter).
+#define K_NET_ADDRS_MAX             4       //resolved addresses kept per server (happy-eyeballs candidates).
+#define K_NET_CONN_ATTEMPT_DELAY_MS 250     //happy-eyeballs wait before racing the next address while the previous connects are still in progress (RFC 8305).
+#define K_NET_BUFF_MIN              (16 * 1024)   //adaptive ingest buffer min size.
+#define K_NET_BUFF_MAX              (1024 * 1024) //adaptive ingest buffer max size.
+#define K_NET_BUFF_TARGET_MS        80      //adaptive ingest buffer holds this ms of the stream's bitrate (a wakeup's data in one recv).
+#define K_NET_RCVBUF_MIN            (64 * 1024)   //adaptive SO_RCVBUF min size (only grows over the kernel's current size).
+#define K_NET_RCVBUF_MAX            (4 * 1024 * 1024) //adaptive SO_RCVBUF max size.
+#define K_NET_RCVBUF_TARGET_MS      500     //adaptive SO_RCVBUF holds this ms of the stream's bitrate (bursts like IDR frames).
+#define K_BUFF_SLAB_CLASS_MIN       (16 * 1024) //frames' payload buffers smallest size-class.
+#define K_BUFF_SLAB_CLASSES         8       //frames' payload buffers size-classes (power of two, 16KB to 2MB), bigger buffers are not cached.
+#define K_BUFF_SLAB_TRIM_SECS       10      //cached payload buffers not needed at the high-water of this period are released.
+#define K_H264_SPS_MAX              32      //seq_parameter_set_id range.
+#define K_H264_PPS_MAX              256     //pic_parameter_set_id range.
+#define K_H264_SLICE_HDR_PEEK_SZ    32      //bytes of a slice NAL (after the start code) enough to parse the fields compared to detect a new picture.
+#define K_FRAMES_QUEUE_SZ_MIN       8       //frames and fed-states queues initial size (rings, doubled when full).
+
 #ifndef SOCKET
 #   define SOCKET           int
 #endif
@@ -258,12 +329,85 @@ const static STNalTypeDesc _naluDefs[] = {
     { 31, ENNalTypeGrp_NonVCL, "Unspecified" },
 };
 
+//H.265 (HEVC), 'Table 7-1 - NAL unit type codes and NAL unit type classes'.
+//NAL header is two bytes: forbidden_zero_bit u(1), nal_unit_type u(6), nuh_layer_id u(6), nuh_temporal_id_plus1 u(3).
+//IRAP (types 16 to 23) pictures can be decoded without referencing other pictures.
+//Types 48 and 49 are RTP aggregation and fragmentation units (RFC 7798).
+
+const static STNalTypeDesc _naluHevcDefs[] = {
+    { 0, ENNalTypeGrp_VCL, "TRAIL_N Coded slice segment of a non-TSA, non-STSA trailing picture" },
+    { 1, ENNalTypeGrp_VCL, "TRAIL_R Coded slice segment of a non-TSA, non-STSA trailing picture" },
+    { 2, ENNalTypeGrp_VCL, "TSA_N Coded slice segment of a TSA picture" },
+    { 3, ENNalTypeGrp_VCL, "TSA_R Coded slice segment of a TSA picture" },
+    { 4, ENNalTypeGrp_VCL, "STSA_N Coded slice segment of an STSA picture" },
+    { 5, ENNalTypeGrp_VCL, "STSA_R Coded slice segment of an STSA picture" },
+    { 6, ENNalTypeGrp_VCL, "RADL_N Coded slice segment of a RADL picture" },
+    { 7, ENNalTypeGrp_VCL, "RADL_R Coded slice segment of a RADL picture" },
+    { 8, ENNalTypeGrp_VCL, "RASL_N Coded slice segment of a RASL picture" },
+    { 9, ENNalTypeGrp_VCL, "RASL_R Coded slice segment of a RASL picture" },
+    { 10, ENNalTypeGrp_VCL, "Reserved non-IRAP sub-layer VCL" },
+    { 11, ENNalTypeGrp_VCL, "Reserved non-IRAP sub-layer VCL" },
+    { 12, ENNalTypeGrp_VCL, "Reserved non-IRAP sub-layer VCL" },
+    { 13, ENNalTypeGrp_VCL, "Reserved non-IRAP sub-layer VCL" },
+    { 14, ENNalTypeGrp_VCL, "Reserved non-IRAP sub-layer VCL" },
+    { 15, ENNalTypeGrp_VCL, "Reserved non-IRAP sub-layer VCL" },
+    { 16, ENNalTypeGrp_VCL, "BLA_W_LP Coded slice segment of a BLA picture (IRAP)" },
+    { 17, ENNalTypeGrp_VCL, "BLA_W_RADL Coded slice segment of a BLA picture (IRAP)" },
+    { 18, ENNalTypeGrp_VCL, "BLA_N_LP Coded slice segment of a BLA picture (IRAP)" },
+    { 19, ENNalTypeGrp_VCL, "IDR_W_RADL Coded slice segment of an IDR picture (IRAP)" },
+    { 20, ENNalTypeGrp_VCL, "IDR_N_LP Coded slice segment of an IDR picture (IRAP)" },
+    { 21, ENNalTypeGrp_VCL, "CRA_NUT Coded slice segment of a CRA picture (IRAP)" },
+    { 22, ENNalTypeGrp_VCL, "RSV_IRAP_VCL22 Reserved IRAP VCL" },
+    { 23, ENNalTypeGrp_VCL, "RSV_IRAP_VCL23 Reserved IRAP VCL" },
+    { 24, ENNalTypeGrp_VCL, "Reserved non-IRAP VCL" },
+    { 25, ENNalTypeGrp_VCL, "Reserved non-IRAP VCL" },
+    { 26, ENNalTypeGrp_VCL, "Reserved non-IRAP VCL" },
+    { 27, ENNalTypeGrp_VCL, "Reserved non-IRAP VCL" },
+    { 28, ENNalTypeGrp_VCL, "Reserved non-IRAP VCL" },
+    { 29, ENNalTypeGrp_VCL, "Reserved non-IRAP VCL" },
+    { 30, ENNalTypeGrp_VCL, "Reserved non-IRAP VCL" },
+    { 31, ENNalTypeGrp_VCL, "Reserved non-IRAP VCL" },
+    { 32, ENNalTypeGrp_NonVCL, "VPS_NUT Video parameter set video_parameter_set_rbsp( )" },
+    { 33, ENNalTypeGrp_NonVCL, "SPS_NUT Sequence parameter set seq_parameter_set_rbsp( )" },
+    { 34, ENNalTypeGrp_NonVCL, "PPS_NUT Picture parameter set pic_parameter_set_rbsp( )" },
+    { 35, ENNalTypeGrp_NonVCL, "AUD_NUT Access unit delimiter access_unit_delimiter_rbsp( )" },
+    { 36, ENNalTypeGrp_NonVCL, "EOS_NUT End of sequence end_of_seq_rbsp( )" },
+    { 37, ENNalTypeGrp_NonVCL, "EOB_NUT End of bitstream end_of_bitstream_rbsp( )" },
+    { 38, ENNalTypeGrp_NonVCL, "FD_NUT Filler data filler_data_rbsp( )" },
+    { 39, ENNalTypeGrp_NonVCL, "PREFIX_SEI_NUT Supplemental enhancement information sei_rbsp( )" },
+    { 40, ENNalTypeGrp_NonVCL, "SUFFIX_SEI_NUT Supplemental enhancement information sei_rbsp( )" },
+    { 41, ENNalTypeGrp_NonVCL, "Reserved" },
+    { 42, ENNalTypeGrp_NonVCL, "Reserved" },
+    { 43, ENNalTypeGrp_NonVCL, "Reserved" },
+    { 44, ENNalTypeGrp_NonVCL, "Reserved" },
+    { 45, ENNalTypeGrp_NonVCL, "Reserved" },
+    { 46, ENNalTypeGrp_NonVCL, "Reserved" },
+    { 47, ENNalTypeGrp_NonVCL, "Reserved" },
+    { 48, ENNalTypeGrp_Stap_A, "Aggregation packet" },
+    { 49, ENNalTypeGrp_FU_A, "Fragmentation unit" },
+    { 50, ENNalTypeGrp_NonVCL, "PACI packet" },
+    { 51, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 52, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 53, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 54, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 55, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 56, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 57, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 58, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 59, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 60, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 61, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 62, ENNalTypeGrp_NonVCL, "Unspecified" },
+    { 63, ENNalTypeGrp_NonVCL, "Unspecified" },
+};
+
 //
 
 struct STPlayer_;
 struct STBuffer_;
 struct STPlane_;
 struct STFramebuffsGrp_;
+struct STDecoderParked_;
 
 //STFbPos
 
@@ -288,6 +432,114 @@ typedef struct STFbRect_ {
     int height;
 } STFbRect;
 
+//STBitsReader
+//Reads the RBSP of a NAL (emulation-prevention bytes '00 00 03' are skipped).
+
+typedef struct STBitsReader_ {
+    const unsigned char* buff;
+    int             sz;
+    int             pos;        //current byte
+    int             bitsLeft;   //bits not read yet at current byte
+    int             zeroes;     //consecutive zero bytes before current byte
+    int             isOverflow; //a read was beyond the end
+} STBitsReader;
+
+void BitsReader_init(STBitsReader* obj, const unsigned char* buff, const int sz);
+unsigned int BitsReader_u(STBitsReader* obj, const int bits); //u(n), 32 bits max
+unsigned int BitsReader_ue(STBitsReader* obj);  //ue(v), exp-Golomb
+int BitsReader_se(STBitsReader* obj);           //se(v), signed exp-Golomb
+
+//STH264Sps
+//Sequence parameter set props (image geometry known without decoding).
+
+typedef struct STH264Sps_ {
+    int             profile_idc;
+    int             constraint_flags;   //constraint_set0..5_flag and reserved bits
+    int             level_idc;
+    int             seq_parameter_set_id;
+    int             chroma_format_idc;
+    int             separate_colour_plane_flag;
+    int             bit_depth_luma;
+    int             log2_max_frame_num;
+    int             pic_order_cnt_type;
+    int             log2_max_pic_order_cnt_lsb;
+    int             delta_pic_order_always_zero_flag;
+    int             max_num_ref_frames;
+    int             frame_mbs_only_flag;
+    int             width;      //pic_width_in_mbs * 16
+    int             height;     //pic_height_in_map_units * 16 * (2 - frame_mbs_only_flag)
+    STFbRect        crop;       //visible area (frame_cropping applied)
+    int             max_num_reorder_frames;   //from VUI bitstream_restriction (-1 if not present)
+    int             max_dec_frame_buffering;  //from VUI bitstream_restriction (-1 if not present)
+    unsigned int    num_units_in_tick;        //from VUI timing_info (0 if not present)
+    unsigned int    time_scale;               //from VUI timing_info (0 if not present), a frame lasts 'num_units_in_tick * 2 / time_scale' secs
+} STH264Sps;
+
+int H264Sps_parse(STH264Sps* obj, const unsigned char* nal, const int nalSz); //'nal' starts at the NAL header byte (after '00 00 00 01'), 0 if the geometry was parsed
+void H264Sps_skipScalingList_(STBitsReader* br, const int sizeOfScalingList);
+void H264Sps_skipHrd_(STBitsReader* br); //hrd_parameters()
+
+//STH264Pps
+//Picture parameter set props (required to parse slice headers).
+
+typedef struct STH264Pps_ {
+    int             isSet;
+    int             pic_parameter_set_id;
+    int             seq_parameter_set_id;
+    int             bottom_field_pic_order_in_frame_present_flag;
+} STH264Pps;
+
+int H264Pps_parse(STH264Pps* obj, const unsigned char* nal, const int nalSz); //'nal' starts at the NAL header byte, 0 if parsed
+
+//STH264SliceHdr
+//Slice header fields that identify the primary coded picture (7.4.1.2.4).
+
+typedef struct STH264SliceHdr_ {
+    int             nal_ref_idc;
+    int             nal_unit_type;
+    int             first_mb_in_slice;
+    int             slice_type;
+    int             pic_parameter_set_id;
+    int             frame_num;
+    int             field_pic_flag;
+    int             bottom_field_flag;
+    int             idr_pic_id;
+    int             pic_order_cnt_type;
+    int             pic_order_cnt_lsb;
+    int             delta_pic_order_cnt_bottom;
+    int             delta_pic_order_cnt[2];
+} STH264SliceHdr;
+
+int H264SliceHdr_parse(STH264SliceHdr* obj, const unsigned char* nal, const int nalSz, const STH264Sps* spss /*[K_H264_SPS_MAX]*/, const STH264Pps* ppss /*[K_H264_PPS_MAX]*/); //0 if parsed, -1 if the referenced parameter sets are not known or the data is not enough
+int H264SliceHdr_isFirstOfNewPicture(const STH264SliceHdr* prev, const STH264SliceHdr* cur); //7.4.1.2.4 Detection of the first VCL NAL unit of a primary coded picture
+
+//STMp4Track
+//Video track's sample table (ISO BMFF 'moov', not fragmented), samples are length-prefixed NALs.
+
+typedef struct STMp4Sample_ {
+    unsigned long long off;     //from file start
+    unsigned int    sz;
+    int             isSync;     //listed at 'stss' (all if not present)
+} STMp4Sample;
+
+typedef struct STMp4Track_ {
+    int             pixFmt;     //V4L2_PIX_FMT_H264 ('avc1', 'avc3') or V4L2_PIX_FMT_HEVC ('hvc1', 'hev1')
+    int             lenSz;      //NALs length-field size (1, 2 or 4)
+    unsigned char*  prms;       //parameter sets from 'avcC' or 'hvcC', as Annex-B (fed before sync samples)
+    int             prmsSz;
+    STMp4Sample*    samples;    //in decoding order
+    unsigned long   samplesUse;
+    unsigned long   frameUs;    //mean sample duration from 'mdhd' (0 if unknown)
+} STMp4Track;
+
+void Mp4Track_init(STMp4Track* obj);
+void Mp4Track_release(STMp4Track* obj);
+int Mp4Track_parse(STMp4Track* obj, const unsigned char* buff, const unsigned long long sz); //first video track's sample table, 0 if parsed
+int Mp4Track_prmsAdd_(STMp4Track* obj, const unsigned char* nal, const int nalSz); //appends a parameter set with its start code
+int Mp4Track_sampleHasPrms(const STMp4Track* obj, const unsigned char* smpl, const unsigned long smplSz); //1 if the sample carries its own parameter sets (in-band SPS/PPS, or VPS/SPS/PPS)
+const unsigned char* Mp4_boxFind_(const unsigned char* buff, const unsigned long long sz, const char* type, unsigned long long* dstBodySz); //body of the first 'type' box (or NULL)
+int Mp4_boxNext_(const unsigned char* buff, const unsigned long long sz, unsigned long long* pos, const unsigned char** dstType, const unsigned char** dstBody, unsigned long long* dstBodySz); //box at '*pos' (advanced after it), 0 if valid
+
 //STThreadTask
 
 typedef void (*ThreadTaskFunc)(void* param);
@@ -525,6 +777,7 @@ typedef struct STBuffer_ {
     int         index;
     int         isOrphanable;   //obtained V4L2_BUF_CAP_SUPPORTS_ORPHANED_BUFS flag when requeting buffers, must be unmaped and closed to be released.
     int         isQueued;
+    int         isBound;        //a frame is being assembled in place on its first plane (zero-copy), not available as unqueued
     STPlane*    planes;
     int         planesSz;
     //dbg
@@ -582,13 +835,14 @@ int Buffers_getCompositionRect(STBuffers* obj, int fd, STFbRect* dstRect);
 int Buffers_allocBuffs(STBuffers* obj, int fd, int ammount, const int print); //to dealloc buffers call this method with zero-ammount.
 int Buffers_export(STBuffers* obj, int fd);
 int Buffers_mmap(STBuffers* obj, int fd);
-int Buffers_getUnqueued(STBuffers* obj, STBuffer** dstBuff, STBuffer* ignoreThis);        //get a buffer not enqueued yet
+int Buffers_getUnqueued(STBuffers* obj, STBuffer** dstBuff, STBuffer* ignoreThis);        //get a buffer not enqueued yet (and not bound to a frame)
 int Buffers_enqueueMinimun(STBuffers* obj, int fd, const int minimun);
 int Buffers_enqueue(STBuffers* obj, int fd, STBuffer* srcBuff, const struct timeval* srcTimestamp);     //add to queue
 int Buffers_dequeue(STBuffers* obj, int fd, STBuffer** dstBuff, struct timeval* dstTimestamp);     //remove from queue
 int Buffers_start(STBuffers* obj, int fd);
 int Buffers_stop(STBuffers* obj, int fd);
 int Buffers_keepLastAsClone(STBuffers* obj, STBuffer* src);
+void Buffers_move(STBuffers* obj, STBuffers* src); //takes 'src' buffers (mapped) and format, 'src' is left inited
 
 //ENPlayerPollFdType
 
@@ -596,11 +850,16 @@ typedef enum ENPlayerPollFdType_ {
     ENPlayerPollFdType_Decoder = 0, //dec (decoder).fd
     ENPlayerPollFdType_SrcFile,     //file.fd
     ENPlayerPollFdType_SrcSocket,   //net.socket
+    ENPlayerPollFdType_DnsEvent,    //player's dns.evtFd
+    ENPlayerPollFdType_NetPoolConn, //player's netPools warm connection
+    ENPlayerPollFdType_SrcConnAttempt, //net.he attempts (happy-eyeballs)
+    ENPlayerPollFdType_IoUring,     //player's uring.ring.fd
     //
     ENPlayerPollFdType_Count
 } ENPlayerPollFdType;
 
 typedef void (*PlayerPollCallback)(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, int revents);
+typedef void (*PlayerUringCallback)(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, const int res); //res: bytes or -errno
 
 //STPlayerPollFd
 
@@ -612,6 +871,59 @@ typedef struct STPlayerPollFd_ {
     int                 autoremove; //orphan
 } STPlayerPollFd;
 
+//STPlayerUringOp
+//Read/recv posted to the io_uring, alive until its completion is reaped.
+
+typedef struct STPlayerUringOp_ {
+    ENPlayerPollFdType  type;
+    void*               obj;
+    int                 fd;
+    PlayerUringCallback callback;
+    int                 isCanceled; //completion is ignored (fd closed or obj removed)
+} STPlayerUringOp;
+
+//STIoUring
+//Minimal io_uring (raw syscalls, no liburing dependency).
+
+#ifdef K_USE_IO_URING
+typedef struct STIoUring_ {
+    int         fd;
+    unsigned    features;   //IORING_FEAT_*
+    //sq (submission)
+    struct {
+        void*       ring;
+        size_t      ringSz;
+        unsigned*   head;
+        unsigned*   tail;
+        unsigned*   mask;
+        unsigned*   array;
+        unsigned    entries;
+        struct io_uring_sqe* sqes;
+        size_t      sqesSz;
+        unsigned    tailLocal;  //filled sqes (published at submit)
+        unsigned    toSubmit;
+    } sq;
+    //cq (completion)
+    struct {
+        void*       ring;
+        size_t      ringSz;
+        unsigned*   head;
+        unsigned*   tail;
+        unsigned*   mask;
+        struct io_uring_cqe* cqes;
+    } cq;
+} STIoUring;
+
+void IoUring_init(STIoUring* obj);
+void IoUring_release(STIoUring* obj);
+//
+int IoUring_setup(STIoUring* obj, const unsigned entries);
+struct io_uring_sqe* IoUring_getSqe(STIoUring* obj);  //NULL if the submission-queue is full
+int IoUring_submit(STIoUring* obj, const unsigned waitCompletions); //returns the ammount of sqes consumed
+struct io_uring_cqe* IoUring_peekCqe(STIoUring* obj); //NULL if no completion is available
+void IoUring_cqeSeen(STIoUring* obj);
+#endif
+
 //STVideoFrameState
 //Allows to follow the timings of frames.
 
@@ -646,9 +958,10 @@ void VideoFrameState_timestampToSeqIdx(const struct timeval* srcTimestamp, unsig
 //STVideoFrameStates
 
 typedef struct STVideoFrameStates_ {
-    STVideoFrameState*  arr;    //oldest first
+    STVideoFrameState*  arr;    //ring, oldest at 'head', newest at 'head + use - 1'
+    int                 head;
     int                 use;
-    int                 sz;
+    int                 sz;     //power of two
 } STVideoFrameStates;
 
 void VideoFrameStates_init(STVideoFrameStates* obj);
@@ -658,6 +971,36 @@ int VideoFrameStates_getStateCloningAndRemoveOlder(STVideoFrameStates* obj, cons
 int VideoFrameStates_addNewestCloning(STVideoFrameStates* obj, const STVideoFrameState* state);
 int VideoFrameStates_empty(STVideoFrameStates* obj);
 
+//STBuffSlabs
+//Frames' payload buffers by size-class (power of two), shared by the streams of a player.
+
+typedef struct STBuffSlabs_ {
+    struct {
+        unsigned char** cached;     //free blocks
+        int             cachedUse;
+        int             cachedSz;
+        int             given;      //blocks in use
+        int             givenMax;   //high-water of 'given' since previous trim
+    } classes[K_BUFF_SLAB_CLASSES];
+    unsigned long long  bytesHeld;  //given + cached (including blocks bigger than the biggest class)
+    unsigned int        secsSinceTrim;
+    //stats
+    struct {
+        struct {
+            unsigned long long allocs;      //blocks given
+            unsigned long long mallocs;     //blocks given not found in cache
+            unsigned long long copyBytes;   //payload copied when growing
+            unsigned long long copyBytesExact; //payload that would be copied growing to the exact size
+        } curSec;
+    } stats;
+} STBuffSlabs;
+
+void BuffSlabs_init(STBuffSlabs* obj);
+void BuffSlabs_release(STBuffSlabs* obj);
+unsigned char* BuffSlabs_alloc(STBuffSlabs* obj, const int minSz, int* dstSz); //block of the smallest size-class that fits (or 'minSz' if bigger than the biggest class)
+void BuffSlabs_free(STBuffSlabs* obj, unsigned char* ptr, const int sz); //cached if 'sz' is a size-class
+void BuffSlabs_trim(STBuffSlabs* obj); //releases cached blocks over the high-water of the blocks given since previous call
+
 //STVideoFrame
 //In H264, an Access unit allways produces an output frame.
 //IDR = Instantaneous Decoding Refresh
@@ -668,19 +1011,31 @@ typedef struct STVideoFrame_ {
     struct {
         int             isInvalid;              //payload must be discarded
         int             lastCompletedNalType;   //
-        int             nalsCountPerType[32];   //counts of NALs contained by this frame, by type (32 max)
+        int             nalsCountPerType[64];   //counts of NALs contained by this frame, by type (32 max in H.264, 64 max in H.265)
         //delimeter
         struct {
             int         isPresent;
             int         primary_pic_type;   //u(3)
             int         slicesAllowedPrimaryPicturePerType[32];   //slices allowed in a primary picture
         } delimeter;
+        //slice (first slice header of the primary coded picture)
+        struct {
+            int         isSet;
+            STH264SliceHdr hdr;
+        } slice;
     } accessUnit;
     //buff
     struct {
         unsigned char*  ptr;
         int             use;
         int             sz;
+        const unsigned char* extPtr; //if not NULL, payload is referenced in place (not owned, 'use' is its size)
+        uint64_t        extPos;     //position of the referenced record (shm ring), to release it after consumed
+        STBuffer*       decBuff;    //if not NULL, 'ptr' is the first plane of this decoder's OUTPUT buffer (assembled in place, not owned)
+        unsigned char*  ownPtr;     //owned buffer, kept aside while 'decBuff' is set
+        int             ownSz;
+        STBuffSlabs*    slabs;      //if not NULL, owned buffers are taken from and returned to here
+        int             szExact;    //size the buffer would have growing to the exact size (stats)
     } buff;
 } STVideoFrame;
 
@@ -689,9 +1044,11 @@ void VideoFrame_release(STVideoFrame* obj);
 //
 int VideoFrame_reset(STVideoFrame* obj);           //state is reseted and buffer 'use' is set to zero
 int VideoFrame_copy(STVideoFrame* obj, const void* data, const int dataSz);  //
+int VideoFrame_bindDecBuff(STVideoFrame* obj, STBuffer* buff);  //payload will be assembled in place on the buffer's first plane (current payload is moved there)
+int VideoFrame_unbindDecBuff(STVideoFrame* obj, const int keepPayload);  //returns to the owned buffer, copying the payload if required
 //
 int VideoFrame_getNalsCount(const STVideoFrame* obj);
-int VideoFrame_getNalsCountOfGrp(const STVideoFrame* obj, const ENNalTypeGrp grp);
+int VideoFrame_getNalsCountOfGrp(const STVideoFrame* obj, const int srcPixFmt /*V4L2_PIX_FMT_H264 or V4L2_PIX_FMT_HEVC*/, const ENNalTypeGrp grp);
 int VideoFrame_setAccessUnitDelimiterFound(STVideoFrame* obj, const int primary_pic_type);
 
 //STVideoFrames
@@ -699,8 +1056,10 @@ int VideoFrame_setAccessUnitDelimiterFound(STVideoFrame* obj, const int primary_
 typedef struct STVideoFrames_ {
     unsigned long   iSeqPushNext;   //iSeq to set to pushed frames
     unsigned long   iSeqPullNext;   //iSeq to set to pulled frames
-    STVideoFrame**  arr;    //array of ptrs
-    int             sz;
+    STBuffSlabs*    slabs;          //if not NULL, frames created by 'pullFrameForFill' use it
+    STVideoFrame**  arr;    //ring of ptrs, left (oldest) at 'head', right at 'head + use - 1'
+    int             head;
+    int             sz;     //power of two
     int             use;
 } STVideoFrames;
 
@@ -710,10 +1069,154 @@ void VideoFrames_release(STVideoFrames* obj);
 int VideoFrames_pullFrameForFill(STVideoFrames* obj, STVideoFrame** dst); //get from the right, reuse or creates a new one
 int VideoFrames_getFramesForReadCount(STVideoFrames* obj); //peek from the left
 int VideoFrames_pullFrameForRead(STVideoFrames* obj, STVideoFrame** dst); //get from the left
+STVideoFrame* VideoFrames_peek(STVideoFrames* obj, const int idx); //idx-th from the left (zero is the next to read), NULL if out of range
 int VideoFrames_pushFrameOwning(STVideoFrames* obj, STVideoFrame* src); //add for future pull (reuse)
 
 //STStreamContext
 
+//ENStreamNetProto (network stream source protocol)
+
+typedef enum ENStreamNetProto_ {
+    ENStreamNetProto_Http = 0,  //HTTP GET, Annex-B body
+    ENStreamNetProto_Rtsp,      //RTSP DESCRIBE/SETUP/PLAY, RTP interleaved over the same TCP connection
+    ENStreamNetProto_RtpUdp,    //RTP over UDP (unicast or multicast group), no requests
+    ENStreamNetProto_Shm,       //local producer's shared-memory ring (memfd received over a UNIX socket at 'server' path)
+    //
+    ENStreamNetProto_Count
+} ENStreamNetProto;
+
+//ENStreamFileFmt (mapped file's content, detected when opened)
+
+typedef enum ENStreamFileFmt_ {
+    ENStreamFileFmt_AnnexB = 0, //NALs delimited by start codes
+    ENStreamFileFmt_Avcc,       //NALs prefixed by 4-bytes lengths, parameter sets in-band
+    ENStreamFileFmt_Mp4,        //ISO BMFF video track, samples of length-prefixed NALs
+    //
+    ENStreamFileFmt_Count
+} ENStreamFileFmt;
+
+//STNetAddr (resolved address, ipv4 or ipv6)
+
+typedef struct STNetAddr_ {
+    int             family;     //AF_INET or AF_INET6
+    union {
+        struct in_addr  v4;
+        struct in6_addr v6;
+    } addr;
+} STNetAddr;
+
+//STNetAddrs (resolved addresses, in connection-attempt order)
+
+typedef struct STNetAddrs_ {
+    STNetAddr       arr[K_NET_ADDRS_MAX];
+    int             use;
+} STNetAddrs;
+
+//STNetConnAttempt (happy-eyeballs connect in progress, the poll's objPtr)
+
+struct STStreamContext_;
+
+typedef struct STNetConnAttempt_ {
+    struct STStreamContext_* ctx; //parent
+    SOCKET          socket;     //0 if not started, failed or already taken
+    int             iAddr;      //at parent's 'net.he.addrs'
+} STNetConnAttempt;
+
+//STRtpPkt (udp rtp packet waiting at the jitter buffer)
+
+typedef struct STRtpPkt_ {
+    int             isUsed;
+    unsigned short  seq;
+    int             sz;
+    struct timeval  arrival;
+    unsigned char   data[K_RTP_PKT_MAX];
+} STRtpPkt;
+
+//STShmRingHdr (shared-memory ring, written by a local producer, see 'nbshmproducer.c')
+//Records are [STShmRecHdr][Annex-B access unit], 16-bytes aligned and never wrapped
+//(a K_SHM_REC_PAD record sends the reader to the ring start). Single producer, single consumer.
+
+#define K_SHM_RING_MAGIC            0x5253424E  //'NBSR'
+#define K_SHM_RING_VERSION          1
+#define K_SHM_RING_HDR_SZ           64          //records start at this offset (header in its own cache line)
+#define K_SHM_REC_PAD               0xFFFFFFFFu //record 'sz' value, next record is at ring start
+#define K_SHM_REC_FLAG_DISCONTINUITY 0x1        //producer dropped previous access units (ring was full)
+
+typedef struct STShmRingHdr_ {
+    uint32_t        magic;      //K_SHM_RING_MAGIC
+    uint32_t        version;    //K_SHM_RING_VERSION
+    uint32_t        dataSz;     //records area size, power of two
+    uint32_t        reserved;
+    uint64_t        head;       //bytes published by the producer (atomic, release)
+    uint64_t        tail;       //bytes released by the consumer (atomic, release)
+} STShmRingHdr;
+
+typedef struct STShmRecHdr_ {
+    uint32_t        sz;         //access unit size, or K_SHM_REC_PAD
+    uint32_t        nalTypes;   //bit-mask of NAL types contained
+    uint32_t        flags;      //K_SHM_REC_FLAG_*
+    uint32_t        reserved;
+} STShmRecHdr;
+
+//ENRtspState (rtsp requests sequence)
+
+typedef enum ENRtspState_ {
+    ENRtspState_Describe = 0,   //waiting DESCRIBE response (sdp)
+    ENRtspState_Setup,          //waiting SETUP response (session)
+    ENRtspState_Play,           //waiting PLAY response
+    ENRtspState_Playing,        //receiving interleaved frames (and keep-alive responses)
+    //
+    ENRtspState_Count
+} ENRtspState;
+
+//ENRtspItlState (rtsp interleaved frame '$' + channel + len16 + payload parsing)
+
+typedef enum ENRtspItlState_ {
+    ENRtspItlState_Magic = 0,
+    ENRtspItlState_Channel,
+    ENRtspItlState_Len0,
+    ENRtspItlState_Len1,
+    ENRtspItlState_Payload,
+    //
+    ENRtspItlState_Count
+} ENRtspItlState;
+
+//ENHttpChunkState (chunked transfer-encoding body parsing)
+
+typedef enum ENHttpChunkState_ {
+    ENHttpChunkState_Size = 0,  //hex digits
+    ENHttpChunkState_Ext,       //chunk-extension (ignored) until CR/LF
+    ENHttpChunkState_SizeLF,    //CR found after size, expecting LF
+    ENHttpChunkState_Data,      //chunk payload
+    ENHttpChunkState_DataCR,    //expecting CR after payload
+    ENHttpChunkState_DataLF,    //expecting LF after payload
+    ENHttpChunkState_Trailer,   //last-chunk found (body ended)
+    //
+    ENHttpChunkState_Count
+} ENHttpChunkState;
+
+//ENHttpPartState (multipart body parsing, like MJPEG's 'multipart/x-mixed-replace')
+
+typedef enum ENHttpPartState_ {
+    ENHttpPartState_Boundary = 0,   //skipping until the delimiter (preamble or after a sized part)
+    ENHttpPartState_Headers,        //rest of the delimiter line and the part headers, until the empty line
+    ENHttpPartState_Body,           //part payload (sized by 'Content-Length' or until the next delimiter)
+    //
+    ENHttpPartState_Count
+} ENHttpPartState;
+
+//STJpegDec (cpu decoder for MJPEG streams)
+
+#ifdef K_USE_LIBJPEG
+typedef struct STJpegDec_ {
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    jmp_buf         jmp;        //errors exit (corrupted data)
+    J_COLOR_SPACE   colorSpace; //output, by the framebuffer's pixFmt
+    int             bytesPerPx;
+} STJpegDec;
+#endif
+
 #define STREAM_CONTEXT_DECODER_SHOULD_BE_OPEN(OBJ)  ( \
                                                         !((OBJ)->shuttingDown.isActive && (OBJ)->shuttingDown.isPermanent) /*decoder is not permanently shutting/ed down*/ \
                                                         && ( \
@@ -730,6 +1233,10 @@ typedef struct STStreamContext_ {
         char*           server; //ip or dns
         unsigned int    port;   //port
         int             keepAlive;   //network connection is kept alive when decoder is disabled.
+        ENStreamNetProto netProto;   //http or rtsp
+        int             maxLatencyMs; //queued frames older than this are dropped up to the newest IDR (0 = unbounded, files are not trimmed)
+        int             gopCacheBytes; //while the decoder is closed, the newest IDR and its followers are kept up to this size, to feed the decoder at once when opened (0 = unbounded)
+        int             fileFps; //mapped files are parsed at this frame rate (0 = from the SPS timing info, or one frame per screen refresh if not present)
         char*           path;   // "/folder/file.264"
         int             srcPixFmt; //V4L2_PIX_FMT_H264
         int             buffersAmmount;
@@ -755,8 +1262,13 @@ typedef struct STStreamContext_ {
         unsigned long   msWithoutFeedFrame;     //to detect decoder-timeout
         unsigned long   msToReopen;  //
         int             isWaitingForIDRFrame;
+        int             isFaulty;               //timed-out, closed instead of parked (the device file is reopened)
         STBuffers       src;
         STBuffers       dst;
+        //jpeg (MJPEG streams)
+        struct {
+            struct STJpegDec_* cpu;     //cpu decoder when the device has no MJPEG support ('fd' is an eventfd and 'dst' a single heap buffer)
+        } jpeg;
         //frames
         struct {
             unsigned long       foundCount; //frames found available to fed
@@ -768,6 +1280,8 @@ typedef struct STStreamContext_ {
     struct {
         STVideoFrame*   filling;    //currently filling frame
         int             fillingNalSz; //current (latest) NAL header and payload sz
+        int             fillingSliceIsPending; //current NAL is a slice whose header was not parsed yet (it could start a new picture)
+        int             gopCacheIsTruncated;   //the GOP cache reached 'cfg.gopCacheBytes', frames are dropped until the next IDR
         STVideoFrames   filled;     //filled with payload
         STVideoFrames   reusable;   //for reutilization
     } frames;
@@ -789,14 +1303,60 @@ typedef struct STStreamContext_ {
         int             fd;
         unsigned long   msWithoutRead;  //to detect connection-timeout
         unsigned long   msToReconnect;  //
+        //mapped (NALs are parsed from the mapping, 'buff' is not used)
+        const unsigned char* map;   //NULL if read by 'fd'
+        unsigned long   mapSz;
+        unsigned long   mapPos;     //next byte to parse, inside the current sample for mp4 (back to zero at the end, loop playback)
+        unsigned long long usNextFrame; //monotonic deadline to parse the next frame (0 = not started)
+        ENStreamFileFmt fmt;        //length-prefixed NALs are fed after a start code (the mapping is not modified)
+        STMp4Track      mp4;        //sample table (ENStreamFileFmt_Mp4)
+        unsigned long   mp4Sample;  //current sample
     } file;
     //net
     struct {
         SOCKET          socket;         //async
-        struct gaicb*   hostResolver;   //async
+        int             isResolving;    //waiting for the player's dns record (async)
+        int             isReusedConn;   //current socket was taken from the player's netPool (warm)
         unsigned long   msWithoutSend;  //to detect connection-timeout
         unsigned long   msWithoutRecv;  //to detect connection-timeout
         unsigned long   msToReconnect;  //
+        //he (happy-eyeballs: connects raced over the resolved addresses, the first to complete is used)
+        struct {
+            STNetAddrs  addrs;      //candidates (families interleaved)
+            int         iNext;      //next candidate to start
+            int         use;        //attempts in progress
+            unsigned long msToNext; //wait before starting the next candidate
+            STNetConnAttempt attempts[K_NET_ADDRS_MAX]; //by candidate index
+        } he;
+        //tune (adaptive buffers and socket options, by observed bitrate)
+        struct {
+            unsigned long bytesPerSec;  //observed (fast-attack, slow-decay), kept between reconnections
+            unsigned long bytesRcvdPrev; //at previous evaluation
+            unsigned long msAccum;      //since previous evaluation
+            int         shrinkEvals;    //consecutive evaluations wanting a smaller buffer
+            int         rcvBufSz;       //SO_RCVBUF as reported by the kernel (0 = unknown)
+            int         rcvLowat;       //SO_RCVLOWAT set (0 = default)
+            //stats
+            struct {
+                struct {
+                    unsigned long recvs;    //read syscalls (recv, recvmmsg or io_uring completions)
+                    unsigned long resizes;  //buffer or socket size changes
+                } curSec;
+            } stats;
+        } tune;
+        //reconn (backoff)
+        struct {
+            int         attempts;       //consecutive attempts without receiving a stream-unit
+            int         wasVisible;     //'dec.shouldBeOpen' at previous tick (to retry immediately when entering the screen)
+            unsigned long msLastWait;   //latest scheduled wait
+            //stats
+            struct {
+                struct {
+                    unsigned long deferred;  //attempts delayed by the pending-connections limits
+                    unsigned long immediate; //backoffs skipped by entering the screen
+                } curSec;
+            } stats;
+        } reconn;
         //
         unsigned long   msSinceStart;   //connection start (resolve or socket)
         unsigned long   msToResolve;    //time since start to resolve host
@@ -818,17 +1378,107 @@ typedef struct STStreamContext_ {
         } req;
         //resp
         struct {
-            int         headerEndSeq;    //0 = [], 1 = ['\r'], 2 = ['\r', '\n'], 3 = ['\r', '\n', '\r']
             int         headerSz;        //
-            int         headerEnded;     //"\r\n\r\n" found after connection
+            int         headerEnded;     //empty-line found after connection
+            int         statusCode;      //from status-line
+            int         isChunked;       //'Transfer-Encoding: chunked'
+            int         contentLength;   //'Content-Length' (-1 if not present)
+            //line (status-line or header being parsed)
+            struct {
+                char    str[K_HTTP_LINE_MAX];
+                int     use;
+                int     count;           //lines completed (0 = status-line not received yet)
+            } line;
+            //chunk (body, if chunked)
+            struct {
+                ENHttpChunkState state;
+                int     sizeDigits;      //hex digits found in current size-line
+                unsigned long remain;    //payload bytes remaining in current chunk
+            } chunk;
+            //part (body, if multipart)
+            struct {
+                char    delim[K_HTTP_BOUNDARY_MAX]; //'\r\n--' + boundary
+                int     delimLen;        //zero if the body is not multipart
+                ENHttpPartState state;
+                int     delimMatched;    //delimiter bytes matched (partial matches at the end of a read are pending)
+                int     linesCount;      //lines completed after the delimiter (the first one is the rest of the delimiter line)
+                int     contentLength;   //part 'Content-Length' (-1 if not present)
+                int     remain;          //sized part payload bytes remaining (-1 if unsized)
+                int     isSkipped;       //part is not an image
+            } part;
         } resp;
+        //rtsp (if cfg.netProto is ENStreamNetProto_Rtsp)
+        struct {
+            ENRtspState state;
+            int         cseq;
+            int         bodyRemain;      //current response body bytes remaining
+            int         isVideoMedia;    //sdp, parsing a 'm=video' section
+            int         isCodecMismatch; //sdp, video 'a=rtpmap' encoding is not the decoder's (see '--srcFmt')
+            int         timeoutSecs;     //session timeout
+            unsigned long msSinceKeepAlive;
+            char        base[K_HTTP_LINE_MAX];     //'Content-Base' or request url
+            char        control[K_HTTP_LINE_MAX];  //video track url (absolute)
+            char        session[K_HTTP_LINE_MAX];  //'Session' id
+            //itl (interleaved frames)
+            struct {
+                ENRtspItlState state;
+                int         channel;
+                int         len;
+                int         use;         //payload bytes accumulated at 'buff' (frame split between reads)
+                unsigned char* buff;     //64KB, allocated at first split frame
+            } itl;
+        } rtsp;
+        //rtp (depacketization, rtsp-interleaved or udp)
+        struct {
+            int             isSeqSet;
+            unsigned short  seqNext;
+            int             isFuActive;  //FU-A fragmented NAL in progress
+            unsigned long   pktsLost;
+            //jitter (udp, reorder buffer)
+            struct {
+                int             isSeqSet;
+                unsigned short  seqNext;   //next seq to release
+                unsigned int    ssrc;      //source of 'seqNext' (a new one restarts the sequence)
+                STRtpPkt*       slots;     //K_RTP_JITTER_SLOTS, indexed by 'seq % K_RTP_JITTER_SLOTS'
+                int             use;       //packets waiting
+            } jitter;
+            //batch (udp, 'recvmmsg()' buffers)
+            struct {
+                struct mmsghdr* msgs;      //K_RTP_UDP_BATCH
+                struct iovec*   iovs;      //K_RTP_UDP_BATCH
+                unsigned char*  buff;      //K_RTP_UDP_BATCH * K_RTP_PKT_MAX
+            } batch;
+            //stats
+            struct {
+                struct {
+                    unsigned long pkts;
+                    unsigned long batches;   //'recvmmsg()' calls with data
+                    unsigned long reordered; //arrived after a later one, released in order
+                    unsigned long late;      //arrived after its seq was released or skipped (dropped)
+                    unsigned long lost;      //seqs skipped
+                } curSec;
+            } stats;
+        } rtp;
     } net;
+    //shm (if cfg.netProto is ENStreamNetProto_Shm, 'net.socket' is the UNIX socket)
+    struct {
+        unsigned char*  map;        //memfd mapping (kept after disconnection while frames reference it)
+        unsigned long   mapSz;
+        STShmRingHdr*   hdr;        //at 'map' start (NULL if not received yet)
+        uint64_t        readPos;    //next record to queue (records before it are referenced by 'frames.filled' or released)
+    } shm;
+    //h264 (parameter sets found in the stream, to parse the slice headers)
+    struct {
+        STH264Sps       sps[K_H264_SPS_MAX];    //by seq_parameter_set_id
+        STH264Pps       pps[K_H264_PPS_MAX];    //by pic_parameter_set_id
+    } h264;
     //drawPlan
     struct {
         //persistent between decoder closing/open
         int lastPixelformat; //last dec.dst.pixelformat value known
         STFbRect lastCompRect; //last dec.dst.composition with non-zero-sizes known
         int lastHeight;     //last dec.dst.composition.height non-zero value known
+        STH264Sps lastSps;  //last SPS found in the stream (geometry known before a decoder is opened)
         //
         int peekRemainMs;   //this stream is allowed to decode to peek the image-size or stream-props
         int hitsCount;      //times this context will be used on the current draw-plan
@@ -856,22 +1506,66 @@ void StreamContext_release(STStreamContext* ctx);
 int StreamContext_isSame(STStreamContext* ctx, const char* device, const char* server, const unsigned int port, const char* resPath, int srcPixFmt /*V4L2_PIX_FMT_H264*/, int dstPixFmt /*V4L2_PIX_FMT_RGB565*/);
 int StreamContext_open(STStreamContext* ctx, struct STPlayer_* plyr, const char* device, const char* server, const unsigned int port, const int keepAlive, const char* resPath, int srcPixFmt /*V4L2_PIX_FMT_H264*/, int buffersAmmount, int planesPerBuffer, int sizePerPlane, int dstPixFmt /*V4L2_PIX_FMT_RGB565*/, const int connTimeoutSecs, const int decoderTimeoutSecs, const unsigned long framesSkip, const unsigned long framesFeedMax);
 int StreamContext_close(STStreamContext* ctx, struct STPlayer_* plyr);
+int StreamContext_park(STStreamContext* ctx, struct STPlayer_* plyr); //stops the decoder and hands it to the player's decPool (closed if not poolable)
+int StreamContext_openParked_(STStreamContext* ctx, struct STPlayer_* plyr, struct STDecoderParked_* parked, const int fd, const int srcPixFmt, const int buffersAmmount, const int planesPerBuffer, const int sizePerPlane, const int print); //takes the parked buffers (src reallocated if its params differ)
 //
+int StreamContext_concatRequest(STStreamContext* ctx, char* dst, int dstSz); //by 'cfg.netProto'
 int StreamContext_concatHttpRequest(STStreamContext* ctx, char* dst, int dstSz);
+int StreamContext_concatRtspRequest(STStreamContext* ctx, char* dst, int dstSz); //by 'net.rtsp.state'
+int StreamContext_concatShmRequest(STStreamContext* ctx, char* dst, int dstSz);
 
 void StreamContext_updatePollMask_(STStreamContext* ctx, struct STPlayer_* plyr);
 void StreamContext_updatePollMaskFile_(STStreamContext* ctx, struct STPlayer_* plyr);
+void StreamContext_netResolved_(STStreamContext* ctx, struct STPlayer_* plyr, const STNetAddrs* hostAddrs); //hostAddrs is NULL if resolution failed
+int StreamContext_netAttemptStart_(STStreamContext* ctx, struct STPlayer_* plyr); //starts the next happy-eyeballs candidate, returns 0 if started
+void StreamContext_netAttemptsClose_(STStreamContext* ctx, struct STPlayer_* plyr); //closes the happy-eyeballs attempts in progress ('plyr' NULL at release)
+void StreamContext_pollCallbackConnAttempt_(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, int revents);
+void StreamContext_netAttachSocket_(STStreamContext* ctx, struct STPlayer_* plyr, SOCKET sckt, const int isReused); //polls the connected or connecting socket and builds the request
+void StreamContext_netAttachUdp_(STStreamContext* ctx, struct STPlayer_* plyr, SOCKET sckt); //polls the bound udp socket (rtp)
+void StreamContext_netUdpRead_(STStreamContext* ctx, struct STPlayer_* plyr); //recvmmsg batches into the rtp jitter buffer
+void StreamContext_rtpJitterDrain_(STStreamContext* ctx, struct STPlayer_* plyr, struct timeval* now, const int isFlush); //releases in-order packets to the depacketizer
+void StreamContext_shmConnect_(STStreamContext* ctx, struct STPlayer_* plyr); //connects to the producer's UNIX socket
+void StreamContext_shmRead_(STStreamContext* ctx, struct STPlayer_* plyr); //receives the ring (memfd) or doorbells and queues the published records
+void StreamContext_shmRelease_(STStreamContext* ctx); //releases the ring space of records already consumed
+void StreamContext_shmUnmap_(STStreamContext* ctx); //discards the frames referencing the ring and unmaps it
+void StreamContext_frameFilledNotify_(STStreamContext* ctx, struct STPlayer_* plyr, const int filledWasEmpty); //starts or feeds the decoder after frames were added to 'frames.filled'
+void StreamContext_spsFound_(STStreamContext* ctx, struct STPlayer_* plyr, const unsigned char* nal, const int nalSz); //keeps the SPS props and sets the draw-plan geometry if the decoder has not set it yet
+void StreamContext_decBuffBindFilling_(STStreamContext* ctx); //the new filling frame is assembled in place on a free OUTPUT buffer (if the decoder is open and not backlogged)
+void StreamContext_decBuffsReclaim_(STStreamContext* ctx); //unbinds the OUTPUT buffers still bound to recycled frames
+void StreamContext_framesTrimToLatency_(STStreamContext* ctx, struct STPlayer_* plyr); //drops the queued frames older than the newest IDR if the oldest exceeds 'cfg.maxLatencyMs'
+int StreamContext_gopCacheAccepts_(STStreamContext* ctx, struct STPlayer_* plyr, const STVideoFrame* frame); //1 if the completed 'frame' can be queued, 0 if it must be dropped (GOP cache while the decoder is closed)
+void StreamContext_decBuffsUnbindAll_(STStreamContext* ctx); //moves the payloads assembled in OUTPUT buffers to the frames' own buffers (before unmapping)
+int StreamContext_cnsmMultipart_(STStreamContext* ctx, struct STPlayer_* plyr); //extracts the parts (JPEGs) from 'buff', -1 = malformed, 1 = close-delimiter found
+int StreamContext_jpegCpuOpen_(STStreamContext* ctx, const int dstPixFmt, int* fd); //replaces the device's 'fd' by an eventfd and creates the cpu decoder
+void StreamContext_jpegCpuClose_(STStreamContext* ctx); //releases the cpu decoder and its output buffer (not the fd)
+void StreamContext_jpegCpuFeed_(STStreamContext* ctx, struct STPlayer_* plyr); //decodes the newest filled frame
+void StreamContext_netBuildRequest_(STStreamContext* ctx); //into 'net.req' (to be sent at POLLOUT)
+int StreamContext_netSendRequest_(STStreamContext* ctx, struct STPlayer_* plyr); //builds the request and enables POLLOUT (connected sockets)
+void StreamContext_cnsmFileRead_(STStreamContext* ctx, struct STPlayer_* plyr, const int rcvd);
+int StreamContext_cnsmNALs_(STStreamContext* ctx, struct STPlayer_* plyr, const int flushOldersIfIsIndependent, const unsigned char* bStart, const unsigned char* bAfterEnd, const int stopAfterFramePushed); //parses Annex-B data, returns the bytes consumed (less than all if stopped after the header that completed a frame)
+int StreamContext_fileMapParseFrame_(STStreamContext* ctx, struct STPlayer_* plyr); //parses the mapping up to the next completed frame, 1 if completed
+int StreamContext_fileMapOpen_(STStreamContext* ctx, const int fd); //maps the opened file to parse it without reads, 0 if mapped
+void StreamContext_fileMapClose_(STStreamContext* ctx);
+unsigned long StreamContext_fileMapFrameUs_(STStreamContext* ctx); //frame duration from '--fileFps' or the SPS timing info (0 = unknown, one frame per screen refresh)
+void StreamContext_fileMapTick_(STStreamContext* ctx, struct STPlayer_* plyr); //parses the frames whose deadline passed
+void StreamContext_cnsmNetRcvd_(STStreamContext* ctx, struct STPlayer_* plyr, const int rcvd);
+int StreamContext_uringPostRead_(STStreamContext* ctx, struct STPlayer_* plyr, const ENPlayerPollFdType type); //0 = posted, 1 = previous still pending
+void StreamContext_uringCallback(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, const int res);
 //
 int StreamContext_getMinBuffersForDst(STStreamContext* ctx, int* dstValue);
 //
 int StreamContext_initAndPrepareSrc(STStreamContext* ctx, int fd, const int buffersAmmount, const int print);
 int StreamContext_initAndStartDst(STStreamContext* ctx, struct STPlayer_* plyr);
+int StreamContext_dstReuseParked_(STStreamContext* ctx); //starts the dst buffers kept by a parked decoder, if the new format fits them
 int StreamContext_stopAndCleanupBuffs(STStreamContext* ctx, STBuffers* buffs, int fd);
 //
 int StreamContext_eventsSubscribe(STStreamContext* ctx, int fd);
 int StreamContext_eventsUnsubscribe(STStreamContext* ctx, int fd);
 
 void StreamContext_tick(STStreamContext* ctx, struct STPlayer_* plyr, unsigned int ms);
+void StreamContext_netScheduleReconnect_(STStreamContext* ctx, struct STPlayer_* plyr);
+void StreamContext_netTuneEval_(STStreamContext* ctx, struct STPlayer_* plyr); //measures the bitrate since previous call (once per second)
+void StreamContext_netTuneApply_(STStreamContext* ctx, struct STPlayer_* plyr); //sizes the ingest buffer and socket options by the measured bitrate
 int StreamContext_getPollEventsMask(STStreamContext* ctx);
 int StreamContext_getPollEventsMaskFile(STStreamContext* ctx, struct STPlayer_* plyr);
 void StreamContext_pollCallback(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, int revents);
@@ -899,6 +1593,87 @@ void PrintedInfo_release(STPrintedInfo* obj);
 int PrintedInfo_set(STPrintedInfo* obj, const char* device, const int srcFmt, const int dstFmt); //applies info
 int PrintedInfo_touch(STPrintedInfo* obj);  //updated 'last' time
 
+//STDnsRecord
+//Server address resolution shared by all the streams of the same server.
+
+typedef struct STDnsRecord_ {
+    char*               server;     //name/ip
+    struct gaicb*       resolver;   //async, owned (including 'ar_result'), NULL if not resolving
+    struct addrinfo     hints;      //resolver's request (must live while resolving)
+    int                 isResolved; //'addrs' is valid
+    STNetAddrs          addrs;      //resolved addresses (families interleaved, preferred first)
+    unsigned long long  msResolved; //player's 'msRunning' at resolution (for cache ttl)
+} STDnsRecord;
+
+void DnsRecord_init(STDnsRecord* obj);
+void DnsRecord_release(STDnsRecord* obj);
+
+//STNetPool
+//Per server:port warm (connected but not requested yet) connections.
+//Streams' responses never end, so in-use connections can't be reused;
+//instead, the connection released by an out-of-screen stream is replaced
+//by a warm one, taken by the next stream requesting the same server:port.
+
+struct STNetPool_;
+
+typedef struct STNetPoolConn_ {
+    struct STNetPool_*  pool;       //parent
+    SOCKET              socket;
+    int                 isConnected; //connect completed (writable)
+    unsigned long long  msStarted;  //player's 'msRunning' at connect-start (for idle expiration)
+} STNetPoolConn;
+
+typedef struct STNetPool_ {
+    char*               server;     //name/ip
+    unsigned int        port;
+    int                 isAddrSet;  //'addr' is valid
+    STNetAddr           addr;       //last address connected to (happy-eyeballs winner)
+    //conns
+    struct {
+        STNetPoolConn** arr;
+        int             use;
+        int             sz;
+    } conns;
+    //stats
+    struct {
+        //curSec (reseted each second)
+        struct {
+            unsigned long   connsNew;       //connections started by streams
+            unsigned long   connsReused;    //warm connections taken by streams
+            unsigned long   connsWarmed;    //warm connections started
+            unsigned long   connsWasted;    //warm connections closed without being taken
+            unsigned long   msToConnectSum; //streams' time to send the request
+            unsigned long   msToConnectCount;
+            unsigned long   msToFirstUnitSum; //streams' time to receive the first unit
+            unsigned long   msToFirstUnitCount;
+        } curSec;
+    } stats;
+} STNetPool;
+
+void NetPool_init(STNetPool* obj);
+void NetPool_release(STNetPool* obj, struct STPlayer_* plyr);
+
+//STDecoderParked
+//Opened decoder released by an out-of-screen stream, kept by the player
+//with both queues stopped and its buffers allocated and mapped; the next
+//stream opening the same device takes it instead of opening a new handle.
+
+typedef struct STDecoderParked_ {
+    char*               device;
+    int                 fd;
+    int                 srcPixFmt;      //'src' buffers were allocated for these params
+    int                 buffersAmmount;
+    int                 planesPerBuffer;
+    int                 sizePerPlane;
+    int                 dstPixFmt;
+    STBuffers           src;
+    STBuffers           dst;
+    unsigned long long  msParked;       //player's 'msRunning' at park (oldest is closed first)
+} STDecoderParked;
+
+void DecoderParked_init(STDecoderParked* obj);
+void DecoderParked_release(STDecoderParked* obj); //closes the device (if not taken)
+
 //STPlayer
 
 //STFramebuffsGrpFb
@@ -918,9 +1693,24 @@ typedef struct STPlayer_ {
         int             extraThreadsAmm;
         int             connTimeoutSecs;
         int             connWaitReconnSecs;
+        int             connWaitReconnMaxSecs; //backoff cap
+        int             connPendingPerServer;  //max simultaneous connection attempts per server:port (0 = unlimited)
+        int             connPendingMax;        //max simultaneous connection attempts (0 = unlimited)
+        int             dnsCacheSecs;
+        int             netPoolIdleMax;     //max warm connections per server:port (0 = disabled)
+        int             netPoolIdleSecs;    //warm connections' max idle time
+        int             ioUring;        //use io_uring for src-ingest (if available)
+        int             netReadBudgetKB;     //max KBs to recv per stream per wakeup (0 = until drained)
+        int             netReadBudgetFrames; //max frames to complete per stream per wakeup (0 = until drained)
+        int             rtpJitterMs;        //udp rtp reorder wait (0 = gaps are skipped immediately)
+        int             netBuffAdapt;       //ingest buffer and SO_RCVBUF sized by observed bitrate
+        int             netTcpNoDelay;      //TCP_NODELAY
+        int             netTcpQuickAck;     //TCP_QUICKACK (re-armed at each read wakeup)
+        int             netRcvLowatMs;      //SO_RCVLOWAT as ms of bitrate (0 = disabled)
         int             decoderTimeoutSecs;
         int             decoderWaitRecopenSecs;
         int             decodersMax;
+        int             decoderPool;        //keep stopped decoders opened for the next stream (counted in 'decodersMax')
         int             decodersToPeekSecs;
         int             animSecsWaits;
         int             animPreRenderSecs;
@@ -939,7 +1729,53 @@ typedef struct STPlayer_ {
         int             fdsUse;
         int             fdsSz;
         int             autoremovesPend; //orphans
+        unsigned int    iNextFirst; //round-robin first fd to process after poll
     } poll;
+    //uring (optional src-ingest backend, replaces poll+read/recv of files and sockets)
+    struct {
+        int             isActive;
+#       ifdef K_USE_IO_URING
+        STIoUring       ring;
+#       endif
+        STPlayerUringOp** arr;  //posted ops (until completion)
+        int             use;
+        int             sz;
+    } uring;
+    //dns (shared by streams)
+    struct {
+        int             evtFd;  //eventfd, written when a 'getaddrinfo_a' completes (SIGEV_THREAD)
+        STDnsRecord**   arr;
+        int             use;
+        int             sz;
+    } dns;
+    //netPools (per server:port, shared by streams)
+    struct {
+        STNetPool**     arr;
+        int             use;
+        int             sz;
+    } netPools;
+    //decPool (decoders parked by out-of-screen streams, shared by streams)
+    struct {
+        STDecoderParked** arr;
+        int             use;
+        int             sz;
+        //stats
+        struct {
+            //curSec (reseted each second)
+            struct {
+                unsigned long   hits;           //opens served by a parked decoder
+                unsigned long   misses;         //opens of a new device handle
+                unsigned long   reallocs;       //hits that reallocated buffers (format or size differed)
+                unsigned long   parked;         //decoders parked by streams
+                unsigned long   evicted;        //parked decoders closed to respect 'decodersMax'
+                unsigned long   usToReassignSum; //hits' time to open
+                unsigned long   usToReassignMax;
+                unsigned long   usToOpenSum;    //misses' time to open
+            } curSec;
+        } stats;
+    } decPool;
+    //slabs (frames' payload buffers, shared by streams)
+    STBuffSlabs         slabs;
     //fbs (framebuffers, a.k.a screens)
     struct {
         STFramebuff**   arr;
@@ -982,6 +1818,8 @@ typedef struct STPlayer_ {
                     unsigned long long  ignored;    //completed NALs ignored (not queued)
                     unsigned long long  queued;     //completed NALs queued
                     unsigned long long  queuedIDR;  //completed NALs queued are IDRs
+                    unsigned long long  dropped;    //queued frames dropped by latency (older than the newest IDR)
+                    unsigned long long  droppedBytes; //payload of 'dropped'
                 } frames;
             } src;
             //decoder
@@ -989,6 +1827,7 @@ typedef struct STPlayer_ {
                 //fed (input)
                 struct {
                     unsigned long long count;   //frames
+                    unsigned long long inPlace; //frames assembled in the OUTPUT buffer (not copied)
                 } fed;
                 //got (output)
                 struct {
@@ -1044,21 +1883,43 @@ int Player_createExtraThreads(STPlayer* obj, int extraThreadsAmm);
 int Player_pollAdd(STPlayer* obj, const ENPlayerPollFdType type, PlayerPollCallback callback, void* objPtr, const int fd, const int events);
 int Player_pollUpdate(STPlayer* obj, const ENPlayerPollFdType type, const void* objPtr, const int fd, const int events, int* dstEventsBefore);
 int Player_pollAutoRemove(STPlayer* obj, const ENPlayerPollFdType type, const void* objPtr, const int fd); //flag to be removed (safe inside poll-events)
+
+//uring (optional src-ingest backend)
+int Player_uringStart(STPlayer* obj, const unsigned entries);
+int Player_uringRead(STPlayer* obj, const ENPlayerPollFdType type, PlayerUringCallback callback, void* objPtr, const int fd, void* buff, const int buffSz, const int isRecv); //0 = posted
+int Player_uringIsPending(STPlayer* obj, const ENPlayerPollFdType type, const void* objPtr);
+int Player_uringSubmit(STPlayer* obj); //submits all posted sqes (one syscall), called before poll
+int Player_uringCancel_(STPlayer* obj, const ENPlayerPollFdType type, const void* objPtr, const int fd, const int waitCompletions); //'type = Count', 'objPtr = NULL' or 'fd < 0' matches any
+
+//dns
+int Player_dnsResolve(STPlayer* obj, const char* server, STNetAddrs* dstAddrs, int* dstIsResolved); //if not cached, 'StreamContext_netResolved_' is called for the server's streams once completed
 //int Player_pollRemove_(STPlayer* obj, const ENPlayerPollFdType type, const void* objPtr, const int fd);  //remove inmediatly (unsafe inside poll-events)
 
+//netPools
+STNetPool* Player_netPoolGet(STPlayer* obj, const char* server, const unsigned int port, const int createIfNecesary);
+SOCKET Player_netPoolTake(STPlayer* obj, const char* server, const unsigned int port); //returns 0 if no warm connection is available
+int Player_netPoolWarm(STPlayer* obj, const char* server, const unsigned int port); //starts a warm connection (if allowed)
+
+//decPool
+int Player_decPoolAdd(STPlayer* obj, STDecoderParked* dec); //takes ownership (closes the oldest ones exceeding 'decodersMax')
+STDecoderParked* Player_decPoolTake(STPlayer* obj, const char* device, const int srcPixFmt, const int dstPixFmt); //returns NULL if none parked for the device, src-fmt and dst-fmt, caller owns the result
+int Player_decPoolTrim(STPlayer* obj, const int slotsToOpen); //closes the oldest parked decoders until opened + parked + 'slotsToOpen' fits 'decodersMax'
+int Player_netConnectAllowed(STPlayer* obj, const char* server, const unsigned int port); //pending-connections limits (per server:port and global)
+
 //fbs
 int Player_fbAdd(STPlayer* obj, const char* device, const ENFramebuffsGrpFbLocation location, const int locX, const int locY, const int animSecsWaits);
 int Player_fbRemove(STPlayer* obj, STFramebuff* stream);
 int Player_fbsCloseCurrentGrps(STPlayer* obj);
 
 //streams
-int Player_streamAdd(STPlayer* obj, const char* device, const char* server, const unsigned int port, const int keepAlive, const char* resPath, const int connTimeoutSecs, const int decoderTimeoutSecs, const unsigned long framesSkip, const unsigned long framesFeedMax);
+int Player_streamAdd(STPlayer* obj, const char* device, const char* server, const unsigned int port, const int keepAlive, const ENStreamNetProto netProto, const int maxLatencyMs, const int gopCacheKB, const int fileFps, const int srcPixFmt /*V4L2_PIX_FMT_H264*/, const char* resPath, const int connTimeoutSecs, const int decoderTimeoutSecs, const unsigned long framesSkip, const unsigned long framesFeedMax);
 int Player_streamRemove(STPlayer* obj, STStreamContext* stream);
 
 //organize
 //Assigns fb and screen-area to each stream. Should be called on each stream resize event.
 int Player_organize(STPlayer* obj);
 int Player_tick(STPlayer* obj, int ms);
+int Player_getMsToNextTick(STPlayer* obj, const int msPerTick); //nearest deadline requiring a tick (multiple of 'msPerTick')
 
 //
 
@@ -1066,8 +1927,17 @@ int v4lDevice_queryCaps(int fd, const int print);
 int v4lDevice_queryControls(int fd, const int print);
 int v4lDevice_controlAnalyze(int fd, struct v4l2_queryctrl* ctrl, const int print);
 //
+SOCKET netSocketConnectStart(const STNetAddr* hostAddr, const unsigned int port, const char* dbgServer, const char* dbgPath); //non-blocking, returns 0 if failed
+SOCKET netSocketUdpBind(const STNetAddr* hostAddr, const unsigned int port, const char* dbgServer, const char* dbgPath); //non-blocking, joins the group if multicast, returns 0 if failed
+//
 long msBetweenTimevals(struct timeval* base, struct timeval* next);
 long msBetweenTimespecs(struct timespec* base, struct timespec* next);
+//
+const unsigned char* nalScanNonZero(const unsigned char* b, const unsigned char* bAfterEnd); //first zero byte (or 'bAfterEnd'), by blocks with NEON/SSE2 or memchr()
+const unsigned char* nalScanStartCode(const unsigned char* b, const unsigned char* bAfterEnd, int* zeroesSeqAccum); //the '0x01' ending a '00 00 00 01' header (or 'bAfterEnd'), zeroes are accumulated between calls (headers split between reads)
+int nalScanBenchmark(const char* path); //prints the per-byte and scanner throughputs on a captured stream, -1 if they found different headers
+int nalsAreLengthPrefixed(const unsigned char* b, const unsigned long long sz, const int lenSz); //1 if the first NALs (up to 8) are chained by 'lenSz'-bytes big-endian lengths (AVCC), not start codes
+int framesQueueBenchmark(const int backlog); //prints the shifting-array and ring costs of queuing and consuming a burst of frames and fed-states, -1 if they produced different orders
 
 //----------
 //-- main --
@@ -1121,8 +1991,23 @@ void printHelp(void){
     K_LOG_INFO("-t, --extraThreads num    extra threads for rendering (default: %d).\n", K_DEF_THREADS_EXTRA_AMM);
     K_LOG_INFO("-cto, --connTimeout num   seconds without conn activity to restart connection (default: %ds).\n", K_DEF_CONN_TIMEOUT_SECS);
     K_LOG_INFO("-crc, --connWaitReconnect num, seconds to wait before reconnect (default: %ds).\n", K_DEF_CONN_RETRY_WAIT_SECS);
+    K_LOG_INFO("-crm, --connWaitReconnectMax num, max seconds to wait before reconnect, doubling after each failed attempt (default: %ds).\n", K_DEF_CONN_RETRY_WAIT_MAX_SECS);
+    K_LOG_INFO("-cps, --connPendingPerServer num, max simultaneous connection attempts per server:port, 0 = unlimited (default: %d).\n", K_DEF_CONN_PENDING_PER_SERVER);
+    K_LOG_INFO("-cpm, --connPendingMax num, max simultaneous connection attempts for all servers, 0 = unlimited (default: %d).\n", K_DEF_CONN_PENDING_MAX);
+    K_LOG_INFO("-dns, --dnsCacheSecs num  seconds to reuse a resolved server address, 0 disables the cache (default: %ds).\n", K_DEF_DNS_CACHE_SECS);
+    K_LOG_INFO("-npm, --netPoolIdleMax num, warm connections kept per server:port for streams entering the screen, 0 disables it (default: %d).\n", K_DEF_NET_POOL_IDLE_MAX);
+    K_LOG_INFO("-nps, --netPoolIdleSecs num, seconds a warm connection is kept (default: %ds).\n", K_DEF_NET_POOL_IDLE_SECS);
+    K_LOG_INFO("-iou, --ioUring 0|1       reads files and sockets with io_uring instead of poll+read/recv, if available (default: 0).\n");
+    K_LOG_INFO("-nrb, --netReadBudgetKB num, max KBs to read per stream per wakeup before yielding, 0 = until drained (default: %d).\n", K_DEF_NET_READ_BUDGET_KB);
+    K_LOG_INFO("-nba, --netBuffAdapt 0|1  sizes each stream's ingest buffer and SO_RCVBUF by its observed bitrate (default: %d).\n", K_DEF_NET_BUFF_ADAPT);
+    K_LOG_INFO("-ntd, --netTcpNoDelay 0|1 sets TCP_NODELAY at streams' sockets (default: %d).\n", K_DEF_NET_TCP_NODELAY);
+    K_LOG_INFO("-nqa, --netTcpQuickAck 0|1, re-arms TCP_QUICKACK at each read wakeup (default: %d).\n", K_DEF_NET_TCP_QUICKACK);
+    K_LOG_INFO("-nlw, --netRcvLowatMs num sets SO_RCVLOWAT as this ms of the stream's bitrate to batch wakeups, 0 = disabled (default: %d).\n", K_DEF_NET_RCVLOWAT_MS);
+    K_LOG_INFO("-nrf, --netReadBudgetFrames num, max frames to complete per stream per wakeup before yielding, 0 = until drained (default: %d).\n", K_DEF_NET_READ_BUDGET_FRAMES);
+    K_LOG_INFO("-rjm, --rtpJitterMs num   ms an out-of-order udp rtp packet waits for the missing ones (default: %dms).\n", K_DEF_RTP_JITTER_MS);
     K_LOG_INFO("-dto, --decTimeout num    seconds without decoder output to restart decoder (default: %ds).\n", K_DEF_DECODER_TIMEOUT_SECS);
     K_LOG_INFO("-dro, --decWaitReopen num, seconds to wait before reopen decoder device (default: %ds).\n", K_DEF_DECODER_RETRY_WAIT_SECS);
+    K_LOG_INFO("-dp, --decPool 0|1        keeps decoders of streams leaving the screen opened and mapped for the next stream entering it (default: %d).\n", K_DEF_DECODER_POOL);
     K_LOG_INFO("-aw, --animWait num       seconds between animation steps (default: %ds).\n", K_DEF_ANIM_WAIT_SECS);
     K_LOG_INFO("-fps, --framesPerSec num  screen frames/refresh per second (default: %d).\n", K_DEF_FRAMES_PER_SEC);
     K_LOG_INFO("-dm, --drawMode v         defines the drawing order:\n");
@@ -1141,11 +2026,23 @@ void printHelp(void){
     K_LOG_INFO("-fbng, --frameBufferNewGrps framebuffers after this wil start new fb layouts.\n");
     K_LOG_INFO("\n");
     K_LOG_INFO("-dec, --decoder path      sets the path to decoder device (like '/dev/video0') for next streams.\n");
-    K_LOG_INFO("-srv, --server name/ip    sets the name/ip to server for next streams.\n");
+    K_LOG_INFO("-srv, --server name/ip    sets the name/ip (ipv4 or ipv6) to server for next streams.\n");
     K_LOG_INFO("-p, --port num            sets the port number for next streams.\n");
     K_LOG_INFO("-ka, --keepAlive 0|1      sets the 'keepAlive' value for streams net-conns.\n");
+    K_LOG_INFO("-np, --netProto v         sets the protocol for next streams:\n");
+    K_LOG_INFO("                          http; GET request, Annex-B body (default).\n");
+    K_LOG_INFO("                          rtsp; DESCRIBE/SETUP/PLAY, RTP interleaved over TCP.\n");
+    K_LOG_INFO("                          udp; RTP over UDP at server:port (multicast group or local address), path is only a name.\n");
+    K_LOG_INFO("                          shm; local producer's shared-memory ring, server is its UNIX socket path, port is ignored.\n");
+    K_LOG_INFO("-sf, --srcFmt v           sets the compressed format for next network streams:\n");
+    K_LOG_INFO("                          h264; Annex-B H.264 (default).\n");
+    K_LOG_INFO("                          hevc; Annex-B H.265 (also 'h265'), rtsp/udp payloads as RFC 7798, not available for shm.\n");
+    K_LOG_INFO("                          mjpeg; JPEGs in a 'multipart/x-mixed-replace' http body, decoded by the device if supported, else at the CPU.\n");
+    K_LOG_INFO("-gc, --gopCache KB        KBs of the newest IDR and its followers kept while the decoder is closed, fed at once when it opens, for next network streams (default: %dKB, 0 = unbounded).\n", K_DEF_STREAM_GOP_CACHE_KB);
+    K_LOG_INFO("-ml, --maxLatency ms      queued frames waiting longer than this for the decoder are dropped up to the newest IDR, for next network streams (default: %dms, 0 = unbounded).\n", K_DEF_STREAM_MAX_LATENCY_MS);
+    K_LOG_INFO("-ffps, --fileFps num      frames per second next files are played at (default: 0 = from the SPS timing info, else one per screen refresh).\n");
     K_LOG_INFO("-s, --stream path         adds a network stream source (like '/http/relative/path/file.h.264').\n");
-    K_LOG_INFO("-f, --file path           adds a file stream source (like '/file/path/file.h.264').\n");
+    K_LOG_INFO("-f, --file path           adds a file stream source (like '/file/path/file.h.264'), H.265 if '--srcFmt hevc' or named '.h265', '.hevc' or '.265'; Annex-B, length-prefixed (AVCC) or MP4 (not fragmented).\n");
     K_LOG_INFO("\n");
     K_LOG_INFO("-v                        same as '--logLevel verbose'.");
     K_LOG_INFO("-llvl, --logLevel v       sets the maximun log level to output:");
@@ -1166,6 +2063,8 @@ void printHelp(void){
     K_LOG_INFO("--simDecoderTimeout num   (1/num) probability to trigger a simulated decoder timeout, for cleanup code test.\n");
     K_LOG_INFO("--framesSkip num          ammount of frames to skip than fed to the decoder.\n");
     K_LOG_INFO("--framesFeedMax num       ammount of frames to decode and then stop.\n");
+    K_LOG_INFO("--benchNalScan path       measures the NAL start-codes scanning throughput on a captured stream file and exits.\n");
+    K_LOG_INFO("--benchFramesQueue num    measures the frames and fed-states queues costs with a backlog of 'num' frames and exits.\n");
     K_LOG_INFO("\n");
 }
     
@@ -1173,6 +2072,8 @@ int main(int argc, char* argv[]){
     int r = -1; int helpPrinted = 0, errorFatal = 0;
     int secsRunAndExit = 0, secsSleepBeforeExit = 0;
     unsigned long framesSkip = 0, framesFeedMax = 0;
+    const char* benchNalScanPath = NULL;
+    int benchFramesQueueBacklog = 0;
     STPlayer* p = (STPlayer*)malloc(sizeof(STPlayer));
     //random initialization
     srand(time(NULL));
@@ -1184,9 +2085,23 @@ int main(int argc, char* argv[]){
         p->cfg.extraThreadsAmm          = K_DEF_THREADS_EXTRA_AMM;
         p->cfg.connTimeoutSecs          = K_DEF_CONN_TIMEOUT_SECS;
         p->cfg.connWaitReconnSecs       = K_DEF_CONN_RETRY_WAIT_SECS;
+        p->cfg.connWaitReconnMaxSecs    = K_DEF_CONN_RETRY_WAIT_MAX_SECS;
+        p->cfg.connPendingPerServer     = K_DEF_CONN_PENDING_PER_SERVER;
+        p->cfg.connPendingMax           = K_DEF_CONN_PENDING_MAX;
+        p->cfg.dnsCacheSecs             = K_DEF_DNS_CACHE_SECS;
+        p->cfg.netPoolIdleMax           = K_DEF_NET_POOL_IDLE_MAX;
+        p->cfg.netPoolIdleSecs          = K_DEF_NET_POOL_IDLE_SECS;
+        p->cfg.netReadBudgetKB          = K_DEF_NET_READ_BUDGET_KB;
+        p->cfg.netReadBudgetFrames      = K_DEF_NET_READ_BUDGET_FRAMES;
+        p->cfg.rtpJitterMs              = K_DEF_RTP_JITTER_MS;
+        p->cfg.netBuffAdapt             = K_DEF_NET_BUFF_ADAPT;
+        p->cfg.netTcpNoDelay            = K_DEF_NET_TCP_NODELAY;
+        p->cfg.netTcpQuickAck           = K_DEF_NET_TCP_QUICKACK;
+        p->cfg.netRcvLowatMs            = K_DEF_NET_RCVLOWAT_MS;
         p->cfg.decoderTimeoutSecs       = K_DEF_DECODER_TIMEOUT_SECS;
         p->cfg.decoderWaitRecopenSecs   = K_DEF_DECODER_RETRY_WAIT_SECS;
         p->cfg.decodersMax              = K_DEF_DECODERS_MAX_AMM;
+        p->cfg.decoderPool              = K_DEF_DECODER_POOL;
         p->cfg.decodersToPeekSecs       = K_DEF_DECODERS_PEEK_MAX_SECS;
         p->cfg.animSecsWaits            = K_DEF_ANIM_WAIT_SECS;
         p->cfg.animPreRenderSecs        = K_DEF_ANIM_PRE_RENDER_SECS;
@@ -1219,6 +2134,11 @@ int main(int argc, char* argv[]){
         const char* decoder = NULL;
         const char* server = NULL;
         int port = 0, keepAlive = 0;
+        ENStreamNetProto netProto = ENStreamNetProto_Http;
+        int srcPixFmt = V4L2_PIX_FMT_H264;
+        int maxLatencyMs = K_DEF_STREAM_MAX_LATENCY_MS;
+        int gopCacheKB = K_DEF_STREAM_GOP_CACHE_KB;
+        int fileFps = 0;
         ENFramebuffsGrpFbLocation fbLoc = ENFramebuffsGrpFbLocation_Free;
         int fbLocX = 0, fbLocY = 0;
         int i; for(i = 0; i < argc; i++){
@@ -1280,6 +2200,188 @@ int main(int argc, char* argv[]){
                     }
                     i++;
                 }
+            } else if(strcmp(arg, "-crm") == 0 || strcmp(arg, "--connWaitReconnectMax") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v <= 0){ //0 is not allowed
+                        K_LOG_INFO("Param '--connWaitReconnectMax' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.connWaitReconnMaxSecs = v;
+                        K_LOG_INFO("Param '--connWaitReconnectMax' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-cps") == 0 || strcmp(arg, "--connPendingPerServer") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0){
+                        K_LOG_INFO("Param '--connPendingPerServer' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.connPendingPerServer = v;
+                        K_LOG_INFO("Param '--connPendingPerServer' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-cpm") == 0 || strcmp(arg, "--connPendingMax") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0){
+                        K_LOG_INFO("Param '--connPendingMax' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.connPendingMax = v;
+                        K_LOG_INFO("Param '--connPendingMax' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-iou") == 0 || strcmp(arg, "--ioUring") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || (v != 0 && v != 1)){
+                        K_LOG_INFO("Param '--ioUring' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.ioUring = v;
+                        K_LOG_INFO("Param '--ioUring' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-nrb") == 0 || strcmp(arg, "--netReadBudgetKB") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0){
+                        K_LOG_INFO("Param '--netReadBudgetKB' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.netReadBudgetKB = v;
+                        K_LOG_INFO("Param '--netReadBudgetKB' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-nrf") == 0 || strcmp(arg, "--netReadBudgetFrames") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0){
+                        K_LOG_INFO("Param '--netReadBudgetFrames' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.netReadBudgetFrames = v;
+                        K_LOG_INFO("Param '--netReadBudgetFrames' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-nba") == 0 || strcmp(arg, "--netBuffAdapt") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || (v != 0 && v != 1)){
+                        K_LOG_INFO("Param '--netBuffAdapt' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.netBuffAdapt = v;
+                        K_LOG_INFO("Param '--netBuffAdapt' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-ntd") == 0 || strcmp(arg, "--netTcpNoDelay") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || (v != 0 && v != 1)){
+                        K_LOG_INFO("Param '--netTcpNoDelay' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.netTcpNoDelay = v;
+                        K_LOG_INFO("Param '--netTcpNoDelay' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-nqa") == 0 || strcmp(arg, "--netTcpQuickAck") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || (v != 0 && v != 1)){
+                        K_LOG_INFO("Param '--netTcpQuickAck' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.netTcpQuickAck = v;
+                        K_LOG_INFO("Param '--netTcpQuickAck' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-nlw") == 0 || strcmp(arg, "--netRcvLowatMs") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0){
+                        K_LOG_INFO("Param '--netRcvLowatMs' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.netRcvLowatMs = v;
+                        K_LOG_INFO("Param '--netRcvLowatMs' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-rjm") == 0 || strcmp(arg, "--rtpJitterMs") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0){
+                        K_LOG_INFO("Param '--rtpJitterMs' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.rtpJitterMs = v;
+                        K_LOG_INFO("Param '--rtpJitterMs' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-dns") == 0 || strcmp(arg, "--dnsCacheSecs") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0){
+                        K_LOG_INFO("Param '--dnsCacheSecs' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.dnsCacheSecs = v;
+                        K_LOG_INFO("Param '--dnsCacheSecs' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-npm") == 0 || strcmp(arg, "--netPoolIdleMax") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0){
+                        K_LOG_INFO("Param '--netPoolIdleMax' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.netPoolIdleMax = v;
+                        K_LOG_INFO("Param '--netPoolIdleMax' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-nps") == 0 || strcmp(arg, "--netPoolIdleSecs") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v <= 0){
+                        K_LOG_INFO("Param '--netPoolIdleSecs' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.netPoolIdleSecs = v;
+                        K_LOG_INFO("Param '--netPoolIdleSecs' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
             } else if(strcmp(arg, "-dto") == 0 || strcmp(arg, "--decTimeout") == 0){
                 if((i + 1) < argc){
                     const char* val = argv[i + 1];
@@ -1306,6 +2408,19 @@ int main(int argc, char* argv[]){
                     }
                     i++;
                 }
+            } else if(strcmp(arg, "-dp") == 0 || strcmp(arg, "--decPool") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || (v != 0 && v != 1)){
+                        K_LOG_INFO("Param '--decPool' value is not valid: '%s'\n", val);
+                    } else {
+                        p->cfg.decoderPool = v;
+                        K_LOG_INFO("Param '--decPool' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
             } else if(strcmp(arg, "-aw") == 0 || strcmp(arg, "--animWait") == 0){
                 if((i + 1) < argc){
                     const char* val = argv[i + 1];
@@ -1438,32 +2553,114 @@ int main(int argc, char* argv[]){
                     }
                     i++;
                 }
-            } else if(strcmp(arg, "-ka") == 0 || strcmp(arg, "--keepAlive") == 0){
+            } else if(strcmp(arg, "-np") == 0 || strcmp(arg, "--netProto") == 0){
                 if((i + 1) < argc){
                     const char* val = argv[i + 1];
-                    char* endPtr = NULL;
-                    const long int v = strtol(val, &endPtr, 0);
-                    if(*endPtr != '\0' || v != 0 || v != 1){
-                        K_LOG_INFO("Param '--keepAlive' value is not valid: '%s'\n", val);
+                    if(strcmp(val, "http") == 0){
+                        netProto = ENStreamNetProto_Http;
+                        K_LOG_INFO("Param '--netProto' value set: '%s'\n", val);
+                    } else if(strcmp(val, "rtsp") == 0){
+                        netProto = ENStreamNetProto_Rtsp;
+                        K_LOG_INFO("Param '--netProto' value set: '%s'\n", val);
+                    } else if(strcmp(val, "udp") == 0){
+                        netProto = ENStreamNetProto_RtpUdp;
+                        K_LOG_INFO("Param '--netProto' value set: '%s'\n", val);
+                    } else if(strcmp(val, "shm") == 0){
+                        netProto = ENStreamNetProto_Shm;
+                        K_LOG_INFO("Param '--netProto' value set: '%s'\n", val);
                     } else {
-                        keepAlive = v;
-                        K_LOG_INFO("Param '--keepAlive' value set: '%d'\n", v);
+                        K_LOG_INFO("Param '--netProto' value is not valid: '%s'\n", val);
                     }
                     i++;
                 }
-            } else if(strcmp(arg, "-s") == 0 || strcmp(arg, "--stream") == 0){
+            } else if(strcmp(arg, "-sf") == 0 || strcmp(arg, "--srcFmt") == 0){
                 if((i + 1) < argc){
                     const char* val = argv[i + 1];
-                    if(decoder == NULL){
-                        K_LOG_ERROR("param '--stream' missing previous param: '--decoder'.\n");
-                        errorFatal = 1;
-                    } else if(server == NULL){
+                    if(strcmp(val, "h264") == 0){
+                        srcPixFmt = V4L2_PIX_FMT_H264;
+                        K_LOG_INFO("Param '--srcFmt' value set: '%s'\n", val);
+                    } else if(strcmp(val, "hevc") == 0 || strcmp(val, "h265") == 0){
+                        srcPixFmt = V4L2_PIX_FMT_HEVC;
+                        K_LOG_INFO("Param '--srcFmt' value set: '%s'\n", val);
+                    } else if(strcmp(val, "mjpeg") == 0){
+                        srcPixFmt = V4L2_PIX_FMT_MJPEG;
+                        K_LOG_INFO("Param '--srcFmt' value set: '%s'\n", val);
+                    } else {
+                        K_LOG_INFO("Param '--srcFmt' value is not valid: '%s'\n", val);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-ka") == 0 || strcmp(arg, "--keepAlive") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || (v != 0 && v != 1)){
+                        K_LOG_INFO("Param '--keepAlive' value is not valid: '%s'\n", val);
+                    } else {
+                        keepAlive = v;
+                        K_LOG_INFO("Param '--keepAlive' value set: '%d'\n", v);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-ml") == 0 || strcmp(arg, "--maxLatency") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0){
+                        K_LOG_INFO("Param '--maxLatency' value is not valid: '%s'\n", val);
+                    } else {
+                        maxLatencyMs = (int)v;
+                        K_LOG_INFO("Param '--maxLatency' value set: '%d'\n", maxLatencyMs);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-gc") == 0 || strcmp(arg, "--gopCache") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0 || v > (1024 * 1024)){
+                        K_LOG_INFO("Param '--gopCache' value is not valid: '%s'\n", val);
+                    } else {
+                        gopCacheKB = (int)v;
+                        K_LOG_INFO("Param '--gopCache' value set: '%d'\n", gopCacheKB);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-ffps") == 0 || strcmp(arg, "--fileFps") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v < 0 || v > 1000){
+                        K_LOG_INFO("Param '--fileFps' value is not valid: '%s'\n", val);
+                    } else {
+                        fileFps = (int)v;
+                        K_LOG_INFO("Param '--fileFps' value set: '%d'\n", fileFps);
+                    }
+                    i++;
+                }
+            } else if(strcmp(arg, "-s") == 0 || strcmp(arg, "--stream") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    if(decoder == NULL){
+                        K_LOG_ERROR("param '--stream' missing previous param: '--decoder'.\n");
+                        errorFatal = 1;
+                    } else if(server == NULL){
                         K_LOG_ERROR("param '--stream' missing previous param: '--server'.\n");
                         errorFatal = 1;
-                    } else if(port <= 0){
+                    } else if(port <= 0 && netProto != ENStreamNetProto_Shm){
                         K_LOG_ERROR("param '--stream' missing previous param: '--port'.\n");
                         errorFatal = 1;
-                    } else if(0 != Player_streamAdd(p, decoder, server, port, keepAlive, val, p->cfg.connTimeoutSecs, p->cfg.decoderTimeoutSecs, framesSkip, framesFeedMax)){
+                    } else if(srcPixFmt == V4L2_PIX_FMT_MJPEG && netProto != ENStreamNetProto_Http){
+                        K_LOG_ERROR("param '--srcFmt mjpeg' requires '--netProto http' (multipart body).\n");
+                        errorFatal = 1;
+                    } else if(srcPixFmt == V4L2_PIX_FMT_HEVC && netProto == ENStreamNetProto_Shm){
+                        K_LOG_ERROR("param '--srcFmt hevc' is not supported with '--netProto shm' (records describe H.264 NALs).\n");
+                        errorFatal = 1;
+                    } else if(0 != Player_streamAdd(p, decoder, server, port, keepAlive, netProto, maxLatencyMs, gopCacheKB, fileFps, srcPixFmt, val, p->cfg.connTimeoutSecs, p->cfg.decoderTimeoutSecs, framesSkip, framesFeedMax)){
                         K_LOG_ERROR("main, could not add stream: '%s'.\n", val);
                         errorFatal = 1;
                     } else {
@@ -1474,10 +2671,12 @@ int main(int argc, char* argv[]){
             } else if(strcmp(arg, "-f") == 0 || strcmp(arg, "--file") == 0){
                 if((i + 1) < argc){
                     const char* val = argv[i + 1];
+                    const char* ext = strrchr(val, '.');
+                    const int isFileHevc = (ext != NULL && (strcasecmp(ext, ".h265") == 0 || strcasecmp(ext, ".hevc") == 0 || strcasecmp(ext, ".265") == 0) ? 1 : 0);
                     if(decoder == NULL){
                         K_LOG_ERROR("param '--file' missing previous param: '--decoder'.\n");
                         errorFatal = 1;
-                    } else if(0 != Player_streamAdd(p, decoder, NULL, 0, keepAlive, val, p->cfg.connTimeoutSecs, p->cfg.decoderTimeoutSecs, framesSkip, framesFeedMax)){
+                    } else if(0 != Player_streamAdd(p, decoder, NULL, 0, keepAlive, ENStreamNetProto_Http, maxLatencyMs, gopCacheKB, fileFps, (srcPixFmt == V4L2_PIX_FMT_HEVC || isFileHevc ? V4L2_PIX_FMT_HEVC : V4L2_PIX_FMT_H264), val, p->cfg.connTimeoutSecs, p->cfg.decoderTimeoutSecs, framesSkip, framesFeedMax)){
                         K_LOG_ERROR("main, could not add stream: '%s'.\n", val);
                         errorFatal = 1;
                     } else {
@@ -1605,6 +2804,25 @@ int main(int argc, char* argv[]){
                     }
                     i++;
                 }
+            } else if(strcmp(arg, "--benchNalScan") == 0){
+                if((i + 1) < argc){
+                    benchNalScanPath = argv[i + 1];
+                    K_LOG_INFO("Param '--benchNalScan' value set: '%s'\n", benchNalScanPath);
+                    i++;
+                }
+            } else if(strcmp(arg, "--benchFramesQueue") == 0){
+                if((i + 1) < argc){
+                    const char* val = argv[i + 1];
+                    char* endPtr = NULL;
+                    const long int v = strtol(val, &endPtr, 0);
+                    if(*endPtr != '\0' || v <= 0 || v > (1024 * 1024)){
+                        K_LOG_INFO("Param '--benchFramesQueue' value is not valid: '%s'\n", val);
+                    } else {
+                        benchFramesQueueBacklog = (int)v;
+                        K_LOG_INFO("Param '--benchFramesQueue' value set: '%d'\n", benchFramesQueueBacklog);
+                    }
+                    i++;
+                }
             } else if(strcmp(arg, "--framesFeedMax") == 0){
                 if((i + 1) < argc){
                     const char* val = argv[i + 1];
@@ -1622,7 +2840,13 @@ int main(int argc, char* argv[]){
         }
     }
     //execute
-    if(!errorFatal){
+    if(!errorFatal && benchNalScanPath != NULL){
+        //benchmark only
+        r = nalScanBenchmark(benchNalScanPath);
+    } else if(!errorFatal && benchFramesQueueBacklog > 0){
+        //benchmark only
+        r = framesQueueBenchmark(benchFramesQueueBacklog);
+    } else if(!errorFatal){
         if(p->streams.arrUse <= 0){
             K_LOG_INFO("Main, no streams loaded.\n");
             if(!helpPrinted){
@@ -1632,6 +2856,7 @@ int main(int argc, char* argv[]){
         } else {
             unsigned long secsRunnning = 0;
             unsigned int animMsPerFrame = (1000 / (p->cfg.screenRefreshPerSec <= 0 ? 1 : p->cfg.screenRefreshPerSec)), animMsAccum = 0;
+            unsigned int animMsToTick = animMsPerFrame; //nearest deadline requiring a tick
             struct timeval timePrev, timeCur;
             struct timeval animPrev, animCur;
             gettimeofday(&timePrev, NULL);
@@ -1647,6 +2872,12 @@ int main(int argc, char* argv[]){
                     r = -1;
                 }
             }
+            //io_uring (optional, fallbacks to poll)
+            if(r == 0 && p->cfg.ioUring){
+                if(0 != Player_uringStart(p, K_DEF_IO_URING_ENTRIES)){
+                    K_LOG_WARN("Main, io_uring not available, using poll and read/recv.\n");
+                }
+            }
             //cycle
             if(r == 0){
                 int countStreamsPermShuttedDown = 0;
@@ -1670,17 +2901,38 @@ int main(int argc, char* argv[]){
                         //reset
                         p->poll.autoremovesPend = 0;
                     }
+                    //timeout (nearest deadline: next tick or next stats second)
+                    int msTimeout = 0;
+                    {
+                        struct timeval now;
+                        gettimeofday(&now, NULL);
+                        {
+                            const long msToTick = (long)animMsToTick - (msBetweenTimevals(&animPrev, &now) + animMsAccum);
+                            const long msToSec = 1000 - msBetweenTimevals(&timePrev, &now);
+                            msTimeout = (int)(msToTick < msToSec ? msToTick : msToSec);
+                            if(msTimeout < 0) msTimeout = 0;
+                        }
+                    }
+                    //io_uring (submit all posted reads in one syscall)
+                    if(p->uring.isActive){
+                        if(0 != Player_uringSubmit(p)){
+                            K_LOG_ERROR("Main, Player_uringSubmit failed.\n");
+                        }
+                    }
                     //poll
                     if(p->poll.fdsUse <= 0){
                         //just sleep
-                        int mSecs = (animMsPerFrame / 4);
-                        usleep((useconds_t)(mSecs <= 0 ? 1 : mSecs) * 1000);
+                        if(msTimeout > 0){
+                            usleep((useconds_t)msTimeout * 1000);
+                        }
                     } else {
-                        const int msTimeout = 40;
                         const int rr = poll(p->poll.fdsNat, p->poll.fdsUse, msTimeout);
                         if(rr > 0){
-                            int i, fndCount = 0;
-                            for(i = 0; i < p->poll.fdsUse && fndCount < rr; i++){
+                            //round-robin first fd (fairness between streams when read budgets are consumed)
+                            const int fdsCount = p->poll.fdsUse, iFirst = (p->poll.iNextFirst++ % fdsCount);
+                            int i2, fndCount = 0;
+                            for(i2 = 0; i2 < fdsCount && fndCount < rr; i2++){
+                                const int i = (iFirst + i2) % fdsCount;
                                 const STPlayerPollFd* fdd = &p->poll.fds[i];
                                 const struct pollfd* fd = &p->poll.fdsNat[i];
                                 if(fd->revents != 0){
@@ -1691,12 +2943,16 @@ int main(int argc, char* argv[]){
                                             case ENPlayerPollFdType_Decoder: typeStr = "decoder"; break;
                                             case ENPlayerPollFdType_SrcFile: typeStr = "file-fd"; break;
                                             case ENPlayerPollFdType_SrcSocket: typeStr = "net-socket"; break;
+                                            case ENPlayerPollFdType_DnsEvent: typeStr = "dns-event"; break;
+                                            case ENPlayerPollFdType_NetPoolConn: typeStr = "net-pool-conn"; break;
+                                            case ENPlayerPollFdType_SrcConnAttempt: typeStr = "net-conn-attempt"; break;
+                                            case ENPlayerPollFdType_IoUring: typeStr = "io-uring"; break;
                                             default: typeStr = "unknow-type"; break;
                                         }
                                         K_LOG_VERBOSE("Main, %s poll: %s%s%s%s%s%s.\n", typeStr, (fd->revents & POLLOUT ? " POLLOUT" : ""), (fd->revents & POLLWRNORM ? " POLLWRNORM" : ""), (fd->revents & POLLIN ? " POLLIN" : ""), (fd->revents & POLLRDNORM ? " POLLRDNORM" : ""), (fd->revents & POLLERR ? " POLLERR" : ""), (fd->revents & POLLPRI ? " POLLPRI" : ""));
                                     }
-                                    //call
-                                    if(fdd->callback != NULL){
+                                    //call (not if removed by a previous callback, its obj could be released)
+                                    if(fdd->callback != NULL && !fdd->autoremove){
                                         (fdd->callback)(fdd->obj, p, fdd->type, fd->revents);
                                     }
                                     fndCount++;
@@ -1709,13 +2965,15 @@ int main(int argc, char* argv[]){
                         gettimeofday(&animCur, NULL);
                         long ms = msBetweenTimevals(&animPrev, &animCur);
                         const long msAccum = (ms + animMsAccum);
-                        if(ms > 0 && msAccum >= animMsPerFrame){
-                            if(0 != Player_tick(p, animMsPerFrame)){
+                        if(ms > 0 && msAccum >= animMsToTick){
+                            if(0 != Player_tick(p, animMsToTick)){
                                 K_LOG_ERROR("Main, anim-tick fail.\n");
                             }
-                            animMsAccum = (ms + animMsAccum) % animMsPerFrame;
-                            K_LOG_VERBOSE("Main, anim-tick (%dms passed, %dms tick, %dms remain).\n", msAccum, animMsPerFrame, animMsAccum);
+                            animMsAccum = (msAccum - animMsToTick) % animMsPerFrame;
+                            K_LOG_VERBOSE("Main, anim-tick (%dms passed, %dms tick, %dms remain).\n", msAccum, animMsToTick, animMsAccum);
                             animPrev = animCur;
+                            //next deadline
+                            animMsToTick = Player_getMsToNextTick(p, animMsPerFrame);
                         }
                     }
                     //time passed
@@ -1741,7 +2999,7 @@ int main(int argc, char* argv[]){
                                     if(s->file.fd > 0){
                                         filesTotal++;
                                     }
-                                    if(s->net.hostResolver != NULL || s->net.socket > 0){
+                                    if(s->net.isResolving || s->net.socket > 0 || s->net.he.use > 0){
                                         netsTotal++;
                                     }
                                 }
@@ -1749,27 +3007,27 @@ int main(int argc, char* argv[]){
                             pthread_mutex_lock(&p->stats.mutex);
                             {
                                 if(p->stats.curSec.draw.count <= 0){
-                                    K_LOG_INFO("Main, sec: %d streams, %d/%d decs (%d peek), file(%d)-net(%d), frame[%d qued, %d IDR, %d ign, %u fed dec(%u, %ums/%ums/%ums, %d skipped)], drawn(%u).\n", p->streams.arrUse
+                                    K_LOG_INFO("Main, sec: %d streams, %d/%d decs (%d peek), file(%d)-net(%d), frame[%d qued, %d IDR, %d ign, %llu late (%lluKB), %u fed (%llu in-place), dec(%u, %ums/%ums/%ums, %d skipped)], drawn(%u).\n", p->streams.arrUse
                                                , decsCountTotal, toDrawCountTotal, peekCountTotal
                                                , filesTotal, netsTotal
-                                               , p->stats.curSec.src.frames.queued, p->stats.curSec.src.frames.queuedIDR, p->stats.curSec.src.frames.ignored
-                                               , p->stats.curSec.dec.fed.count, p->stats.curSec.dec.got.count, p->stats.curSec.dec.got.msMin, (p->stats.curSec.dec.got.count <= 0 ? 0 : p->stats.curSec.dec.got.msSum / p->stats.curSec.dec.got.count), p->stats.curSec.dec.got.msMax, p->stats.curSec.dec.got.skipped
+                                               , p->stats.curSec.src.frames.queued, p->stats.curSec.src.frames.queuedIDR, p->stats.curSec.src.frames.ignored, p->stats.curSec.src.frames.dropped, (p->stats.curSec.src.frames.droppedBytes / 1024)
+                                               , p->stats.curSec.dec.fed.count, p->stats.curSec.dec.fed.inPlace, p->stats.curSec.dec.got.count, p->stats.curSec.dec.got.msMin, (p->stats.curSec.dec.got.count <= 0 ? 0 : p->stats.curSec.dec.got.msSum / p->stats.curSec.dec.got.count), p->stats.curSec.dec.got.msMax, p->stats.curSec.dec.got.skipped
                                                , p->stats.curSec.draw.count
                                                );
                                 } else if(p->stats.curSec.draw.msMin <= 0){
-                                    K_LOG_INFO("Main, sec: %d streams, %d/%d decs (%d peek), file(%d)-net(%d), frame[%d qued, %d IDR, %d ign, %u fed, dec(%u, %ums/%ums/%ums, %d skipped)], drawn(%u, %u/%u/%u ms).\n", p->streams.arrUse
+                                    K_LOG_INFO("Main, sec: %d streams, %d/%d decs (%d peek), file(%d)-net(%d), frame[%d qued, %d IDR, %d ign, %llu late (%lluKB), %u fed (%llu in-place), dec(%u, %ums/%ums/%ums, %d skipped)], drawn(%u, %u/%u/%u ms).\n", p->streams.arrUse
                                                , decsCountTotal, toDrawCountTotal, peekCountTotal
                                                , filesTotal, netsTotal
-                                               , p->stats.curSec.src.frames.queued, p->stats.curSec.src.frames.queuedIDR, p->stats.curSec.src.frames.ignored
-                                               , p->stats.curSec.dec.fed.count, p->stats.curSec.dec.got.count, p->stats.curSec.dec.got.msMin, (p->stats.curSec.dec.got.count <= 0 ? 0 : p->stats.curSec.dec.got.msSum / p->stats.curSec.dec.got.count), p->stats.curSec.dec.got.msMax, p->stats.curSec.dec.got.skipped
+                                               , p->stats.curSec.src.frames.queued, p->stats.curSec.src.frames.queuedIDR, p->stats.curSec.src.frames.ignored, p->stats.curSec.src.frames.dropped, (p->stats.curSec.src.frames.droppedBytes / 1024)
+                                               , p->stats.curSec.dec.fed.count, p->stats.curSec.dec.fed.inPlace, p->stats.curSec.dec.got.count, p->stats.curSec.dec.got.msMin, (p->stats.curSec.dec.got.count <= 0 ? 0 : p->stats.curSec.dec.got.msSum / p->stats.curSec.dec.got.count), p->stats.curSec.dec.got.msMax, p->stats.curSec.dec.got.skipped
                                                , p->stats.curSec.draw.count, p->stats.curSec.draw.msMin, p->stats.curSec.draw.msSum / p->stats.curSec.draw.count, p->stats.curSec.draw.msMax
                                                );
                                 } else {
-                                    K_LOG_INFO("Main, sec: %d streams, %d/%d decs (%d peek), file(%d)-net(%d), frame[%d qued, %d IDR, %d ign, %u fed, dec(%u, %ums/%ums/%ums, %d skipped)], drawn(%u, %u/%u/%u ms, %u/%u/%u fps max).\n", p->streams.arrUse
+                                    K_LOG_INFO("Main, sec: %d streams, %d/%d decs (%d peek), file(%d)-net(%d), frame[%d qued, %d IDR, %d ign, %llu late (%lluKB), %u fed (%llu in-place), dec(%u, %ums/%ums/%ums, %d skipped)], drawn(%u, %u/%u/%u ms, %u/%u/%u fps max).\n", p->streams.arrUse
                                                , decsCountTotal, toDrawCountTotal, peekCountTotal
                                                , filesTotal, netsTotal
-                                               , p->stats.curSec.src.frames.queued, p->stats.curSec.src.frames.queuedIDR, p->stats.curSec.src.frames.ignored
-                                               , p->stats.curSec.dec.fed.count, p->stats.curSec.dec.got.count, p->stats.curSec.dec.got.msMin, (p->stats.curSec.dec.got.count <= 0 ? 0 : p->stats.curSec.dec.got.msSum / p->stats.curSec.dec.got.count), p->stats.curSec.dec.got.msMax, p->stats.curSec.dec.got.skipped
+                                               , p->stats.curSec.src.frames.queued, p->stats.curSec.src.frames.queuedIDR, p->stats.curSec.src.frames.ignored, p->stats.curSec.src.frames.dropped, (p->stats.curSec.src.frames.droppedBytes / 1024)
+                                               , p->stats.curSec.dec.fed.count, p->stats.curSec.dec.fed.inPlace, p->stats.curSec.dec.got.count, p->stats.curSec.dec.got.msMin, (p->stats.curSec.dec.got.count <= 0 ? 0 : p->stats.curSec.dec.got.msSum / p->stats.curSec.dec.got.count), p->stats.curSec.dec.got.msMax, p->stats.curSec.dec.got.skipped
                                                , p->stats.curSec.draw.count, p->stats.curSec.draw.msMin, p->stats.curSec.draw.msSum / p->stats.curSec.draw.count, p->stats.curSec.draw.msMax, 1000ULL / p->stats.curSec.draw.msMax, 1000ULL / (p->stats.curSec.draw.msSum / p->stats.curSec.draw.count), 1000ULL / p->stats.curSec.draw.msMin
                                                );
                                 }
@@ -1777,6 +3035,89 @@ int main(int argc, char* argv[]){
                                 memset(&p->stats.curSec, 0, sizeof(p->stats.curSec));
                             }
                             pthread_mutex_unlock(&p->stats.mutex);
+                            //netPools (only if activity)
+                            {
+                                int i; for(i = 0; i < p->netPools.use; i++){
+                                    STNetPool* pool = p->netPools.arr[i];
+                                    if(pool->stats.curSec.connsNew > 0 || pool->stats.curSec.connsReused > 0 || pool->stats.curSec.connsWarmed > 0 || pool->stats.curSec.connsWasted > 0 || pool->stats.curSec.msToConnectCount > 0 || pool->stats.curSec.msToFirstUnitCount > 0){
+                                        K_LOG_INFO("Main, sec: net-pool '%s:%d', %d warm, conns(%lu new, %lu reused, %lu warmed, %lu wasted), %lums avg to connect (%lu), %lums avg to first-unit (%lu).\n", pool->server, pool->port, pool->conns.use
+                                                   , pool->stats.curSec.connsNew, pool->stats.curSec.connsReused, pool->stats.curSec.connsWarmed, pool->stats.curSec.connsWasted
+                                                   , (pool->stats.curSec.msToConnectCount <= 0 ? 0 : pool->stats.curSec.msToConnectSum / pool->stats.curSec.msToConnectCount), pool->stats.curSec.msToConnectCount
+                                                   , (pool->stats.curSec.msToFirstUnitCount <= 0 ? 0 : pool->stats.curSec.msToFirstUnitSum / pool->stats.curSec.msToFirstUnitCount), pool->stats.curSec.msToFirstUnitCount
+                                                   );
+                                    }
+                                    //reset
+                                    memset(&pool->stats.curSec, 0, sizeof(pool->stats.curSec));
+                                }
+                            }
+                            //decPool (only if activity)
+                            {
+                                if(p->decPool.stats.curSec.hits > 0 || p->decPool.stats.curSec.misses > 0 || p->decPool.stats.curSec.parked > 0 || p->decPool.stats.curSec.evicted > 0){
+                                    K_LOG_INFO("Main, sec: dec-pool, %d parked, opens(%lu hits, %lu misses, %lu reallocs), decs(%lu parked, %lu closed), %luus avg (%luus max) to reassign, %luus avg to open.\n", p->decPool.use
+                                               , p->decPool.stats.curSec.hits, p->decPool.stats.curSec.misses, p->decPool.stats.curSec.reallocs
+                                               , p->decPool.stats.curSec.parked, p->decPool.stats.curSec.evicted
+                                               , (p->decPool.stats.curSec.hits <= 0 ? 0 : p->decPool.stats.curSec.usToReassignSum / p->decPool.stats.curSec.hits), p->decPool.stats.curSec.usToReassignMax
+                                               , (p->decPool.stats.curSec.misses <= 0 ? 0 : p->decPool.stats.curSec.usToOpenSum / p->decPool.stats.curSec.misses)
+                                               );
+                                }
+                                //reset
+                                memset(&p->decPool.stats.curSec, 0, sizeof(p->decPool.stats.curSec));
+                            }
+                            //frames' payload buffers (only if activity)
+                            {
+                                STBuffSlabs* slabs = &p->slabs;
+                                if(slabs->stats.curSec.allocs > 0 || slabs->stats.curSec.copyBytesExact > 0){
+                                    K_LOG_INFO("Main, sec: frame-buffs, %llu KBs held, %llu allocs (%llu mallocs), %llu KBs copied growing (%llu KBs saved).\n", (slabs->bytesHeld / 1024)
+                                               , slabs->stats.curSec.allocs, slabs->stats.curSec.mallocs
+                                               , (slabs->stats.curSec.copyBytes / 1024), (slabs->stats.curSec.copyBytesExact > slabs->stats.curSec.copyBytes ? (slabs->stats.curSec.copyBytesExact - slabs->stats.curSec.copyBytes) / 1024 : 0)
+                                               );
+                                }
+                                //reset
+                                memset(&slabs->stats.curSec, 0, sizeof(slabs->stats.curSec));
+                                //trim
+                                if(++slabs->secsSinceTrim >= K_BUFF_SLAB_TRIM_SECS){
+                                    BuffSlabs_trim(slabs);
+                                }
+                            }
+                            //rtp udp streams (only if activity)
+                            {
+                                int i; for(i = 0; i < p->streams.arrUse; i++){
+                                    STStreamContext* s = p->streams.arr[i];
+                                    if(s->net.rtp.stats.curSec.pkts > 0 || s->net.rtp.stats.curSec.lost > 0){
+                                        K_LOG_INFO("Main, sec: rtp '%s:%d%s', %lu pkts (%lu batches), %lu reordered, %lu late, %lu lost, %d waiting.\n", s->cfg.server, s->cfg.port, s->cfg.path
+                                                   , s->net.rtp.stats.curSec.pkts, s->net.rtp.stats.curSec.batches, s->net.rtp.stats.curSec.reordered, s->net.rtp.stats.curSec.late, s->net.rtp.stats.curSec.lost, s->net.rtp.jitter.use
+                                                   );
+                                    }
+                                    //reset
+                                    memset(&s->net.rtp.stats.curSec, 0, sizeof(s->net.rtp.stats.curSec));
+                                }
+                            }
+                            //net tuning (only if sizes changed)
+                            {
+                                int i; for(i = 0; i < p->streams.arrUse; i++){
+                                    STStreamContext* s = p->streams.arr[i];
+                                    if(s->net.tune.stats.curSec.resizes > 0){
+                                        K_LOG_INFO("Main, sec: net-tune '%s:%d%s', %lu KB/s, %lu recvs, buff %d KBs, rcvbuf %d KBs, rcvlowat %d.\n", s->cfg.server, s->cfg.port, s->cfg.path
+                                                   , (s->net.tune.bytesPerSec / 1024), s->net.tune.stats.curSec.recvs, (s->buff.buffSz / 1024), (s->net.tune.rcvBufSz / 1024), s->net.tune.rcvLowat
+                                                   );
+                                    }
+                                    //reset
+                                    memset(&s->net.tune.stats.curSec, 0, sizeof(s->net.tune.stats.curSec));
+                                }
+                            }
+                            //reconnecting streams (only if backing off or delayed)
+                            {
+                                int i; for(i = 0; i < p->streams.arrUse; i++){
+                                    STStreamContext* s = p->streams.arr[i];
+                                    if((s->net.reconn.attempts > 1 && s->net.socket <= 0 && !s->net.isResolving && s->net.he.use <= 0) || s->net.reconn.stats.curSec.deferred > 0 || s->net.reconn.stats.curSec.immediate > 0){
+                                        K_LOG_INFO("Main, sec: reconn '%s:%d%s', %d attempts, next in %lums (of %lums), %lu deferred, %lu immediate.\n", s->cfg.server, s->cfg.port, s->cfg.path
+                                                   , s->net.reconn.attempts, s->net.msToReconnect, s->net.reconn.msLastWait, s->net.reconn.stats.curSec.deferred, s->net.reconn.stats.curSec.immediate
+                                                   );
+                                    }
+                                    //reset
+                                    memset(&s->net.reconn.stats.curSec, 0, sizeof(s->net.reconn.stats.curSec));
+                                }
+                            }
                         }
                         timePrev = timeCur;
                         secsRunnning++;
@@ -1860,6 +3201,20 @@ int main(int argc, char* argv[]){
 
 void Player_init(STPlayer* obj){
     memset(obj, 0, sizeof(*obj));
+    //uring
+    {
+#       ifdef K_USE_IO_URING
+        IoUring_init(&obj->uring.ring);
+#       endif
+    }
+    //dns
+    {
+        obj->dns.evtFd = -1;
+    }
+    //slabs
+    {
+        BuffSlabs_init(&obj->slabs);
+    }
     //
     //stats
     {
@@ -1935,6 +3290,26 @@ void Player_release(STPlayer* obj){
         obj->fbs.arrUse = 0;
         obj->fbs.arrSz = 0;
     }
+    //uring (before streams, posted buffers are owned by them)
+    {
+        if(0 != Player_uringCancel_(obj, ENPlayerPollFdType_Count, NULL, -1, 1)){
+            K_LOG_ERROR("Player, release, uring cancel failed.\n");
+        }
+        if(obj->uring.arr != NULL){
+            int i; for(i = 0; i < obj->uring.use; i++){
+                free(obj->uring.arr[i]);
+                obj->uring.arr[i] = NULL;
+            }
+            free(obj->uring.arr);
+            obj->uring.arr = NULL;
+        }
+        obj->uring.use = 0;
+        obj->uring.sz = 0;
+#       ifdef K_USE_IO_URING
+        IoUring_release(&obj->uring.ring);
+#       endif
+        obj->uring.isActive = 0;
+    }
     //streams
     {
         if(obj->streams.arr != NULL){
@@ -1949,6 +3324,56 @@ void Player_release(STPlayer* obj){
         obj->streams.arrUse = 0;
         obj->streams.arrSz = 0;
     }
+    //dns
+    {
+        if(obj->dns.arr != NULL){
+            int i; for(i = 0; i < obj->dns.use; i++){
+                DnsRecord_release(obj->dns.arr[i]);
+                free(obj->dns.arr[i]);
+                obj->dns.arr[i] = NULL;
+            }
+            free(obj->dns.arr);
+            obj->dns.arr = NULL;
+        }
+        obj->dns.use = 0;
+        obj->dns.sz = 0;
+        if(obj->dns.evtFd >= 0){
+            close(obj->dns.evtFd);
+            obj->dns.evtFd = -1;
+        }
+    }
+    //netPools
+    {
+        if(obj->netPools.arr != NULL){
+            int i; for(i = 0; i < obj->netPools.use; i++){
+                NetPool_release(obj->netPools.arr[i], obj);
+                free(obj->netPools.arr[i]);
+                obj->netPools.arr[i] = NULL;
+            }
+            free(obj->netPools.arr);
+            obj->netPools.arr = NULL;
+        }
+        obj->netPools.use = 0;
+        obj->netPools.sz = 0;
+    }
+    //decPool
+    {
+        if(obj->decPool.arr != NULL){
+            int i; for(i = 0; i < obj->decPool.use; i++){
+                DecoderParked_release(obj->decPool.arr[i]);
+                free(obj->decPool.arr[i]);
+                obj->decPool.arr[i] = NULL;
+            }
+            free(obj->decPool.arr);
+            obj->decPool.arr = NULL;
+        }
+        obj->decPool.use = 0;
+        obj->decPool.sz = 0;
+    }
+    //slabs (after streams, frames return their buffers to it)
+    {
+        BuffSlabs_release(&obj->slabs);
+    }
     //poll
     {
         if(obj->poll.fds != NULL){
@@ -2103,7 +3528,7 @@ int Player_pollAdd(STPlayer* obj, const ENPlayerPollFdType type, PlayerPollCallb
     int i; for(i = 0; i < obj->poll.fdsUse; i++){
         STPlayerPollFd* fdsN = &obj->poll.fds[i];
         struct pollfd* fdsNatN = &obj->poll.fdsNat[i];
-        if(fdsN->type == type && fdsN->obj == objPtr && fdsNatN->fd == fd){
+        if(fdsN->type == type && fdsN->obj == objPtr && fdsNatN->fd == fd && !fdsN->autoremove){ //ignore orphans (fd and obj could be reused before the autoremove)
             fnd = 1;
             break;
         }
@@ -2164,7 +3589,7 @@ int Player_pollUpdate(STPlayer* obj, const ENPlayerPollFdType type, const void*
     int i; for(i = 0; i < obj->poll.fdsUse; i++){
         STPlayerPollFd* fdsN = &obj->poll.fds[i];
         struct pollfd* fdsNatN = &obj->poll.fdsNat[i];
-        if(fdsN->type == type && fdsN->obj == objPtr && fdsNatN->fd == fd){
+        if(fdsN->type == type && fdsN->obj == objPtr && fdsNatN->fd == fd && !fdsN->autoremove){
             if(dstEventsBefore != NULL){
                 *dstEventsBefore = fdsN->events;
             }
@@ -2184,7 +3609,7 @@ int Player_pollAutoRemove(STPlayer* obj, const ENPlayerPollFdType type, const vo
     int i; for(i = 0; i < obj->poll.fdsUse; i++){
         STPlayerPollFd* fdsN = &obj->poll.fds[i];
         struct pollfd* fdsNatN = &obj->poll.fdsNat[i];
-        if(fdsN->type == type && fdsN->obj == objPtr && fdsNatN->fd == fd){
+        if(fdsN->type == type && fdsN->obj == objPtr && fdsNatN->fd == fd && !fdsN->autoremove){
             fdsNatN->events = 0;
             fdsN->autoremove = 1;
             obj->poll.autoremovesPend++;
@@ -2192,6 +3617,12 @@ int Player_pollAutoRemove(STPlayer* obj, const ENPlayerPollFdType type, const vo
             break;
         }
     }
+    //cancel posted reads (the fd is about to be closed)
+    if(obj->uring.use > 0){
+        if(0 != Player_uringCancel_(obj, type, objPtr, fd, 0)){
+            K_LOG_ERROR("Player, pollAutoRemove, uring cancel failed.\n");
+        }
+    }
     return r;
 }
 
@@ -2216,3123 +3647,6072 @@ int Player_pollAutoRemove(STPlayer* obj, const ENPlayerPollFdType type, const vo
     return r;
 }*/
 
-//fbs
-
-int Player_fbAdd(STPlayer* obj, const char* device, const ENFramebuffsGrpFbLocation location, const int locX, const int locY, const int animSecsWaits){
-    int r = -1;
-    //resize arr
-    while(obj->fbs.arrUse >= obj->fbs.arrSz){
-        STFramebuff** arrN = NULL;
-        //
-        arrN = malloc(sizeof(STFramebuff*) * (obj->fbs.arrSz + 1));
-        if(arrN == NULL){
-            if(arrN != NULL) free(arrN); arrN = NULL;
-            break;
-        } else {
-            obj->fbs.arrSz++;
-            if(obj->fbs.arr != NULL){
-                if(obj->fbs.arrUse > 0){
-                    memcpy(arrN, obj->fbs.arr, sizeof(STFramebuff*) * obj->fbs.arrUse);
+//uring (optional src-ingest backend)
+
+void Player_uringReap_(STPlayer* obj){
+#   ifdef K_USE_IO_URING
+    struct io_uring_cqe* cqe = NULL;
+    while((cqe = IoUring_peekCqe(&obj->uring.ring)) != NULL){
+        STPlayerUringOp* op = (STPlayerUringOp*)(uintptr_t)cqe->user_data;
+        const int res = cqe->res;
+        IoUring_cqeSeen(&obj->uring.ring);
+        if(op != NULL){ //NULL = cancel-request completion
+            //remove record
+            int i; for(i = 0; i < obj->uring.use; i++){
+                if(obj->uring.arr[i] == op){
+                    obj->uring.use--;
+                    for(;i < obj->uring.use; i++){
+                        obj->uring.arr[i] = obj->uring.arr[i + 1];
+                    }
+                    break;
                 }
-                free(obj->fbs.arr);
             }
-            obj->fbs.arr = arrN;
+            //call
+            if(!op->isCanceled && op->callback != NULL){
+                (op->callback)(op->obj, obj, op->type, res);
+            }
+            free(op);
+            op = NULL;
         }
     }
-    //add record
-    if((obj->fbs.arrUse + 1) <= obj->fbs.arrSz){
-        STFramebuff* fbN = malloc(sizeof(STFramebuff));
-        Framebuff_init(fbN);
+#   endif
+}
+
+void Player_uringPollCallback_(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, int revents){
+    Player_uringReap_((STPlayer*)userParam);
+}
+
+int Player_uringStart(STPlayer* obj, const unsigned entries){
+    int r = -1;
+#   ifdef K_USE_IO_URING
+    if(obj->uring.isActive){
         r = 0;
-        if(0 != Framebuff_open(fbN, device)){
-            K_LOG_ERROR("Player, fbAdd failed: '%s'.\n", device);
-            r = -1;
+    } else if(0 != IoUring_setup(&obj->uring.ring, entries)){
+        K_LOG_ERROR("Player, uring, setup failed.\n");
+    } else if(!(obj->uring.ring.features & IORING_FEAT_RW_CUR_POS)){
+        //required for reading files and pipes at their current position
+        K_LOG_ERROR("Player, uring, IORING_FEAT_RW_CUR_POS not supported (kernel 5.6+ required).\n");
+        IoUring_release(&obj->uring.ring);
+    } else if(0 != Player_pollAdd(obj, ENPlayerPollFdType_IoUring, Player_uringPollCallback_, obj, obj->uring.ring.fd, POLLIN)){
+        K_LOG_ERROR("Player, uring, poll-add failed.\n");
+        IoUring_release(&obj->uring.ring);
+    } else {
+        K_LOG_INFO("Player, uring, src-ingest backend active (%u entries).\n", obj->uring.ring.sq.entries);
+        obj->uring.isActive = 1;
+        r = 0;
+    }
+#   else
+    K_LOG_ERROR("Player, uring, not compiled (K_USE_IO_URING not defined).\n");
+#   endif
+    return r;
+}
+
+int Player_uringRead(STPlayer* obj, const ENPlayerPollFdType type, PlayerUringCallback callback, void* objPtr, const int fd, void* buff, const int buffSz, const int isRecv){ //0 = posted
+    int r = -1;
+#   ifdef K_USE_IO_URING
+    if(obj->uring.isActive && buff != NULL && buffSz > 0){
+        struct io_uring_sqe* sqe = IoUring_getSqe(&obj->uring.ring);
+        if(sqe == NULL){
+            //queue full, flush and retry
+            if(IoUring_submit(&obj->uring.ring, 0) > 0){
+                sqe = IoUring_getSqe(&obj->uring.ring);
+            }
+        }
+        if(sqe == NULL){
+            K_LOG_ERROR("Player, uring, submission-queue is full.\n");
         } else {
-            K_LOG_INFO("Player_fbAdd device added to poll: '%s'.\n", device);
-            //consume
-            obj->fbs.arr[obj->fbs.arrUse] = fbN;
-            obj->fbs.arrUse++;
-            //Add to group (y pixFmt)
-            {
-                STFramebuffsGrp* grpFnd = NULL;
-                //search a match
-                if(obj->fbs.grps.arr != NULL){
-                    int i; for(i = 0; i < obj->fbs.grps.use; i++){
-                        STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
-                        if(!grp->isClosed && grp->pixFmt == fbN->pixFmt){
-                            grpFnd = grp;
-                            break;
-                        }
-                    }
-                }
-                //allocate (if not found)
-                if(grpFnd == NULL){
-                    //resize
-                    while(obj->fbs.grps.use >= obj->fbs.grps.sz){
-                        const int szN = obj->fbs.grps.sz + 8;
-                        STFramebuffsGrp* arrN = (STFramebuffsGrp*)malloc(sizeof(obj->fbs.grps.arr[0]) * szN);
-                        if(arrN == NULL){
-                            break;
-                        } else {
-                            if(obj->fbs.grps.arr != NULL){
-                                if(obj->fbs.grps.use > 0){
-                                    memcpy(arrN, obj->fbs.grps.arr, sizeof(obj->fbs.grps.arr[0]) * obj->fbs.grps.use);
-                                }
-                                free(obj->fbs.grps.arr);
-                            }
-                            obj->fbs.grps.arr = arrN;
-                            obj->fbs.grps.sz = szN;
+            //resize array
+            while(obj->uring.use >= obj->uring.sz){
+                const int szN = (obj->uring.use + 16);
+                STPlayerUringOp** arrN = malloc(sizeof(STPlayerUringOp*) * szN);
+                if(arrN == NULL){
+                    break;
+                } else {
+                    if(obj->uring.arr != NULL){
+                        if(obj->uring.use > 0){
+                            memcpy(arrN, obj->uring.arr, sizeof(obj->uring.arr[0]) * obj->uring.use);
                         }
+                        free(obj->uring.arr);
                     }
-                    //add
-                    if(obj->fbs.grps.use < obj->fbs.grps.sz){
-                        grpFnd = &obj->fbs.grps.arr[obj->fbs.grps.use++];
-                        FramebuffsGrp_init(grpFnd);
-                        grpFnd->pixFmt = fbN->pixFmt;
-                        grpFnd->cfg.animSecsWaits = animSecsWaits;
-                    }
-                }
-                //add
-                if(grpFnd == NULL){
-                    K_LOG_ERROR("Player, fbAdd failed, could not create fbsGrp: '%s'.\n", device);
-                    r = -1;
-                } else if(0 != FramebuffsGrp_addFb(grpFnd, fbN, location, locX, locY)){ //ToDo: implement 'ENFramebuffsGrpFbLocation_'
-                    K_LOG_ERROR("Player, fbAdd failed, could not add to fbsGrp: '%s'.\n", device);
-                    r = -1;
-                } else {
-                    K_LOG_INFO("Player, fbAdd opened and to fbsGrp: '%s'.\n", device);
+                    obj->uring.arr = arrN;
+                    obj->uring.sz = szN;
                 }
             }
-            //reorganize
-            if(0 != Player_organize(obj)){
-                K_LOG_ERROR("Player_organize failed after fb creation.\n");
+            //add
+            if(obj->uring.use < obj->uring.sz){
+                STPlayerUringOp* op = (STPlayerUringOp*)malloc(sizeof(STPlayerUringOp));
+                memset(op, 0, sizeof(*op));
+                op->type        = type;
+                op->obj         = objPtr;
+                op->fd          = fd;
+                op->callback    = callback;
+                obj->uring.arr[obj->uring.use++] = op;
+                //sqe
+                sqe->opcode     = (isRecv ? IORING_OP_RECV : IORING_OP_READ);
+                sqe->fd         = fd;
+                sqe->addr       = (unsigned long long)(uintptr_t)buff;
+                sqe->len        = (unsigned)buffSz;
+                sqe->off        = (isRecv ? 0 : (unsigned long long)-1); //-1 = current file position
+                sqe->user_data  = (unsigned long long)(uintptr_t)op;
+                r = 0;
+            } else {
+                //neutralize the reserved sqe
+                sqe->opcode     = IORING_OP_NOP;
+                sqe->user_data  = 0;
             }
-            //consume
-            fbN = NULL;
-        }
-        //release (if not consumed)
-        if(fbN != NULL){
-            Framebuff_release(fbN);
-            free(fbN);
-            fbN = NULL;
         }
     }
-    //
+#   endif
     return r;
 }
 
-int Player_fbRemove(STPlayer* obj, STFramebuff* fb){
-    int r = -1;
-    //search
-    int i; for(i = 0; i < obj->fbs.arrUse; i++){
-        if(fb == obj->fbs.arr[i]){
-            //remove
-            obj->fbs.arrUse--;
-            for(;i < obj->fbs.arrUse; i++){
-                obj->fbs.arr[i] = obj->fbs.arr[i + 1];
-            }
-            Framebuff_release(fb);
-            free(fb);
-            r = 0;
-            //reorganize
-            if(0 != Player_organize(obj)){
-                K_LOG_ERROR("Player_organize failed after fb removal.\n");
-            }
-            break;
+int Player_uringIsPending(STPlayer* obj, const ENPlayerPollFdType type, const void* objPtr){
+    int i; for(i = 0; i < obj->uring.use; i++){
+        const STPlayerUringOp* op = obj->uring.arr[i];
+        if(op->type == type && op->obj == objPtr){
+            return 1;
         }
     }
-    return r;
+    return 0;
 }
 
-int Player_fbsCloseCurrentGrps(STPlayer* obj){
-    int i; for(i = 0; i < obj->fbs.grps.use; i++){
-        STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
-        grp->isClosed = 1;
+int Player_uringSubmit(STPlayer* obj){ //submits all posted sqes (one syscall), called before poll
+    int r = 0;
+#   ifdef K_USE_IO_URING
+    if(obj->uring.isActive && obj->uring.ring.sq.toSubmit > 0){
+        if(IoUring_submit(&obj->uring.ring, 0) < 0){
+            r = -1;
+        }
     }
-    return 0;
+#   endif
+    return r;
 }
 
-//streams
-
-int Player_streamAdd(STPlayer* obj, const char* device, const char* server, const unsigned int port, const int keepAlive, const char* resPath, const int connTimeoutSecs, const int decoderTimeoutSecs, const unsigned long framesSkip, const unsigned long framesFeedMax){
-    int r = -1;
-    if(resPath == NULL || resPath[0] == '\0'){
-        K_LOG_ERROR("Player_streamAdd 'resPath' is required.\n");
-    } else {
-        //resize arr
-        while(obj->streams.arrUse >= obj->streams.arrSz){
-            STStreamContext** arrN = NULL;
-            //
-            arrN = malloc(sizeof(STStreamContext*) * (obj->streams.arrSz + 1));
-            if(arrN == NULL){
-                if(arrN != NULL) free(arrN); arrN = NULL;
-                break;
-            } else {
-                obj->streams.arrSz++;
-                if(obj->streams.arr != NULL){
-                    if(obj->streams.arrUse > 0){
-                        memcpy(arrN, obj->streams.arr, sizeof(STStreamContext*) * obj->streams.arrUse);
+int Player_uringCancel_(STPlayer* obj, const ENPlayerPollFdType type, const void* objPtr, const int fd, const int waitCompletions){ //'type = Count', 'objPtr = NULL' or 'fd < 0' matches any
+    int r = 0;
+#   ifdef K_USE_IO_URING
+    if(obj->uring.isActive){
+        int i, pendCount = 0;
+        for(i = 0; i < obj->uring.use; i++){
+            STPlayerUringOp* op = obj->uring.arr[i];
+            if((type == ENPlayerPollFdType_Count || op->type == type) && (objPtr == NULL || op->obj == objPtr) && (fd < 0 || op->fd == fd)){
+                if(!op->isCanceled){
+                    struct io_uring_sqe* sqe = IoUring_getSqe(&obj->uring.ring);
+                    if(sqe == NULL && IoUring_submit(&obj->uring.ring, 0) > 0){
+                        sqe = IoUring_getSqe(&obj->uring.ring);
+                    }
+                    if(sqe == NULL){
+                        K_LOG_ERROR("Player, uring, cancel failed, submission-queue is full.\n");
+                        r = -1;
+                    } else {
+                        sqe->opcode     = IORING_OP_ASYNC_CANCEL;
+                        sqe->addr       = (unsigned long long)(uintptr_t)op;
+                        sqe->user_data  = 0;
                     }
-                    free(obj->streams.arr);
+                    op->isCanceled = 1;
                 }
-                obj->streams.arr = arrN;
+                pendCount++;
             }
         }
-        //add record
-        if((obj->streams.arrUse + 1) <= obj->streams.arrSz){
-            int fileFd = -1;
-            const int isFileFd = ((server == NULL || server[0] == '\0') && port <= 0) ? 1 : 0;
-            if(isFileFd){
-                //stream src is file
-                fileFd = open(resPath, O_RDONLY);
-                if(fileFd < 0){
-                    K_LOG_ERROR("Player, streamAdd, open failed: '%s'.\n", resPath);
+        //wait for completions (posted buffers must stay valid until then)
+        while(waitCompletions && pendCount > 0){
+            if(IoUring_submit(&obj->uring.ring, 1) < 0){
+                r = -1;
+                break;
+            }
+            Player_uringReap_(obj);
+            pendCount = 0;
+            for(i = 0; i < obj->uring.use; i++){
+                const STPlayerUringOp* op = obj->uring.arr[i];
+                if((type == ENPlayerPollFdType_Count || op->type == type) && (objPtr == NULL || op->obj == objPtr) && (fd < 0 || op->fd == fd)){
+                    pendCount++;
                 }
             }
-            if(isFileFd && fileFd < 0){
-                K_LOG_ERROR("Player, streamAdd, file is required to add: '%s'.\n", resPath);
-            } else {
-                //add only once, trying every known dstPixFmt (will be validated in the open method).
-                int lastPixFmt = 0, fmtsCount = 0, streamAdded = 0;
-                int i; for(i = 0; i < obj->fbs.grps.use; i++){
-                    STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
-                    if(!grp->isClosed && lastPixFmt != grp->pixFmt){
-                        STStreamContext* streamF = NULL;
-                        //find already added matching stream
-                        {
-                            int i; for(i = 0; i < obj->streams.arrUse; i++){
-                                STStreamContext* s = obj->streams.arr[i];
-                                if(s != NULL){
-                                    if(0 == StreamContext_isSame(s, device, server, port, resPath, V4L2_PIX_FMT_H264, grp->pixFmt)){
-                                        streamF = s;
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-                        //
-                        if(streamF != NULL){
-                            //add existing stream
-                            if(0 != FramebuffsGrp_addStream(grp, streamF)){
-                                K_LOG_ERROR("Player, streamAdd, FramebuffsGrp_addStream failed for existing stream.\n");
-                            } else {
-                                K_LOG_VERBOSE("Player, streamAdd, Player_streamAdd existing stream added: '%s'.\n", resPath);
-                                streamAdded++;
-                                r = 0;
-                            }
+        }
+    }
+#   endif
+    return r;
+}
+
+//dns
+
+void Player_dnsNotify_(union sigval sv){
+    //Note: called from a 'getaddrinfo_a' thread, only the eventfd is touched here.
+    const uint64_t v = 1;
+    if(write(sv.sival_int, &v, sizeof(v)) != sizeof(v)){
+        //ignore, the eventfd counter is already signaled or closed
+    }
+}
+
+void Player_dnsPollCallback_(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, int revents){
+    STPlayer* obj = (STPlayer*)userParam;
+    //consume event
+    if(revents & POLLIN){
+        uint64_t v = 0;
+        if(read(obj->dns.evtFd, &v, sizeof(v)) != sizeof(v)){
+            //ignore (EAGAIN)
+        }
+    }
+    //collect completed resolutions
+    {
+        int i; for(i = 0; i < obj->dns.use; i++){
+            STDnsRecord* rec = obj->dns.arr[i];
+            if(rec->resolver != NULL){
+                const int reslvRet = gai_error(rec->resolver);
+                if(reslvRet == EAI_INPROGRESS){
+                    //active
+                    continue;
+                }
+                rec->isResolved = 0;
+                if(reslvRet != 0){
+                    //error
+                    K_LOG_ERROR("Player, dns, getaddrinfo_a failed (progress): '%s'.\n", rec->server);
+                } else {
+                    //success (families interleaved starting with the preferred one, RFC 8305)
+                    STNetAddrs v4, v6; int preferred = 0, i4 = 0, i6 = 0;
+                    struct addrinfo* res = rec->resolver->ar_result;
+                    v4.use = v6.use = 0;
+                    while (res){
+                        if (res->ai_family == AF_INET && v4.use < K_NET_ADDRS_MAX) {
+                            v4.arr[v4.use].family = AF_INET;
+                            v4.arr[v4.use].addr.v4 = ((struct sockaddr_in*)res->ai_addr)->sin_addr;
+                            v4.use++;
+                        } else if (res->ai_family == AF_INET6 && v6.use < K_NET_ADDRS_MAX) {
+                            v6.arr[v6.use].family = AF_INET6;
+                            v6.arr[v6.use].addr.v6 = ((struct sockaddr_in6*)res->ai_addr)->sin6_addr;
+                            v6.use++;
                         } else {
-                            //open new stream
-                            STStreamContext* streamN = malloc(sizeof(STStreamContext));
-                            StreamContext_init(streamN);
-                            if(0 != StreamContext_open(streamN, obj, device, server, port, keepAlive, resPath, V4L2_PIX_FMT_H264, 1, 1, (1024 * 1024 * 1), grp->pixFmt, connTimeoutSecs, decoderTimeoutSecs, framesSkip, framesFeedMax)){
-                                //do not print.
-                            } else if(0 != StreamContext_close(streamN, obj)){
-                                K_LOG_ERROR("Player, streamAdd, StreamContext_close failed after StreamContext_open: '%s'.\n", resPath);
-                            } else {
-                                //add new buffer
-                                if(0 != FramebuffsGrp_addStream(grp, streamN)){
-                                    K_LOG_ERROR("Player, streamAdd, FramebuffsGrp_addStream failed for new stream.\n");
-                                } else {
-                                    K_LOG_VERBOSE("Player, streamAdd, Player_streamAdd device opened, closed and added: '%s'.\n", resPath);
-                                    streamN->streamId = ++obj->streamIdNext;
-                                    obj->streams.arr[obj->streams.arrUse] = streamN; streamN = NULL; //consume
-                                    obj->streams.arrUse++;
-                                    streamAdded++;
-                                    r = 0;
-                                }
-                            }
-                            //release (if not consumed)
-                            if(streamN != NULL){
-                                StreamContext_release(streamN);
-                                free(streamN);
-                                streamN = NULL;
-                            }
+                            res = res->ai_next;
+                            continue;
                         }
-                        //
-                        lastPixFmt = grp->pixFmt;
-                        fmtsCount++;
+                        if(preferred == 0){
+                            preferred = res->ai_family; //getaddrinfo's order (RFC 6724)
+                        }
+                        //next
+                        res = res->ai_next;
                     }
-                }
-                //
-                if(!streamAdded){
-                    if(fmtsCount == 0){
-                        K_LOG_INFO("Player_streamAdd, no open fbGrp to add stream, for '%s'.\n", fmtsCount, resPath);
+                    rec->addrs.use = 0;
+                    while(rec->addrs.use < K_NET_ADDRS_MAX && (i4 < v4.use || i6 < v6.use)){
+                        const int takeV6 = (i6 < v6.use && (i4 >= v4.use || (rec->addrs.use % 2) == (preferred == AF_INET6 ? 0 : 1)));
+                        rec->addrs.arr[rec->addrs.use++] = (takeV6 ? v6.arr[i6++] : v4.arr[i4++]);
+                    }
+                    if(rec->addrs.use > 0){
+                        rec->isResolved = 1;
+                        rec->msResolved = obj->msRunning;
+                    }
+                    if(!rec->isResolved){
+                        K_LOG_ERROR("Player, dns, host-addr-not-found('%s').\n", rec->server);
                     } else {
-                        K_LOG_INFO("Player_streamAdd, could not add to device supporting the dstPixFmt (%d fmts found) for '%s'.\n", fmtsCount, resPath);
+                        K_LOG_VERBOSE("Player, dns, resolved('%s'): %d ipv6 and %d ipv4 addresses.\n", rec->server, v6.use, v4.use);
                     }
-                    r = -1;
-                } else {
-                    if(0 != Player_organize(obj)){
-                        K_LOG_ERROR("Player, streamAdd, Player_organize failed after new stream.\n");
+                    //release result (owned)
+                    if(rec->resolver->ar_result != NULL){
+                        freeaddrinfo(rec->resolver->ar_result);
+                        rec->resolver->ar_result = NULL;
+                    }
+                }
+                free(rec->resolver);
+                rec->resolver = NULL;
+                //notify waiting streams
+                {
+                    int j; for(j = 0; j < obj->streams.arrUse; j++){
+                        STStreamContext* ctx = obj->streams.arr[j];
+                        if(ctx->net.isResolving && ctx->cfg.server != NULL && strcmp(ctx->cfg.server, rec->server) == 0){
+                            StreamContext_netResolved_(ctx, obj, (rec->isResolved ? &rec->addrs : NULL));
+                        }
                     }
                 }
-            }
-            //release
-            if(fileFd > 0){
-                close(fileFd);
-                fileFd = -1;
             }
         }
     }
-    //
-    return r;
 }
 
-int Player_streamRemove(STPlayer* obj, STStreamContext* stream){
+int Player_dnsResolve(STPlayer* obj, const char* server, STNetAddrs* dstAddrs, int* dstIsResolved){
     int r = -1;
+    STDnsRecord* rec = NULL;
+    if(server == NULL || server[0] == '\0'){
+        return -1;
+    }
+    //eventfd (created on first use)
+    if(obj->dns.evtFd < 0){
+        int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if(fd < 0){
+            K_LOG_ERROR("Player, dns, eventfd failed errno(%d).\n", errno);
+        } else if(0 != Player_pollAdd(obj, ENPlayerPollFdType_DnsEvent, Player_dnsPollCallback_, obj, fd, POLLIN)){
+            K_LOG_ERROR("Player, dns, eventfd poll-add failed.\n");
+            close(fd);
+            fd = -1;
+        } else {
+            obj->dns.evtFd = fd; fd = -1; //consume
+        }
+        if(obj->dns.evtFd < 0){
+            return -1;
+        }
+    }
     //search
-    int i; for(i = 0; i < obj->streams.arrUse; i++){
-        if(stream == obj->streams.arr[i]){
-            //remove
-            obj->streams.arrUse--;
-            for(;i < obj->streams.arrUse; i++){
-                obj->streams.arr[i] = obj->streams.arr[i + 1];
-            }
-            StreamContext_release(stream);
-            free(stream);
-            r = 0;
-            //reorganize
-            if(0 != Player_organize(obj)){
-                K_LOG_ERROR("Player_organize failed after stream removal.\n");
+    {
+        int i; for(i = 0; i < obj->dns.use; i++){
+            STDnsRecord* rec2 = obj->dns.arr[i];
+            if(strcmp(rec2->server, server) == 0){
+                rec = rec2;
+                break;
             }
-            break;
         }
     }
-    return r;
-}
-
-//organize
-//Assigns fb and screen-area to each stream. Should be called on each stream resize event.
-int Player_organize(STPlayer* obj){
-    int r = 0;
-    int i; for(i = 0 ; i < obj->fbs.grps.use; i++){
-        STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
-        if(0 != FramebuffsGrp_layoutStart(grp)){
-            K_LOG_ERROR("FramebuffsGrp_layoutStart failed.\n");
-        } else {
-            int j; for(j = 0; j < grp->streams.use; j++){
-                STStreamContext* s = grp->streams.arr[j];
-                if(s->drawPlan.lastPixelformat == grp->pixFmt){
-                    STFbSize sz;
-                    memset(&sz, 0, sizeof(sz));
-                    sz.width = s->drawPlan.lastCompRect.width;
-                    sz.height = s->drawPlan.lastCompRect.height;
-                    if(0 != FramebuffsGrp_layoutAdd(grp, s->streamId, sz)){
-                        K_LOG_ERROR("FramebuffsGrp_layoutAdd failed.\n");
+    //create
+    if(rec == NULL){
+        //resize array
+        while(obj->dns.use >= obj->dns.sz){
+            const int szN = (obj->dns.use + 4);
+            STDnsRecord** arrN = malloc(sizeof(STDnsRecord*) * szN);
+            if(arrN == NULL){
+                break;
+            } else {
+                if(obj->dns.arr != NULL){
+                    if(obj->dns.use > 0){
+                        memcpy(arrN, obj->dns.arr, sizeof(obj->dns.arr[0]) * obj->dns.use);
                     }
+                    free(obj->dns.arr);
                 }
+                obj->dns.arr = arrN;
+                obj->dns.sz = szN;
             }
-            //
-            if(0 != FramebuffsGrp_layoutEnd(grp)){
-                K_LOG_ERROR("FramebuffsGrp_layoutEnd failed.\n");
+        }
+        //add
+        if(obj->dns.use < obj->dns.sz){
+            const int serverLen = strlen(server);
+            rec = (STDnsRecord*)malloc(sizeof(STDnsRecord));
+            DnsRecord_init(rec);
+            rec->server = malloc(serverLen + 1);
+            memcpy(rec->server, server, serverLen + 1);
+            obj->dns.arr[obj->dns.use++] = rec;
+        }
+    }
+    //resolve
+    if(rec != NULL){
+        if(rec->isResolved && obj->cfg.dnsCacheSecs > 0 && (obj->msRunning - rec->msResolved) < ((unsigned long long)obj->cfg.dnsCacheSecs * 1000ULL)){
+            //cached
+            if(dstAddrs != NULL) *dstAddrs = rec->addrs;
+            if(dstIsResolved != NULL) *dstIsResolved = 1;
+            r = 0;
+        } else if(rec->resolver != NULL){
+            //already resolving (completion will notify all the server's streams)
+            r = 0;
+        } else {
+            struct gaicb* resolver = (struct gaicb*)malloc(sizeof(struct gaicb));
+            struct sigevent sev;
+            memset(resolver, 0, sizeof(*resolver));
+            memset(&sev, 0, sizeof(sev));
+            memset(&rec->hints, 0, sizeof(rec->hints));
+            rec->hints.ai_family = AF_UNSPEC; //ipv4 and ipv6
+            rec->hints.ai_socktype = SOCK_STREAM; //one result per address
+            rec->hints.ai_flags = AI_ADDRCONFIG; //only families configured at this host
+            resolver->ar_name = rec->server;
+            resolver->ar_request = &rec->hints;
+            sev.sigev_notify = SIGEV_THREAD;
+            sev.sigev_notify_function = Player_dnsNotify_;
+            sev.sigev_value.sival_int = obj->dns.evtFd;
+            if(0 != getaddrinfo_a(GAI_NOWAIT, &resolver, 1, &sev)){
+                K_LOG_ERROR("Player, dns, getaddrinfo_a failed (start): '%s'.\n", rec->server);
+            } else {
+                rec->resolver = resolver; resolver = NULL; //consume
+                rec->isResolved = 0;
+                r = 0;
+            }
+            //release (if not consumed)
+            if(resolver != NULL){
+                free(resolver);
+                resolver = NULL;
             }
         }
     }
     return r;
 }
 
+//netPools
 
-int Player_draw__(STPlayer* obj, STFramebuffDrawRect* rects, int rectsSz, int* dstRectsUse, int* dstLinesReq);
-int Player_draw_(STPlayer* obj);
-
-int Player_tick(STPlayer* obj, int ms){
-    int r = 0;
-    //
-    obj->anim.tickSeq++;
-    //fbs
+STNetPool* Player_netPoolGet(STPlayer* obj, const char* server, const unsigned int port, const int createIfNecesary){
+    STNetPool* pool = NULL;
+    if(server == NULL || server[0] == '\0' || port <= 0){
+        return NULL;
+    }
+    //search
     {
-        int hitsCountOnceAnimEnd = 0, hitsCountOnceDrawEnd = 0;
-        //reset draw plan hits and decrease peekers time
-        {
-            int i; for(i = 0; i < obj->streams.arrUse; i++){
-                STStreamContext* s = obj->streams.arr[i];
-                s->drawPlan.hitsCount = 0;
-                //peeking image-size/stream-props (allowing decoder)
-                {
-                    if(s->drawPlan.lastCompRect.width > 0 && s->drawPlan.lastCompRect.height > 0){
-                        if(s->drawPlan.peekRemainMs > 0){
-                            //peek completed (image-size determinated)
-                            s->drawPlan.peekRemainMs = 0;
-                        }
-                    } else {
-                        s->drawPlan.peekRemainMs -= (s->drawPlan.peekRemainMs <= ms ? s->drawPlan.peekRemainMs : ms);
+        int i; for(i = 0; i < obj->netPools.use; i++){
+            STNetPool* pool2 = obj->netPools.arr[i];
+            if(pool2->port == port && strcmp(pool2->server, server) == 0){
+                pool = pool2;
+                break;
+            }
+        }
+    }
+    //create
+    if(pool == NULL && createIfNecesary){
+        //resize array
+        while(obj->netPools.use >= obj->netPools.sz){
+            const int szN = (obj->netPools.use + 4);
+            STNetPool** arrN = malloc(sizeof(STNetPool*) * szN);
+            if(arrN == NULL){
+                break;
+            } else {
+                if(obj->netPools.arr != NULL){
+                    if(obj->netPools.use > 0){
+                        memcpy(arrN, obj->netPools.arr, sizeof(obj->netPools.arr[0]) * obj->netPools.use);
                     }
+                    free(obj->netPools.arr);
                 }
+                obj->netPools.arr = arrN;
+                obj->netPools.sz = szN;
             }
         }
-        //animate fbs
-        {
-            const int doDrawPlanIfAnimating = 1;
-            int i; for(i = 0 ; i < obj->fbs.grps.use; i++){
-                STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
-                if(0 != FramebuffsGrp_layoutAnimTick(grp, ms, obj, (1000 * obj->cfg.animPreRenderSecs), doDrawPlanIfAnimating)){
-                    K_LOG_ERROR("Player, FramebuffsGrp_layoutAnimTick failed.\n");
-                }
-            }
+        //add
+        if(obj->netPools.use < obj->netPools.sz){
+            const int serverLen = strlen(server);
+            pool = (STNetPool*)malloc(sizeof(STNetPool));
+            NetPool_init(pool);
+            pool->server = malloc(serverLen + 1);
+            memcpy(pool->server, server, serverLen + 1);
+            pool->port = port;
+            obj->netPools.arr[obj->netPools.use++] = pool;
         }
-        //count draw plan hits for animations final stage
-        {
-            int i; for(i = 0; i < obj->streams.arrUse; i++){
-                const STStreamContext* s = obj->streams.arr[i];
-                if(s->drawPlan.hitsCount > 0){
-                    hitsCountOnceAnimEnd++;
-                }
+    }
+    return pool;
+}
+
+void Player_netPoolConnRemove_(STPlayer* obj, STNetPool* pool, STNetPoolConn* conn, const int isWasted){
+    int i; for(i = 0; i < pool->conns.use; i++){
+        if(pool->conns.arr[i] == conn){
+            //remove from array
+            pool->conns.use--;
+            for(; i < pool->conns.use; i++){
+                pool->conns.arr[i] = pool->conns.arr[i + 1];
             }
-        }
-        //draw
-        if(0 != Player_draw_(obj)){
-            K_LOG_INFO("Player, anim-draw fail.\n");
-        }
-        //count draw plan hits after final draw
-        {
-            int i; for(i = 0; i < obj->streams.arrUse; i++){
-                const STStreamContext* s = obj->streams.arr[i];
-                if(s->drawPlan.hitsCount > 0){
-                    hitsCountOnceDrawEnd++;
+            //close
+            if(conn->socket > 0){
+                Player_pollAutoRemove(obj, ENPlayerPollFdType_NetPoolConn, conn, conn->socket);
+                if(isWasted){
+                    close(conn->socket);
+                    pool->stats.curSec.connsWasted++;
                 }
+                conn->socket = 0;
             }
+            free(conn);
+            break;
         }
-        //activate peeking
-        {
-            int decodersToBeOpenCount = 0;
-            //Reset decoders flags and count decoders already open
-            {
-                int i; for(i = 0; i < obj->streams.arrUse; i++){
-                    STStreamContext* s = obj->streams.arr[i];
-                    s->dec.shouldBeOpen = 0;
-                    if(s->dec.fd >= 0){
-                        decodersToBeOpenCount++;
-                        s->dec.shouldBeOpen = STREAM_CONTEXT_DECODER_SHOULD_BE_OPEN(s);
-                    }
-                }
-            }
-            //Activate new decoders that are necesary for rendering
-            {
-                int i; for(i = 0; i < obj->streams.arrUse; i++){
-                    STStreamContext* s = obj->streams.arr[i];
-                    if(s->dec.fd < 0 && !s->dec.shouldBeOpen && decodersToBeOpenCount < obj->cfg.decodersMax && STREAM_CONTEXT_DECODER_SHOULD_BE_OPEN(s) && s->drawPlan.hitsCount > 0){
-                        s->dec.shouldBeOpen = 1;
-                        decodersToBeOpenCount++;
-                    }
+    }
+}
+
+void Player_netPoolConnPollCallback_(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, int revents){
+    STNetPoolConn* conn = (STNetPoolConn*)userParam;
+    STNetPool* pool = conn->pool;
+    if((revents & (POLLERR | POLLHUP | POLLIN))){
+        //error, closed or unexpected data (before any request)
+        K_LOG_VERBOSE("Player, netPool, warm conn closed by %s: '%s:%d'.\n", (revents & POLLIN ? "data-or-eof" : "error"), pool->server, pool->port);
+        Player_netPoolConnRemove_(plyr, pool, conn, 1);
+    } else if((revents & POLLOUT) && !conn->isConnected){
+        int err = 0; socklen_t errSz = sizeof(err);
+        if(0 != getsockopt(conn->socket, SOL_SOCKET, SO_ERROR, &err, &errSz) || err != 0){
+            K_LOG_VERBOSE("Player, netPool, warm conn failed errno(%d): '%s:%d'.\n", err, pool->server, pool->port);
+            Player_netPoolConnRemove_(plyr, pool, conn, 1);
+        } else if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_NetPoolConn, conn, conn->socket, POLLIN, NULL)){ //detect remote close while idle
+            K_LOG_ERROR("Player, netPool, poll-update-failed: '%s:%d'.\n", pool->server, pool->port);
+            Player_netPoolConnRemove_(plyr, pool, conn, 1);
+        } else {
+            K_LOG_VERBOSE("Player, netPool, warm conn ready: '%s:%d'.\n", pool->server, pool->port);
+            conn->isConnected = 1;
+        }
+    }
+}
+
+SOCKET Player_netPoolTake(STPlayer* obj, const char* server, const unsigned int port){
+    SOCKET r = 0;
+    STNetPool* pool = Player_netPoolGet(obj, server, port, 0);
+    if(pool != NULL){
+        int i; for(i = (int)pool->conns.use - 1; i >= 0 && r == 0; i--){
+            STNetPoolConn* conn = pool->conns.arr[i];
+            if(conn->isConnected && conn->socket > 0){
+                //validate (remote could have closed it since last poll)
+                char c = 0;
+                const ssize_t rcvd = recv(conn->socket, &c, sizeof(c), MSG_PEEK | MSG_DONTWAIT);
+                if(rcvd < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+                    r = conn->socket;
+                    pool->stats.curSec.connsReused++;
+                    Player_netPoolConnRemove_(obj, pool, conn, 0); //socket ownership transfered
+                } else {
+                    Player_netPoolConnRemove_(obj, pool, conn, 1);
                 }
             }
-            //Activate new decoders that are already flagged for peeking
-            {
-                int i; for(i = 0; i < obj->streams.arrUse; i++){
-                    STStreamContext* s = obj->streams.arr[i];
-                    if(s->dec.fd < 0 && !s->dec.shouldBeOpen && decodersToBeOpenCount < obj->cfg.decodersMax && STREAM_CONTEXT_DECODER_SHOULD_BE_OPEN(s) && s->drawPlan.peekRemainMs > 0){
-                        s->dec.shouldBeOpen = 1;
-                        decodersToBeOpenCount++;
+        }
+    }
+    return r;
+}
+
+int Player_netPoolWarm(STPlayer* obj, const char* server, const unsigned int port){
+    int r = -1;
+    STNetPool* pool = NULL;
+    if(obj->cfg.netPoolIdleMax <= 0){
+        return -1;
+    }
+    pool = Player_netPoolGet(obj, server, port, 0);
+    if(pool != NULL && pool->isAddrSet && pool->conns.use < obj->cfg.netPoolIdleMax){
+        //resize array
+        while(pool->conns.use >= pool->conns.sz){
+            const int szN = (pool->conns.use + 4);
+            STNetPoolConn** arrN = malloc(sizeof(STNetPoolConn*) * szN);
+            if(arrN == NULL){
+                break;
+            } else {
+                if(pool->conns.arr != NULL){
+                    if(pool->conns.use > 0){
+                        memcpy(arrN, pool->conns.arr, sizeof(pool->conns.arr[0]) * pool->conns.use);
                     }
+                    free(pool->conns.arr);
                 }
+                pool->conns.arr = arrN;
+                pool->conns.sz = szN;
             }
-            //Activate new decoders that can be flagged as new peekkers
-            if(obj->cfg.decodersToPeekSecs > 0){
-                int evalsInSeq = 0;
-                while(evalsInSeq < obj->streams.arrUse && decodersToBeOpenCount < obj->cfg.decodersMax) {
-                    //eval
-                    const int iStream = (obj->peek.iNextStreamEval % obj->streams.arrUse);
-                    STStreamContext* s = obj->streams.arr[iStream];
-                    if(
-                       s->drawPlan.lastCompRect.width <= 0 || s->drawPlan.lastCompRect.height <= 0 //image-size not determined yet
-                       && s->frames.filled.use > 0 //frame(s) available to decode
-                       && s->drawPlan.peekRemainMs <= 0 //not currently peeking
-                       //
-                       && s->dec.fd < 0 //no decoder
-                       && !s->dec.shouldBeOpen //not flagged to open yet
-                       )
-                    {
-                        s->drawPlan.peekRemainMs = (1000 * obj->cfg.decodersToPeekSecs);
-                        //allow new peeker
-                        if(STREAM_CONTEXT_DECODER_SHOULD_BE_OPEN(s)){ //just in case (valdate again)
-                            s->dec.shouldBeOpen = 1;
-                            decodersToBeOpenCount++;
-                            evalsInSeq = 0; //restart cycle
-                        }
-                    }
-                    //next
-                    obj->peek.iNextStreamEval = (obj->peek.iNextStreamEval + 1) % obj->streams.arrUse;
-                    evalsInSeq++;
+        }
+        //add
+        if(pool->conns.use < pool->conns.sz){
+            SOCKET sckt = netSocketConnectStart(&pool->addr, pool->port, pool->server, "(warm)");
+            if(sckt){
+                STNetPoolConn* conn = (STNetPoolConn*)malloc(sizeof(STNetPoolConn));
+                memset(conn, 0, sizeof(*conn));
+                conn->pool = pool;
+                conn->socket = sckt;
+                conn->msStarted = obj->msRunning;
+                if(0 != Player_pollAdd(obj, ENPlayerPollFdType_NetPoolConn, Player_netPoolConnPollCallback_, conn, sckt, POLLOUT)){
+                    K_LOG_ERROR("Player, netPool, poll-add-failed: '%s:%d'.\n", pool->server, pool->port);
+                    close(sckt);
+                    free(conn);
+                } else {
+                    pool->conns.arr[pool->conns.use++] = conn;
+                    pool->stats.curSec.connsWarmed++;
+                    r = 0;
                 }
             }
         }
-        K_LOG_VERBOSE("Player, draw, active streams: +%d by animation, +%d (of %d) by final-draw.\n", hitsCountOnceAnimEnd, (hitsCountOnceDrawEnd - hitsCountOnceAnimEnd), obj->streams.arrUse);
     }
-    //streams
-    {
-        int i; for(i = (int)obj->streams.arrUse - 1; i >= 0; i--){
-            STStreamContext* ctx = obj->streams.arr[i];
-            StreamContext_tick(ctx, obj, ms);
+    return r;
+}
+
+int Player_netConnectAllowed(STPlayer* obj, const char* server, const unsigned int port){
+    int countSrvr = 0, countAll = 0;
+    int i; for(i = 0; i < obj->streams.arrUse; i++){
+        const STStreamContext* s = obj->streams.arr[i];
+        //resolving, or connected but nothing received yet
+        if((s->cfg.netProto == ENStreamNetProto_Http || s->cfg.netProto == ENStreamNetProto_Rtsp) && (s->net.isResolving || s->net.he.use > 0 || (s->net.socket > 0 && s->net.bytesRcvd == 0))){
+            countAll++;
+            if(s->cfg.port == port && s->cfg.server != NULL && strcmp(s->cfg.server, server) == 0){
+                countSrvr++;
+            }
         }
     }
-    obj->msRunning += ms;
-    return r;
+    return ((obj->cfg.connPendingPerServer <= 0 || countSrvr < obj->cfg.connPendingPerServer) && (obj->cfg.connPendingMax <= 0 || countAll < obj->cfg.connPendingMax));
 }
 
-int Player_drawGetRects_(STPlayer* obj, STFramebuffDrawRect* rects, int rectsSz, int* dstRectsUse){
-    int r = 0;
-    //fbs
-    {
-        int i; for(i = 0 ; i < obj->fbs.grps.use; i++){
-            STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
-            if(0 != FramebuffsGrp_drawGetRects(grp, obj, grp->layout.anim.yOffset, rects, rectsSz, dstRectsUse)){
-                //do not stop, continue processing, 'dstRectsUse' could be updated by next calls.
-                r = -1;
+//decPool
+
+int Player_decPoolAdd(STPlayer* obj, STDecoderParked* dec){
+    int r = -1;
+    //resize array
+    while(obj->decPool.use >= obj->decPool.sz){
+        const int szN = (obj->decPool.use + 4);
+        STDecoderParked** arrN = malloc(sizeof(STDecoderParked*) * szN);
+        if(arrN == NULL){
+            break;
+        } else {
+            if(obj->decPool.arr != NULL){
+                if(obj->decPool.use > 0){
+                    memcpy(arrN, obj->decPool.arr, sizeof(obj->decPool.arr[0]) * obj->decPool.use);
+                }
+                free(obj->decPool.arr);
             }
+            obj->decPool.arr = arrN;
+            obj->decPool.sz = szN;
         }
     }
+    //add
+    if(obj->decPool.use < obj->decPool.sz){
+        dec->msParked = obj->msRunning;
+        obj->decPool.arr[obj->decPool.use++] = dec;
+        obj->decPool.stats.curSec.parked++;
+        r = 0;
+        //respect 'decodersMax' (the oldest are closed, could be this one)
+        Player_decPoolTrim(obj, 0);
+    }
     return r;
 }
 
-int Player_drawGetLines_(STPlayer* obj, STFramebuffDrawRect* rects, const int rectsUse, STFramebuffDrawLine* lines, const int linesSz, int* dstLinesUse){
-    int r = 0;
-    //build draw plan (lines per row)
-    STFramebuff* rowStartFb = NULL;
-    int i, iRow = -1, rowStartRectIdx = 0, rowRectsCount = 0;
-    for(i = 0; i < rectsUse; i++){
-        STFramebuffDrawRect* rect = &rects[i];
-        if(rowStartFb != rect->fb || iRow != rect->iRow){
-            if(rowRectsCount > 0){
-                if(0 != Framebuff_drawRowsBuildPlan(rowStartFb, &rowStartFb->screen, &rects[rowStartRectIdx], rowRectsCount, lines, linesSz, dstLinesUse)){
-                    r = -1;
-                }
+STDecoderParked* Player_decPoolTake(STPlayer* obj, const char* device, const int srcPixFmt, const int dstPixFmt){
+    STDecoderParked* r = NULL;
+    int i, iFnd = -1;
+    //same device, src-fmt and dst-fmt (their support was validated when opened), the most recently parked
+    for(i = 0; i < obj->decPool.use; i++){
+        STDecoderParked* dec = obj->decPool.arr[i];
+        if(dec->srcPixFmt == srcPixFmt && dec->dstPixFmt == dstPixFmt && dec->device != NULL && device != NULL && strcmp(dec->device, device) == 0){
+            if(iFnd < 0 || dec->msParked >= obj->decPool.arr[iFnd]->msParked){
+                iFnd = i;
             }
-            rowStartFb = rect->fb;
-            iRow = rect->iRow;
-            rowStartRectIdx = i;
-            rowRectsCount = 0;
         }
-        //add to row
-        rowRectsCount++;
     }
-    //flush last row
-    if(rowRectsCount > 0){
-        if(0 != Framebuff_drawRowsBuildPlan(rowStartFb, &rowStartFb->screen, &rects[rowStartRectIdx], rowRectsCount, lines, linesSz, dstLinesUse)){
-            r = -1;
+    if(iFnd >= 0){
+        r = obj->decPool.arr[iFnd];
+        //remove from array
+        obj->decPool.use--;
+        for(i = iFnd; i < obj->decPool.use; i++){
+            obj->decPool.arr[i] = obj->decPool.arr[i + 1];
         }
     }
     return r;
 }
 
-//---------------------
-//-- Unplaned drawing
-//---------------------
-//Draws the rects in order. This means the src and dst memory area will jump.
-
-//STPlayerDrawRectsUnplanedTask
-typedef struct STPlayerDrawRectsUnplanedTask_ {
-    STPlayer*               dst;    //for the mutex
-    STFramebuffDrawRect*    rects;
-    int                     rectsSz;
-} STPlayerDrawRectsUnplanedTask;
-
-void Player_drawRectsUnplanedTaskFunc_(void* param){
-    STPlayerDrawRectsUnplanedTask* t = (STPlayerDrawRectsUnplanedTask*)param;
-    //draw
-    {
-        int i; for(i = 0; i < t->rectsSz; i++){
-            STFramebuffDrawRect* rect = &t->rects[i];
-            if(rect->fb != NULL){
-                STFramebuffPtr* dst = &rect->fb->screen;
-                if(rect->plane == NULL){
-                    //black rect
-                    if(rect->fb->blackLine != NULL){
-                        int yDst = rect->posCur.y;
-                        int ySrc = rect->srcRectY;
-                        const int bytesPerPx = (rect->fb->bitsPerPx / 8);
-                        const int copyLen = bytesPerPx * rect->srcRectWidth; //ToDo: validate srcWidth <= blackLineSz
-                        while(ySrc < rect->srcRectYAfterEnd){
-                            unsigned char* srcLn = rect->fb->blackLine;
-                            unsigned char* dstLn = &dst->ptr[(rect->fb->bytesPerLn * yDst) + (bytesPerPx * rect->posCur.x)];
-                            K_ASSERT(dstLn >= dst->ptr && (dstLn + copyLen) <= (dst->ptr + dst->ptrSz)) //must be inside the destination range
-                            if(copyLen > 0){
-                                memcpy(dstLn, srcLn, copyLen);
-                            }
-                            ySrc++;
-                            yDst++;
-                        }
-                    }
-                } else {
-                    //image
-                    STFbRect src;
-                    memset(&src, 0, sizeof(src));
-                    src.x = rect->srcRectX;
-                    src.y = rect->srcRectY;
-                    src.width = rect->srcRectWidth;
-                    src.height = (rect->srcRectYAfterEnd - rect->srcRectY);
-                    if(0 != Framebuff_bitblit(rect->fb, dst, rect->posCur, rect->plane, src)){
-                        K_LOG_ERROR("StreamContext, bitblit failed.\n");
-                    }
-                }
-            }
+int Player_decPoolTrim(STPlayer* obj, const int slotsToOpen){
+    int r = 0, openedCount = 0;
+    int i; for(i = 0; i < obj->streams.arrUse; i++){
+        if(obj->streams.arr[i]->dec.fd >= 0){
+            openedCount++;
         }
     }
-    //reduce counter
-    {
-        pthread_mutex_lock(&t->dst->draw.mutex);
+    while(obj->decPool.use > 0 && (openedCount + obj->decPool.use + slotsToOpen) > obj->cfg.decodersMax){
+        int iOldest = 0;
+        for(i = 1; i < obj->decPool.use; i++){
+            if(obj->decPool.arr[i]->msParked < obj->decPool.arr[iOldest]->msParked){
+                iOldest = i;
+            }
+        }
         {
-            K_ASSERT(t->dst->draw.tasksPendCount > 0)
-            if(t->dst->draw.tasksPendCount > 0){
-                t->dst->draw.tasksPendCount--;
-                if(t->dst->draw.tasksPendCount == 0){ //optimization, only awake main-thread if is the last task.
-                    pthread_cond_broadcast(&t->dst->draw.cond);
-                }
+            STDecoderParked* dec = obj->decPool.arr[iOldest];
+            K_LOG_VERBOSE("Player, decPool, closing parked decoder (%llums parked): '%s'.\n", (obj->msRunning - dec->msParked), dec->device);
+            //remove from array
+            obj->decPool.use--;
+            for(i = iOldest; i < obj->decPool.use; i++){
+                obj->decPool.arr[i] = obj->decPool.arr[i + 1];
             }
+            DecoderParked_release(dec);
+            free(dec);
+            obj->decPool.stats.curSec.evicted++;
+            r++;
         }
-        pthread_mutex_unlock(&t->dst->draw.mutex);
     }
+    return r;
 }
 
-int Player_drawRectsUnplaned_(STPlayer* obj, STFramebuffDrawRect* rects, const int rectsUse){
-    int r = 0;
-    STPlayerDrawRectsUnplanedTask* tt = malloc(sizeof(STPlayerDrawRectsUnplanedTask) * (obj->threads.use + 1));
-    if(tt != NULL){
-        memset(tt, 0, sizeof(STPlayerDrawRectsUnplanedTask) * (obj->threads.use + 1));
+//fbs
+
+int Player_fbAdd(STPlayer* obj, const char* device, const ENFramebuffsGrpFbLocation location, const int locX, const int locY, const int animSecsWaits){
+    int r = -1;
+    //resize arr
+    while(obj->fbs.arrUse >= obj->fbs.arrSz){
+        STFramebuff** arrN = NULL;
         //
-        int iRectStart = 0, ttUse = 0, rectsPerThread = (rectsUse / (obj->threads.use + 1));
-        int i; for(i = 0; i < obj->threads.use; i++){
-            STThread* thread = &obj->threads.arr[i];
-            STPlayerDrawRectsUnplanedTask* task = &tt[ttUse];
-            //
-            task->dst   = obj;
-            task->rects = &rects[iRectStart];
-            task->rectsSz = rectsPerThread;
-            if((iRectStart + task->rectsSz) > rectsUse){
-                task->rectsSz = rectsUse - iRectStart;
+        arrN = malloc(sizeof(STFramebuff*) * (obj->fbs.arrSz + 1));
+        if(arrN == NULL){
+            if(arrN != NULL) free(arrN); arrN = NULL;
+            break;
+        } else {
+            obj->fbs.arrSz++;
+            if(obj->fbs.arr != NULL){
+                if(obj->fbs.arrUse > 0){
+                    memcpy(arrN, obj->fbs.arr, sizeof(STFramebuff*) * obj->fbs.arrUse);
+                }
+                free(obj->fbs.arr);
             }
-            //
-            pthread_mutex_lock(&obj->draw.mutex);
+            obj->fbs.arr = arrN;
+        }
+    }
+    //add record
+    if((obj->fbs.arrUse + 1) <= obj->fbs.arrSz){
+        STFramebuff* fbN = malloc(sizeof(STFramebuff));
+        Framebuff_init(fbN);
+        r = 0;
+        if(0 != Framebuff_open(fbN, device)){
+            K_LOG_ERROR("Player, fbAdd failed: '%s'.\n", device);
+            r = -1;
+        } else {
+            K_LOG_INFO("Player_fbAdd device added to poll: '%s'.\n", device);
+            //consume
+            obj->fbs.arr[obj->fbs.arrUse] = fbN;
+            obj->fbs.arrUse++;
+            //Add to group (y pixFmt)
             {
-                obj->draw.tasksPendCount++;
-            }
-            pthread_mutex_unlock(&obj->draw.mutex);
-            if(0 != Thread_addTask(thread, Player_drawRectsUnplanedTaskFunc_, task)){
-                //K_LOG_ERROR("Thread_addTask failed.\n"); //ToDo: comment this print (risk to noisy).
-                pthread_mutex_lock(&obj->draw.mutex);
-                {
-                    obj->draw.tasksPendCount--;
+                STFramebuffsGrp* grpFnd = NULL;
+                //search a match
+                if(obj->fbs.grps.arr != NULL){
+                    int i; for(i = 0; i < obj->fbs.grps.use; i++){
+                        STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
+                        if(!grp->isClosed && grp->pixFmt == fbN->pixFmt){
+                            grpFnd = grp;
+                            break;
+                        }
+                    }
+                }
+                //allocate (if not found)
+                if(grpFnd == NULL){
+                    //resize
+                    while(obj->fbs.grps.use >= obj->fbs.grps.sz){
+                        const int szN = obj->fbs.grps.sz + 8;
+                        STFramebuffsGrp* arrN = (STFramebuffsGrp*)malloc(sizeof(obj->fbs.grps.arr[0]) * szN);
+                        if(arrN == NULL){
+                            break;
+                        } else {
+                            if(obj->fbs.grps.arr != NULL){
+                                if(obj->fbs.grps.use > 0){
+                                    memcpy(arrN, obj->fbs.grps.arr, sizeof(obj->fbs.grps.arr[0]) * obj->fbs.grps.use);
+                                }
+                                free(obj->fbs.grps.arr);
+                            }
+                            obj->fbs.grps.arr = arrN;
+                            obj->fbs.grps.sz = szN;
+                        }
+                    }
+                    //add
+                    if(obj->fbs.grps.use < obj->fbs.grps.sz){
+                        grpFnd = &obj->fbs.grps.arr[obj->fbs.grps.use++];
+                        FramebuffsGrp_init(grpFnd);
+                        grpFnd->pixFmt = fbN->pixFmt;
+                        grpFnd->cfg.animSecsWaits = animSecsWaits;
+                    }
+                }
+                //add
+                if(grpFnd == NULL){
+                    K_LOG_ERROR("Player, fbAdd failed, could not create fbsGrp: '%s'.\n", device);
+                    r = -1;
+                } else if(0 != FramebuffsGrp_addFb(grpFnd, fbN, location, locX, locY)){ //ToDo: implement 'ENFramebuffsGrpFbLocation_'
+                    K_LOG_ERROR("Player, fbAdd failed, could not add to fbsGrp: '%s'.\n", device);
+                    r = -1;
+                } else {
+                    K_LOG_INFO("Player, fbAdd opened and to fbsGrp: '%s'.\n", device);
                 }
-                pthread_mutex_unlock(&obj->draw.mutex);
-            } else {
-                //next
-                iRectStart += task->rectsSz;
-                ttUse++;
             }
-        }
-        //task to draw remaining lines on this same thread
-        {
-            STPlayerDrawRectsUnplanedTask* task = &tt[ttUse];
-            task->dst   = obj;
-            task->rects = &rects[iRectStart];
-            task->rectsSz = rectsUse - iRectStart;
-            ttUse++;
-            pthread_mutex_lock(&obj->draw.mutex);
-            {
-                obj->draw.tasksPendCount++;
+            //reorganize
+            if(0 != Player_organize(obj)){
+                K_LOG_ERROR("Player_organize failed after fb creation.\n");
             }
-            pthread_mutex_unlock(&obj->draw.mutex);
-            Player_drawRectsUnplanedTaskFunc_(task);
+            //consume
+            fbN = NULL;
         }
-        //wait for tasks
-        {
-            pthread_mutex_lock(&obj->draw.mutex);
-            while(obj->draw.tasksPendCount > 0){
-                K_ASSERT(obj->draw.tasksPendCount >= 0)
-                pthread_cond_wait(&obj->draw.cond, &obj->draw.mutex);
-            }
-            pthread_mutex_unlock(&obj->draw.mutex);
+        //release (if not consumed)
+        if(fbN != NULL){
+            Framebuff_release(fbN);
+            free(fbN);
+            fbN = NULL;
         }
-        free(tt);
-        tt = NULL;
     }
+    //
     return r;
 }
 
-//---------------------
-//-- Planed drawing
-//---------------------
-//Draws the lines in order. This means the dst memory area will be sequential, the src memory area will be jumping.
-
-//STFramebuffDrawLine
-
-//All the lines to be drawn, in dst-pointer order.
-//The purpose is to organize all the memcpy instructions
-//reducing the memory-jumps, to make the memcpy as closer
-//as posible to as one single call for the dst-memory area.
-
-//STPlayerDrawLinesPlanedTask
-
-typedef struct STPlayerDrawLinesPlanedTask_ {
-    STPlayer*               dst;    //for the mutex
-    STFramebuffDrawLine*    lines;
-    int                     linesSz;
-} STPlayerDrawLinesPlanedTask;
-
-void Player_drawLinesPlanedTaskFunc_(void* param){
-    STPlayerDrawLinesPlanedTask* t = (STPlayerDrawLinesPlanedTask*)param;
-    //draw
-    {
-        STFramebuffDrawLine* ln = t->lines;
-        STFramebuffDrawLine* lnAfterEnd = ln + t->linesSz;
-        while(ln < lnAfterEnd){
-            if(ln->sz > 0){
-                memcpy(ln->dst, ln->src, ln->sz);
+int Player_fbRemove(STPlayer* obj, STFramebuff* fb){
+    int r = -1;
+    //search
+    int i; for(i = 0; i < obj->fbs.arrUse; i++){
+        if(fb == obj->fbs.arr[i]){
+            //remove
+            obj->fbs.arrUse--;
+            for(;i < obj->fbs.arrUse; i++){
+                obj->fbs.arr[i] = obj->fbs.arr[i + 1];
             }
-            //next
-            ln++;
-        }
-    }
-    //reduce counter
-    {
-        pthread_mutex_lock(&t->dst->draw.mutex);
-        {
-            K_ASSERT(t->dst->draw.tasksPendCount > 0)
-            if(t->dst->draw.tasksPendCount > 0){
-                t->dst->draw.tasksPendCount--;
-                if(t->dst->draw.tasksPendCount == 0){ //optimization, only awake main-thread if is the last task.
-                    pthread_cond_broadcast(&t->dst->draw.cond);
-                }
+            Framebuff_release(fb);
+            free(fb);
+            r = 0;
+            //reorganize
+            if(0 != Player_organize(obj)){
+                K_LOG_ERROR("Player_organize failed after fb removal.\n");
             }
+            break;
         }
-        pthread_mutex_unlock(&t->dst->draw.mutex);
     }
+    return r;
 }
 
-int Player_drawLinesPlaned_(STPlayer* obj, STFramebuffDrawLine* lines, const int linesUse){
-    int r = 0;
-    STPlayerDrawLinesPlanedTask* tt = malloc(sizeof(STPlayerDrawLinesPlanedTask) * (obj->threads.use + 1));
-    if(tt != NULL){
-        memset(tt, 0, sizeof(STPlayerDrawLinesPlanedTask) * (obj->threads.use + 1));
-        //
-        int iLineStart = 0, ttUse = 0, linesPerThread = (linesUse / (obj->threads.use + 1));
-        int i; for(i = 0; i < obj->threads.use; i++){
-            STThread* thread = &obj->threads.arr[i];
-            STPlayerDrawLinesPlanedTask* task = &tt[ttUse];
-            //
-            task->dst   = obj;
-            task->lines = &lines[iLineStart];
-            task->linesSz = linesPerThread;
-            if((iLineStart + task->linesSz) > linesUse){
-                task->linesSz = linesUse - iLineStart;
-            }
+int Player_fbsCloseCurrentGrps(STPlayer* obj){
+    int i; for(i = 0; i < obj->fbs.grps.use; i++){
+        STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
+        grp->isClosed = 1;
+    }
+    return 0;
+}
+
+//streams
+
+int Player_streamAdd(STPlayer* obj, const char* device, const char* server, const unsigned int port, const int keepAlive, const ENStreamNetProto netProto, const int maxLatencyMs, const int gopCacheKB, const int fileFps, const int srcPixFmt /*V4L2_PIX_FMT_H264*/, const char* resPath, const int connTimeoutSecs, const int decoderTimeoutSecs, const unsigned long framesSkip, const unsigned long framesFeedMax){
+    int r = -1;
+    if(resPath == NULL || resPath[0] == '\0'){
+        K_LOG_ERROR("Player_streamAdd 'resPath' is required.\n");
+    } else {
+        //resize arr
+        while(obj->streams.arrUse >= obj->streams.arrSz){
+            STStreamContext** arrN = NULL;
             //
-            pthread_mutex_lock(&obj->draw.mutex);
-            {
-                obj->draw.tasksPendCount++;
-            }
-            pthread_mutex_unlock(&obj->draw.mutex);
-            if(0 != Thread_addTask(thread, Player_drawLinesPlanedTaskFunc_, task)){
-                //K_LOG_ERROR("Thread_addTask failed.\n"); //ToDo: comment this print (risk to noisy).
-                pthread_mutex_lock(&obj->draw.mutex);
-                {
-                    obj->draw.tasksPendCount--;
-                }
-                pthread_mutex_unlock(&obj->draw.mutex);
+            arrN = malloc(sizeof(STStreamContext*) * (obj->streams.arrSz + 1));
+            if(arrN == NULL){
+                if(arrN != NULL) free(arrN); arrN = NULL;
+                break;
             } else {
-                //next
-                iLineStart += task->linesSz;
-                ttUse++;
+                obj->streams.arrSz++;
+                if(obj->streams.arr != NULL){
+                    if(obj->streams.arrUse > 0){
+                        memcpy(arrN, obj->streams.arr, sizeof(STStreamContext*) * obj->streams.arrUse);
+                    }
+                    free(obj->streams.arr);
+                }
+                obj->streams.arr = arrN;
             }
         }
-        //task to draw remaining lines on this same thread
-        {
-            STPlayerDrawLinesPlanedTask* task = &tt[ttUse];
-            task->dst   = obj;
-            task->lines = &lines[iLineStart];
-            task->linesSz = linesUse - iLineStart;
-            ttUse++;
-            pthread_mutex_lock(&obj->draw.mutex);
-            {
-                obj->draw.tasksPendCount++;
+        //add record
+        if((obj->streams.arrUse + 1) <= obj->streams.arrSz){
+            int fileFd = -1;
+            const int isFileFd = ((server == NULL || server[0] == '\0') && port <= 0) ? 1 : 0;
+            if(isFileFd){
+                //stream src is file
+                fileFd = open(resPath, O_RDONLY);
+                if(fileFd < 0){
+                    K_LOG_ERROR("Player, streamAdd, open failed: '%s'.\n", resPath);
+                }
             }
-            pthread_mutex_unlock(&obj->draw.mutex);
-            Player_drawLinesPlanedTaskFunc_(task);
-        }
-        //wait for tasks
-        {
-            pthread_mutex_lock(&obj->draw.mutex);
-            while(obj->draw.tasksPendCount > 0){
-                K_ASSERT(obj->draw.tasksPendCount >= 0)
-                pthread_cond_wait(&obj->draw.cond, &obj->draw.mutex);
-            }
-            pthread_mutex_unlock(&obj->draw.mutex);
-        }
-        free(tt);
-        tt = NULL;
-    }
-    return r;
-}
-
-int Player_draw_(STPlayer* obj){
-    int r = 0, drawn = 0;
-    STFramebuffDrawRect* rects = NULL;
-    int rectsSz = 0, rectsUse = 0;
-    //
-    struct timeval start;
-    gettimeofday(&start, NULL);
-    //precalculate drawing rects
-    if(0 == Player_drawGetRects_(obj, rects, rectsSz, &rectsUse)){
-        K_LOG_VERBOSE("Player, drawing nothing-to-draw.\n");
-    } else {
-        //resize rects array
-        if(rectsUse > 0){
-            rects = malloc(sizeof(STFramebuffDrawRect) * rectsUse);
-            if(rects == NULL){
-                K_LOG_INFO("Player, draw, recs[%d] culd not be allocated.\n", rectsUse);
-                r = -1;
+            if(isFileFd && fileFd < 0){
+                K_LOG_ERROR("Player, streamAdd, file is required to add: '%s'.\n", resPath);
             } else {
-                rectsSz = rectsUse;
-                rectsUse = 0;
-                if(0 != Player_drawGetRects_(obj, rects, rectsSz, &rectsUse)){
-                    K_LOG_INFO("Player, draw, failed recs[%d].\n", rectsSz);
-                } else {
-                    //-------
-                    //draw rects unplaned (unoptimized)
-                    //-------
-                    switch(obj->cfg.drawMode){
-                        case ENPlayerDrawMode_Src:
-                            //-------
-                            //draw rects unplaned
-                            //-------
-                            if(0 != Player_drawRectsUnplaned_(obj, rects, rectsUse)){
-                                K_LOG_INFO("Player, draw, failed draw rects[%d].\n", rectsUse);
-                            } else {
-                                K_LOG_VERBOSE("Player, drawn rects[%d].\n", rectsSz);
-                                drawn = 1;
-                            }
-                            break;
-                        default: //ENPlayerDrawMode_Dst
-                            //-------
-                            //draw lines planed (optimized)
-                            //-------
-                            {
-                                int linesSz = 0;
-                                //count-lines
-                                int i; for(i = 0 ; i < rectsUse; i++){
-                                    STFramebuffDrawRect* rect = &rects[i];
-                                    if(rect->srcRectY < rect->srcRectYAfterEnd){
-                                        linesSz += (rect->srcRectYAfterEnd - rect->srcRectY);
+                //add only once, trying every known dstPixFmt (will be validated in the open method).
+                int lastPixFmt = 0, fmtsCount = 0, streamAdded = 0;
+                int i; for(i = 0; i < obj->fbs.grps.use; i++){
+                    STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
+                    if(!grp->isClosed && lastPixFmt != grp->pixFmt){
+                        STStreamContext* streamF = NULL;
+                        //find already added matching stream
+                        {
+                            int i; for(i = 0; i < obj->streams.arrUse; i++){
+                                STStreamContext* s = obj->streams.arr[i];
+                                if(s != NULL){
+                                    if(0 == StreamContext_isSame(s, device, server, port, resPath, srcPixFmt, grp->pixFmt)){
+                                        streamF = s;
+                                        break;
                                     }
                                 }
-                                if(linesSz > 0){
-                                    STFramebuffDrawLine* lines = (STFramebuffDrawLine*)malloc(sizeof(STFramebuffDrawLine) * linesSz);
-                                    if(lines == NULL){
-                                        K_LOG_INFO("Player, draw, lines[%d] culd not be allocated.\n", linesSz);
-                                        r = -1;
-                                    } else {
-                                        int linesUse = 0;
-                                        memset(lines, 0, sizeof(STFramebuffDrawLine) * linesSz);
-                                        if(0 != Player_drawGetLines_(obj, rects, rectsUse, lines, linesSz, &linesUse)){
-                                            K_LOG_INFO("Player, draw, failed get lines[%d / %d].\n", linesUse, linesSz);
-                                        } else if(0 != Player_drawLinesPlaned_(obj, lines, linesUse)){
-                                            K_LOG_INFO("Player, draw, failed draw lines[%d / %d].\n", linesUse, linesSz);
-                                        } else {
-                                            K_LOG_VERBOSE("Player, drawn rects[%d] lines[%d].\n", rectsSz, linesSz);
-                                            drawn = 1;
-                                        }
-                                        //
-                                        free(lines);
-                                        lines = NULL;
-                                    }
+                            }
+                        }
+                        //
+                        if(streamF != NULL){
+                            //add existing stream
+                            if(0 != FramebuffsGrp_addStream(grp, streamF)){
+                                K_LOG_ERROR("Player, streamAdd, FramebuffsGrp_addStream failed for existing stream.\n");
+                            } else {
+                                K_LOG_VERBOSE("Player, streamAdd, Player_streamAdd existing stream added: '%s'.\n", resPath);
+                                streamAdded++;
+                                r = 0;
+                            }
+                        } else {
+                            //open new stream
+                            STStreamContext* streamN = malloc(sizeof(STStreamContext));
+                            StreamContext_init(streamN);
+                            streamN->frames.reusable.slabs = &obj->slabs; //payload buffers shared by streams
+                            if(0 != StreamContext_open(streamN, obj, device, server, port, keepAlive, resPath, srcPixFmt, 2, 1, (1024 * 1024 * 1), grp->pixFmt, connTimeoutSecs, decoderTimeoutSecs, framesSkip, framesFeedMax)){
+                                //do not print.
+                            } else if(0 != StreamContext_park(streamN, obj)){
+                                K_LOG_ERROR("Player, streamAdd, StreamContext_park failed after StreamContext_open: '%s'.\n", resPath);
+                            } else {
+                                //add new buffer
+                                if(0 != FramebuffsGrp_addStream(grp, streamN)){
+                                    K_LOG_ERROR("Player, streamAdd, FramebuffsGrp_addStream failed for new stream.\n");
+                                } else {
+                                    K_LOG_VERBOSE("Player, streamAdd, Player_streamAdd device opened, closed and added: '%s'.\n", resPath);
+                                    streamN->cfg.netProto = netProto;
+                                    streamN->cfg.maxLatencyMs = maxLatencyMs;
+                                    streamN->cfg.gopCacheBytes = (gopCacheKB * 1024);
+                                    streamN->cfg.fileFps = fileFps;
+                                    streamN->streamId = ++obj->streamIdNext;
+                                    obj->streams.arr[obj->streams.arrUse] = streamN; streamN = NULL; //consume
+                                    obj->streams.arrUse++;
+                                    streamAdded++;
+                                    r = 0;
                                 }
                             }
-                            break;
+                            //release (if not consumed)
+                            if(streamN != NULL){
+                                StreamContext_release(streamN);
+                                free(streamN);
+                                streamN = NULL;
+                            }
+                        }
+                        //
+                        lastPixFmt = grp->pixFmt;
+                        fmtsCount++;
+                    }
+                }
+                //
+                if(!streamAdded){
+                    if(fmtsCount == 0){
+                        K_LOG_INFO("Player_streamAdd, no open fbGrp to add stream, for '%s'.\n", fmtsCount, resPath);
+                    } else {
+                        K_LOG_INFO("Player_streamAdd, could not add to device supporting the dstPixFmt (%d fmts found) for '%s'.\n", fmtsCount, resPath);
+                    }
+                    r = -1;
+                } else {
+                    if(0 != Player_organize(obj)){
+                        K_LOG_ERROR("Player, streamAdd, Player_organize failed after new stream.\n");
                     }
                 }
             }
+            //release
+            if(fileFd > 0){
+                close(fileFd);
+                fileFd = -1;
+            }
         }
     }
-    //add stats
-    if(r == 0 && drawn){
-        struct timeval end; long ms;
-        gettimeofday(&end, NULL);
-        ms = msBetweenTimevals(&start, &end);
-        if(ms >= 0){
-            pthread_mutex_lock(&obj->stats.mutex);
-            {
-                if(obj->stats.curSec.draw.count == 0){
-                    obj->stats.curSec.draw.msMin = ms;
-                    obj->stats.curSec.draw.msMax = ms;
-                } else {
-                    if(obj->stats.curSec.draw.msMin > ms) obj->stats.curSec.draw.msMin = ms;
-                    if(obj->stats.curSec.draw.msMax < ms) obj->stats.curSec.draw.msMax = ms;
-                }
-                obj->stats.curSec.draw.msSum += ms;
-                obj->stats.curSec.draw.count++;
+    //
+    return r;
+}
+
+int Player_streamRemove(STPlayer* obj, STStreamContext* stream){
+    int r = -1;
+    //search
+    int i; for(i = 0; i < obj->streams.arrUse; i++){
+        if(stream == obj->streams.arr[i]){
+            //remove
+            obj->streams.arrUse--;
+            for(;i < obj->streams.arrUse; i++){
+                obj->streams.arr[i] = obj->streams.arr[i + 1];
             }
-            pthread_mutex_unlock(&obj->stats.mutex);
+            //wait for posted reads into the stream's buffer
+            if(0 != Player_uringCancel_(obj, ENPlayerPollFdType_Count, stream, -1, 1)){
+                K_LOG_ERROR("Player_streamRemove, uring cancel failed.\n");
+            }
+            //connect attempts are polled with their own objPtr
+            StreamContext_netAttemptsClose_(stream, obj);
+            StreamContext_release(stream);
+            free(stream);
+            r = 0;
+            //reorganize
+            if(0 != Player_organize(obj)){
+                K_LOG_ERROR("Player_organize failed after stream removal.\n");
+            }
+            break;
         }
     }
-    //release
-    {
-        if(rects != NULL){
-            free(rects);
-            rects = NULL;
+    return r;
+}
+
+//organize
+//Assigns fb and screen-area to each stream. Should be called on each stream resize event.
+int Player_organize(STPlayer* obj){
+    int r = 0;
+    int i; for(i = 0 ; i < obj->fbs.grps.use; i++){
+        STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
+        if(0 != FramebuffsGrp_layoutStart(grp)){
+            K_LOG_ERROR("FramebuffsGrp_layoutStart failed.\n");
+        } else {
+            int j; for(j = 0; j < grp->streams.use; j++){
+                STStreamContext* s = grp->streams.arr[j];
+                if(s->drawPlan.lastPixelformat == grp->pixFmt){
+                    STFbSize sz;
+                    memset(&sz, 0, sizeof(sz));
+                    sz.width = s->drawPlan.lastCompRect.width;
+                    sz.height = s->drawPlan.lastCompRect.height;
+                    if(0 != FramebuffsGrp_layoutAdd(grp, s->streamId, sz)){
+                        K_LOG_ERROR("FramebuffsGrp_layoutAdd failed.\n");
+                    }
+                }
+            }
+            //
+            if(0 != FramebuffsGrp_layoutEnd(grp)){
+                K_LOG_ERROR("FramebuffsGrp_layoutEnd failed.\n");
+            }
         }
-        rectsSz = rectsUse = 0;
     }
     return r;
 }
 
-//-------------------
-//-- StreamContext --
-//-------------------
 
-void StreamContext_init(STStreamContext* ctx){
-    memset(ctx, 0, sizeof(STStreamContext));
-    //buff
-    {
-        ctx->buff.buffUse   = 0;
-        ctx->buff.buffSz    = (1024 * 64);
-        ctx->buff.buff      = (unsigned char*)malloc(ctx->buff.buffSz);
-    }
-    //file
-    {
-        ctx->file.fd = -1;
-    }
-    //net
+int Player_draw__(STPlayer* obj, STFramebuffDrawRect* rects, int rectsSz, int* dstRectsUse, int* dstLinesReq);
+int Player_draw_(STPlayer* obj);
+
+int Player_tick(STPlayer* obj, int ms){
+    int r = 0;
+    //
+    obj->anim.tickSeq++;
+    //fbs
     {
-        //
-    }
-    //dec (decoder)
-    {
-        ctx->dec.fd = -1;
-        //src
+        int hitsCountOnceAnimEnd = 0, hitsCountOnceDrawEnd = 0;
+        //reset draw plan hits and decrease peekers time
         {
-            Buffers_init(&ctx->dec.src);
+            int i; for(i = 0; i < obj->streams.arrUse; i++){
+                STStreamContext* s = obj->streams.arr[i];
+                s->drawPlan.hitsCount = 0;
+                //peeking image-size/stream-props (allowing decoder)
+                {
+                    if(s->drawPlan.lastCompRect.width > 0 && s->drawPlan.lastCompRect.height > 0){
+                        if(s->drawPlan.peekRemainMs > 0){
+                            //peek completed (image-size determinated)
+                            s->drawPlan.peekRemainMs = 0;
+                        }
+                    } else {
+                        s->drawPlan.peekRemainMs -= (s->drawPlan.peekRemainMs <= ms ? s->drawPlan.peekRemainMs : ms);
+                    }
+                }
+            }
         }
-        //dst
+        //animate fbs
         {
-            Buffers_init(&ctx->dec.dst);
+            const int doDrawPlanIfAnimating = 1;
+            int i; for(i = 0 ; i < obj->fbs.grps.use; i++){
+                STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
+                if(0 != FramebuffsGrp_layoutAnimTick(grp, ms, obj, (1000 * obj->cfg.animPreRenderSecs), doDrawPlanIfAnimating)){
+                    K_LOG_ERROR("Player, FramebuffsGrp_layoutAnimTick failed.\n");
+                }
+            }
         }
-        //frames
+        //count draw plan hits for animations final stage
         {
-            //
-        }
-    }
-    //frames
-    {
-        VideoFrames_init(&ctx->frames.filled);      //filled with payload
-        VideoFrames_init(&ctx->frames.reusable);    //for reutilization
-    }
-}
-
-void StreamContext_release(STStreamContext* ctx){
-    //buff
-    {
-        if(ctx->buff.buff != NULL){
-            free(ctx->buff.buff);
-            ctx->buff.buff = NULL;
+            int i; for(i = 0; i < obj->streams.arrUse; i++){
+                const STStreamContext* s = obj->streams.arr[i];
+                if(s->drawPlan.hitsCount > 0){
+                    hitsCountOnceAnimEnd++;
+                }
+            }
         }
-        ctx->buff.buffSz = 0;
-    }
-    //file
-    {
-        if(ctx->file.fd >= 0){
-            close(ctx->file.fd);
-            ctx->file.fd = -1;
+        //draw
+        if(0 != Player_draw_(obj)){
+            K_LOG_INFO("Player, anim-draw fail.\n");
         }
-    }
-    //net
-    {
-        if(ctx->net.hostResolver != NULL){
-            if(0 != gai_cancel(ctx->net.hostResolver)){
-                //error
+        //count draw plan hits after final draw
+        {
+            int i; for(i = 0; i < obj->streams.arrUse; i++){
+                const STStreamContext* s = obj->streams.arr[i];
+                if(s->drawPlan.hitsCount > 0){
+                    hitsCountOnceDrawEnd++;
+                }
             }
-            //ToDo: how to cleanup?
-            //if(ctx->net.hostResolver->ar_result != NULL){
-            //    freeaddrinfo(ctx->net.hostResolver->ar_result);
-            //}
-            free(ctx->net.hostResolver);
-            ctx->net.hostResolver = NULL;
-        }
-        if(ctx->net.socket){
-            close(ctx->net.socket);
-            ctx->net.socket = 0;
         }
-        //req
+        //activate peeking
         {
-            if(ctx->net.req.pay != NULL){
-                free(ctx->net.req.pay);
-                ctx->net.req.pay = NULL;
+            int decodersToBeOpenCount = 0;
+            //Reset decoders flags and count decoders already open
+            {
+                int i; for(i = 0; i < obj->streams.arrUse; i++){
+                    STStreamContext* s = obj->streams.arr[i];
+                    s->dec.shouldBeOpen = 0;
+                    if(s->dec.fd >= 0){
+                        decodersToBeOpenCount++;
+                        s->dec.shouldBeOpen = STREAM_CONTEXT_DECODER_SHOULD_BE_OPEN(s);
+                    }
+                }
+            }
+            //Activate new decoders that are necesary for rendering
+            {
+                int i; for(i = 0; i < obj->streams.arrUse; i++){
+                    STStreamContext* s = obj->streams.arr[i];
+                    if(s->dec.fd < 0 && !s->dec.shouldBeOpen && decodersToBeOpenCount < obj->cfg.decodersMax && STREAM_CONTEXT_DECODER_SHOULD_BE_OPEN(s) && s->drawPlan.hitsCount > 0){
+                        s->dec.shouldBeOpen = 1;
+                        decodersToBeOpenCount++;
+                    }
+                }
+            }
+            //Activate new decoders that are already flagged for peeking
+            {
+                int i; for(i = 0; i < obj->streams.arrUse; i++){
+                    STStreamContext* s = obj->streams.arr[i];
+                    if(s->dec.fd < 0 && !s->dec.shouldBeOpen && decodersToBeOpenCount < obj->cfg.decodersMax && STREAM_CONTEXT_DECODER_SHOULD_BE_OPEN(s) && s->drawPlan.peekRemainMs > 0){
+                        s->dec.shouldBeOpen = 1;
+                        decodersToBeOpenCount++;
+                    }
+                }
+            }
+            //Activate new decoders that can be flagged as new peekkers
+            if(obj->cfg.decodersToPeekSecs > 0){
+                int evalsInSeq = 0;
+                while(evalsInSeq < obj->streams.arrUse && decodersToBeOpenCount < obj->cfg.decodersMax) {
+                    //eval
+                    const int iStream = (obj->peek.iNextStreamEval % obj->streams.arrUse);
+                    STStreamContext* s = obj->streams.arr[iStream];
+                    if(
+                       s->drawPlan.lastCompRect.width <= 0 || s->drawPlan.lastCompRect.height <= 0 //image-size not determined yet
+                       && s->frames.filled.use > 0 //frame(s) available to decode
+                       && s->drawPlan.peekRemainMs <= 0 //not currently peeking
+                       //
+                       && s->dec.fd < 0 //no decoder
+                       && !s->dec.shouldBeOpen //not flagged to open yet
+                       )
+                    {
+                        s->drawPlan.peekRemainMs = (1000 * obj->cfg.decodersToPeekSecs);
+                        //allow new peeker
+                        if(STREAM_CONTEXT_DECODER_SHOULD_BE_OPEN(s)){ //just in case (valdate again)
+                            s->dec.shouldBeOpen = 1;
+                            decodersToBeOpenCount++;
+                            evalsInSeq = 0; //restart cycle
+                        }
+                    }
+                    //next
+                    obj->peek.iNextStreamEval = (obj->peek.iNextStreamEval + 1) % obj->streams.arrUse;
+                    evalsInSeq++;
+                }
             }
-            ctx->net.req.payUse = 0;
-            ctx->net.req.paySz = 0;
         }
+        K_LOG_VERBOSE("Player, draw, active streams: +%d by animation, +%d (of %d) by final-draw.\n", hitsCountOnceAnimEnd, (hitsCountOnceDrawEnd - hitsCountOnceAnimEnd), obj->streams.arrUse);
     }
-    //frames
+    //streams
     {
-        //currently filling
-        if(ctx->frames.filling != NULL){
-            VideoFrame_release(ctx->frames.filling);
-            free(ctx->frames.filling);
-            ctx->frames.filling = NULL;
+        int i; for(i = (int)obj->streams.arrUse - 1; i >= 0; i--){
+            STStreamContext* ctx = obj->streams.arr[i];
+            StreamContext_tick(ctx, obj, ms);
         }
-        VideoFrames_release(&ctx->frames.filled);      //filled with payload
-        VideoFrames_release(&ctx->frames.reusable);    //for reutilization
     }
-    //dec (decoder)
+    obj->msRunning += ms;
+    //netPools (expire idle warm connections)
     {
-        if(ctx->dec.fd >= 0){
-            if(0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.dst, ctx->dec.fd)){
-                K_LOG_WARN("StreamContext_stopAndCleanupBuffs(dst) failed.\n");
-            }
-            if(0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.src, ctx->dec.fd)){
-                K_LOG_WARN("StreamContext_stopAndCleanupBuffs(src) failed.\n");
-            }
-            if(0 != StreamContext_eventsUnsubscribe(ctx, ctx->dec.fd)){
-                K_LOG_ERROR("StreamContext, unsubscribe failed.\n");
+        const unsigned long long msIdleMax = (unsigned long long)obj->cfg.netPoolIdleSecs * 1000ULL;
+        int i; for(i = 0; i < obj->netPools.use; i++){
+            STNetPool* pool = obj->netPools.arr[i];
+            int j; for(j = (int)pool->conns.use - 1; j >= 0; j--){
+                STNetPoolConn* conn = pool->conns.arr[j];
+                if((obj->msRunning - conn->msStarted) >= msIdleMax){
+                    K_LOG_VERBOSE("Player, netPool, warm conn expired: '%s:%d'.\n", pool->server, pool->port);
+                    Player_netPoolConnRemove_(obj, pool, conn, 1);
+                }
             }
-            v4l2_close(ctx->dec.fd);
-            ctx->dec.fd = -1;
-        }
-        Buffers_release(&ctx->dec.src);
-        Buffers_release(&ctx->dec.dst);
-        //frames
-        {
-            VideoFrameStates_release(&ctx->dec.frames.fed);
         }
     }
-    //cfg
-    {
-        if(ctx->cfg.device != NULL){ free(ctx->cfg.device); ctx->cfg.device = NULL; }
-        if(ctx->cfg.server != NULL){ free(ctx->cfg.server); ctx->cfg.server = NULL; }
-        if(ctx->cfg.path != NULL){ free(ctx->cfg.path); ctx->cfg.path = NULL; }
-    }
+    return r;
 }
 
-int StreamContext_concatHttpRequest(STStreamContext* ctx, char* dst, const int dstSz){
-    int r = 0;
-    //line-0
-    {
-        const char* str = "GET ";
-        const int len = strlen(str);
-        if(dst != NULL && (r + len) <= dstSz){
-            memcpy(&dst[r], str, len);
-        }
-        r += len;
-    }
+int Player_getMsToNextTick(STPlayer* obj, const int msPerTick){
+    const int msPerTick2 = (msPerTick <= 0 ? 1 : msPerTick);
+    int isActive = 0; unsigned long msToNext = 0, msToNextFnd = 0;
+    //streams
     {
-        const char* str = ctx->cfg.path;
-        const int len = strlen(str);
-        if(dst != NULL && (r + len) <= dstSz){
-            memcpy(&dst[r], str, len);
+        int i; for(i = 0; i < obj->streams.arrUse && !isActive; i++){
+            const STStreamContext* s = obj->streams.arr[i];
+            if(
+               s->dec.fd >= 0 //decoder open (draw, decoder-timeout)
+               || s->file.fd > 0 //file open (read-blocking, conn-timeout)
+               || s->net.socket > 0 || s->net.isResolving || s->net.he.use > 0 //connecting or connected (resolver polling, happy-eyeballs, conn-timeout)
+               || s->frames.filled.use > 0 //frames to feed or peek
+               || s->drawPlan.peekRemainMs > 0 //peeking
+               || (s->flushing.isActive && !s->flushing.isCompleted)
+               || (s->shuttingDown.isActive && !s->shuttingDown.isCompleted)
+               )
+            {
+                isActive = 1;
+            } else {
+                //decoder reopen
+                if(s->dec.shouldBeOpen){
+                    if(!msToNextFnd || msToNext > s->dec.msToReopen){
+                        msToNext = s->dec.msToReopen;
+                        msToNextFnd = 1;
+                    }
+                }
+                //file reconnect
+                if((s->cfg.server == NULL || s->cfg.server[0] == '\0') && s->cfg.port <= 0 && s->cfg.path != NULL && s->cfg.path[0] != '\0'){
+                    if(!msToNextFnd || msToNext > s->file.msToReconnect){
+                        msToNext = s->file.msToReconnect;
+                        msToNextFnd = 1;
+                    }
+                }
+                //net reconnect
+                if(s->cfg.server != NULL && s->cfg.server[0] != '\0' && s->cfg.port > 0 && (s->cfg.keepAlive || s->dec.shouldBeOpen)){
+                    if(!msToNextFnd || msToNext > s->net.msToReconnect){
+                        msToNext = s->net.msToReconnect;
+                        msToNextFnd = 1;
+                    }
+                }
+            }
         }
-        r += len;
     }
+    //netPools (warm connections expiration)
     {
-        const char* str = " HTTP/1.1\r\n";
-        const int len = strlen(str);
-        if(dst != NULL && (r + len) <= dstSz){
-            memcpy(&dst[r], str, len);
+        const unsigned long long msIdleMax = (unsigned long long)obj->cfg.netPoolIdleSecs * 1000ULL;
+        int i; for(i = 0; i < obj->netPools.use && !isActive; i++){
+            const STNetPool* pool = obj->netPools.arr[i];
+            int j; for(j = 0; j < pool->conns.use; j++){
+                const unsigned long long msIdle = (obj->msRunning - pool->conns.arr[j]->msStarted);
+                const unsigned long msToExpire = (unsigned long)(msIdle >= msIdleMax ? 0 : msIdleMax - msIdle);
+                if(!msToNextFnd || msToNext > msToExpire){
+                    msToNext = msToExpire;
+                    msToNextFnd = 1;
+                }
+            }
         }
-        r += len;
     }
-    //line-1
+    //fbs layout animation (including the pre-render window)
     {
-        const char* str = "Host: ";
-        const int len = strlen(str);
-        if(dst != NULL && (r + len) <= dstSz){
-            memcpy(&dst[r], str, len);
+        const unsigned long msPreRender = (1000 * obj->cfg.animPreRenderSecs);
+        int i; for(i = 0 ; i < obj->fbs.grps.use && !isActive; i++){
+            const STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
+            if(grp->layout.anim.msWait <= msPreRender){
+                isActive = 1;
+            } else if(!msToNextFnd || msToNext > (grp->layout.anim.msWait - msPreRender)){
+                msToNext = (grp->layout.anim.msWait - msPreRender);
+                msToNextFnd = 1;
+            }
         }
-        r += len;
     }
-    {
-        const char* str = ctx->cfg.server;
-        const int len = strlen(str);
-        if(dst != NULL && (r + len) <= dstSz){
-            memcpy(&dst[r], str, len);
-        }
-        r += len;
+    //result (aligned to ticks)
+    if(isActive || !msToNextFnd || msToNext <= msPerTick2){
+        return msPerTick2;
     }
+    return (int)((msToNext / msPerTick2) * msPerTick2);
+}
+
+int Player_drawGetRects_(STPlayer* obj, STFramebuffDrawRect* rects, int rectsSz, int* dstRectsUse){
+    int r = 0;
+    //fbs
     {
-        const char* str = "\r\n";
-        const int len = strlen(str);
-        if(dst != NULL && (r + len) <= dstSz){
-            memcpy(&dst[r], str, len);
+        int i; for(i = 0 ; i < obj->fbs.grps.use; i++){
+            STFramebuffsGrp* grp = &obj->fbs.grps.arr[i];
+            if(0 != FramebuffsGrp_drawGetRects(grp, obj, grp->layout.anim.yOffset, rects, rectsSz, dstRectsUse)){
+                //do not stop, continue processing, 'dstRectsUse' could be updated by next calls.
+                r = -1;
+            }
         }
-        r += len;
-    }
-    //line-2
-    {
-        const char* str = "\r\n";
-        const int len = strlen(str);
-        if(dst != NULL && (r + len) <= dstSz){
-            memcpy(&dst[r], str, len);
-        }
-        r += len;
     }
     return r;
 }
 
-int StreamContext_getMinBuffersForDst(STStreamContext* ctx, int* dstValue){
-    struct v4l2_control ctrl;
-    memset(&ctrl, 0, sizeof(ctrl));
-    ctrl.id = V4L2_CID_MIN_BUFFERS_FOR_CAPTURE;
-    const int rr2 = v4l2_ioctl(ctx->dec.fd, VIDIOC_G_CTRL, &ctrl);
-    if(rr2 == 0){
-        if(dstValue != NULL){
-            *dstValue = ctrl.value;
-        }
-    } else {
-        const STErrCode* err = _getErrCode(errno);
-        if(err == NULL){
-            K_LOG_ERROR("VIDIOC_G_CTRL, V4L2_CID_MIN_BUFFERS_FOR_CAPTURE, returned errno(%d).\n", errno);
-        } else {
-            K_LOG_ERROR("VIDIOC_G_CTRL, V4L2_CID_MIN_BUFFERS_FOR_CAPTURE, returned '%s'.\n", err->str);
+int Player_drawGetLines_(STPlayer* obj, STFramebuffDrawRect* rects, const int rectsUse, STFramebuffDrawLine* lines, const int linesSz, int* dstLinesUse){
+    int r = 0;
+    //build draw plan (lines per row)
+    STFramebuff* rowStartFb = NULL;
+    int i, iRow = -1, rowStartRectIdx = 0, rowRectsCount = 0;
+    for(i = 0; i < rectsUse; i++){
+        STFramebuffDrawRect* rect = &rects[i];
+        if(rowStartFb != rect->fb || iRow != rect->iRow){
+            if(rowRectsCount > 0){
+                if(0 != Framebuff_drawRowsBuildPlan(rowStartFb, &rowStartFb->screen, &rects[rowStartRectIdx], rowRectsCount, lines, linesSz, dstLinesUse)){
+                    r = -1;
+                }
+            }
+            rowStartFb = rect->fb;
+            iRow = rect->iRow;
+            rowStartRectIdx = i;
+            rowRectsCount = 0;
         }
+        //add to row
+        rowRectsCount++;
     }
-    return rr2;
-}
-
-int StreamContext_initAndPrepareSrc(STStreamContext* ctx, int fd, const int buffersAmmount, const int print){
-    int r = -1;
-    //should be stopped
-    if(0 != Buffers_allocBuffs(&ctx->dec.src, fd, buffersAmmount, print)){
-        K_LOG_ERROR("StreamContext, Buffers_allocBuffs(%d) failed.\n", buffersAmmount);
-    } else if(ctx->dec.src.sz <= 0){
-        K_LOG_ERROR("StreamContext, Buffers_allocBuffs(%d) created zero buffs.\n", buffersAmmount);
-    //} else if(0 != Buffers_export(&ctx->dec.src, fd)){
-    //    K_LOG_ERROR("StreamContext, Buffers_export(%d) failed.\n", ctx->dec.src.sz);
-    } else if(0 != Buffers_mmap(&ctx->dec.src, fd)){
-        K_LOG_ERROR("StreamContext, Buffers_mmap(%d) failed.\n", ctx->dec.src.sz);
-    } else {
-        //if(ctx->dec.src.sz == buffersAmmount){
-        //    K_LOG_INFO("StreamContext, inited device with %d buffers.\n", buffersAmmount);
-        //} else {
-        //    K_LOG_INFO("StreamContext, inited device with %d of %d buffers.\n", ctx->dec.src.sz, buffersAmmount);
-        //}
-        ctx->dec.isWaitingForIDRFrame = 1;
-        r = 0;
-    }
-    return r;
-}
-
-int StreamContext_initAndStartDst(STStreamContext* ctx, struct STPlayer_* plyr){
-    int r = -1;
-    STPrintedInfo* printDstFmt = Player_getPrintIfNotRecent(plyr, ctx->cfg.device, ctx->cfg.srcPixFmt, ctx->cfg.dstPixFmt, K_DEF_REPRINTS_HIDE_SECS);
-    if(printDstFmt != NULL){ PrintedInfo_touch(printDstFmt); }
-    ctx->dec.dst.enqueuedRequiredMin = 0;
-    if(0 != Buffers_setFmt(&ctx->dec.dst, ctx->dec.fd, ctx->cfg.dstPixFmt, 1, 0, 1 /*getCompositionRect*/, (printDstFmt != NULL ? 1 : 0))){
-        K_LOG_ERROR("Buffers_setFmt(dst) failed: '%s'.\n", ctx->cfg.device);
-    } else if(0 != StreamContext_getMinBuffersForDst(ctx, &ctx->dec.dst.enqueuedRequiredMin)){
-        K_LOG_ERROR("StreamContext_getMinBuffersForDst(dst) failed: '%s'.\n", ctx->cfg.device);
-    } else if(ctx->dec.dst.enqueuedRequiredMin <= 0){
-        K_LOG_ERROR("StreamContext_getMinBuffersForDst(dst) returned(%d): '%s'.\n", ctx->dec.dst.enqueuedRequiredMin, ctx->cfg.device);
-    } else if(0 != Buffers_allocBuffs(&ctx->dec.dst, ctx->dec.fd, ctx->dec.dst.enqueuedRequiredMin /*+ 1*/, (printDstFmt != NULL ? 1 : 0))){ //+1 to keep a copy for rendering
-        K_LOG_ERROR("Buffers_allocBuffs(%d, dst) failed: '%s'.\n", (ctx->dec.dst.enqueuedRequiredMin /*+ 1*/), ctx->cfg.device);
-    } else if(ctx->dec.dst.sz <= 0){
-        K_LOG_ERROR("Buffers_allocBuffs(%d, dst) created zero buffers: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
-    } else if(ctx->dec.dst.sz < ctx->dec.dst.enqueuedRequiredMin){
-        K_LOG_ERROR("Buffers_allocBuffs(%d, dst) created below minimun(%d) buffers: '%s'.\n", ctx->dec.dst.sz, ctx->dec.dst.enqueuedRequiredMin, ctx->cfg.device);
-    //} else if(0 != Buffers_export(&ctx->dec.dst, ctx->dec.fd)){
-    //    K_LOG_ERROR("Buffers_export(%d, dst) failed: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
-    } else if(0 != Buffers_mmap(&ctx->dec.dst, ctx->dec.fd)){
-        K_LOG_ERROR("Buffers_mmap(%d, dst) failed: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
-    } else if(0 != Buffers_enqueueMinimun(&ctx->dec.dst, ctx->dec.fd, ctx->dec.dst.enqueuedRequiredMin)){
-        K_LOG_ERROR("Buffers_enqueueMinimun(%d / %d, dst) failed: '%s'.\n", ctx->dec.dst.enqueuedRequiredMin, ctx->dec.dst.sz, ctx->cfg.device);
-    } else if(0 != Buffers_start(&ctx->dec.dst, ctx->dec.fd)){
-        K_LOG_ERROR("Buffers_start(%d, dst) failed: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
-    } else {
-        if(ctx->dec.dst.sz != (ctx->dec.dst.enqueuedRequiredMin /*+ 1*/)){
-            K_LOG_INFO("StreamContext, dst-started (%d/%d buffers): '%s'.\n", ctx->dec.dst.sz, (ctx->dec.dst.enqueuedRequiredMin /*+ 1*/), ctx->cfg.device);
-        } else {
-            K_LOG_VERBOSE("StreamContext, dst-started (%d buffers): '%s'.\n", (ctx->dec.dst.enqueuedRequiredMin /*+ 1*/), ctx->cfg.device);
-        }
-        //if(ctx->dec.dst.sz == ctx->dec.dst.enqueuedRequiredMin){
-        //    K_LOG_WARN("attempt to allocate one extra buffer failed, this implies an extra memcopy() per decoded-frame: '%s'.\n", ctx->cfg.device);
-        //}
-        r = 0;
-        //
-        ctx->drawPlan.lastPixelformat = ctx->dec.dst.pixelformat;
-        if(ctx->dec.dst.composition.width > 0 && ctx->dec.dst.composition.height > 0){
-            ctx->drawPlan.lastCompRect = ctx->dec.dst.composition;
-        }
-        //update poll (dst started)
-        StreamContext_updatePollMask_(ctx, plyr);
-        //reorganize
-        if(0 != Player_organize(plyr)){
-            K_LOG_ERROR("Player_organize failed after dst-resized.\n");
+    //flush last row
+    if(rowRectsCount > 0){
+        if(0 != Framebuff_drawRowsBuildPlan(rowStartFb, &rowStartFb->screen, &rects[rowStartRectIdx], rowRectsCount, lines, linesSz, dstLinesUse)){
+            r = -1;
         }
     }
     return r;
 }
 
-int StreamContext_stopAndCleanupBuffs(STStreamContext* ctx, STBuffers* buffs, int fd){
-    int r = -1;
-    //IMPORTANT NOTE: if device exposed 'V4L2_BUF_CAP_SUPPORTS_ORPHANED_BUFS' capability
-    //, the buffer is not released untill is unmaped and closed.
-    //
-    if(fd >= 0){
-        if(0 != Buffers_stop(buffs, fd)){
-            K_LOG_ERROR("Buffers_stop(dst) failed: '%s'.\n", ctx->cfg.device);
-        }
-        //
-        if(0 != Buffers_allocBuffs(buffs, fd, 0, 0)){
-            K_LOG_ERROR("Buffers_allocBuffs(dst, 0) failed: '%s'.\n", ctx->cfg.device);
-        } else {
-            r = 0;
-        }
-    }
-    return r;
-}
+//---------------------
+//-- Unplaned drawing
+//---------------------
+//Draws the rects in order. This means the src and dst memory area will jump.
 
-//
+//STPlayerDrawRectsUnplanedTask
+typedef struct STPlayerDrawRectsUnplanedTask_ {
+    STPlayer*               dst;    //for the mutex
+    STFramebuffDrawRect*    rects;
+    int                     rectsSz;
+} STPlayerDrawRectsUnplanedTask;
 
-int StreamContext_eventsSubscribe(STStreamContext* ctx, int fd){
-    //V4L2_EVENT_RESOLUTION_CHANGE == V4L2_EVENT_SOURCE_CHANGE
-    //V4L2_EVENT_SOURCE_CHANGE (event with changes set to V4L2_EVENT_SRC_CH_RESOLUTION)
+void Player_drawRectsUnplanedTaskFunc_(void* param){
+    STPlayerDrawRectsUnplanedTask* t = (STPlayerDrawRectsUnplanedTask*)param;
+    //draw
     {
-        struct v4l2_event_subscription sub;
-        memset(&sub, 0, sizeof(sub));
-        //
-        sub.type = V4L2_EVENT_SOURCE_CHANGE;
-        //
-        int rr; CALL_IOCTL(rr, v4l2_ioctl(fd, VIDIOC_SUBSCRIBE_EVENT, &sub));
-        if(rr != 0){
-            K_LOG_ERROR("StreamContext, Subscription to event V4L2_EVENT_SOURCE_CHANGE errno(%d).\n", errno);
-            return -1;
-        } else {
-            K_LOG_VERBOSE("StreamContext, Subscription to event V4L2_EVENT_SOURCE_CHANGE success.\n");
+        int i; for(i = 0; i < t->rectsSz; i++){
+            STFramebuffDrawRect* rect = &t->rects[i];
+            if(rect->fb != NULL){
+                STFramebuffPtr* dst = &rect->fb->screen;
+                if(rect->plane == NULL){
+                    //black rect
+                    if(rect->fb->blackLine != NULL){
+                        int yDst = rect->posCur.y;
+                        int ySrc = rect->srcRectY;
+                        const int bytesPerPx = (rect->fb->bitsPerPx / 8);
+                        const int copyLen = bytesPerPx * rect->srcRectWidth; //ToDo: validate srcWidth <= blackLineSz
+                        while(ySrc < rect->srcRectYAfterEnd){
+                            unsigned char* srcLn = rect->fb->blackLine;
+                            unsigned char* dstLn = &dst->ptr[(rect->fb->bytesPerLn * yDst) + (bytesPerPx * rect->posCur.x)];
+                            K_ASSERT(dstLn >= dst->ptr && (dstLn + copyLen) <= (dst->ptr + dst->ptrSz)) //must be inside the destination range
+                            if(copyLen > 0){
+                                memcpy(dstLn, srcLn, copyLen);
+                            }
+                            ySrc++;
+                            yDst++;
+                        }
+                    }
+                } else {
+                    //image
+                    STFbRect src;
+                    memset(&src, 0, sizeof(src));
+                    src.x = rect->srcRectX;
+                    src.y = rect->srcRectY;
+                    src.width = rect->srcRectWidth;
+                    src.height = (rect->srcRectYAfterEnd - rect->srcRectY);
+                    if(0 != Framebuff_bitblit(rect->fb, dst, rect->posCur, rect->plane, src)){
+                        K_LOG_ERROR("StreamContext, bitblit failed.\n");
+                    }
+                }
+            }
         }
     }
-    //V4L2_EVENT_EOS
+    //reduce counter
     {
-        struct v4l2_event_subscription sub;
-        memset(&sub, 0, sizeof(sub));
-        //
-        sub.type = V4L2_EVENT_EOS;
-        //
-        int rr; CALL_IOCTL(rr, v4l2_ioctl(fd, VIDIOC_SUBSCRIBE_EVENT, &sub));
-        if(rr != 0){
-            K_LOG_ERROR("StreamContext, Subscription to event V4L2_EVENT_EOS errno(%d).\n", errno);
-            return -1;
-        } else {
-            K_LOG_VERBOSE("StreamContext, Subscription to event V4L2_EVENT_EOS success.\n");
+        pthread_mutex_lock(&t->dst->draw.mutex);
+        {
+            K_ASSERT(t->dst->draw.tasksPendCount > 0)
+            if(t->dst->draw.tasksPendCount > 0){
+                t->dst->draw.tasksPendCount--;
+                if(t->dst->draw.tasksPendCount == 0){ //optimization, only awake main-thread if is the last task.
+                    pthread_cond_broadcast(&t->dst->draw.cond);
+                }
+            }
         }
+        pthread_mutex_unlock(&t->dst->draw.mutex);
     }
-    return 0;
-}
-
-int StreamContext_eventsUnsubscribe(STStreamContext* ctx, int fd){
-    struct v4l2_event_subscription sub;
-    memset(&sub, 0, sizeof(sub));
-    //
-    sub.type = V4L2_EVENT_ALL;
-    //
-    int rr; CALL_IOCTL(rr, v4l2_ioctl(fd, VIDIOC_UNSUBSCRIBE_EVENT, &sub));
-    if(rr != 0){
-        K_LOG_ERROR("StreamContext, Unscubscribe failed errno(%d).\n", errno);
-        return -1;
-    } else {
-        K_LOG_VERBOSE("StreamContext, Unscubscribe success.\n");
-    }
-    return 0;
 }
 
-void StreamContext_tick(STStreamContext* ctx, struct STPlayer_* plyr, unsigned int ms){
-    //decoder
-    if(ctx->dec.fd < 0){
-        ctx->dec.msOpen = 0;
-        ctx->dec.msFirstFrameFed = 0;
-        ctx->dec.msFirstFrameOut = 0;
-        ctx->dec.framesInSinceOpen = 0;
-        ctx->dec.framesOutSinceOpen = 0;
+int Player_drawRectsUnplaned_(STPlayer* obj, STFramebuffDrawRect* rects, const int rectsUse){
+    int r = 0;
+    STPlayerDrawRectsUnplanedTask* tt = malloc(sizeof(STPlayerDrawRectsUnplanedTask) * (obj->threads.use + 1));
+    if(tt != NULL){
+        memset(tt, 0, sizeof(STPlayerDrawRectsUnplanedTask) * (obj->threads.use + 1));
         //
-        if(ctx->dec.msToReopen <= ms){
-            ctx->dec.msToReopen = 0;
-        } else {
-            ctx->dec.msToReopen -= ms;
-            //if(ctx->dec.shouldBeOpen && (ctx->dec.msToReopen / 1000) != ((ctx->dec.msToReopen + ms) / 1000)){
-            //    K_LOG_INFO("StreamContext_tick, waiting %d secs to reopen attempt: %s.\n", (ctx->dec.msToReopen / 1000), ctx->cfg.path);
-            //}
-        }
-        if(ctx->dec.shouldBeOpen){
-            //reopen
-            if(ctx->dec.msToReopen == 0){
-                //ToDo: execute this action once no src-buffer is queued or timedout src-bufer flush?
-                if(0 != StreamContext_open(ctx, plyr, ctx->cfg.device, ctx->cfg.server, ctx->cfg.port, ctx->cfg.keepAlive, ctx->cfg.path, ctx->cfg.srcPixFmt, ctx->cfg.buffersAmmount, ctx->cfg.planesPerBuffer, ctx->cfg.sizePerPlane, ctx->cfg.dstPixFmt, ctx->cfg.connTimeoutSecs, ctx->cfg.decoderTimeoutSecs, ctx->cfg.framesSkip, ctx->cfg.framesFeedMax)){
-                    K_LOG_ERROR("StreamContext, streamAdd failed: '%s' @ '%s'.\n", ctx->cfg.path, ctx->cfg.device);
-                } else {
-                    K_LOG_VERBOSE("StreamContext (%lld), tick device reopened and added to poll: '%s'.\n", (long long)ctx, ctx->cfg.path);
-                    //trigger network connection (if not keepAlive)
-                    if(!ctx->cfg.keepAlive){
-                        ctx->net.msToReconnect = 0;
-                    }
+        int iRectStart = 0, ttUse = 0, rectsPerThread = (rectsUse / (obj->threads.use + 1));
+        int i; for(i = 0; i < obj->threads.use; i++){
+            STThread* thread = &obj->threads.arr[i];
+            STPlayerDrawRectsUnplanedTask* task = &tt[ttUse];
+            //
+            task->dst   = obj;
+            task->rects = &rects[iRectStart];
+            task->rectsSz = rectsPerThread;
+            if((iRectStart + task->rectsSz) > rectsUse){
+                task->rectsSz = rectsUse - iRectStart;
+            }
+            //
+            pthread_mutex_lock(&obj->draw.mutex);
+            {
+                obj->draw.tasksPendCount++;
+            }
+            pthread_mutex_unlock(&obj->draw.mutex);
+            if(0 != Thread_addTask(thread, Player_drawRectsUnplanedTaskFunc_, task)){
+                //K_LOG_ERROR("Thread_addTask failed.\n"); //ToDo: comment this print (risk to noisy).
+                pthread_mutex_lock(&obj->draw.mutex);
+                {
+                    obj->draw.tasksPendCount--;
                 }
-                ctx->dec.msToReopen = (plyr->cfg.decoderWaitRecopenSecs <= 0 ? 1 : plyr->cfg.decoderWaitRecopenSecs) * 1000;
+                pthread_mutex_unlock(&obj->draw.mutex);
+            } else {
+                //next
+                iRectStart += task->rectsSz;
+                ttUse++;
             }
         }
-    }
-    //file
-    if(ctx->file.fd > 0){
-        int simConnTimeout = 0;
-        //
-        if(plyr->cfg.dbg.simNetworkTimeout > 0){
-            if((rand() % plyr->cfg.dbg.simNetworkTimeout) == 0){
-                K_LOG_WARN("StreamContext_tick, forcing/simulating a NETWORK timeout (1 / %d prob.): '%s'.\n", plyr->cfg.dbg.simNetworkTimeout, ctx->cfg.path);
-                simConnTimeout = 1;
+        //task to draw remaining lines on this same thread
+        {
+            STPlayerDrawRectsUnplanedTask* task = &tt[ttUse];
+            task->dst   = obj;
+            task->rects = &rects[iRectStart];
+            task->rectsSz = rectsUse - iRectStart;
+            ttUse++;
+            pthread_mutex_lock(&obj->draw.mutex);
+            {
+                obj->draw.tasksPendCount++;
             }
+            pthread_mutex_unlock(&obj->draw.mutex);
+            Player_drawRectsUnplanedTaskFunc_(task);
         }
-        //connecting or connected
-        ctx->file.msWithoutRead += ms;
-        //continue reading (after screen refresh)
-        if(ctx->file.fd > 0 && ctx->buff.screenRefreshSeqBlocking > 0 && ctx->buff.screenRefreshSeqBlocking != plyr->anim.tickSeq){
-            ctx->buff.screenRefreshSeqBlocking = 0;
-            StreamContext_updatePollMaskFile_(ctx, plyr);
-        }
-        //timeout
-        if(ctx->file.fd > 0 && (simConnTimeout || (ctx->cfg.connTimeoutSecs > 0 && ctx->file.msWithoutRead > (ctx->cfg.connTimeoutSecs * 1000)))){
-            if(simConnTimeout){
-                K_LOG_ERROR("StreamContext_tick, net, simulated-connection-timeout('%s:%d') after %ds not reading: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->file.msWithoutRead / 1000), ctx->cfg.path);
-            } else {
-                //the lastest inactive trigger was reading
-                K_LOG_ERROR("StreamContext_tick, net, connection-timeout('%s:%d') after %ds not reading: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->file.msWithoutRead / 1000), ctx->cfg.path);
-            }
-            if(ctx->file.fd > 0){
-                const char* reason = "file timeout";
-                if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
-                    K_LOG_ERROR("StreamContext_tick, StreamContext_shutdownStart failed (at '%s').\n", reason);
-                }
+        //wait for tasks
+        {
+            pthread_mutex_lock(&obj->draw.mutex);
+            while(obj->draw.tasksPendCount > 0){
+                K_ASSERT(obj->draw.tasksPendCount >= 0)
+                pthread_cond_wait(&obj->draw.cond, &obj->draw.mutex);
             }
+            pthread_mutex_unlock(&obj->draw.mutex);
         }
-    } else if((ctx->cfg.server == NULL || ctx->cfg.server[0] == '\0') && ctx->cfg.port <= 0 && ctx->cfg.path != NULL && ctx->cfg.path[0] != '\0'){
-        //waiting
-        if(ctx->file.msToReconnect <= ms){
-            ctx->file.msToReconnect = 0;
-        } else {
-            ctx->file.msToReconnect -= ms;
-            //if((ctx->file.msToReconnect / 1000) != ((ctx->file.msToReconnect + ms) / 1000)){
-            //    K_LOG_INFO("StreamContext_tick, waiting %d secs to reconnect attempt: '%s'.\n", (ctx->file.msToReconnect / 1000), ctx->cfg.path);
-            //}
+        free(tt);
+        tt = NULL;
+    }
+    return r;
+}
+
+//---------------------
+//-- Planed drawing
+//---------------------
+//Draws the lines in order. This means the dst memory area will be sequential, the src memory area will be jumping.
+
+//STFramebuffDrawLine
+
+//All the lines to be drawn, in dst-pointer order.
+//The purpose is to organize all the memcpy instructions
+//reducing the memory-jumps, to make the memcpy as closer
+//as posible to as one single call for the dst-memory area.
+
+//STPlayerDrawLinesPlanedTask
+
+typedef struct STPlayerDrawLinesPlanedTask_ {
+    STPlayer*               dst;    //for the mutex
+    STFramebuffDrawLine*    lines;
+    int                     linesSz;
+} STPlayerDrawLinesPlanedTask;
+
+void Player_drawLinesPlanedTaskFunc_(void* param){
+    STPlayerDrawLinesPlanedTask* t = (STPlayerDrawLinesPlanedTask*)param;
+    //draw
+    {
+        STFramebuffDrawLine* ln = t->lines;
+        STFramebuffDrawLine* lnAfterEnd = ln + t->linesSz;
+        while(ln < lnAfterEnd){
+            if(ln->sz > 0){
+                memcpy(ln->dst, ln->src, ln->sz);
+            }
+            //next
+            ln++;
         }
-        //reconnect
-        if(ctx->file.msToReconnect == 0){
-            ctx->file.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
-            //
-            if(!(ctx->shuttingDown.isActive && ctx->shuttingDown.isPermanent)){
-                int fd = open(ctx->cfg.path, O_RDONLY | O_NONBLOCK);
-                if(fd < 0){
-                    K_LOG_ERROR("StreamContext, could not open file: '%s'.\n", ctx->cfg.path);
-                } else {
-                    K_LOG_INFO("StreamContext, file opened: '%s'.\n", ctx->cfg.path);
-                    //add to pollster
-                    if(0 != Player_pollAdd(plyr, ENPlayerPollFdType_SrcFile, StreamContext_pollCallback, ctx, fd, POLLIN)){ //read
-                        K_LOG_ERROR("poll-add-failed to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
-                    } else {
-                        K_LOG_INFO("StreamContext, socket added to poll: '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
-                        ctx->file.fd = fd; fd = -1; //consume
-                        ctx->file.msWithoutRead = 0;
-                        //reaet vars
-                        ctx->buff.buffUse = 0;
-                        ctx->buff.buffCsmd = 0;
-                        //
-                        ctx->buff.nal.zeroesSeqAccum    = 0;   //reading posible headers '0x00 0x00 0x00 0x01' (start of a NAL)
-                        //ctx->file.resp.nal.startsCount = 0;    //total NALs found
-                        //
-                        ctx->frames.fillingNalSz = 0;
-                        if(ctx->frames.filling != NULL){
-                            //add for future pull (reuse)
-                            if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, ctx->frames.filling)){
-                                K_LOG_INFO("StreamContext_tick, VideoFrames_pushFrameOwning failed: '%s'.\n", ctx->cfg.path);
-                                VideoFrame_release(ctx->frames.filling);
-                                free(ctx->frames.filling);
-                            }
-                            ctx->frames.filling = NULL;
-                        }
-                    }
-                    //release (if not consumed)
-                    if(fd >= 0){
-                        close(fd);
-                        fd = -1;
-                    }
+    }
+    //reduce counter
+    {
+        pthread_mutex_lock(&t->dst->draw.mutex);
+        {
+            K_ASSERT(t->dst->draw.tasksPendCount > 0)
+            if(t->dst->draw.tasksPendCount > 0){
+                t->dst->draw.tasksPendCount--;
+                if(t->dst->draw.tasksPendCount == 0){ //optimization, only awake main-thread if is the last task.
+                    pthread_cond_broadcast(&t->dst->draw.cond);
                 }
             }
         }
+        pthread_mutex_unlock(&t->dst->draw.mutex);
     }
-    //net
-    if(ctx->net.hostResolver != NULL || ctx->net.socket > 0){
-        ctx->net.msSinceStart += ms;
-    }
-    //net
-    if(ctx->net.socket > 0){
-        int closeConnn = 0, simConnTimeout = 0;
+}
+
+int Player_drawLinesPlaned_(STPlayer* obj, STFramebuffDrawLine* lines, const int linesUse){
+    int r = 0;
+    STPlayerDrawLinesPlanedTask* tt = malloc(sizeof(STPlayerDrawLinesPlanedTask) * (obj->threads.use + 1));
+    if(tt != NULL){
+        memset(tt, 0, sizeof(STPlayerDrawLinesPlanedTask) * (obj->threads.use + 1));
         //
-        if(plyr->cfg.dbg.simNetworkTimeout > 0){
-            if((rand() % plyr->cfg.dbg.simNetworkTimeout) == 0){
-                K_LOG_WARN("StreamContext_tick, forcing/simulating a NETWORK timeout (1 / %d prob.): '%s'.\n", plyr->cfg.dbg.simNetworkTimeout, ctx->cfg.path);
-                simConnTimeout = 1;
+        int iLineStart = 0, ttUse = 0, linesPerThread = (linesUse / (obj->threads.use + 1));
+        int i; for(i = 0; i < obj->threads.use; i++){
+            STThread* thread = &obj->threads.arr[i];
+            STPlayerDrawLinesPlanedTask* task = &tt[ttUse];
+            //
+            task->dst   = obj;
+            task->lines = &lines[iLineStart];
+            task->linesSz = linesPerThread;
+            if((iLineStart + task->linesSz) > linesUse){
+                task->linesSz = linesUse - iLineStart;
             }
-        }
-        //connecting or connected
-        ctx->net.msWithoutSend += ms;
-        ctx->net.msWithoutRecv += ms;
-        //
-        if(simConnTimeout){
-            K_LOG_ERROR("StreamContext_tick, net, simulated-connection-timeout('%s:%d') after %ds not writting and %ds not reading: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->net.msWithoutSend / 1000), (ctx->net.msWithoutRecv / 1000), ctx->cfg.path);
-            closeConnn = 1;
-        } else if((ctx->cfg.connTimeoutSecs > 0 && ctx->net.msWithoutSend > (ctx->cfg.connTimeoutSecs * 1000) && ctx->net.msWithoutRecv > (ctx->cfg.connTimeoutSecs * 1000))){
-            if(ctx->net.msWithoutSend == ctx->net.msWithoutRecv){
-                //the lastest inactive trigger was both (connection attemp)
-                K_LOG_ERROR("StreamContext_tick, net, connection-timeout('%s:%d') after %ds: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->net.msWithoutSend / 1000), ctx->cfg.path);
-            } else if(ctx->net.msWithoutSend < ctx->net.msWithoutRecv){
-                //the lastest inactive trigger was writting
-                K_LOG_ERROR("StreamContext_tick, net, connection-timeout('%s:%d') after %ds not writting: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->net.msWithoutSend / 1000), ctx->cfg.path);
+            //
+            pthread_mutex_lock(&obj->draw.mutex);
+            {
+                obj->draw.tasksPendCount++;
+            }
+            pthread_mutex_unlock(&obj->draw.mutex);
+            if(0 != Thread_addTask(thread, Player_drawLinesPlanedTaskFunc_, task)){
+                //K_LOG_ERROR("Thread_addTask failed.\n"); //ToDo: comment this print (risk to noisy).
+                pthread_mutex_lock(&obj->draw.mutex);
+                {
+                    obj->draw.tasksPendCount--;
+                }
+                pthread_mutex_unlock(&obj->draw.mutex);
             } else {
-                //the lastest inactive trigger was reading
-                K_LOG_ERROR("StreamContext_tick, net, connection-timeout('%s:%d') after %ds not reading: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->net.msWithoutRecv / 1000), ctx->cfg.path);
+                //next
+                iLineStart += task->linesSz;
+                ttUse++;
             }
-            closeConnn = 1;
-        } else if(!ctx->cfg.keepAlive && !ctx->dec.shouldBeOpen){
-            K_LOG_VERBOSE("StreamContext_tick, net, closing conn out-of-screen: '%s:%d%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
-            closeConnn = 1;
         }
-        if(closeConnn && ctx->net.socket > 0){
-            Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
-            close(ctx->net.socket);
-            ctx->net.socket = 0;
-            ctx->net.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
-        }
-    } else if(ctx->net.hostResolver == NULL && ctx->cfg.server != NULL && ctx->cfg.server[0] != '\0' && ctx->cfg.port > 0 && ctx->cfg.path != NULL && ctx->cfg.path[0] != '\0'){
-        //waiting
-        if(ctx->net.msToReconnect <= ms){
-            ctx->net.msToReconnect = 0;
-        } else {
-            ctx->net.msToReconnect -= ms;
-            //if((ctx->net.msToReconnect / 1000) != ((ctx->net.msToReconnect + ms) / 1000)){
-            //    K_LOG_INFO("StreamContext_tick, waiting %d secs to reconnect attempt: '%s'.\n", (ctx->net.msToReconnect / 1000), ctx->cfg.path);
-            //}
+        //task to draw remaining lines on this same thread
+        {
+            STPlayerDrawLinesPlanedTask* task = &tt[ttUse];
+            task->dst   = obj;
+            task->lines = &lines[iLineStart];
+            task->linesSz = linesUse - iLineStart;
+            ttUse++;
+            pthread_mutex_lock(&obj->draw.mutex);
+            {
+                obj->draw.tasksPendCount++;
+            }
+            pthread_mutex_unlock(&obj->draw.mutex);
+            Player_drawLinesPlanedTaskFunc_(task);
         }
-        //reconnect
-        if(ctx->net.msToReconnect == 0 && (ctx->cfg.keepAlive || ctx->dec.shouldBeOpen)){
-            ctx->net.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
-            //
-            if(!(ctx->shuttingDown.isActive && ctx->shuttingDown.isPermanent)){
-                struct gaicb* hostResolver = (struct gaicb*)malloc(sizeof(struct gaicb));
-                memset(hostResolver, 0, sizeof(*hostResolver));
-                hostResolver->ar_name = ctx->cfg.server;
-                if(0 != getaddrinfo_a(GAI_NOWAIT, &hostResolver, 1, NULL)){
-                    K_LOG_ERROR("StreamContext_tick, net, getaddrinfo_a failed (start): '%s' / '%s'.\n", ctx->cfg.server, ctx->cfg.path);
-                } else {
-                    //release previous
-                    {
-                        if(ctx->net.hostResolver != NULL){
-                            if(0 != gai_cancel(ctx->net.hostResolver)){
-                                //error
-                            }
-                            //ToDo: how to cleanup?
-                            //if(ctx->net.hostResolver->ar_result != NULL){
-                            //    freeaddrinfo(ctx->net.hostResolver->ar_result);
-                            //}
-                            free(ctx->net.hostResolver);
-                            ctx->net.hostResolver = NULL;
-                        }
-                    }
-                    //set new
-                    ctx->net.hostResolver = hostResolver;
-                    hostResolver = NULL; //consume
-                    //reset stat
-                    ctx->net.msSinceStart = 0;   //connection start (resolve or socket)
-                    ctx->net.msToResolve = 0;    //time since start to resolve host
-                    ctx->net.msToConnect = 0;    //time since start to send request
-                    ctx->net.msToRespStart = 0;  //time since start to receive response header
-                    ctx->net.msToRespHead = 0;   //time since complete to receive response header
-                    ctx->net.msToRespBody = 0;   //time since start to receive response body
-                    ctx->net.msToFirstUnit = 0;  //time since complete to receive first unit
-                    ctx->net.bytesSent      = 0;
-                    ctx->net.bytesRcvd      = 0;
-                    ctx->net.unitsRcvd      = 0;
-                }
-                //release (if not consumed)
-                if(hostResolver != NULL){
-                    free(hostResolver);
-                    hostResolver = NULL;
-                }
+        //wait for tasks
+        {
+            pthread_mutex_lock(&obj->draw.mutex);
+            while(obj->draw.tasksPendCount > 0){
+                K_ASSERT(obj->draw.tasksPendCount >= 0)
+                pthread_cond_wait(&obj->draw.cond, &obj->draw.mutex);
             }
+            pthread_mutex_unlock(&obj->draw.mutex);
         }
+        free(tt);
+        tt = NULL;
     }
-    //net (resolver)
-    if(ctx->net.hostResolver != NULL){
-        int rslvRelease = 0;
-        int reslvRet = gai_error(ctx->net.hostResolver);
-        if(reslvRet == EAI_INPROGRESS){
-            //active
-        } else if(reslvRet != 0){
-            //error
-            K_LOG_ERROR("StreamContext_tick, net, getaddrinfo_a failed (progress): '%s' / '%s'.\n", ctx->cfg.server, ctx->cfg.path);
-            rslvRelease = 1;
-        } else {
-            //success
-            struct addrinfo* res = ctx->net.hostResolver->ar_result;
-            struct in_addr hostAddr; int hostAddrFnd = 0;
-            memset(&hostAddr, 0, sizeof(struct in_addr));
-            while (res){
-                if (res->ai_family == AF_INET) {
-                    hostAddr = ((struct sockaddr_in*)res->ai_addr)->sin_addr;
-                    hostAddrFnd = 1;
-                    break;
-                    //} else if (res->ai_family == AF_INET6) {
-                    //ToDo: enable 'sockaddr_in6'
-                    //ptr = &((struct sockaddr_in6*)res->ai_addr)->sin6_addr;
-                    //hostAddrFnd = 1;
-                    //break;
-                }
-                //next
-                res = res->ai_next;
-            }
-            if(!hostAddrFnd){
-                K_LOG_ERROR("StreamContext_tick, net, host-addr-not-found('%s'): '%s'.\n", ctx->cfg.server, ctx->cfg.path);
+    return r;
+}
+
+int Player_draw_(STPlayer* obj){
+    int r = 0, drawn = 0;
+    STFramebuffDrawRect* rects = NULL;
+    int rectsSz = 0, rectsUse = 0;
+    //
+    struct timeval start;
+    gettimeofday(&start, NULL);
+    //precalculate drawing rects
+    if(0 == Player_drawGetRects_(obj, rects, rectsSz, &rectsUse)){
+        K_LOG_VERBOSE("Player, drawing nothing-to-draw.\n");
+    } else {
+        //resize rects array
+        if(rectsUse > 0){
+            rects = malloc(sizeof(STFramebuffDrawRect) * rectsUse);
+            if(rects == NULL){
+                K_LOG_INFO("Player, draw, recs[%d] culd not be allocated.\n", rectsUse);
+                r = -1;
             } else {
-                //connect
-                struct sockaddr remoteAddr;
-                memset(&remoteAddr, 0, sizeof(struct sockaddr));
-                {
-                    struct sockaddr_in* addr4 = (struct sockaddr_in*)&remoteAddr;
-                    addr4->sin_family    = AF_INET;
-                    addr4->sin_port      = (u_short)htons((u_short)ctx->cfg.port);
-                    addr4->sin_addr      = hostAddr;
-                }
-                //Create hnd (if necesary)
-                SOCKET sckt = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-                if(!sckt || sckt == INVALID_SOCKET){
-                    K_LOG_ERROR("StreamContext_tick, net, socket creation failed: '%s'.\n", ctx->cfg.path);
-                    ctx->net.socket = 0;
-                }
-                //config
-#               ifdef SO_NOSIGPIPE
-                if(sckt && sckt != INVALID_SOCKET){
-                    int v = 1; //(noSIGPIPE ? 1 : 0);
-                    if(setsockopt(sckt, SOL_SOCKET, SO_NOSIGPIPE, (const char*)&v, sizeof(v)) < 0){
-                        K_LOG_ERROR("StreamContext_tick, net, socket SO_NOSIGPIPE option failed: '%s'.\n", ctx->cfg.path);
-                        close(sckt);
-                        sckt = 0;
-                    }
-                }
-#               endif
-                //non-block
-                if(sckt && sckt != INVALID_SOCKET){
-                    int flags, nonBlocking = 1;
-                    if ((flags = fcntl(sckt, F_GETFL, 0)) == -1){
-                        K_LOG_ERROR("StreamContext_tick, net, F_GETFL failed: '%s'.\n", ctx->cfg.path);
-                        close(sckt);
-                        sckt = 0;
-                    } else {
-#                       ifdef O_NONBLOCK
-                        if(nonBlocking) flags |= O_NONBLOCK;
-                        else flags &= ~O_NONBLOCK;
-#                       endif
-#                       ifdef O_NDELAY
-                        if(nonBlocking) flags |= O_NDELAY;
-                        else flags &= ~O_NDELAY;
-#                       endif
-#                       ifdef FNDELAY
-                        if(nonBlocking) flags |= FNDELAY;
-                        else flags &= ~FNDELAY;
-#                       endif
-                        if(fcntl(sckt, F_SETFL, flags) == -1){
-                            K_LOG_ERROR("StreamContext_tick, net, F_SETFL O_NONBLOCK option failed: '%s'.\n", ctx->cfg.path);
-                            close(sckt);
-                            sckt = 0;
-                        }
-                    }
-                }
-                //connect
-                if(sckt && sckt != INVALID_SOCKET){
-                    //Connect (unlocked)
-                    {
-                        const int nret = connect(sckt, (struct sockaddr*)&remoteAddr, sizeof(remoteAddr));
-                        if (nret != 0){
-                            //EINPROGRESS: first call; EALREADY: subsequent calls
-                            if(!(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINPROGRESS)){
-                                K_LOG_ERROR("StreamContext_tick, connect-start-failed to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
-                                close(sckt);
-                                sckt = 0;
+                rectsSz = rectsUse;
+                rectsUse = 0;
+                if(0 != Player_drawGetRects_(obj, rects, rectsSz, &rectsUse)){
+                    K_LOG_INFO("Player, draw, failed recs[%d].\n", rectsSz);
+                } else {
+                    //-------
+                    //draw rects unplaned (unoptimized)
+                    //-------
+                    switch(obj->cfg.drawMode){
+                        case ENPlayerDrawMode_Src:
+                            //-------
+                            //draw rects unplaned
+                            //-------
+                            if(0 != Player_drawRectsUnplaned_(obj, rects, rectsUse)){
+                                K_LOG_INFO("Player, draw, failed draw rects[%d].\n", rectsUse);
                             } else {
-                                K_LOG_VERBOSE("StreamContext_tick, net, connect-started to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                                K_LOG_VERBOSE("Player, drawn rects[%d].\n", rectsSz);
+                                drawn = 1;
                             }
-                        }
-                    }
-                    //add to pollster
-                    if(0 != Player_pollAdd(plyr, ENPlayerPollFdType_SrcSocket, StreamContext_pollCallback, ctx, sckt, POLLOUT)){ //write
-                        K_LOG_ERROR("StreamContext_tick, poll-add-failed to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
-                        close(sckt);
-                        sckt = 0;
-                    } else {
-                        K_LOG_VERBOSE("StreamContext_tick, socket added to poll: '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
-                        ctx->net.socket = sckt;
-                        ctx->net.msWithoutSend = 0;
-                        ctx->net.msWithoutRecv = 0;
-                    }
-                }
-                //build request
-                {
-                    const int reqSz = StreamContext_concatHttpRequest(ctx, ctx->net.req.pay, ctx->net.req.paySz);
-                    if((reqSz + 1) <= ctx->net.req.paySz){ //+1 for '\0' for printing
-                        ctx->net.req.pay[reqSz] = '\0';
-                        ctx->net.req.payUse     = reqSz;
-                        ctx->net.req.payCsmd    = 0;
-                        K_LOG_VERBOSE("StreamContext_tick, net http-req built (reused %d/%d buffer): '%s'.\n", ctx->net.req.payUse, ctx->net.req.paySz, ctx->cfg.path);
-                    } else {
-                        if(ctx->net.req.pay != NULL){
-                            free(ctx->net.req.pay);
-                            ctx->net.req.pay = NULL;
-                        }
-                        ctx->net.req.paySz      = reqSz + 1; //+1 for '\0' for printing
-                        ctx->net.req.pay        = (char*)malloc(ctx->net.req.paySz);
-                        ctx->net.req.payUse     = StreamContext_concatHttpRequest(ctx, ctx->net.req.pay, ctx->net.req.paySz);
-                        ctx->net.req.payCsmd    = 0;
-                        ctx->net.req.pay[ctx->net.req.payUse] = '\0';
-                        K_LOG_VERBOSE("StreamContext_tick, net http-req built (new %d/%d buffer): '%s'.\n", ctx->net.req.payUse, ctx->net.req.paySz, ctx->cfg.path);
-                    }
-                }
-                //reset vars
-                {
-                    ctx->net.resp.headerEndSeq = 0;
-                    ctx->net.resp.headerSz = 0;
-                    ctx->net.resp.headerEnded = 0;
-                    //
-                    ctx->buff.buffUse = 0;
-                    ctx->buff.buffCsmd = 0;
-                    //
-                    ctx->buff.nal.zeroesSeqAccum    = 0;   //reading posible headers '0x00 0x00 0x00 0x01' (start of a NAL)
-                    //ctx->buff.nal.startsCount = 0;    //total NALs found
-                    //
-                    ctx->frames.fillingNalSz = 0;
-                    if(ctx->frames.filling != NULL){
-                        //add for future pull (reuse)
-                        if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, ctx->frames.filling)){
-                            K_LOG_INFO("StreamContext_tick, VideoFrames_pushFrameOwning failed: '%s'.\n", ctx->cfg.path);
-                            VideoFrame_release(ctx->frames.filling);
-                            free(ctx->frames.filling);
-                        }
-                        ctx->frames.filling = NULL;
+                            break;
+                        default: //ENPlayerDrawMode_Dst
+                            //-------
+                            //draw lines planed (optimized)
+                            //-------
+                            {
+                                int linesSz = 0;
+                                //count-lines
+                                int i; for(i = 0 ; i < rectsUse; i++){
+                                    STFramebuffDrawRect* rect = &rects[i];
+                                    if(rect->srcRectY < rect->srcRectYAfterEnd){
+                                        linesSz += (rect->srcRectYAfterEnd - rect->srcRectY);
+                                    }
+                                }
+                                if(linesSz > 0){
+                                    STFramebuffDrawLine* lines = (STFramebuffDrawLine*)malloc(sizeof(STFramebuffDrawLine) * linesSz);
+                                    if(lines == NULL){
+                                        K_LOG_INFO("Player, draw, lines[%d] culd not be allocated.\n", linesSz);
+                                        r = -1;
+                                    } else {
+                                        int linesUse = 0;
+                                        memset(lines, 0, sizeof(STFramebuffDrawLine) * linesSz);
+                                        if(0 != Player_drawGetLines_(obj, rects, rectsUse, lines, linesSz, &linesUse)){
+                                            K_LOG_INFO("Player, draw, failed get lines[%d / %d].\n", linesUse, linesSz);
+                                        } else if(0 != Player_drawLinesPlaned_(obj, lines, linesUse)){
+                                            K_LOG_INFO("Player, draw, failed draw lines[%d / %d].\n", linesUse, linesSz);
+                                        } else {
+                                            K_LOG_VERBOSE("Player, drawn rects[%d] lines[%d].\n", rectsSz, linesSz);
+                                            drawn = 1;
+                                        }
+                                        //
+                                        free(lines);
+                                        lines = NULL;
+                                    }
+                                }
+                            }
+                            break;
                     }
                 }
-                ctx->net.msToResolve = ctx->net.msSinceStart;
-                if(ctx->net.msToResolve > 1000){
-                    K_LOG_INFO("StreamContext_tick, %s ms to resolve-host: '%s'.\n", ctx->net.msToResolve, ctx->cfg.path);
-                } else {
-                    K_LOG_VERBOSE("StreamContext_tick, %s ms to resolve-host: '%s'.\n", ctx->net.msToResolve, ctx->cfg.path);
-                }
-            }
-            rslvRelease = 1;
-        }
-        //release
-        if(rslvRelease){
-            if(0 != gai_cancel(ctx->net.hostResolver)){
-                //error
             }
-            //ToDo: how to cleanup?
-            //if(ctx->net.hostResolver->ar_result != NULL){
-            //    freeaddrinfo(ctx->net.hostResolver->ar_result);
-            //}
-            free(ctx->net.hostResolver);
-            ctx->net.hostResolver = NULL;
         }
     }
-    //buffs
-    if(ctx->dec.fd >= 0){
-        if(!ctx->dec.shouldBeOpen){
-            if(!ctx->shuttingDown.isActive){
-                const int isPermanent = 0;
-                if(0 != StreamContext_shutdownStart(ctx, plyr, isPermanent)){
-                    K_LOG_ERROR("StreamContext_tick, StreamContext_shutdownStart failed (at tick).\n");
-                }
-            }
-        } else {
-            int simDecoderTimeout = 0;
-            if(plyr->cfg.dbg.simDecoderTimeout > 0){
-                if((rand() % plyr->cfg.dbg.simDecoderTimeout) == 0){
-                    K_LOG_WARN("StreamContext_tick, forcing/simulating a DECODER timeout (1 / %d prob.): '%s'.\n", plyr->cfg.dbg.simDecoderTimeout, ctx->cfg.path);
-                    simDecoderTimeout = 1;
-                }
-            }
-            //
-            ctx->dec.src.msWithoutEnqueuing += ms;
-            ctx->dec.src.msWithoutDequeuing += ms;
-            //
-            ctx->dec.dst.msWithoutEnqueuing += ms;
-            ctx->dec.dst.msWithoutDequeuing += ms;
-            //
-            //Detect decoder timeout
-            if(plyr->cfg.decoderTimeoutSecs > 0 || simDecoderTimeout){
-                if(ctx->dec.src.isExplicitON && ctx->dec.dst.isExplicitON && (simDecoderTimeout || (ctx->dec.dst.msWithoutDequeuing > ctx->dec.msWithoutFeedFrame && (ctx->dec.dst.msWithoutDequeuing - ctx->dec.msWithoutFeedFrame) >= (plyr->cfg.decoderTimeoutSecs * 1000)))){
-                    unsigned long msDecoderInative = (ctx->dec.dst.msWithoutDequeuing - ctx->dec.msWithoutFeedFrame);
-                    if(simDecoderTimeout){
-                        K_LOG_ERROR("StreamContext_tick, simulated-decoder timeout: %u ms inactive while ON and frames arriving: '%s'.\n", msDecoderInative, ctx->cfg.path);
-                    } else {
-                        K_LOG_ERROR("StreamContext_tick, decoder timeout: %u ms inactive while ON and frames arriving: '%s'.\n", msDecoderInative, ctx->cfg.path);
-                    }
-                    {
-                        //IMPORTANT: in raspberry pi-4 'seek' is aparently unsupported,
-                        //           leaking buffers and producing messages
-                        //           "bcm2835_codec_flush_buffers: Timeout waiting for buffers to be returned".
-                        //           Instead of stopping and resuming the src-buffers, is safer to reopen the device file.
-                        //
-                        //shutdown
-                        if(!ctx->shuttingDown.isActive){
-                            const int isPermanent = 0;
-                            if(0 != StreamContext_shutdownStart(ctx, plyr, isPermanent)){
-                                K_LOG_ERROR("StreamContext_tick, StreamContext_shutdownStart failed (at decoder timeout).\n");
-                            }
-                        }
-                        ctx->dec.isWaitingForIDRFrame = 1;
-                        ctx->dec.msToReopen = (plyr->cfg.decoderWaitRecopenSecs <= 0 ? 1 : plyr->cfg.decoderWaitRecopenSecs) * 1000;
-                    }
-                    //reset (just in case)
-                    {
-                        ctx->dec.src.msWithoutEnqueuing = 0;
-                        ctx->dec.src.msWithoutDequeuing = 0;
-                        //
-                        ctx->dec.dst.msWithoutEnqueuing = 0;
-                        ctx->dec.dst.msWithoutDequeuing = 0;
-                        //
-                        ctx->dec.msWithoutFeedFrame = 0;
-                    }
+    //add stats
+    if(r == 0 && drawn){
+        struct timeval end; long ms;
+        gettimeofday(&end, NULL);
+        ms = msBetweenTimevals(&start, &end);
+        if(ms >= 0){
+            pthread_mutex_lock(&obj->stats.mutex);
+            {
+                if(obj->stats.curSec.draw.count == 0){
+                    obj->stats.curSec.draw.msMin = ms;
+                    obj->stats.curSec.draw.msMax = ms;
+                } else {
+                    if(obj->stats.curSec.draw.msMin > ms) obj->stats.curSec.draw.msMin = ms;
+                    if(obj->stats.curSec.draw.msMax < ms) obj->stats.curSec.draw.msMax = ms;
                 }
+                obj->stats.curSec.draw.msSum += ms;
+                obj->stats.curSec.draw.count++;
             }
+            pthread_mutex_unlock(&obj->stats.mutex);
         }
     }
-    //flushing tick
-    if(ctx->flushing.isActive && !ctx->flushing.isCompleted){
-        if(0 != StreamContext_flushTick(ctx, ms, "StreamContext_tick")){
-            K_LOG_WARN("StreamContext_tick, StreamContext_flushTick failed: '%s'.\n", ctx->cfg.path);
-        }
-    }
-    //shutdown tick
-    if(ctx->shuttingDown.isActive && !ctx->shuttingDown.isCompleted){
-        if(0 != StreamContext_shutdownTick(ctx, plyr, ms, "StreamContext_tick")){
-            K_LOG_WARN("StreamContext_tick, StreamContext_shutdownTick failed: '%s'.\n", ctx->cfg.path);
+    //release
+    {
+        if(rects != NULL){
+            free(rects);
+            rects = NULL;
         }
+        rectsSz = rectsUse = 0;
     }
-    //
-    if(ctx->dec.fd >= 0){
-        ctx->dec.msOpen += ms;
-    }
-    ctx->dec.msWithoutFeedFrame += ms;
+    return r;
 }
 
-int StreamContext_flushStart(STStreamContext* ctx){
-    int r = -1;
-    if(!ctx->flushing.isActive){
-        r = 0;
-        memset(&ctx->flushing, 0, sizeof(ctx->flushing));
-        ctx->flushing.isActive = 1;
-        if(ctx->dec.fd < 0){
-            //K_LOG_INFO("StreamContext, flushStart  starting and completed (no decoder open).\n");
-            ctx->flushing.isSrcDone = 1;
-            ctx->flushing.isCompleted = 1;
-        } else {
-            //K_LOG_INFO("StreamContext, flushStart  starting.\n");
-            //flush-tick once to porgress now if posible
-            if(0 != StreamContext_flushTick(ctx, 0, "StreamContext_flushStart")){
-                K_LOG_ERROR("StreamContext_flushStart, StreamContext_flushTick failed.\n");
-                r = -1;
-            }
-        }
-    }
-    return r;
-}
+//-------------------
+//-- StreamContext --
+//-------------------
 
-int StreamContext_flushTick(STStreamContext* ctx, const int ms, const char* srcLocation){
-    int r = -1;
-    if(ctx->flushing.isActive && !ctx->flushing.isCompleted){
-        r = 0;
-        ctx->flushing.msAccum += ms;
+void StreamContext_init(STStreamContext* ctx){
+    memset(ctx, 0, sizeof(STStreamContext));
+    //buff
+    {
+        ctx->buff.buffUse   = 0;
+        ctx->buff.buffSz    = (1024 * 64);
+        ctx->buff.buff      = (unsigned char*)malloc(ctx->buff.buffSz);
+    }
+    //file
+    {
+        ctx->file.fd = -1;
+    }
+    //net
+    {
         //
-        if(ctx->dec.fd < 0){
-            if(!ctx->flushing.isSrcDone || !ctx->flushing.isCompleted){
-                K_LOG_WARN("StreamContext, device closed before flushing (%ums) (at '%s').\n", ctx->flushing.msAccum, srcLocation);
-                ctx->flushing.isSrcDone = 1;
-                ctx->flushing.isCompleted = 1;
-            }
-        } else {
-            //src
-            if(!ctx->flushing.isSrcDone){
-                //try to dequeue bufer
-                while(ctx->dec.src.enqueuedCount > 0){
-                    STBuffer* buff = NULL;
-                    if(0 != Buffers_dequeue(&ctx->dec.src, ctx->dec.fd, &buff, NULL)){
-                        buff = NULL;
-                        break;
-                    }
-                }
-                if(ctx->dec.src.enqueuedCount == 0){
-                    //K_LOG_INFO("StreamContext, flushing src-completed (%ums) (at '%s').\n", ctx->flushing.msAccum, srcLocation);
-                    ctx->flushing.isSrcDone = 1;
-                }
-            }
-            //dst
-            if(ctx->flushing.isSrcDone && !ctx->flushing.isCompleted){
-                //only flush src
-                ctx->flushing.isCompleted = 1;
-                //K_LOG_INFO("StreamContext, flushing completed (%ums) (at '%s').\n", ctx->flushing.msAccum, srcLocation);
-                /*
-                //try to dequeue bufer
-                while(ctx->dec.dst.enqueuedCount > 0){
-                    STBuffer* buff = NULL;
-                    if(0 != Buffers_dequeue(&ctx->dec.dst, ctx->dec.fd, &buff, NULL)){
-                        buff = NULL;
-                        break;
-                    }
-                }
-                if(ctx->dec.dst.enqueuedCount == 0){
-                    K_LOG_INFO("StreamContext, flushing src-dst-completed (%ums) (at '%s').\n", ctx->flushing.msAccum, srcLocation);
-                    ctx->flushing.isCompleted = 1;
-                }*/
-            }
-            //timeout
-            if(ctx->flushing.msAccum > (250) && (!ctx->flushing.isSrcDone || !ctx->flushing.isCompleted)){
-                K_LOG_WARN("StreamContext, flushing timeout(%ums), %d buffers still in src-queue and %d in dst-queue (at '%s').\n", ctx->flushing.msAccum, ctx->dec.src.enqueuedCount, ctx->dec.dst.enqueuedCount, srcLocation);
-                ctx->flushing.isSrcDone = 1;
-                ctx->flushing.isCompleted = 1;
-            }
+    }
+    //dec (decoder)
+    {
+        ctx->dec.fd = -1;
+        //src
+        {
+            Buffers_init(&ctx->dec.src);
+        }
+        //dst
+        {
+            Buffers_init(&ctx->dec.dst);
+        }
+        //frames
+        {
+            //
         }
     }
-    return r;
+    //frames
+    {
+        VideoFrames_init(&ctx->frames.filled);      //filled with payload
+        VideoFrames_init(&ctx->frames.reusable);    //for reutilization
+    }
 }
 
-int StreamContext_shutdownStart(STStreamContext* ctx, struct STPlayer_* plyr, const int isPermanent){
-    int r = -1;
-    if(!ctx->shuttingDown.isActive){
-        r = 0;
-        //activate
-        memset(&ctx->shuttingDown, 0, sizeof(ctx->shuttingDown));
-        ctx->shuttingDown.isActive = 1;
-        ctx->shuttingDown.isPermanent = isPermanent;
-        //activate flush
-        if(!ctx->flushing.isActive){
-            if(0 != StreamContext_flushStart(ctx)){
-                K_LOG_ERROR("StreamContext_shutdownStart, StreamContext_flushStart failed.\n");
-                r = -1;
-            }
+void StreamContext_release(STStreamContext* ctx){
+    //buff
+    {
+        if(ctx->buff.buff != NULL){
+            free(ctx->buff.buff);
+            ctx->buff.buff = NULL;
         }
-        if(ctx->dec.fd < 0){
-            //K_LOG_INFO("StreamContext, shutdown starting and completed (no decoder open).\n");
-            ctx->shuttingDown.isCompleted = 1;
-        } else {
-            //K_LOG_INFO("StreamContext, shutdown starting.\n");
-            //shutdown-tick once to porgress now if posible
-            if(0 != StreamContext_shutdownTick(ctx, plyr, 0, "StreamContext_shutdownStart")){
-                K_LOG_ERROR("StreamContext_shutdownStart, StreamContext_shutdownTick failed.\n");
-                r = -1;
+        ctx->buff.buffSz = 0;
+    }
+    //file
+    {
+        StreamContext_fileMapClose_(ctx);
+        if(ctx->file.fd >= 0){
+            close(ctx->file.fd);
+            ctx->file.fd = -1;
+        }
+    }
+    //net
+    {
+        ctx->net.isResolving = 0; //dns records are owned by the player
+        if(ctx->net.rtsp.itl.buff != NULL){
+            free(ctx->net.rtsp.itl.buff);
+            ctx->net.rtsp.itl.buff = NULL;
+        }
+        if(ctx->net.rtp.jitter.slots != NULL){
+            free(ctx->net.rtp.jitter.slots);
+            ctx->net.rtp.jitter.slots = NULL;
+        }
+        if(ctx->net.rtp.batch.msgs != NULL){
+            free(ctx->net.rtp.batch.msgs);
+            ctx->net.rtp.batch.msgs = NULL;
+        }
+        if(ctx->net.rtp.batch.iovs != NULL){
+            free(ctx->net.rtp.batch.iovs);
+            ctx->net.rtp.batch.iovs = NULL;
+        }
+        if(ctx->net.rtp.batch.buff != NULL){
+            free(ctx->net.rtp.batch.buff);
+            ctx->net.rtp.batch.buff = NULL;
+        }
+        if(ctx->shm.map != NULL){
+            munmap(ctx->shm.map, ctx->shm.mapSz);
+            ctx->shm.map = NULL;
+            ctx->shm.hdr = NULL;
+        }
+        if(ctx->net.socket){
+            close(ctx->net.socket);
+            ctx->net.socket = 0;
+        }
+        StreamContext_netAttemptsClose_(ctx, NULL);
+        //req
+        {
+            if(ctx->net.req.pay != NULL){
+                free(ctx->net.req.pay);
+                ctx->net.req.pay = NULL;
             }
+            ctx->net.req.payUse = 0;
+            ctx->net.req.paySz = 0;
         }
     }
-    return r;
-}
-
-int StreamContext_shutdownTick(STStreamContext* ctx, struct STPlayer_* plyr, const int ms, const char* srcLocation){
-    int r = -1;
-    if(ctx->shuttingDown.isActive && !ctx->shuttingDown.isCompleted){
-        r = 0;
-        ctx->shuttingDown.msAccum += ms;
-        //
-        if(ctx->dec.fd < 0){
-            if(!ctx->shuttingDown.isCompleted){
-                K_LOG_WARN("StreamContext, device closed before shutting-down (%ums) (at '%s').\n", ctx->shuttingDown.msAccum, srcLocation);
-                ctx->shuttingDown.isCompleted = 1;
+    //frames
+    {
+        //currently filling
+        if(ctx->frames.filling != NULL){
+            VideoFrame_release(ctx->frames.filling);
+            free(ctx->frames.filling);
+            ctx->frames.filling = NULL;
+        }
+        VideoFrames_release(&ctx->frames.filled);      //filled with payload
+        VideoFrames_release(&ctx->frames.reusable);    //for reutilization
+    }
+    //dec (decoder)
+    {
+        if(ctx->dec.fd >= 0 && ctx->dec.jpeg.cpu != NULL){
+            close(ctx->dec.fd);
+            ctx->dec.fd = -1;
+        } else if(ctx->dec.fd >= 0){
+            if(0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.dst, ctx->dec.fd)){
+                K_LOG_WARN("StreamContext_stopAndCleanupBuffs(dst) failed.\n");
             }
-        } else {
-            //
-            if(ctx->flushing.isCompleted){
-                //K_LOG_INFO("StreamContext, shutting-down-completed (%ums) (at '%s').\n", ctx->shuttingDown.msAccum, srcLocation);
-                ctx->shuttingDown.isCompleted = 1;
-                if(0 != StreamContext_close(ctx, plyr)){
-                    K_LOG_WARN("StreamContext_close failed: '%s' (at shutdown completion) (at '%s').\n", ctx->cfg.path, srcLocation);
-                } else {
-                    K_LOG_VERBOSE("StreamContext(%lld), shutdown completed %ums: '%s' (at shutdown completion) (at '%s').\n", (long long)ctx, ctx->shuttingDown.msAccum, ctx->cfg.path, srcLocation);
-                    K_ASSERT(ctx->dec.fd < 0)
-                }
+            if(0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.src, ctx->dec.fd)){
+                K_LOG_WARN("StreamContext_stopAndCleanupBuffs(src) failed.\n");
             }
-            //timeout
-            if(!ctx->shuttingDown.isCompleted && ctx->shuttingDown.msAccum > (500)){
-                K_LOG_WARN("StreamContext, shutting-down timeout(%ums), %d buffers still in src-queue and %d in dst-queue (at '%s').\n", ctx->shuttingDown.msAccum, ctx->dec.src.enqueuedCount, ctx->dec.dst.enqueuedCount, srcLocation);
-                ctx->shuttingDown.isCompleted = 1;
-                if(0 != StreamContext_close(ctx, plyr)){
-                    K_LOG_WARN("StreamContext_close failed: '%s' (at shutdown timeout) (at '%s').\n", ctx->cfg.path, srcLocation);
-                }
+            if(0 != StreamContext_eventsUnsubscribe(ctx, ctx->dec.fd)){
+                K_LOG_ERROR("StreamContext, unsubscribe failed.\n");
             }
+            v4l2_close(ctx->dec.fd);
+            ctx->dec.fd = -1;
+        }
+        StreamContext_jpegCpuClose_(ctx);
+        Buffers_release(&ctx->dec.src);
+        Buffers_release(&ctx->dec.dst);
+        //frames
+        {
+            VideoFrameStates_release(&ctx->dec.frames.fed);
         }
     }
-    return r;
+    //cfg
+    {
+        if(ctx->cfg.device != NULL){ free(ctx->cfg.device); ctx->cfg.device = NULL; }
+        if(ctx->cfg.server != NULL){ free(ctx->cfg.server); ctx->cfg.server = NULL; }
+        if(ctx->cfg.path != NULL){ free(ctx->cfg.path); ctx->cfg.path = NULL; }
+    }
 }
 
+int StreamContext_concatRequest(STStreamContext* ctx, char* dst, const int dstSz){
+    if(ctx->cfg.netProto == ENStreamNetProto_Rtsp){
+        return StreamContext_concatRtspRequest(ctx, dst, dstSz);
+    } else if(ctx->cfg.netProto == ENStreamNetProto_Shm){
+        return StreamContext_concatShmRequest(ctx, dst, dstSz);
+    }
+    return StreamContext_concatHttpRequest(ctx, dst, dstSz);
+}
 
-void StreamContext_cnsmRespHttpHeader_(STStreamContext* ctx){
-    while(!ctx->net.resp.headerEnded && ctx->buff.buffCsmd < ctx->buff.buffUse){
-        //0 = [], 1 = ['\r'], 2 = ['\r', '\n'], 3 = ['\r', '\n', '\r']
-        unsigned char c = ctx->buff.buff[ctx->buff.buffCsmd];
-        switch(ctx->net.resp.headerEndSeq){
-            case 0:
-                if(c == '\r') ctx->net.resp.headerEndSeq++;
-                break;
-            case 1:
-                if(c == '\n') ctx->net.resp.headerEndSeq++;
-                else if(c == '\r') ctx->net.resp.headerEndSeq = 1;
-                else ctx->net.resp.headerEndSeq = 0;
-                break;
-            case 2:
-                if(c == '\r') ctx->net.resp.headerEndSeq++;
-                else ctx->net.resp.headerEndSeq = 0;
-                break;
-            case 3:
-                if(c == '\n') {
-                    ctx->net.resp.headerEndSeq = 0;
-                    ctx->net.resp.headerEnded = 1;
-                    K_LOG_VERBOSE("StreamContext, net, response body started (after %d bytes header).\n", (ctx->net.resp.headerSz + 1));
-                    //print
-                    {
-                        if((ctx->buff.buffCsmd + 1) < ctx->buff.buffSz){
-                            unsigned char b = ctx->buff.buff[ctx->buff.buffCsmd + 1];
-                            ctx->buff.buff[ctx->buff.buffCsmd + 1] = '\0';
-                            K_LOG_VERBOSE("StreamContext, net, response header (last-read):\n-->%s<--.\n", &ctx->buff.buff[0]);
-                            ctx->buff.buff[ctx->buff.buffCsmd + 1] = b;
-                        }
-                    }
-                } else if(c == '\r'){
-                    ctx->net.resp.headerEndSeq = 1;
-                } else {
-                    ctx->net.resp.headerEndSeq = 0;
-                }
-                break;
-            default:
-                //program-logic error
-                break;
-                
-        }
-        ctx->net.resp.headerSz++;
-        ctx->buff.buffCsmd++;
+int StreamContext_concatShmRequest(STStreamContext* ctx, char* dst, const int dstSz){
+    //'NBSHM/1 stream-name\n'
+    return snprintf((dstSz > 0 ? dst : NULL), (dstSz > 0 ? dstSz : 0), "NBSHM/%d %s\n", K_SHM_RING_VERSION, ctx->cfg.path);
+}
+
+int StreamContext_concatRtspRequest(STStreamContext* ctx, char* dst, const int dstSz){
+    int r = 0;
+    char* dst2 = (dstSz > 0 ? dst : NULL);
+    const int dstSz2 = (dst2 != NULL ? dstSz : 0);
+    switch(ctx->net.rtsp.state){
+        case ENRtspState_Describe:
+            r = snprintf(dst2, dstSz2, "DESCRIBE %s RTSP/1.0\r\nCSeq: %d\r\nAccept: application/sdp\r\nUser-Agent: nbplayer\r\n\r\n", ctx->net.rtsp.base, ctx->net.rtsp.cseq);
+            break;
+        case ENRtspState_Setup:
+            r = snprintf(dst2, dstSz2, "SETUP %s RTSP/1.0\r\nCSeq: %d\r\nTransport: RTP/AVP/TCP;unicast;interleaved=0-1\r\nUser-Agent: nbplayer\r\n\r\n", ctx->net.rtsp.control, ctx->net.rtsp.cseq);
+            break;
+        case ENRtspState_Play:
+            r = snprintf(dst2, dstSz2, "PLAY %s RTSP/1.0\r\nCSeq: %d\r\nSession: %s\r\nRange: npt=0.000-\r\nUser-Agent: nbplayer\r\n\r\n", ctx->net.rtsp.base, ctx->net.rtsp.cseq, ctx->net.rtsp.session);
+            break;
+        default:
+            //keep-alive (session timeout)
+            r = snprintf(dst2, dstSz2, "OPTIONS %s RTSP/1.0\r\nCSeq: %d\r\nSession: %s\r\nUser-Agent: nbplayer\r\n\r\n", ctx->net.rtsp.base, ctx->net.rtsp.cseq, ctx->net.rtsp.session);
+            break;
     }
+    return (r < 0 ? 0 : r);
 }
 
-int StreamContext_getPollEventsMask(STStreamContext* ctx){
-    int events = POLLERR | POLLPRI;
-    //src-events only if dst-is-runnning
-    /*
-    if(ctx->dec.src.isExplicitON && ctx->dec.src.isImplicitON && ctx->dec.dst.isExplicitON && ctx->dec.dst.isImplicitON){
-        if(VideoFrames_getFramesForReadCount(&ctx->frames.filled) > 0){
-            events |= POLLOUT | POLLWRNORM; //src
+int StreamContext_concatHttpRequest(STStreamContext* ctx, char* dst, const int dstSz){
+    int r = 0;
+    //line-0
+    {
+        const char* str = "GET ";
+        const int len = strlen(str);
+        if(dst != NULL && (r + len) <= dstSz){
+            memcpy(&dst[r], str, len);
         }
-        events |= POLLIN | POLLRDNORM; //dst
+        r += len;
     }
-    */
-    //src-events and dst-events indepently
-    if(ctx->dec.src.isExplicitON && ctx->dec.src.isImplicitON){
-        if(!ctx->flushing.isActive && VideoFrames_getFramesForReadCount(&ctx->frames.filled) > 0){
-            events |= POLLOUT | POLLWRNORM; //src
+    {
+        const char* str = ctx->cfg.path;
+        const int len = strlen(str);
+        if(dst != NULL && (r + len) <= dstSz){
+            memcpy(&dst[r], str, len);
         }
-        if(ctx->dec.dst.isExplicitON && ctx->dec.dst.isImplicitON){
-            events |= POLLIN | POLLRDNORM; //dst
+        r += len;
+    }
+    {
+        const char* str = " HTTP/1.1\r\n";
+        const int len = strlen(str);
+        if(dst != NULL && (r + len) <= dstSz){
+            memcpy(&dst[r], str, len);
         }
+        r += len;
     }
-    return events;
+    //line-1
+    {
+        const char* str = "Host: ";
+        const int len = strlen(str);
+        if(dst != NULL && (r + len) <= dstSz){
+            memcpy(&dst[r], str, len);
+        }
+        r += len;
+    }
+    {
+        const int isIPv6 = (strchr(ctx->cfg.server, ':') != NULL); //literal, in brackets
+        const char* str = ctx->cfg.server;
+        const int len = strlen(str);
+        if(dst != NULL && (r + len + (isIPv6 ? 2 : 0)) <= dstSz){
+            if(isIPv6) dst[r] = '[';
+            memcpy(&dst[r + (isIPv6 ? 1 : 0)], str, len);
+            if(isIPv6) dst[r + 1 + len] = ']';
+        }
+        r += len + (isIPv6 ? 2 : 0);
+    }
+    {
+        const char* str = "\r\n";
+        const int len = strlen(str);
+        if(dst != NULL && (r + len) <= dstSz){
+            memcpy(&dst[r], str, len);
+        }
+        r += len;
+    }
+    //line-2
+    {
+        const char* str = "Connection: keep-alive\r\n";
+        const int len = strlen(str);
+        if(dst != NULL && (r + len) <= dstSz){
+            memcpy(&dst[r], str, len);
+        }
+        r += len;
+    }
+    //line-3
+    {
+        const char* str = "\r\n";
+        const int len = strlen(str);
+        if(dst != NULL && (r + len) <= dstSz){
+            memcpy(&dst[r], str, len);
+        }
+        r += len;
+    }
+    return r;
 }
 
-void StreamContext_updatePollMask_(STStreamContext* ctx, struct STPlayer_* plyr){
-    int events = StreamContext_getPollEventsMask(ctx), eventsBefore = 0;
-    if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_Decoder, ctx, ctx->dec.fd, events, &eventsBefore)){ //read
-        K_LOG_ERROR("poll-update-failed to '%s'.\n", ctx->cfg.path);
+int StreamContext_getMinBuffersForDst(STStreamContext* ctx, int* dstValue){
+    struct v4l2_control ctrl;
+    memset(&ctrl, 0, sizeof(ctrl));
+    ctrl.id = V4L2_CID_MIN_BUFFERS_FOR_CAPTURE;
+    const int rr2 = v4l2_ioctl(ctx->dec.fd, VIDIOC_G_CTRL, &ctrl);
+    if(rr2 == 0){
+        if(dstValue != NULL){
+            *dstValue = ctrl.value;
+        }
     } else {
-        if(eventsBefore != events){
-            //
-            if((eventsBefore & (POLLERR)) != (events & (POLLERR))){
-                K_LOG_VERBOSE("StreamContext, poll-mask: %cerr.\n", (eventsBefore & (POLLERR)) ? '-' : '+');
-            }
-            if((eventsBefore & (POLLPRI)) != (events & (POLLPRI))){
-                K_LOG_VERBOSE("StreamContext, poll-mask: %cevents.\n", (eventsBefore & (POLLPRI)) ? '-' : '+');
-            }
-            if((eventsBefore & (POLLOUT | POLLWRNORM)) != (events & (POLLOUT | POLLWRNORM))){
-                K_LOG_VERBOSE("StreamContext, poll-mask: %csrc.\n", (eventsBefore & (POLLOUT | POLLWRNORM)) ? '-' : '+');
-            }
-            if((eventsBefore & (POLLIN | POLLRDNORM)) != (events & (POLLIN | POLLRDNORM))){
-                K_LOG_VERBOSE("StreamContext, poll-mask: %cdst.\n", (eventsBefore & (POLLIN | POLLRDNORM)) ? '-' : '+');
-            }
-            //
-            K_LOG_VERBOSE("StreamContext, device-poll listening:%s%s%s%s%s.\n", (events & POLLERR) ? " errors" : "", (events & POLLPRI) ? " events": "", (events & (POLLOUT | POLLWRNORM)) ? " src": "", (events & (POLLIN | POLLRDNORM)) ? " dst": "", (events & (POLLERR | POLLPRI | POLLOUT | POLLWRNORM | POLLIN | POLLRDNORM)) == 0 ? "none" : "");
+        const STErrCode* err = _getErrCode(errno);
+        if(err == NULL){
+            K_LOG_ERROR("VIDIOC_G_CTRL, V4L2_CID_MIN_BUFFERS_FOR_CAPTURE, returned errno(%d).\n", errno);
+        } else {
+            K_LOG_ERROR("VIDIOC_G_CTRL, V4L2_CID_MIN_BUFFERS_FOR_CAPTURE, returned '%s'.\n", err->str);
         }
     }
+    return rr2;
 }
 
-int StreamContext_getPollEventsMaskFile(STStreamContext* ctx, struct STPlayer_* plyr){
-    int events = POLLERR;
-    //src-events and dst-events indepently
-    if(!ctx->flushing.isActive //not flushing src
-       && (ctx->buff.screenRefreshSeqBlocking == 0 || ctx->buff.screenRefreshSeqBlocking != plyr->anim.tickSeq) //not waiting for screen change
-       ){
-        events |= POLLIN;
+int StreamContext_initAndPrepareSrc(STStreamContext* ctx, int fd, const int buffersAmmount, const int print){
+    int r = -1;
+    //should be stopped
+    if(0 != Buffers_allocBuffs(&ctx->dec.src, fd, buffersAmmount, print)){
+        K_LOG_ERROR("StreamContext, Buffers_allocBuffs(%d) failed.\n", buffersAmmount);
+    } else if(ctx->dec.src.sz <= 0){
+        K_LOG_ERROR("StreamContext, Buffers_allocBuffs(%d) created zero buffs.\n", buffersAmmount);
+    //} else if(0 != Buffers_export(&ctx->dec.src, fd)){
+    //    K_LOG_ERROR("StreamContext, Buffers_export(%d) failed.\n", ctx->dec.src.sz);
+    } else if(0 != Buffers_mmap(&ctx->dec.src, fd)){
+        K_LOG_ERROR("StreamContext, Buffers_mmap(%d) failed.\n", ctx->dec.src.sz);
+    } else {
+        //if(ctx->dec.src.sz == buffersAmmount){
+        //    K_LOG_INFO("StreamContext, inited device with %d buffers.\n", buffersAmmount);
+        //} else {
+        //    K_LOG_INFO("StreamContext, inited device with %d of %d buffers.\n", ctx->dec.src.sz, buffersAmmount);
+        //}
+        ctx->dec.isWaitingForIDRFrame = 1;
+        r = 0;
     }
-    return events;
+    return r;
 }
 
-void StreamContext_updatePollMaskFile_(STStreamContext* ctx, struct STPlayer_* plyr){
-    if(ctx->file.fd >= 0){
-        const int mask = StreamContext_getPollEventsMaskFile(ctx, plyr);
-        if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_SrcFile, ctx, ctx->file.fd, mask, NULL)){ //read
-            const char* reason = "poll-update-failed";
-            if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
-                K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
+int StreamContext_initAndStartDst(STStreamContext* ctx, struct STPlayer_* plyr){
+    int r = -1;
+    STPrintedInfo* printDstFmt = Player_getPrintIfNotRecent(plyr, ctx->cfg.device, ctx->cfg.srcPixFmt, ctx->cfg.dstPixFmt, K_DEF_REPRINTS_HIDE_SECS);
+    if(printDstFmt != NULL){ PrintedInfo_touch(printDstFmt); }
+    ctx->dec.dst.enqueuedRequiredMin = 0;
+    //buffers kept by a parked decoder
+    if(ctx->dec.dst.sz > 0 && !ctx->dec.dst.isExplicitON){
+        if(0 == StreamContext_dstReuseParked_(ctx)){
+            r = 0;
+        } else {
+            plyr->decPool.stats.curSec.reallocs++;
+            if(0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.dst, ctx->dec.fd)){
+                K_LOG_WARN("StreamContext_stopAndCleanupBuffs(dst, parked) failed: '%s'.\n", ctx->cfg.device);
             }
         }
     }
+    if(r == 0){
+        K_LOG_VERBOSE("StreamContext, dst-started (%d parked buffers): '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
+    } else if(0 != Buffers_setFmt(&ctx->dec.dst, ctx->dec.fd, ctx->cfg.dstPixFmt, 1, 0, 1 /*getCompositionRect*/, (printDstFmt != NULL ? 1 : 0))){
+        K_LOG_ERROR("Buffers_setFmt(dst) failed: '%s'.\n", ctx->cfg.device);
+    } else if(0 != StreamContext_getMinBuffersForDst(ctx, &ctx->dec.dst.enqueuedRequiredMin)){
+        K_LOG_ERROR("StreamContext_getMinBuffersForDst(dst) failed: '%s'.\n", ctx->cfg.device);
+    } else if(ctx->dec.dst.enqueuedRequiredMin <= 0){
+        K_LOG_ERROR("StreamContext_getMinBuffersForDst(dst) returned(%d): '%s'.\n", ctx->dec.dst.enqueuedRequiredMin, ctx->cfg.device);
+    } else if(0 != Buffers_allocBuffs(&ctx->dec.dst, ctx->dec.fd, ctx->dec.dst.enqueuedRequiredMin /*+ 1*/, (printDstFmt != NULL ? 1 : 0))){ //+1 to keep a copy for rendering
+        K_LOG_ERROR("Buffers_allocBuffs(%d, dst) failed: '%s'.\n", (ctx->dec.dst.enqueuedRequiredMin /*+ 1*/), ctx->cfg.device);
+    } else if(ctx->dec.dst.sz <= 0){
+        K_LOG_ERROR("Buffers_allocBuffs(%d, dst) created zero buffers: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
+    } else if(ctx->dec.dst.sz < ctx->dec.dst.enqueuedRequiredMin){
+        K_LOG_ERROR("Buffers_allocBuffs(%d, dst) created below minimun(%d) buffers: '%s'.\n", ctx->dec.dst.sz, ctx->dec.dst.enqueuedRequiredMin, ctx->cfg.device);
+    //} else if(0 != Buffers_export(&ctx->dec.dst, ctx->dec.fd)){
+    //    K_LOG_ERROR("Buffers_export(%d, dst) failed: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
+    } else if(0 != Buffers_mmap(&ctx->dec.dst, ctx->dec.fd)){
+        K_LOG_ERROR("Buffers_mmap(%d, dst) failed: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
+    } else if(0 != Buffers_enqueueMinimun(&ctx->dec.dst, ctx->dec.fd, ctx->dec.dst.enqueuedRequiredMin)){
+        K_LOG_ERROR("Buffers_enqueueMinimun(%d / %d, dst) failed: '%s'.\n", ctx->dec.dst.enqueuedRequiredMin, ctx->dec.dst.sz, ctx->cfg.device);
+    } else if(0 != Buffers_start(&ctx->dec.dst, ctx->dec.fd)){
+        K_LOG_ERROR("Buffers_start(%d, dst) failed: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
+    } else {
+        if(ctx->dec.dst.sz != (ctx->dec.dst.enqueuedRequiredMin /*+ 1*/)){
+            K_LOG_INFO("StreamContext, dst-started (%d/%d buffers): '%s'.\n", ctx->dec.dst.sz, (ctx->dec.dst.enqueuedRequiredMin /*+ 1*/), ctx->cfg.device);
+        } else {
+            K_LOG_VERBOSE("StreamContext, dst-started (%d buffers): '%s'.\n", (ctx->dec.dst.enqueuedRequiredMin /*+ 1*/), ctx->cfg.device);
+        }
+        //if(ctx->dec.dst.sz == ctx->dec.dst.enqueuedRequiredMin){
+        //    K_LOG_WARN("attempt to allocate one extra buffer failed, this implies an extra memcopy() per decoded-frame: '%s'.\n", ctx->cfg.device);
+        //}
+        r = 0;
+    }
+    if(r == 0){
+        ctx->drawPlan.lastPixelformat = ctx->dec.dst.pixelformat;
+        if(ctx->dec.dst.composition.width > 0 && ctx->dec.dst.composition.height > 0){
+            ctx->drawPlan.lastCompRect = ctx->dec.dst.composition;
+        }
+        //update poll (dst started)
+        StreamContext_updatePollMask_(ctx, plyr);
+        //reorganize
+        if(0 != Player_organize(plyr)){
+            K_LOG_ERROR("Player_organize failed after dst-resized.\n");
+        }
+    }
+    return r;
 }
 
-void StreamContext_cnsmFrameOportunity_(STStreamContext* ctx, struct STPlayer_* plyr){
-    int tryAgain = 1;
-    while(tryAgain && ctx->dec.fd >= 0 && !ctx->flushing.isActive && VideoFrames_getFramesForReadCount(&ctx->frames.filled) > 0){
-        STBuffer* buff = NULL;
-        int buffIsDequeued = 0;
-        //try to use a new buffer
-        if(buff == NULL){
-            if(0 != Buffers_getUnqueued(&ctx->dec.src, &buff, NULL)){
-                buff = NULL;
-            }
+int StreamContext_dstReuseParked_(STStreamContext* ctx){
+    int r = -1, minBuffs = 0;
+    struct v4l2_format fm;
+    memset(&fm, 0, sizeof(fm));
+    fm.type = ctx->dec.dst.type;
+    //new format (after the resolution-change event)
+    int rr; CALL_IOCTL(rr, v4l2_ioctl(ctx->dec.fd, VIDIOC_G_FMT, &fm));
+    if(rr != 0){
+        K_LOG_ERROR("StreamContext, parked dst, getting format failed: '%s'.\n", ctx->cfg.device);
+#   ifdef K_USE_MPLANE
+    } else if(fm.fmt.pix_mp.pixelformat != ctx->dec.dst.pixelformat || fm.fmt.pix_mp.width != ctx->dec.dst.width || fm.fmt.pix_mp.height != ctx->dec.dst.height){
+        K_LOG_VERBOSE("StreamContext, parked dst, format changed %dx%d -> %dx%d: '%s'.\n", ctx->dec.dst.width, ctx->dec.dst.height, fm.fmt.pix_mp.width, fm.fmt.pix_mp.height, ctx->cfg.device);
+#   else
+    } else if(fm.fmt.pix.pixelformat != ctx->dec.dst.pixelformat || fm.fmt.pix.width != ctx->dec.dst.width || fm.fmt.pix.height != ctx->dec.dst.height){
+        K_LOG_VERBOSE("StreamContext, parked dst, format changed %dx%d -> %dx%d: '%s'.\n", ctx->dec.dst.width, ctx->dec.dst.height, fm.fmt.pix.width, fm.fmt.pix.height, ctx->cfg.device);
+#   endif
+    } else if(ctx->dec.dst.pixelformat != ctx->cfg.dstPixFmt){
+        K_LOG_VERBOSE("StreamContext, parked dst, pixel-format differs: '%s'.\n", ctx->cfg.device);
+    } else if(0 != StreamContext_getMinBuffersForDst(ctx, &minBuffs) || minBuffs <= 0 || ctx->dec.dst.sz < minBuffs){
+        K_LOG_VERBOSE("StreamContext, parked dst, %d buffers below minimun(%d): '%s'.\n", ctx->dec.dst.sz, minBuffs, ctx->cfg.device);
+    } else {
+        ctx->dec.dst.enqueuedRequiredMin = minBuffs;
+        //visible area could differ with the same coded size
+        if(0 != Buffers_getCompositionRect(&ctx->dec.dst, ctx->dec.fd, &ctx->dec.dst.composition)){
+            ctx->dec.dst.composition.x = 0;
+            ctx->dec.dst.composition.y = 0;
+            ctx->dec.dst.composition.width = ctx->dec.dst.width;
+            ctx->dec.dst.composition.height = ctx->dec.dst.height;
+        }
+        if(0 != Buffers_enqueueMinimun(&ctx->dec.dst, ctx->dec.fd, ctx->dec.dst.enqueuedRequiredMin)){
+            K_LOG_ERROR("Buffers_enqueueMinimun(%d / %d, parked dst) failed: '%s'.\n", ctx->dec.dst.enqueuedRequiredMin, ctx->dec.dst.sz, ctx->cfg.device);
+        } else if(0 != Buffers_start(&ctx->dec.dst, ctx->dec.fd)){
+            K_LOG_ERROR("Buffers_start(%d, parked dst) failed: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
+        } else {
+            r = 0;
         }
-        //try to dequeue and reuse bufer
-        if(buff == NULL && ctx->dec.src.enqueuedCount > 0){
-            if(0 != Buffers_dequeue(&ctx->dec.src, ctx->dec.fd, &buff, NULL)){
-                buff = NULL;
-            } else {
-                buffIsDequeued = 1;
-            }
+    }
+    return r;
+}
+
+int StreamContext_stopAndCleanupBuffs(STStreamContext* ctx, STBuffers* buffs, int fd){
+    int r = -1;
+    //IMPORTANT NOTE: if device exposed 'V4L2_BUF_CAP_SUPPORTS_ORPHANED_BUFS' capability
+    //, the buffer is not released untill is unmaped and closed.
+    //
+    if(fd >= 0){
+        if(0 != Buffers_stop(buffs, fd)){
+            K_LOG_ERROR("Buffers_stop(dst) failed: '%s'.\n", ctx->cfg.device);
         }
-        //feed frame
-        tryAgain = 0;
-        if(buff == NULL){
-            //
+        //
+        if(0 != Buffers_allocBuffs(buffs, fd, 0, 0)){
+            K_LOG_ERROR("Buffers_allocBuffs(dst, 0) failed: '%s'.\n", ctx->cfg.device);
         } else {
-            STVideoFrame* frame = NULL;
-            if(0 != VideoFrames_pullFrameForRead(&ctx->frames.filled, &frame)){
-                K_LOG_ERROR("StreamContext(%lld), no frame available (program logic error).\n", (long long)ctx);
-            } else {
-                //validate
-                if(buff->planesSz < 0){
-                    K_LOG_ERROR("StreamContext, at least one plane is required.\n");
-                } else if(buff->planes[0].length < frame->buff.use){
-                    K_LOG_ERROR("StreamContext, frame doesnt fit on plane's buffer.\n");
-                } else if(ctx->dec.isWaitingForIDRFrame && !frame->state.isIndependent){
-                    K_LOG_VERBOSE("StreamContext(%lld), frame(#%d) ignored, waiting-for-IDR, %d states-fed.\n", (long long)ctx, (frame->state.iSeq + 1), ctx->dec.frames.fed.use);
-                    tryAgain = 1; //search next frame
+            r = 0;
+        }
+    }
+    return r;
+}
+
+//
+
+int StreamContext_eventsSubscribe(STStreamContext* ctx, int fd){
+    //V4L2_EVENT_RESOLUTION_CHANGE == V4L2_EVENT_SOURCE_CHANGE
+    //V4L2_EVENT_SOURCE_CHANGE (event with changes set to V4L2_EVENT_SRC_CH_RESOLUTION)
+    {
+        struct v4l2_event_subscription sub;
+        memset(&sub, 0, sizeof(sub));
+        //
+        sub.type = V4L2_EVENT_SOURCE_CHANGE;
+        //
+        int rr; CALL_IOCTL(rr, v4l2_ioctl(fd, VIDIOC_SUBSCRIBE_EVENT, &sub));
+        if(rr != 0){
+            K_LOG_ERROR("StreamContext, Subscription to event V4L2_EVENT_SOURCE_CHANGE errno(%d).\n", errno);
+            return -1;
+        } else {
+            K_LOG_VERBOSE("StreamContext, Subscription to event V4L2_EVENT_SOURCE_CHANGE success.\n");
+        }
+    }
+    //V4L2_EVENT_EOS
+    {
+        struct v4l2_event_subscription sub;
+        memset(&sub, 0, sizeof(sub));
+        //
+        sub.type = V4L2_EVENT_EOS;
+        //
+        int rr; CALL_IOCTL(rr, v4l2_ioctl(fd, VIDIOC_SUBSCRIBE_EVENT, &sub));
+        if(rr != 0){
+            K_LOG_ERROR("StreamContext, Subscription to event V4L2_EVENT_EOS errno(%d).\n", errno);
+            return -1;
+        } else {
+            K_LOG_VERBOSE("StreamContext, Subscription to event V4L2_EVENT_EOS success.\n");
+        }
+    }
+    return 0;
+}
+
+int StreamContext_eventsUnsubscribe(STStreamContext* ctx, int fd){
+    struct v4l2_event_subscription sub;
+    memset(&sub, 0, sizeof(sub));
+    //
+    sub.type = V4L2_EVENT_ALL;
+    //
+    int rr; CALL_IOCTL(rr, v4l2_ioctl(fd, VIDIOC_UNSUBSCRIBE_EVENT, &sub));
+    if(rr != 0){
+        K_LOG_ERROR("StreamContext, Unscubscribe failed errno(%d).\n", errno);
+        return -1;
+    } else {
+        K_LOG_VERBOSE("StreamContext, Unscubscribe success.\n");
+    }
+    return 0;
+}
+
+//Next connection attempt: the wait doubles after each attempt without stream-units (up to the cap), with +-25% jitter to not retry in lockstep with other streams.
+void StreamContext_netScheduleReconnect_(STStreamContext* ctx, struct STPlayer_* plyr){
+    const unsigned long msBase = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
+    const unsigned long msMax = (plyr->cfg.connWaitReconnMaxSecs * 1000UL > msBase ? plyr->cfg.connWaitReconnMaxSecs * 1000UL : msBase);
+    unsigned long msWait = msBase;
+    int i; for(i = 1; i < ctx->net.reconn.attempts && msWait < msMax; i++){
+        msWait *= 2;
+    }
+    if(msWait > msMax){
+        msWait = msMax;
+    }
+    msWait = msWait - (msWait / 4) + (rand() % (msWait / 2 + 1));
+    ctx->net.msToReconnect = ctx->net.reconn.msLastWait = msWait;
+}
+
+void StreamContext_netTuneEval_(STStreamContext* ctx, struct STPlayer_* plyr){
+    if(ctx->net.tune.msAccum > 0){
+        const unsigned long bytes = (ctx->net.bytesRcvd >= ctx->net.tune.bytesRcvdPrev ? ctx->net.bytesRcvd - ctx->net.tune.bytesRcvdPrev : ctx->net.bytesRcvd);
+        const unsigned long bytesPerSec = (unsigned long)((unsigned long long)bytes * 1000ULL / ctx->net.tune.msAccum);
+        //fast-attack (bursts), slow-decay (pauses)
+        if(bytesPerSec >= ctx->net.tune.bytesPerSec){
+            ctx->net.tune.bytesPerSec = bytesPerSec;
+        } else {
+            ctx->net.tune.bytesPerSec = (ctx->net.tune.bytesPerSec * 3 + bytesPerSec) / 4;
+        }
+    }
+    ctx->net.tune.bytesRcvdPrev = ctx->net.bytesRcvd;
+    ctx->net.tune.msAccum = 0;
+    StreamContext_netTuneApply_(ctx, plyr);
+}
+
+void StreamContext_netTuneApply_(STStreamContext* ctx, struct STPlayer_* plyr){
+    const int isTcp = (ctx->cfg.netProto == ENStreamNetProto_Http || ctx->cfg.netProto == ENStreamNetProto_Rtsp);
+    const unsigned long long bps = ctx->net.tune.bytesPerSec;
+    int changed = 0;
+    if(ctx->net.socket <= 0){
+        return;
+    }
+    //ingest buffer (udp and shm do not read into it)
+    if(plyr->cfg.netBuffAdapt){
+        int target = K_NET_BUFF_MIN;
+        if(isTcp){
+            const unsigned long long want = bps * K_NET_BUFF_TARGET_MS / 1000ULL;
+            while(target < K_NET_BUFF_MAX && (unsigned long long)target < want){
+                target *= 2;
+            }
+        }
+        //grow now, shrink after a few evaluations (less than a quarter needed)
+        if(target > ctx->buff.buffSz){
+            ctx->net.tune.shrinkEvals = 0;
+        } else if((target * 4) <= ctx->buff.buffSz){
+            ctx->net.tune.shrinkEvals++;
+        } else {
+            ctx->net.tune.shrinkEvals = 0;
+        }
+        if(target != ctx->buff.buffSz && (target > ctx->buff.buffSz || ctx->net.tune.shrinkEvals >= 3)
+           && ctx->buff.buffCsmd >= ctx->buff.buffUse //empty (nothing to move)
+           && !Player_uringIsPending(plyr, ENPlayerPollFdType_SrcSocket, ctx) //not a posted read destination
+           )
+        {
+            unsigned char* buffN = (unsigned char*)malloc(target);
+            if(buffN != NULL){
+                K_LOG_VERBOSE("StreamContext, net, ingest buffer %d -> %d KBs (%llu KB/s): '%s'.\n", (ctx->buff.buffSz / 1024), (target / 1024), (bps / 1024), ctx->cfg.path);
+                if(ctx->buff.buff != NULL){
+                    free(ctx->buff.buff);
+                }
+                ctx->buff.buff = buffN;
+                ctx->buff.buffSz = target;
+                ctx->buff.buffCsmd = ctx->buff.buffUse = 0;
+                ctx->net.tune.shrinkEvals = 0;
+                changed = 1;
+            }
+        }
+    }
+    //SO_RCVBUF (only grows over the kernel's current size; setting it disables tcp autotuning)
+    if(plyr->cfg.netBuffAdapt){
+        int cur = 0; socklen_t curLen = sizeof(cur);
+        if(getsockopt(ctx->net.socket, SOL_SOCKET, SO_RCVBUF, &cur, &curLen) == 0){
+            unsigned long long target = bps * K_NET_RCVBUF_TARGET_MS / 1000ULL;
+            cur /= 2; //reported doubled (bookkeeping overhead)
+            if(target < K_NET_RCVBUF_MIN) target = K_NET_RCVBUF_MIN;
+            if(target > K_NET_RCVBUF_MAX) target = K_NET_RCVBUF_MAX;
+            if(target > (unsigned long long)cur){
+                const int v = (int)target;
+                if(setsockopt(ctx->net.socket, SOL_SOCKET, SO_RCVBUF, &v, sizeof(v)) != 0){
+                    K_LOG_WARN("StreamContext, net, SO_RCVBUF(%d) failed: '%s'.\n", v, ctx->cfg.path);
+                } else if(getsockopt(ctx->net.socket, SOL_SOCKET, SO_RCVBUF, &cur, &curLen) == 0){
+                    cur /= 2; //capped by 'net.core.rmem_max'
+                    changed = 1;
+                }
+            }
+            ctx->net.tune.rcvBufSz = cur;
+        }
+    }
+    //SO_RCVLOWAT (wakeup when this ammount is available; tcp only)
+    if(isTcp && plyr->cfg.netRcvLowatMs > 0){
+        int lowat = (int)(bps * plyr->cfg.netRcvLowatMs / 1000ULL);
+        if(lowat > ctx->buff.buffSz / 2) lowat = ctx->buff.buffSz / 2;
+        if(lowat < 1) lowat = 1;
+        //ignore small changes
+        if(lowat > (ctx->net.tune.rcvLowat + ctx->net.tune.rcvLowat / 4) || lowat < (ctx->net.tune.rcvLowat - ctx->net.tune.rcvLowat / 4)){
+            if(setsockopt(ctx->net.socket, SOL_SOCKET, SO_RCVLOWAT, &lowat, sizeof(lowat)) != 0){
+                K_LOG_WARN("StreamContext, net, SO_RCVLOWAT(%d) failed: '%s'.\n", lowat, ctx->cfg.path);
+            } else {
+                ctx->net.tune.rcvLowat = lowat;
+                changed = 1;
+            }
+        }
+    }
+    if(changed){
+        ctx->net.tune.stats.curSec.resizes++;
+    }
+}
+
+void StreamContext_tick(STStreamContext* ctx, struct STPlayer_* plyr, unsigned int ms){
+    //decoder
+    if(ctx->dec.fd < 0){
+        ctx->dec.msOpen = 0;
+        ctx->dec.msFirstFrameFed = 0;
+        ctx->dec.msFirstFrameOut = 0;
+        ctx->dec.framesInSinceOpen = 0;
+        ctx->dec.framesOutSinceOpen = 0;
+        //
+        if(ctx->dec.msToReopen <= ms){
+            ctx->dec.msToReopen = 0;
+        } else {
+            ctx->dec.msToReopen -= ms;
+            //if(ctx->dec.shouldBeOpen && (ctx->dec.msToReopen / 1000) != ((ctx->dec.msToReopen + ms) / 1000)){
+            //    K_LOG_INFO("StreamContext_tick, waiting %d secs to reopen attempt: %s.\n", (ctx->dec.msToReopen / 1000), ctx->cfg.path);
+            //}
+        }
+        if(ctx->dec.shouldBeOpen){
+            //reopen
+            if(ctx->dec.msToReopen == 0){
+                //ToDo: execute this action once no src-buffer is queued or timedout src-bufer flush?
+                if(0 != StreamContext_open(ctx, plyr, ctx->cfg.device, ctx->cfg.server, ctx->cfg.port, ctx->cfg.keepAlive, ctx->cfg.path, ctx->cfg.srcPixFmt, ctx->cfg.buffersAmmount, ctx->cfg.planesPerBuffer, ctx->cfg.sizePerPlane, ctx->cfg.dstPixFmt, ctx->cfg.connTimeoutSecs, ctx->cfg.decoderTimeoutSecs, ctx->cfg.framesSkip, ctx->cfg.framesFeedMax)){
+                    K_LOG_ERROR("StreamContext, streamAdd failed: '%s' @ '%s'.\n", ctx->cfg.path, ctx->cfg.device);
                 } else {
-                    ctx->dec.frames.foundCount++;
-                    //feed
-                    if(ctx->dec.frames.foundCount <= ctx->cfg.framesSkip){
-                        K_LOG_INFO("StreamContext, skipping-fed frame (#%d/%d) (user-param 'framesSkip').\n", ctx->dec.frames.foundCount, ctx->cfg.framesSkip);
-                    } else if(ctx->flushing.isActive){
-                        K_LOG_INFO("StreamContext, skipping-fed frame (#%d/%d) (flushing).\n", ctx->dec.frames.foundCount, ctx->cfg.framesSkip);
+                    K_LOG_VERBOSE("StreamContext (%lld), tick device reopened and added to poll: '%s'.\n", (long long)ctx, ctx->cfg.path);
+                    //feed the GOP cache at once (without waiting for the next arrival)
+                    if(VideoFrames_getFramesForReadCount(&ctx->frames.filled) > 0){
+                        StreamContext_frameFilledNotify_(ctx, plyr, 1 /*filledWasEmpty*/);
+                    }
+                    //trigger network connection (if not keepAlive)
+                    if(!ctx->cfg.keepAlive){
+                        ctx->net.msToReconnect = 0;
+                    }
+                }
+                ctx->dec.msToReopen = (plyr->cfg.decoderWaitRecopenSecs <= 0 ? 1 : plyr->cfg.decoderWaitRecopenSecs) * 1000;
+            }
+        }
+    }
+    //file
+    if(ctx->file.fd > 0){
+        int simConnTimeout = 0;
+        //
+        if(plyr->cfg.dbg.simNetworkTimeout > 0){
+            if((rand() % plyr->cfg.dbg.simNetworkTimeout) == 0){
+                K_LOG_WARN("StreamContext_tick, forcing/simulating a NETWORK timeout (1 / %d prob.): '%s'.\n", plyr->cfg.dbg.simNetworkTimeout, ctx->cfg.path);
+                simConnTimeout = 1;
+            }
+        }
+        //connecting or connected
+        ctx->file.msWithoutRead += ms;
+        //continue reading (after screen refresh)
+        if(ctx->file.fd > 0 && ctx->buff.screenRefreshSeqBlocking > 0 && ctx->buff.screenRefreshSeqBlocking != plyr->anim.tickSeq){
+            ctx->buff.screenRefreshSeqBlocking = 0;
+            StreamContext_updatePollMaskFile_(ctx, plyr);
+        } else if(ctx->file.fd > 0 && plyr->uring.isActive){
+            //io_uring: post again after end-of-file or flush (if not pending)
+            StreamContext_updatePollMaskFile_(ctx, plyr);
+        }
+        //mapped: parse the frames due
+        if(ctx->file.fd > 0 && ctx->file.map != NULL){
+            StreamContext_fileMapTick_(ctx, plyr);
+        }
+        //timeout
+        if(ctx->file.fd > 0 && (simConnTimeout || (ctx->cfg.connTimeoutSecs > 0 && ctx->file.msWithoutRead > (ctx->cfg.connTimeoutSecs * 1000)))){
+            if(simConnTimeout){
+                K_LOG_ERROR("StreamContext_tick, net, simulated-connection-timeout('%s:%d') after %ds not reading: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->file.msWithoutRead / 1000), ctx->cfg.path);
+            } else {
+                //the lastest inactive trigger was reading
+                K_LOG_ERROR("StreamContext_tick, net, connection-timeout('%s:%d') after %ds not reading: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->file.msWithoutRead / 1000), ctx->cfg.path);
+            }
+            if(ctx->file.fd > 0){
+                const char* reason = "file timeout";
+                if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
+                    K_LOG_ERROR("StreamContext_tick, StreamContext_shutdownStart failed (at '%s').\n", reason);
+                }
+            }
+        }
+    } else if((ctx->cfg.server == NULL || ctx->cfg.server[0] == '\0') && ctx->cfg.port <= 0 && ctx->cfg.path != NULL && ctx->cfg.path[0] != '\0'){
+        //waiting
+        if(ctx->file.msToReconnect <= ms){
+            ctx->file.msToReconnect = 0;
+        } else {
+            ctx->file.msToReconnect -= ms;
+            //if((ctx->file.msToReconnect / 1000) != ((ctx->file.msToReconnect + ms) / 1000)){
+            //    K_LOG_INFO("StreamContext_tick, waiting %d secs to reconnect attempt: '%s'.\n", (ctx->file.msToReconnect / 1000), ctx->cfg.path);
+            //}
+        }
+        //reconnect
+        if(ctx->file.msToReconnect == 0){
+            ctx->file.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
+            //
+            if(!(ctx->shuttingDown.isActive && ctx->shuttingDown.isPermanent)){
+                int fd = open(ctx->cfg.path, O_RDONLY | O_NONBLOCK);
+                if(fd < 0){
+                    K_LOG_ERROR("StreamContext, could not open file: '%s'.\n", ctx->cfg.path);
+                } else {
+                    K_LOG_INFO("StreamContext, file opened: '%s'.\n", ctx->cfg.path);
+                    //map (parsed at tick), else read
+                    StreamContext_fileMapOpen_(ctx, fd);
+                    //add to pollster
+                    if(0 != Player_pollAdd(plyr, ENPlayerPollFdType_SrcFile, StreamContext_pollCallback, ctx, fd, (plyr->uring.isActive || ctx->file.map != NULL ? 0 : POLLIN))){ //read (io_uring: posted after opening)
+                        K_LOG_ERROR("poll-add-failed to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
                     } else {
-                        struct timeval vTimestamp; //virtual timestamp
-                        memset(&vTimestamp, 0, sizeof(vTimestamp));
-                        //sync record
-                        {
-                            int i;
-                            //first plane
-                            STPlane* p = &buff->planes[0];
-                            memcpy(p->dataPtr, frame->buff.ptr, frame->buff.use);
-                            p->used = frame->buff.use;
-                            //others
-                            for(i = 1; i < buff->planesSz; i++){
-                                STPlane* p = &buff->planes[i];
-                                p->used = 0;
+                        K_LOG_INFO("StreamContext, socket added to poll: '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                        ctx->file.fd = fd; fd = -1; //consume
+                        ctx->file.msWithoutRead = 0;
+                        //reaet vars
+                        ctx->buff.buffUse = 0;
+                        ctx->buff.buffCsmd = 0;
+                        //
+                        ctx->buff.nal.zeroesSeqAccum    = 0;   //reading posible headers '0x00 0x00 0x00 0x01' (start of a NAL)
+                        //ctx->file.resp.nal.startsCount = 0;    //total NALs found
+                        //
+                        ctx->frames.fillingNalSz = 0;
+                        if(ctx->frames.filling != NULL){
+                            //add for future pull (reuse)
+                            if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, ctx->frames.filling)){
+                                K_LOG_INFO("StreamContext_tick, VideoFrames_pushFrameOwning failed: '%s'.\n", ctx->cfg.path);
+                                VideoFrame_release(ctx->frames.filling);
+                                free(ctx->frames.filling);
                             }
-                            //virtual timestamp
-                            VideoFrameState_iSeqToTimestamp(frame->state.iSeq, &vTimestamp);
-                            //processing timestamps
-                            gettimeofday(&frame->state.times.proc.start, NULL);
-                            frame->state.times.proc.end = frame->state.times.proc.start;
+                            ctx->frames.filling = NULL;
                         }
-                        //queue record
-                        if(0 != Buffers_enqueue(&ctx->dec.src, ctx->dec.fd, buff, &vTimestamp)){
-                            K_LOG_ERROR("StreamContext, frame could not be queued.\n");
-                        } else {
-                            ctx->dec.framesInSinceOpen++;
-                            //first-frame-fed event
-                            if(ctx->dec.framesInSinceOpen == 1){
-                                ctx->dec.msFirstFrameFed = ctx->dec.msOpen;
-                                if(ctx->dec.msFirstFrameFed >= 1000){
-                                    K_LOG_WARN("StreamContext(%lld), %ums to fed first frame (with types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s).\n"
-                                               , (long long)ctx, ctx->dec.msOpen
-                                               , frame->accessUnit.nalsCountPerType[0] ? " 0" : ""
-                                               , frame->accessUnit.nalsCountPerType[1] ? " 1" : ""
-                                               , frame->accessUnit.nalsCountPerType[2] ? " 2" : ""
-                                               , frame->accessUnit.nalsCountPerType[3] ? " 3" : ""
-                                               , frame->accessUnit.nalsCountPerType[4] ? " 4" : ""
-                                               , frame->accessUnit.nalsCountPerType[5] ? " 5" : ""
-                                               , frame->accessUnit.nalsCountPerType[6] ? " 6" : ""
-                                               , frame->accessUnit.nalsCountPerType[7] ? " 7" : ""
-                                               , frame->accessUnit.nalsCountPerType[8] ? " 8" : ""
-                                               , frame->accessUnit.nalsCountPerType[9] ? " 9" : ""
-                                               , frame->accessUnit.nalsCountPerType[10] ? " 10" : ""
-                                               , frame->accessUnit.nalsCountPerType[11] ? " 11" : ""
-                                               , frame->accessUnit.nalsCountPerType[12] ? " 12" : ""
-                                               , frame->accessUnit.nalsCountPerType[13] ? " 13" : ""
-                                               , frame->accessUnit.nalsCountPerType[14] ? " 14" : ""
-                                               , frame->accessUnit.nalsCountPerType[15] ? " 15" : ""
-                                               , frame->accessUnit.nalsCountPerType[16] ? " 16" : ""
-                                               , frame->accessUnit.nalsCountPerType[17] ? " 17" : ""
-                                               , frame->accessUnit.nalsCountPerType[18] ? " 18" : ""
-                                               , frame->accessUnit.nalsCountPerType[19] ? " 19" : ""
-                                               , frame->accessUnit.nalsCountPerType[20] ? " 20" : ""
-                                               , frame->accessUnit.nalsCountPerType[21] ? " 21" : ""
-                                               , frame->accessUnit.nalsCountPerType[22] ? " 22" : ""
-                                               , frame->accessUnit.nalsCountPerType[23] ? " 23" : ""
-                                               , frame->accessUnit.nalsCountPerType[24] ? " 24" : ""
-                                               , frame->accessUnit.nalsCountPerType[25] ? " 25" : ""
-                                               , frame->accessUnit.nalsCountPerType[26] ? " 26" : ""
-                                               , frame->accessUnit.nalsCountPerType[27] ? " 27" : ""
-                                               , frame->accessUnit.nalsCountPerType[28] ? " 28" : ""
-                                               , frame->accessUnit.nalsCountPerType[29] ? " 29" : ""
-                                               , frame->accessUnit.nalsCountPerType[30] ? " 30" : ""
-                                               , frame->accessUnit.nalsCountPerType[31] ? " 31" : ""
-                                               );
-                                } else {
-                                    K_LOG_VERBOSE("StreamContext(%lld), %ums to fed first frame (with types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s).\n"
-                                               , (long long)ctx, ctx->dec.msOpen
-                                               , frame->accessUnit.nalsCountPerType[0] ? " 0" : ""
-                                               , frame->accessUnit.nalsCountPerType[1] ? " 1" : ""
-                                               , frame->accessUnit.nalsCountPerType[2] ? " 2" : ""
-                                               , frame->accessUnit.nalsCountPerType[3] ? " 3" : ""
-                                               , frame->accessUnit.nalsCountPerType[4] ? " 4" : ""
-                                               , frame->accessUnit.nalsCountPerType[5] ? " 5" : ""
-                                               , frame->accessUnit.nalsCountPerType[6] ? " 6" : ""
-                                               , frame->accessUnit.nalsCountPerType[7] ? " 7" : ""
-                                               , frame->accessUnit.nalsCountPerType[8] ? " 8" : ""
-                                               , frame->accessUnit.nalsCountPerType[9] ? " 9" : ""
-                                               , frame->accessUnit.nalsCountPerType[10] ? " 10" : ""
-                                               , frame->accessUnit.nalsCountPerType[11] ? " 11" : ""
-                                               , frame->accessUnit.nalsCountPerType[12] ? " 12" : ""
-                                               , frame->accessUnit.nalsCountPerType[13] ? " 13" : ""
-                                               , frame->accessUnit.nalsCountPerType[14] ? " 14" : ""
-                                               , frame->accessUnit.nalsCountPerType[15] ? " 15" : ""
-                                               , frame->accessUnit.nalsCountPerType[16] ? " 16" : ""
-                                               , frame->accessUnit.nalsCountPerType[17] ? " 17" : ""
-                                               , frame->accessUnit.nalsCountPerType[18] ? " 18" : ""
-                                               , frame->accessUnit.nalsCountPerType[19] ? " 19" : ""
-                                               , frame->accessUnit.nalsCountPerType[20] ? " 20" : ""
-                                               , frame->accessUnit.nalsCountPerType[21] ? " 21" : ""
-                                               , frame->accessUnit.nalsCountPerType[22] ? " 22" : ""
-                                               , frame->accessUnit.nalsCountPerType[23] ? " 23" : ""
-                                               , frame->accessUnit.nalsCountPerType[24] ? " 24" : ""
-                                               , frame->accessUnit.nalsCountPerType[25] ? " 25" : ""
-                                               , frame->accessUnit.nalsCountPerType[26] ? " 26" : ""
-                                               , frame->accessUnit.nalsCountPerType[27] ? " 27" : ""
-                                               , frame->accessUnit.nalsCountPerType[28] ? " 28" : ""
-                                               , frame->accessUnit.nalsCountPerType[29] ? " 29" : ""
-                                               , frame->accessUnit.nalsCountPerType[30] ? " 30" : ""
-                                               , frame->accessUnit.nalsCountPerType[31] ? " 31" : ""
-                                               );
-                                }
-                            }
-                            //Add frame state to processing queue
-                            VideoFrameStates_addNewestCloning(&ctx->dec.frames.fed, &frame->state);
-                            ctx->dec.msWithoutFeedFrame = 0;
-                            ctx->dec.isWaitingForIDRFrame = 0;
-                            //stats
-                            plyr->stats.curSec.dec.fed.count++;
-                            //
-                            tryAgain = 1; //search next frame
-                            ctx->dec.frames.fedCount++;
-                            K_LOG_VERBOSE("StreamContext, frame(#%d, with types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) queued to src-buffs (%s), %d states-fed.\n"
-                                          , (frame->state.iSeq + 1)
-                                          , frame->accessUnit.nalsCountPerType[0] ? " 0" : ""
-                                          , frame->accessUnit.nalsCountPerType[1] ? " 1" : ""
-                                          , frame->accessUnit.nalsCountPerType[2] ? " 2" : ""
-                                          , frame->accessUnit.nalsCountPerType[3] ? " 3" : ""
-                                          , frame->accessUnit.nalsCountPerType[4] ? " 4" : ""
-                                          , frame->accessUnit.nalsCountPerType[5] ? " 5" : ""
-                                          , frame->accessUnit.nalsCountPerType[6] ? " 6" : ""
-                                          , frame->accessUnit.nalsCountPerType[7] ? " 7" : ""
-                                          , frame->accessUnit.nalsCountPerType[8] ? " 8" : ""
-                                          , frame->accessUnit.nalsCountPerType[9] ? " 9" : ""
-                                          , frame->accessUnit.nalsCountPerType[10] ? " 10" : ""
-                                          , frame->accessUnit.nalsCountPerType[11] ? " 11" : ""
-                                          , frame->accessUnit.nalsCountPerType[12] ? " 12" : ""
-                                          , frame->accessUnit.nalsCountPerType[13] ? " 13" : ""
-                                          , frame->accessUnit.nalsCountPerType[14] ? " 14" : ""
-                                          , frame->accessUnit.nalsCountPerType[15] ? " 15" : ""
-                                          , frame->accessUnit.nalsCountPerType[16] ? " 16" : ""
-                                          , frame->accessUnit.nalsCountPerType[17] ? " 17" : ""
-                                          , frame->accessUnit.nalsCountPerType[18] ? " 18" : ""
-                                          , frame->accessUnit.nalsCountPerType[19] ? " 19" : ""
-                                          , frame->accessUnit.nalsCountPerType[20] ? " 20" : ""
-                                          , frame->accessUnit.nalsCountPerType[21] ? " 21" : ""
-                                          , frame->accessUnit.nalsCountPerType[22] ? " 22" : ""
-                                          , frame->accessUnit.nalsCountPerType[23] ? " 23" : ""
-                                          , frame->accessUnit.nalsCountPerType[24] ? " 24" : ""
-                                          , frame->accessUnit.nalsCountPerType[25] ? " 25" : ""
-                                          , frame->accessUnit.nalsCountPerType[26] ? " 26" : ""
-                                          , frame->accessUnit.nalsCountPerType[27] ? " 27" : ""
-                                          , frame->accessUnit.nalsCountPerType[28] ? " 28" : ""
-                                          , frame->accessUnit.nalsCountPerType[29] ? " 29" : ""
-                                          , frame->accessUnit.nalsCountPerType[30] ? " 30" : ""
-                                          , frame->accessUnit.nalsCountPerType[31] ? " 31" : ""
-                                          , (buffIsDequeued ? "dequeued" : "unused"), ctx->dec.frames.fed.use);
-                            //start shutdown after this frame
-                            if(ctx->cfg.framesFeedMax > 0 && ctx->dec.frames.fedCount >= ctx->cfg.framesFeedMax && !ctx->shuttingDown.isActive){
-                                const int isPermanent = 1;
-                                if(0 != StreamContext_shutdownStart(ctx, plyr, isPermanent)){
-                                    K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed.\n");
-                                } else {
-                                    K_LOG_INFO("StreamContext, StreamContext_shutdownStart after %d frames fed (user-param 'framesFeedMax').\n", ctx->dec.frames.fedCount);
-                                }
+                        //io_uring: post first read
+                        if(plyr->uring.isActive){
+                            StreamContext_updatePollMaskFile_(ctx, plyr);
+                        }
+                    }
+                    //release (if not consumed)
+                    if(fd >= 0){
+                        StreamContext_fileMapClose_(ctx);
+                        close(fd);
+                        fd = -1;
+                    }
+                }
+            }
+        }
+    }
+    //net
+    if(ctx->net.isResolving || ctx->net.socket > 0 || ctx->net.he.use > 0){
+        ctx->net.msSinceStart += ms;
+    }
+    //net (happy-eyeballs attempts in progress)
+    if(ctx->net.he.use > 0){
+        //race next candidate
+        if(ctx->net.he.msToNext <= ms){
+            ctx->net.he.msToNext = 0;
+            if(ctx->net.he.iNext < ctx->net.he.addrs.use){
+                StreamContext_netAttemptStart_(ctx, plyr);
+            }
+        } else {
+            ctx->net.he.msToNext -= ms;
+        }
+        //timeout
+        if(ctx->cfg.connTimeoutSecs > 0 && ctx->net.msSinceStart > (ctx->cfg.connTimeoutSecs * 1000)){
+            K_LOG_ERROR("StreamContext_tick, net, connection-timeout('%s:%d') after %ds and %d addresses: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->net.msSinceStart / 1000), ctx->net.he.iNext, ctx->cfg.path);
+            StreamContext_netAttemptsClose_(ctx, plyr);
+            StreamContext_netScheduleReconnect_(ctx, plyr);
+        }
+    }
+    //net
+    if(ctx->net.socket > 0){
+        int closeConnn = 0, simConnTimeout = 0, isOutOfScreen = 0;
+        //
+        if(plyr->cfg.dbg.simNetworkTimeout > 0){
+            if((rand() % plyr->cfg.dbg.simNetworkTimeout) == 0){
+                K_LOG_WARN("StreamContext_tick, forcing/simulating a NETWORK timeout (1 / %d prob.): '%s'.\n", plyr->cfg.dbg.simNetworkTimeout, ctx->cfg.path);
+                simConnTimeout = 1;
+            }
+        }
+        //connecting or connected
+        ctx->net.msWithoutSend += ms;
+        ctx->net.msWithoutRecv += ms;
+        ctx->net.reconn.wasVisible = ctx->dec.shouldBeOpen;
+        //adaptive buffers (each second)
+        ctx->net.tune.msAccum += ms;
+        if(ctx->net.tune.msAccum >= 1000){
+            StreamContext_netTuneEval_(ctx, plyr);
+        }
+        //rtp udp (release packets that waited enough for the missing ones)
+        if(ctx->cfg.netProto == ENStreamNetProto_RtpUdp && ctx->net.rtp.jitter.use > 0){
+            struct timeval now;
+            gettimeofday(&now, NULL);
+            StreamContext_rtpJitterDrain_(ctx, plyr, &now, 0);
+        }
+        //shm (release the ring space of frames fed since last tick)
+        if(ctx->cfg.netProto == ENStreamNetProto_Shm){
+            StreamContext_shmRelease_(ctx);
+        }
+        //rtsp session keep-alive (at half the server's timeout)
+        if(ctx->cfg.netProto == ENStreamNetProto_Rtsp && ctx->net.rtsp.state == ENRtspState_Playing){
+            ctx->net.rtsp.msSinceKeepAlive += ms;
+            if(ctx->net.rtsp.msSinceKeepAlive >= (ctx->net.rtsp.timeoutSecs * 500) && ctx->net.req.payCsmd >= ctx->net.req.payUse){
+                ctx->net.rtsp.msSinceKeepAlive = 0;
+                ctx->net.rtsp.cseq++;
+                if(0 != StreamContext_netSendRequest_(ctx, plyr)){
+                    closeConnn = 1;
+                }
+            }
+        }
+        //
+        if(simConnTimeout){
+            K_LOG_ERROR("StreamContext_tick, net, simulated-connection-timeout('%s:%d') after %ds not writting and %ds not reading: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->net.msWithoutSend / 1000), (ctx->net.msWithoutRecv / 1000), ctx->cfg.path);
+            closeConnn = 1;
+        } else if((ctx->cfg.connTimeoutSecs > 0 && ctx->net.msWithoutSend > (ctx->cfg.connTimeoutSecs * 1000) && ctx->net.msWithoutRecv > (ctx->cfg.connTimeoutSecs * 1000))){
+            if(ctx->net.msWithoutSend == ctx->net.msWithoutRecv){
+                //the lastest inactive trigger was both (connection attemp)
+                K_LOG_ERROR("StreamContext_tick, net, connection-timeout('%s:%d') after %ds: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->net.msWithoutSend / 1000), ctx->cfg.path);
+            } else if(ctx->net.msWithoutSend < ctx->net.msWithoutRecv){
+                //the lastest inactive trigger was writting
+                K_LOG_ERROR("StreamContext_tick, net, connection-timeout('%s:%d') after %ds not writting: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->net.msWithoutSend / 1000), ctx->cfg.path);
+            } else {
+                //the lastest inactive trigger was reading
+                K_LOG_ERROR("StreamContext_tick, net, connection-timeout('%s:%d') after %ds not reading: '%s'.\n", ctx->cfg.server, ctx->cfg.port, (ctx->net.msWithoutRecv / 1000), ctx->cfg.path);
+            }
+            closeConnn = 1;
+        } else if(!ctx->cfg.keepAlive && !ctx->dec.shouldBeOpen){
+            K_LOG_VERBOSE("StreamContext_tick, net, closing conn out-of-screen: '%s:%d%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+            closeConnn = 1;
+            isOutOfScreen = 1;
+        }
+        if(closeConnn && ctx->net.socket > 0){
+            Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
+            close(ctx->net.socket);
+            ctx->net.socket = 0;
+            StreamContext_netScheduleReconnect_(ctx, plyr);
+            //replace by a warm connection (for the next stream entering the screen)
+            if(isOutOfScreen && (ctx->cfg.netProto == ENStreamNetProto_Http || ctx->cfg.netProto == ENStreamNetProto_Rtsp)){
+                Player_netPoolWarm(plyr, ctx->cfg.server, ctx->cfg.port);
+            }
+        }
+    } else if(!ctx->net.isResolving && ctx->net.he.use == 0 && ctx->cfg.server != NULL && ctx->cfg.server[0] != '\0' && (ctx->cfg.port > 0 || ctx->cfg.netProto == ENStreamNetProto_Shm) && ctx->cfg.path != NULL && ctx->cfg.path[0] != '\0'){
+        //entering the screen (skip backoff)
+        if(ctx->dec.shouldBeOpen && !ctx->net.reconn.wasVisible && ctx->net.msToReconnect > ms){
+            K_LOG_VERBOSE("StreamContext_tick, net, entering the screen, reconnecting now instead of in %lu ms: '%s'.\n", ctx->net.msToReconnect, ctx->cfg.path);
+            ctx->net.msToReconnect = 0;
+            ctx->net.reconn.stats.curSec.immediate++;
+        }
+        ctx->net.reconn.wasVisible = ctx->dec.shouldBeOpen;
+        //waiting
+        if(ctx->net.msToReconnect <= ms){
+            ctx->net.msToReconnect = 0;
+        } else {
+            ctx->net.msToReconnect -= ms;
+            //if((ctx->net.msToReconnect / 1000) != ((ctx->net.msToReconnect + ms) / 1000)){
+            //    K_LOG_INFO("StreamContext_tick, waiting %d secs to reconnect attempt: '%s'.\n", (ctx->net.msToReconnect / 1000), ctx->cfg.path);
+            //}
+        }
+        //reconnect
+        if(ctx->net.msToReconnect == 0 && (ctx->cfg.keepAlive || ctx->dec.shouldBeOpen)){
+            const int isTcp = (ctx->cfg.netProto == ENStreamNetProto_Http || ctx->cfg.netProto == ENStreamNetProto_Rtsp);
+            const SOCKET warmSckt = (isTcp ? Player_netPoolTake(plyr, ctx->cfg.server, ctx->cfg.port) : 0);
+            if(isTcp && !warmSckt && !Player_netConnectAllowed(plyr, ctx->cfg.server, ctx->cfg.port)){
+                //too many attempts in progress (retry soon, without backoff)
+                ctx->net.msToReconnect = K_NET_CONN_DEFER_MS + (rand() % K_NET_CONN_DEFER_MS);
+                ctx->net.reconn.stats.curSec.deferred++;
+            } else if(!(ctx->shuttingDown.isActive && ctx->shuttingDown.isPermanent)){
+                STNetAddrs hostAddrs; int hostAddrFnd = 0;
+                memset(&hostAddrs, 0, sizeof(hostAddrs));
+                //next attempt (if this one fails)
+                ctx->net.reconn.attempts++;
+                StreamContext_netScheduleReconnect_(ctx, plyr);
+                //reset stat
+                ctx->net.msSinceStart = 0;   //connection start (resolve or socket)
+                ctx->net.msToResolve = 0;    //time since start to resolve host
+                ctx->net.msToConnect = 0;    //time since start to send request
+                ctx->net.msToRespStart = 0;  //time since start to receive response header
+                ctx->net.msToRespHead = 0;   //time since complete to receive response header
+                ctx->net.msToRespBody = 0;   //time since start to receive response body
+                ctx->net.msToFirstUnit = 0;  //time since complete to receive first unit
+                ctx->net.bytesSent      = 0;
+                ctx->net.bytesRcvd      = 0;
+                ctx->net.unitsRcvd      = 0;
+                if(ctx->cfg.netProto == ENStreamNetProto_Shm){
+                    //local producer (no resolve)
+                    StreamContext_shmConnect_(ctx, plyr);
+                } else if(warmSckt){
+                    //warm connection (no resolve, no handshake)
+                    K_LOG_VERBOSE("StreamContext_tick, net, reusing warm conn to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                    StreamContext_netAttachSocket_(ctx, plyr, warmSckt, 1);
+                } else if(0 != Player_dnsResolve(plyr, ctx->cfg.server, &hostAddrs, &hostAddrFnd)){
+                    K_LOG_ERROR("StreamContext_tick, net, Player_dnsResolve failed (start): '%s' / '%s'.\n", ctx->cfg.server, ctx->cfg.path);
+                } else {
+                    //waiting for player's dns record
+                    ctx->net.isResolving = 1;
+                    //cached (connect now)
+                    if(hostAddrFnd){
+                        StreamContext_netResolved_(ctx, plyr, &hostAddrs);
+                    }
+                }
+            } else if(warmSckt){
+                close(warmSckt);
+            }
+        }
+    }
+    //buffs
+    if(ctx->dec.fd >= 0){
+        if(!ctx->dec.shouldBeOpen){
+            if(!ctx->shuttingDown.isActive){
+                const int isPermanent = 0;
+                if(0 != StreamContext_shutdownStart(ctx, plyr, isPermanent)){
+                    K_LOG_ERROR("StreamContext_tick, StreamContext_shutdownStart failed (at tick).\n");
+                }
+            }
+        } else {
+            int simDecoderTimeout = 0;
+            if(plyr->cfg.dbg.simDecoderTimeout > 0){
+                if((rand() % plyr->cfg.dbg.simDecoderTimeout) == 0){
+                    K_LOG_WARN("StreamContext_tick, forcing/simulating a DECODER timeout (1 / %d prob.): '%s'.\n", plyr->cfg.dbg.simDecoderTimeout, ctx->cfg.path);
+                    simDecoderTimeout = 1;
+                }
+            }
+            //
+            ctx->dec.src.msWithoutEnqueuing += ms;
+            ctx->dec.src.msWithoutDequeuing += ms;
+            //
+            ctx->dec.dst.msWithoutEnqueuing += ms;
+            ctx->dec.dst.msWithoutDequeuing += ms;
+            //
+            //Detect decoder timeout
+            if(plyr->cfg.decoderTimeoutSecs > 0 || simDecoderTimeout){
+                if(ctx->dec.src.isExplicitON && ctx->dec.dst.isExplicitON && (simDecoderTimeout || (ctx->dec.dst.msWithoutDequeuing > ctx->dec.msWithoutFeedFrame && (ctx->dec.dst.msWithoutDequeuing - ctx->dec.msWithoutFeedFrame) >= (plyr->cfg.decoderTimeoutSecs * 1000)))){
+                    unsigned long msDecoderInative = (ctx->dec.dst.msWithoutDequeuing - ctx->dec.msWithoutFeedFrame);
+                    if(simDecoderTimeout){
+                        K_LOG_ERROR("StreamContext_tick, simulated-decoder timeout: %u ms inactive while ON and frames arriving: '%s'.\n", msDecoderInative, ctx->cfg.path);
+                    } else {
+                        K_LOG_ERROR("StreamContext_tick, decoder timeout: %u ms inactive while ON and frames arriving: '%s'.\n", msDecoderInative, ctx->cfg.path);
+                    }
+                    {
+                        //IMPORTANT: in raspberry pi-4 'seek' is aparently unsupported,
+                        //           leaking buffers and producing messages
+                        //           "bcm2835_codec_flush_buffers: Timeout waiting for buffers to be returned".
+                        //           Instead of stopping and resuming the src-buffers, is safer to reopen the device file.
+                        //
+                        //shutdown (flagged before starting it, the shutdown could complete at start)
+                        ctx->dec.isFaulty = 1;
+                        if(!ctx->shuttingDown.isActive){
+                            const int isPermanent = 0;
+                            if(0 != StreamContext_shutdownStart(ctx, plyr, isPermanent)){
+                                K_LOG_ERROR("StreamContext_tick, StreamContext_shutdownStart failed (at decoder timeout).\n");
                             }
                         }
+                        ctx->dec.isWaitingForIDRFrame = 1;
+                        ctx->dec.msToReopen = (plyr->cfg.decoderWaitRecopenSecs <= 0 ? 1 : plyr->cfg.decoderWaitRecopenSecs) * 1000;
+                    }
+                    //reset (just in case)
+                    {
+                        ctx->dec.src.msWithoutEnqueuing = 0;
+                        ctx->dec.src.msWithoutDequeuing = 0;
+                        //
+                        ctx->dec.dst.msWithoutEnqueuing = 0;
+                        ctx->dec.dst.msWithoutDequeuing = 0;
+                        //
+                        ctx->dec.msWithoutFeedFrame = 0;
+                    }
+                }
+            }
+        }
+    }
+    //flushing tick
+    if(ctx->flushing.isActive && !ctx->flushing.isCompleted){
+        if(0 != StreamContext_flushTick(ctx, ms, "StreamContext_tick")){
+            K_LOG_WARN("StreamContext_tick, StreamContext_flushTick failed: '%s'.\n", ctx->cfg.path);
+        }
+    }
+    //shutdown tick
+    if(ctx->shuttingDown.isActive && !ctx->shuttingDown.isCompleted){
+        if(0 != StreamContext_shutdownTick(ctx, plyr, ms, "StreamContext_tick")){
+            K_LOG_WARN("StreamContext_tick, StreamContext_shutdownTick failed: '%s'.\n", ctx->cfg.path);
+        }
+    }
+    //
+    if(ctx->dec.fd >= 0){
+        ctx->dec.msOpen += ms;
+    }
+    ctx->dec.msWithoutFeedFrame += ms;
+}
+
+//happy-eyeballs
+
+int StreamContext_netAttemptStart_(STStreamContext* ctx, struct STPlayer_* plyr){
+    int r = -1;
+    while(r != 0 && ctx->net.he.iNext < ctx->net.he.addrs.use){
+        const int iAddr = ctx->net.he.iNext++;
+        STNetConnAttempt* att = &ctx->net.he.attempts[iAddr];
+        const SOCKET sckt = netSocketConnectStart(&ctx->net.he.addrs.arr[iAddr], ctx->cfg.port, ctx->cfg.server, ctx->cfg.path);
+        if(sckt){
+            att->ctx = ctx;
+            att->iAddr = iAddr;
+            if(0 != Player_pollAdd(plyr, ENPlayerPollFdType_SrcConnAttempt, StreamContext_pollCallbackConnAttempt_, att, sckt, POLLOUT)){ //connected
+                K_LOG_ERROR("StreamContext_netAttemptStart_, poll-add-failed to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                close(sckt);
+            } else {
+                att->socket = sckt;
+                ctx->net.he.use++;
+                ctx->net.he.msToNext = K_NET_CONN_ATTEMPT_DELAY_MS;
+                r = 0;
+            }
+        }
+    }
+    return r;
+}
+
+void StreamContext_netAttemptsClose_(STStreamContext* ctx, struct STPlayer_* plyr){
+    int i; for(i = 0; i < K_NET_ADDRS_MAX; i++){
+        STNetConnAttempt* att = &ctx->net.he.attempts[i];
+        if(att->socket > 0){
+            if(plyr != NULL){
+                Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcConnAttempt, att, att->socket);
+            }
+            close(att->socket);
+            att->socket = 0;
+        }
+    }
+    ctx->net.he.use = 0;
+    ctx->net.he.iNext = ctx->net.he.addrs.use;
+}
+
+void StreamContext_pollCallbackConnAttempt_(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, int revents){
+    STNetConnAttempt* att = (STNetConnAttempt*)userParam;
+    STStreamContext* ctx = att->ctx;
+    if(att->socket > 0 && (revents & (POLLOUT | POLLERR | POLLHUP))){
+        const SOCKET sckt = att->socket;
+        const STNetAddr* addr = &ctx->net.he.addrs.arr[att->iAddr];
+        int err = 0; socklen_t errLen = sizeof(err);
+        if(getsockopt(sckt, SOL_SOCKET, SO_ERROR, &err, &errLen) != 0){
+            err = errno;
+        }
+        //not an attempt anymore
+        Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcConnAttempt, att, sckt);
+        att->socket = 0;
+        ctx->net.he.use--;
+        if(err != 0 || !(revents & POLLOUT)){
+            //failed (race the next candidate now)
+            K_LOG_WARN("StreamContext, net, connect failed to '%s:%d' (%s, candidate #%d, errno %d): '%s'.\n", ctx->cfg.server, ctx->cfg.port, (addr->family == AF_INET6 ? "ipv6" : "ipv4"), (att->iAddr + 1), err, ctx->cfg.path);
+            close(sckt);
+            if(0 != StreamContext_netAttemptStart_(ctx, plyr) && ctx->net.he.use <= 0){
+                K_LOG_ERROR("StreamContext, net, connect failed to all %d addresses of '%s:%d': '%s'.\n", ctx->net.he.addrs.use, ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                StreamContext_netScheduleReconnect_(ctx, plyr);
+            }
+        } else {
+            //winner (the other attempts are discarded)
+            STNetPool* pool = Player_netPoolGet(plyr, ctx->cfg.server, ctx->cfg.port, 1);
+            K_LOG_VERBOSE("StreamContext, net, connected to '%s:%d' (%s, candidate #%d of %d started): '%s'.\n", ctx->cfg.server, ctx->cfg.port, (addr->family == AF_INET6 ? "ipv6" : "ipv4"), (att->iAddr + 1), ctx->net.he.iNext, ctx->cfg.path);
+            if(pool != NULL){
+                pool->addr = *addr; //for warm connections
+                pool->isAddrSet = 1;
+                pool->stats.curSec.connsNew++;
+            }
+            StreamContext_netAttemptsClose_(ctx, plyr);
+            StreamContext_netAttachSocket_(ctx, plyr, sckt, 0);
+        }
+    }
+}
+
+void StreamContext_netResolved_(STStreamContext* ctx, struct STPlayer_* plyr, const STNetAddrs* hostAddrs){
+    ctx->net.isResolving = 0;
+    if(hostAddrs == NULL || hostAddrs->use <= 0){
+        K_LOG_ERROR("StreamContext_netResolved_, net, host-addr-not-found('%s'): '%s'.\n", ctx->cfg.server, ctx->cfg.path);
+    } else if(ctx->net.socket > 0 || ctx->net.he.use > 0){
+        K_LOG_VERBOSE("StreamContext_netResolved_, net, already connected to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+    } else if(ctx->cfg.netProto == ENStreamNetProto_RtpUdp){
+        const SOCKET sckt = netSocketUdpBind(&hostAddrs->arr[0], ctx->cfg.port, ctx->cfg.server, ctx->cfg.path);
+        if(sckt){
+            StreamContext_netAttachUdp_(ctx, plyr, sckt);
+        }
+    } else {
+        //race the candidates (first one now, next ones after a delay or a failure)
+        ctx->net.he.addrs = *hostAddrs;
+        ctx->net.he.iNext = 0;
+        ctx->net.he.use = 0;
+        if(0 != StreamContext_netAttemptStart_(ctx, plyr)){
+            K_LOG_ERROR("StreamContext_netResolved_, net, no connection could be started to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+        }
+        ctx->net.msToResolve = ctx->net.msSinceStart;
+        if(ctx->net.msToResolve > 1000){
+            K_LOG_INFO("StreamContext_netResolved_, %lu ms to resolve-host: '%s'.\n", ctx->net.msToResolve, ctx->cfg.path);
+        } else {
+            K_LOG_VERBOSE("StreamContext_netResolved_, %lu ms to resolve-host: '%s'.\n", ctx->net.msToResolve, ctx->cfg.path);
+        }
+    }
+}
+
+void StreamContext_netBuildRequest_(STStreamContext* ctx){
+    const int reqSz = StreamContext_concatRequest(ctx, ctx->net.req.pay, ctx->net.req.paySz);
+    if((reqSz + 1) <= ctx->net.req.paySz){ //+1 for '\0' for printing
+        ctx->net.req.pay[reqSz] = '\0';
+        ctx->net.req.payUse     = reqSz;
+        ctx->net.req.payCsmd    = 0;
+        K_LOG_VERBOSE("StreamContext_netBuildRequest_, net req built (reused %d/%d buffer): '%s'.\n", ctx->net.req.payUse, ctx->net.req.paySz, ctx->cfg.path);
+    } else {
+        if(ctx->net.req.pay != NULL){
+            free(ctx->net.req.pay);
+            ctx->net.req.pay = NULL;
+        }
+        ctx->net.req.paySz      = reqSz + 1; //+1 for '\0' for printing
+        ctx->net.req.pay        = (char*)malloc(ctx->net.req.paySz);
+        ctx->net.req.payUse     = StreamContext_concatRequest(ctx, ctx->net.req.pay, ctx->net.req.paySz);
+        ctx->net.req.payCsmd    = 0;
+        ctx->net.req.pay[ctx->net.req.payUse] = '\0';
+        K_LOG_VERBOSE("StreamContext_netBuildRequest_, net req built (new %d/%d buffer): '%s'.\n", ctx->net.req.payUse, ctx->net.req.paySz, ctx->cfg.path);
+    }
+}
+
+void StreamContext_netAttachSocket_(STStreamContext* ctx, struct STPlayer_* plyr, SOCKET sckt, const int isReused){
+    ctx->net.isReusedConn = isReused;
+    //add to pollster
+    if(0 != Player_pollAdd(plyr, ENPlayerPollFdType_SrcSocket, StreamContext_pollCallback, ctx, sckt, POLLOUT)){ //write (reused sockets are already writable)
+        K_LOG_ERROR("StreamContext_netAttachSocket_, poll-add-failed to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+        close(sckt);
+        sckt = 0;
+    } else {
+        K_LOG_VERBOSE("StreamContext_netAttachSocket_, socket added to poll: '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+        ctx->net.socket = sckt;
+        ctx->net.msWithoutSend = 0;
+        ctx->net.msWithoutRecv = 0;
+        //options (unix sockets ignore them)
+        if(plyr->cfg.netTcpNoDelay && ctx->cfg.netProto != ENStreamNetProto_Shm){
+            const int v = 1;
+            if(setsockopt(sckt, IPPROTO_TCP, TCP_NODELAY, &v, sizeof(v)) != 0){
+                K_LOG_WARN("StreamContext_netAttachSocket_, TCP_NODELAY failed: '%s'.\n", ctx->cfg.path);
+            }
+        }
+    }
+    //reset vars
+    {
+        ctx->net.resp.headerSz = 0;
+        ctx->net.resp.headerEnded = 0;
+        ctx->net.resp.statusCode = 0;
+        ctx->net.resp.isChunked = 0;
+        ctx->net.resp.line.use = 0;
+        ctx->net.resp.line.count = 0;
+        ctx->net.resp.chunk.state = ENHttpChunkState_Size;
+        ctx->net.resp.chunk.sizeDigits = 0;
+        ctx->net.resp.chunk.remain = 0;
+        ctx->net.resp.contentLength = -1;
+        ctx->net.resp.part.delimLen = 0;
+        ctx->net.resp.part.state = ENHttpPartState_Boundary;
+        ctx->net.resp.part.delimMatched = 0;
+        //rtsp (requests sequence restarts)
+        ctx->net.rtsp.state = ENRtspState_Describe;
+        ctx->net.rtsp.cseq = 1;
+        ctx->net.rtsp.bodyRemain = 0;
+        ctx->net.rtsp.isVideoMedia = 0;
+        ctx->net.rtsp.isCodecMismatch = 0;
+        ctx->net.rtsp.timeoutSecs = K_RTSP_SESSION_TIMEOUT_SECS;
+        ctx->net.rtsp.msSinceKeepAlive = 0;
+        if(strchr(ctx->cfg.server, ':') != NULL){
+            snprintf(ctx->net.rtsp.base, sizeof(ctx->net.rtsp.base), "rtsp://[%s]:%d%s", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path); //ipv6 literal
+        } else {
+            snprintf(ctx->net.rtsp.base, sizeof(ctx->net.rtsp.base), "rtsp://%s:%d%s", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+        }
+        ctx->net.rtsp.control[0] = '\0';
+        ctx->net.rtsp.session[0] = '\0';
+        ctx->net.rtsp.itl.state = ENRtspItlState_Magic;
+        ctx->net.rtsp.itl.use = 0;
+        ctx->net.rtp.isSeqSet = 0;
+        ctx->net.rtp.isFuActive = 0;
+        //
+        ctx->buff.buffUse = 0;
+        ctx->buff.buffCsmd = 0;
+        //
+        ctx->buff.nal.zeroesSeqAccum    = 0;   //reading posible headers '0x00 0x00 0x00 0x01' (start of a NAL)
+        //ctx->buff.nal.startsCount = 0;    //total NALs found
+        //
+        ctx->frames.fillingNalSz = 0;
+        if(ctx->frames.filling != NULL){
+            //add for future pull (reuse)
+            if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, ctx->frames.filling)){
+                K_LOG_INFO("StreamContext_netAttachSocket_, VideoFrames_pushFrameOwning failed: '%s'.\n", ctx->cfg.path);
+                VideoFrame_release(ctx->frames.filling);
+                free(ctx->frames.filling);
+            }
+            ctx->frames.filling = NULL;
+        }
+    }
+    //sizes (by the bitrate of previous connections)
+    ctx->net.tune.bytesRcvdPrev = ctx->net.bytesRcvd;
+    ctx->net.tune.msAccum = 0;
+    ctx->net.tune.rcvLowat = 0;
+    StreamContext_netTuneApply_(ctx, plyr);
+    //build request
+    StreamContext_netBuildRequest_(ctx);
+}
+
+void StreamContext_netAttachUdp_(STStreamContext* ctx, struct STPlayer_* plyr, SOCKET sckt){
+    //buffers (allocated once, kept between reconnections)
+    if(ctx->net.rtp.jitter.slots == NULL){
+        ctx->net.rtp.jitter.slots = (STRtpPkt*)malloc(sizeof(STRtpPkt) * K_RTP_JITTER_SLOTS);
+    }
+    if(ctx->net.rtp.batch.msgs == NULL){
+        ctx->net.rtp.batch.msgs = (struct mmsghdr*)malloc(sizeof(struct mmsghdr) * K_RTP_UDP_BATCH);
+    }
+    if(ctx->net.rtp.batch.iovs == NULL){
+        ctx->net.rtp.batch.iovs = (struct iovec*)malloc(sizeof(struct iovec) * K_RTP_UDP_BATCH);
+    }
+    if(ctx->net.rtp.batch.buff == NULL){
+        ctx->net.rtp.batch.buff = (unsigned char*)malloc(K_RTP_UDP_BATCH * K_RTP_PKT_MAX);
+    }
+    if(ctx->net.rtp.jitter.slots == NULL || ctx->net.rtp.batch.msgs == NULL || ctx->net.rtp.batch.iovs == NULL || ctx->net.rtp.batch.buff == NULL){
+        K_LOG_ERROR("StreamContext_netAttachUdp_, rtp buffers allocation failed: '%s'.\n", ctx->cfg.path);
+        close(sckt);
+        sckt = 0;
+    } else if(0 != Player_pollAdd(plyr, ENPlayerPollFdType_SrcSocket, StreamContext_pollCallback, ctx, sckt, POLLIN)){ //read-only
+        K_LOG_ERROR("StreamContext_netAttachUdp_, poll-add-failed to '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+        close(sckt);
+        sckt = 0;
+    } else {
+        K_LOG_VERBOSE("StreamContext_netAttachUdp_, socket added to poll: '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+        ctx->net.socket = sckt;
+        ctx->net.isReusedConn = 0;
+        ctx->net.msWithoutSend = 0;
+        ctx->net.msWithoutRecv = 0;
+        //sizes (udp: SO_RCVBUF only)
+        ctx->net.tune.bytesRcvdPrev = ctx->net.bytesRcvd;
+        ctx->net.tune.msAccum = 0;
+        StreamContext_netTuneApply_(ctx, plyr);
+        //reset vars
+        memset(ctx->net.rtp.jitter.slots, 0, sizeof(STRtpPkt) * K_RTP_JITTER_SLOTS);
+        ctx->net.rtp.jitter.isSeqSet = 0;
+        ctx->net.rtp.jitter.use = 0;
+        ctx->net.rtp.isSeqSet = 0;
+        ctx->net.rtp.isFuActive = 0;
+        //link batch buffers
+        {
+            int i; for(i = 0; i < K_RTP_UDP_BATCH; i++){
+                ctx->net.rtp.batch.iovs[i].iov_base = &ctx->net.rtp.batch.buff[i * K_RTP_PKT_MAX];
+                ctx->net.rtp.batch.iovs[i].iov_len  = K_RTP_PKT_MAX;
+                memset(&ctx->net.rtp.batch.msgs[i], 0, sizeof(ctx->net.rtp.batch.msgs[i]));
+                ctx->net.rtp.batch.msgs[i].msg_hdr.msg_iov      = &ctx->net.rtp.batch.iovs[i];
+                ctx->net.rtp.batch.msgs[i].msg_hdr.msg_iovlen   = 1;
+            }
+        }
+    }
+}
+
+int StreamContext_flushStart(STStreamContext* ctx){
+    int r = -1;
+    if(!ctx->flushing.isActive){
+        r = 0;
+        memset(&ctx->flushing, 0, sizeof(ctx->flushing));
+        ctx->flushing.isActive = 1;
+        if(ctx->dec.fd < 0){
+            //K_LOG_INFO("StreamContext, flushStart  starting and completed (no decoder open).\n");
+            ctx->flushing.isSrcDone = 1;
+            ctx->flushing.isCompleted = 1;
+        } else {
+            //K_LOG_INFO("StreamContext, flushStart  starting.\n");
+            //flush-tick once to porgress now if posible
+            if(0 != StreamContext_flushTick(ctx, 0, "StreamContext_flushStart")){
+                K_LOG_ERROR("StreamContext_flushStart, StreamContext_flushTick failed.\n");
+                r = -1;
+            }
+        }
+    }
+    return r;
+}
+
+int StreamContext_flushTick(STStreamContext* ctx, const int ms, const char* srcLocation){
+    int r = -1;
+    if(ctx->flushing.isActive && !ctx->flushing.isCompleted){
+        r = 0;
+        ctx->flushing.msAccum += ms;
+        //
+        if(ctx->dec.fd < 0){
+            if(!ctx->flushing.isSrcDone || !ctx->flushing.isCompleted){
+                K_LOG_WARN("StreamContext, device closed before flushing (%ums) (at '%s').\n", ctx->flushing.msAccum, srcLocation);
+                ctx->flushing.isSrcDone = 1;
+                ctx->flushing.isCompleted = 1;
+            }
+        } else {
+            //src
+            if(!ctx->flushing.isSrcDone){
+                //try to dequeue bufer
+                while(ctx->dec.src.enqueuedCount > 0){
+                    STBuffer* buff = NULL;
+                    if(0 != Buffers_dequeue(&ctx->dec.src, ctx->dec.fd, &buff, NULL)){
+                        buff = NULL;
+                        break;
+                    }
+                }
+                if(ctx->dec.src.enqueuedCount == 0){
+                    //K_LOG_INFO("StreamContext, flushing src-completed (%ums) (at '%s').\n", ctx->flushing.msAccum, srcLocation);
+                    ctx->flushing.isSrcDone = 1;
+                }
+            }
+            //dst
+            if(ctx->flushing.isSrcDone && !ctx->flushing.isCompleted){
+                //only flush src
+                ctx->flushing.isCompleted = 1;
+                //K_LOG_INFO("StreamContext, flushing completed (%ums) (at '%s').\n", ctx->flushing.msAccum, srcLocation);
+                /*
+                //try to dequeue bufer
+                while(ctx->dec.dst.enqueuedCount > 0){
+                    STBuffer* buff = NULL;
+                    if(0 != Buffers_dequeue(&ctx->dec.dst, ctx->dec.fd, &buff, NULL)){
+                        buff = NULL;
+                        break;
+                    }
+                }
+                if(ctx->dec.dst.enqueuedCount == 0){
+                    K_LOG_INFO("StreamContext, flushing src-dst-completed (%ums) (at '%s').\n", ctx->flushing.msAccum, srcLocation);
+                    ctx->flushing.isCompleted = 1;
+                }*/
+            }
+            //timeout
+            if(ctx->flushing.msAccum > (250) && (!ctx->flushing.isSrcDone || !ctx->flushing.isCompleted)){
+                K_LOG_WARN("StreamContext, flushing timeout(%ums), %d buffers still in src-queue and %d in dst-queue (at '%s').\n", ctx->flushing.msAccum, ctx->dec.src.enqueuedCount, ctx->dec.dst.enqueuedCount, srcLocation);
+                ctx->flushing.isSrcDone = 1;
+                ctx->flushing.isCompleted = 1;
+            }
+        }
+    }
+    return r;
+}
+
+int StreamContext_shutdownStart(STStreamContext* ctx, struct STPlayer_* plyr, const int isPermanent){
+    int r = -1;
+    if(!ctx->shuttingDown.isActive){
+        r = 0;
+        //activate
+        memset(&ctx->shuttingDown, 0, sizeof(ctx->shuttingDown));
+        ctx->shuttingDown.isActive = 1;
+        ctx->shuttingDown.isPermanent = isPermanent;
+        //activate flush
+        if(!ctx->flushing.isActive){
+            if(0 != StreamContext_flushStart(ctx)){
+                K_LOG_ERROR("StreamContext_shutdownStart, StreamContext_flushStart failed.\n");
+                r = -1;
+            }
+        }
+        if(ctx->dec.fd < 0){
+            //K_LOG_INFO("StreamContext, shutdown starting and completed (no decoder open).\n");
+            ctx->shuttingDown.isCompleted = 1;
+        } else {
+            //K_LOG_INFO("StreamContext, shutdown starting.\n");
+            //shutdown-tick once to porgress now if posible
+            if(0 != StreamContext_shutdownTick(ctx, plyr, 0, "StreamContext_shutdownStart")){
+                K_LOG_ERROR("StreamContext_shutdownStart, StreamContext_shutdownTick failed.\n");
+                r = -1;
+            }
+        }
+    }
+    return r;
+}
+
+int StreamContext_shutdownTick(STStreamContext* ctx, struct STPlayer_* plyr, const int ms, const char* srcLocation){
+    int r = -1;
+    if(ctx->shuttingDown.isActive && !ctx->shuttingDown.isCompleted){
+        r = 0;
+        ctx->shuttingDown.msAccum += ms;
+        //
+        if(ctx->dec.fd < 0){
+            if(!ctx->shuttingDown.isCompleted){
+                K_LOG_WARN("StreamContext, device closed before shutting-down (%ums) (at '%s').\n", ctx->shuttingDown.msAccum, srcLocation);
+                ctx->shuttingDown.isCompleted = 1;
+            }
+        } else {
+            //
+            if(ctx->flushing.isCompleted){
+                //K_LOG_INFO("StreamContext, shutting-down-completed (%ums) (at '%s').\n", ctx->shuttingDown.msAccum, srcLocation);
+                ctx->shuttingDown.isCompleted = 1;
+                //flushed, the decoder can be handed to the next stream (unless it timed-out)
+                if(0 != StreamContext_park(ctx, plyr)){
+                    K_LOG_WARN("StreamContext_close failed: '%s' (at shutdown completion) (at '%s').\n", ctx->cfg.path, srcLocation);
+                } else {
+                    K_LOG_VERBOSE("StreamContext(%lld), shutdown completed %ums: '%s' (at shutdown completion) (at '%s').\n", (long long)ctx, ctx->shuttingDown.msAccum, ctx->cfg.path, srcLocation);
+                    K_ASSERT(ctx->dec.fd < 0)
+                }
+            }
+            //timeout
+            if(!ctx->shuttingDown.isCompleted && ctx->shuttingDown.msAccum > (500)){
+                K_LOG_WARN("StreamContext, shutting-down timeout(%ums), %d buffers still in src-queue and %d in dst-queue (at '%s').\n", ctx->shuttingDown.msAccum, ctx->dec.src.enqueuedCount, ctx->dec.dst.enqueuedCount, srcLocation);
+                ctx->shuttingDown.isCompleted = 1;
+                if(0 != StreamContext_close(ctx, plyr)){
+                    K_LOG_WARN("StreamContext_close failed: '%s' (at shutdown timeout) (at '%s').\n", ctx->cfg.path, srcLocation);
+                }
+            }
+        }
+    }
+    return r;
+}
+
+
+int StreamContext_cnsmRespHttpHeaderLine_(STStreamContext* ctx, const char* line, const int lineLen){
+    int r = 0;
+    if(ctx->net.resp.line.count == 0){
+        //status-line: 'HTTP/1.1 200 OK' or 'RTSP/1.0 200 OK'
+        const char* proto = (ctx->cfg.netProto == ENStreamNetProto_Rtsp ? "RTSP/" : "HTTP/");
+        const char* sp = (lineLen > 5 && strncmp(line, proto, 5) == 0 ? strchr(line, ' ') : NULL);
+        if(sp == NULL){
+            K_LOG_ERROR("StreamContext, net, response status-line not valid ('%s'): '%s'.\n", line, ctx->cfg.path);
+            r = -1;
+        } else {
+            ctx->net.resp.statusCode = atoi(sp + 1);
+            if(ctx->net.resp.statusCode < 200 || ctx->net.resp.statusCode > 299){
+                K_LOG_ERROR("StreamContext, net, response status '%s' from '%s:%d': '%s'.\n", (sp + 1), ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                r = -1;
+            }
+        }
+    } else {
+        //header: 'Name: value'
+        const char* colon = strchr(line, ':');
+        if(colon != NULL){
+            const int nameLen = (int)(colon - line);
+            const char* val = colon + 1;
+            while(*val == ' ' || *val == '\t') val++;
+            if(nameLen == 14 && strncasecmp(line, "Content-Length", 14) == 0){
+                ctx->net.resp.contentLength = atoi(val);
+            } else if(ctx->cfg.netProto == ENStreamNetProto_Rtsp){
+                if(nameLen == 7 && strncasecmp(line, "Session", 7) == 0){
+                    //'Session: id;timeout=60'
+                    const char* tm = strstr(val, "timeout=");
+                    int i = 0;
+                    while(val[i] != '\0' && val[i] != ';' && val[i] != ' ' && (i + 1) < (int)sizeof(ctx->net.rtsp.session)){
+                        ctx->net.rtsp.session[i] = val[i];
+                        i++;
+                    }
+                    ctx->net.rtsp.session[i] = '\0';
+                    if(tm != NULL && atoi(tm + 8) > 0){
+                        ctx->net.rtsp.timeoutSecs = atoi(tm + 8);
+                    }
+                } else if(nameLen == 12 && strncasecmp(line, "Content-Base", 12) == 0 && val[0] != '\0'){
+                    snprintf(ctx->net.rtsp.base, sizeof(ctx->net.rtsp.base), "%s", val);
+                }
+            } else if(nameLen == 17 && strncasecmp(line, "Transfer-Encoding", 17) == 0){
+                if(strcasestr(val, "chunked") != NULL){
+                    K_LOG_VERBOSE("StreamContext, net, response body is chunked: '%s'.\n", ctx->cfg.path);
+                    ctx->net.resp.isChunked = 1;
+                }
+            } else if(nameLen == 12 && strncasecmp(line, "Content-Type", 12) == 0){
+                //error pages (html or plain text) instead of a stream
+                if(strncasecmp(val, "text/", 5) == 0){
+                    K_LOG_ERROR("StreamContext, net, response content-type '%s' from '%s:%d': '%s'.\n", val, ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                    r = -1;
+                } else if(strncasecmp(val, "multipart/", 10) == 0){
+                    //'multipart/x-mixed-replace; boundary=xyz' (MJPEG), parts are delimited by '\r\n--xyz'
+                    const char* bnd = strcasestr(val, "boundary=");
+                    int i = 0, n = 4;
+                    if(bnd != NULL){
+                        bnd += 9;
+                        if(*bnd == '"') bnd++;
+                        memcpy(ctx->net.resp.part.delim, "\r\n--", 4);
+                        while(bnd[i] != '\0' && bnd[i] != '"' && bnd[i] != ';' && bnd[i] != ' ' && (n + 1) < K_HTTP_BOUNDARY_MAX){
+                            ctx->net.resp.part.delim[n++] = bnd[i++];
+                        }
+                        ctx->net.resp.part.delim[n] = '\0';
+                    }
+                    if(i == 0){
+                        K_LOG_ERROR("StreamContext, net, response content-type '%s' without boundary from '%s:%d': '%s'.\n", val, ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                        r = -1;
+                    } else {
+                        K_LOG_VERBOSE("StreamContext, net, response body is multipart (boundary '%s'): '%s'.\n", &ctx->net.resp.part.delim[4], ctx->cfg.path);
+                        ctx->net.resp.part.delimLen = n;
+                        ctx->net.resp.part.state = ENHttpPartState_Boundary;
+                        ctx->net.resp.part.delimMatched = 2; //first delimiter has no leading CRLF
+                    }
+                }
+            }
+        }
+    }
+    return r;
+}
+
+int StreamContext_cnsmRespHttpHeader_(STStreamContext* ctx){ //-1 = response rejected
+    int r = 0;
+    while(r == 0 && !ctx->net.resp.headerEnded && ctx->buff.buffCsmd < ctx->buff.buffUse){
+        const unsigned char c = ctx->buff.buff[ctx->buff.buffCsmd];
+        if(c == '\n'){
+            //line completed (without '\r')
+            int lineLen = ctx->net.resp.line.use;
+            if(lineLen > 0 && ctx->net.resp.line.str[lineLen - 1] == '\r'){
+                lineLen--;
+            }
+            ctx->net.resp.line.str[lineLen] = '\0';
+            if(lineLen == 0){
+                if(ctx->net.resp.line.count > 0){
+                    ctx->net.resp.headerEnded = 1;
+                    K_LOG_VERBOSE("StreamContext, net, response body started (after %d bytes header, status %d%s).\n", (ctx->net.resp.headerSz + 1), ctx->net.resp.statusCode, (ctx->net.resp.isChunked ? ", chunked" : ""));
+                    //print
+                    {
+                        if((ctx->buff.buffCsmd + 1) < ctx->buff.buffSz){
+                            unsigned char b = ctx->buff.buff[ctx->buff.buffCsmd + 1];
+                            ctx->buff.buff[ctx->buff.buffCsmd + 1] = '\0';
+                            K_LOG_VERBOSE("StreamContext, net, response header (last-read):\n-->%s<--.\n", &ctx->buff.buff[0]);
+                            ctx->buff.buff[ctx->buff.buffCsmd + 1] = b;
+                        }
+                    }
+                }
+            } else {
+                r = StreamContext_cnsmRespHttpHeaderLine_(ctx, ctx->net.resp.line.str, lineLen);
+                ctx->net.resp.line.count++;
+            }
+            ctx->net.resp.line.use = 0;
+        } else if((ctx->net.resp.line.use + 1) < K_HTTP_LINE_MAX){
+            //accumulate (longer lines are truncated)
+            ctx->net.resp.line.str[ctx->net.resp.line.use++] = (char)c;
+        }
+        ctx->net.resp.headerSz++;
+        ctx->buff.buffCsmd++;
+    }
+    return r;
+}
+
+//Removes the chunks framing from 'buff[buffCsmd, buffUse)', moving the payloads
+//backwards inside the same buffer; 'buffUse' is reduced accordingly.
+int StreamContext_cnsmRespHttpChunked_(STStreamContext* ctx){ //0 = continue, 1 = last-chunk found, -1 = malformed
+    int r = 0;
+    unsigned char* buff = ctx->buff.buff;
+    int iRd = ctx->buff.buffCsmd, iWr = ctx->buff.buffCsmd;
+    while(r == 0 && iRd < ctx->buff.buffUse){
+        if(ctx->net.resp.chunk.state == ENHttpChunkState_Data){
+            //payload span (moved only after framing was removed)
+            int spanSz = (ctx->buff.buffUse - iRd);
+            if((unsigned long)spanSz > ctx->net.resp.chunk.remain){
+                spanSz = (int)ctx->net.resp.chunk.remain;
+            }
+            if(iWr != iRd){
+                memmove(&buff[iWr], &buff[iRd], spanSz);
+            }
+            iWr += spanSz;
+            iRd += spanSz;
+            ctx->net.resp.chunk.remain -= spanSz;
+            if(ctx->net.resp.chunk.remain == 0){
+                ctx->net.resp.chunk.state = ENHttpChunkState_DataCR;
+            }
+        } else {
+            const unsigned char c = buff[iRd++];
+            int sizeLineEnded = 0;
+            switch(ctx->net.resp.chunk.state){
+                case ENHttpChunkState_Size:
+                    if((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')){
+                        const int v = (c <= '9' ? c - '0' : c <= 'F' ? c - 'A' + 10 : c - 'a' + 10);
+                        if(ctx->net.resp.chunk.sizeDigits >= 7){
+                            r = -1; //chunk too big
+                        } else {
+                            ctx->net.resp.chunk.remain = (ctx->net.resp.chunk.remain * 16) + v;
+                            ctx->net.resp.chunk.sizeDigits++;
+                        }
+                    } else if(ctx->net.resp.chunk.sizeDigits <= 0){
+                        r = -1;
+                    } else if(c == ';' || c == ' ' || c == '\t'){
+                        ctx->net.resp.chunk.state = ENHttpChunkState_Ext;
+                    } else if(c == '\r'){
+                        ctx->net.resp.chunk.state = ENHttpChunkState_SizeLF;
+                    } else if(c == '\n'){
+                        sizeLineEnded = 1;
+                    } else {
+                        r = -1;
+                    }
+                    break;
+                case ENHttpChunkState_Ext:
+                    if(c == '\r'){
+                        ctx->net.resp.chunk.state = ENHttpChunkState_SizeLF;
+                    } else if(c == '\n'){
+                        sizeLineEnded = 1;
+                    }
+                    break;
+                case ENHttpChunkState_SizeLF:
+                    if(c == '\n'){
+                        sizeLineEnded = 1;
+                    } else {
+                        r = -1;
+                    }
+                    break;
+                case ENHttpChunkState_DataCR:
+                    if(c == '\r'){
+                        ctx->net.resp.chunk.state = ENHttpChunkState_DataLF;
+                    } else if(c == '\n'){
+                        ctx->net.resp.chunk.state = ENHttpChunkState_Size;
+                    } else {
+                        r = -1;
+                    }
+                    break;
+                case ENHttpChunkState_DataLF:
+                    if(c == '\n'){
+                        ctx->net.resp.chunk.state = ENHttpChunkState_Size;
+                    } else {
+                        r = -1;
+                    }
+                    break;
+                case ENHttpChunkState_Trailer:
+                    //ignored
+                    break;
+                default:
+                    //program-logic error
+                    r = -1;
+                    break;
+            }
+            if(sizeLineEnded){
+                ctx->net.resp.chunk.sizeDigits = 0;
+                if(ctx->net.resp.chunk.remain == 0){
+                    ctx->net.resp.chunk.state = ENHttpChunkState_Trailer;
+                    r = 1;
+                } else {
+                    ctx->net.resp.chunk.state = ENHttpChunkState_Data;
+                }
+            }
+        }
+    }
+    ctx->buff.buffUse = iWr;
+    return r;
+}
+
+int StreamContext_getPollEventsMask(STStreamContext* ctx){
+    int events = POLLERR | POLLPRI;
+    //src-events only if dst-is-runnning
+    /*
+    if(ctx->dec.src.isExplicitON && ctx->dec.src.isImplicitON && ctx->dec.dst.isExplicitON && ctx->dec.dst.isImplicitON){
+        if(VideoFrames_getFramesForReadCount(&ctx->frames.filled) > 0){
+            events |= POLLOUT | POLLWRNORM; //src
+        }
+        events |= POLLIN | POLLRDNORM; //dst
+    }
+    */
+    //src-events and dst-events indepently
+    if(ctx->dec.src.isExplicitON && ctx->dec.src.isImplicitON){
+        if(!ctx->flushing.isActive && VideoFrames_getFramesForReadCount(&ctx->frames.filled) > 0){
+            events |= POLLOUT | POLLWRNORM; //src
+        }
+        if(ctx->dec.dst.isExplicitON && ctx->dec.dst.isImplicitON){
+            events |= POLLIN | POLLRDNORM; //dst
+        }
+    }
+    return events;
+}
+
+void StreamContext_updatePollMask_(STStreamContext* ctx, struct STPlayer_* plyr){
+    int events = StreamContext_getPollEventsMask(ctx), eventsBefore = 0;
+    if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_Decoder, ctx, ctx->dec.fd, events, &eventsBefore)){ //read
+        K_LOG_ERROR("poll-update-failed to '%s'.\n", ctx->cfg.path);
+    } else {
+        if(eventsBefore != events){
+            //
+            if((eventsBefore & (POLLERR)) != (events & (POLLERR))){
+                K_LOG_VERBOSE("StreamContext, poll-mask: %cerr.\n", (eventsBefore & (POLLERR)) ? '-' : '+');
+            }
+            if((eventsBefore & (POLLPRI)) != (events & (POLLPRI))){
+                K_LOG_VERBOSE("StreamContext, poll-mask: %cevents.\n", (eventsBefore & (POLLPRI)) ? '-' : '+');
+            }
+            if((eventsBefore & (POLLOUT | POLLWRNORM)) != (events & (POLLOUT | POLLWRNORM))){
+                K_LOG_VERBOSE("StreamContext, poll-mask: %csrc.\n", (eventsBefore & (POLLOUT | POLLWRNORM)) ? '-' : '+');
+            }
+            if((eventsBefore & (POLLIN | POLLRDNORM)) != (events & (POLLIN | POLLRDNORM))){
+                K_LOG_VERBOSE("StreamContext, poll-mask: %cdst.\n", (eventsBefore & (POLLIN | POLLRDNORM)) ? '-' : '+');
+            }
+            //
+            K_LOG_VERBOSE("StreamContext, device-poll listening:%s%s%s%s%s.\n", (events & POLLERR) ? " errors" : "", (events & POLLPRI) ? " events": "", (events & (POLLOUT | POLLWRNORM)) ? " src": "", (events & (POLLIN | POLLRDNORM)) ? " dst": "", (events & (POLLERR | POLLPRI | POLLOUT | POLLWRNORM | POLLIN | POLLRDNORM)) == 0 ? "none" : "");
+        }
+    }
+}
+
+int StreamContext_getPollEventsMaskFile(STStreamContext* ctx, struct STPlayer_* plyr){
+    int events = POLLERR;
+    //src-events and dst-events indepently
+    if(!ctx->flushing.isActive //not flushing src
+       && ctx->file.map == NULL //mapped files are parsed at tick
+       && (ctx->buff.screenRefreshSeqBlocking == 0 || ctx->buff.screenRefreshSeqBlocking != plyr->anim.tickSeq) //not waiting for screen change
+       ){
+        events |= POLLIN;
+    }
+    return events;
+}
+
+void StreamContext_updatePollMaskFile_(STStreamContext* ctx, struct STPlayer_* plyr){
+    if(ctx->file.fd >= 0 && plyr->uring.isActive){
+        //io_uring: post a read instead of polling
+        const int mask = StreamContext_getPollEventsMaskFile(ctx, plyr);
+        if((mask & POLLIN) && StreamContext_uringPostRead_(ctx, plyr, ENPlayerPollFdType_SrcFile) < 0){
+            const char* reason = "uring-post-failed";
+            if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
+                K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
+            }
+        }
+    } else if(ctx->file.fd >= 0){
+        const int mask = StreamContext_getPollEventsMaskFile(ctx, plyr);
+        if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_SrcFile, ctx, ctx->file.fd, mask, NULL)){ //read
+            const char* reason = "poll-update-failed";
+            if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
+                K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
+            }
+        }
+    }
+}
+
+//zero-copy feed (OUTPUT buffers)
+
+void StreamContext_spsFound_(STStreamContext* ctx, struct STPlayer_* plyr, const unsigned char* nal, const int nalSz){
+    STH264Sps sps;
+    if(0 != H264Sps_parse(&sps, nal, nalSz)){
+        K_LOG_VERBOSE("StreamContext, SPS could not be parsed (%d bytes): '%s'.\n", nalSz, ctx->cfg.path);
+    } else {
+        if(memcmp(&ctx->drawPlan.lastSps, &sps, sizeof(sps)) != 0){
+            K_LOG_INFO("StreamContext, SPS profile(%d) level(%d) %dx%d (visible %dx%d at %d,%d), %d ref-frames, %d reorder, %d dec-buffering: '%s'.\n", sps.profile_idc, sps.level_idc, sps.width, sps.height, sps.crop.width, sps.crop.height, sps.crop.x, sps.crop.y, sps.max_num_ref_frames, sps.max_num_reorder_frames, sps.max_dec_frame_buffering, ctx->cfg.path);
+            ctx->drawPlan.lastSps = sps;
+        }
+        ctx->h264.sps[sps.seq_parameter_set_id] = sps; //to parse slice headers
+
+        //draw plan (the decoder's composition prevails once its dst is started)
+        if(!ctx->dec.dst.isExplicitON && !ctx->dec.dst.isImplicitON && ctx->cfg.dstPixFmt != 0){
+            if(ctx->drawPlan.lastPixelformat != ctx->cfg.dstPixFmt || ctx->drawPlan.lastCompRect.width != sps.crop.width || ctx->drawPlan.lastCompRect.height != sps.crop.height){
+                ctx->drawPlan.lastPixelformat = ctx->cfg.dstPixFmt;
+                ctx->drawPlan.lastCompRect = sps.crop;
+                ctx->drawPlan.lastHeight = sps.crop.height;
+                if(0 != Player_organize(plyr)){
+                    K_LOG_ERROR("StreamContext, Player_organize failed after SPS.\n");
+                }
+            }
+        }
+    }
+}
+
+void StreamContext_decBuffBindFilling_(STStreamContext* ctx){
+    STVideoFrame* frame = ctx->frames.filling;
+    int isBacklogged = 0;
+    StreamContext_decBuffsReclaim_(ctx);
+    //queued frames waiting for a buffer need at least one unbound buffer (they are fed before this one)
+    {
+        int i, boundCount = 0, waitingCount = 0;
+        for(i = 0; i < ctx->frames.filled.use; i++){
+            if(VideoFrames_peek(&ctx->frames.filled, i)->buff.decBuff == NULL){
+                waitingCount++;
+            }
+        }
+        for(i = 0; i < ctx->dec.src.sz; i++){
+            if(ctx->dec.src.arr[i].isBound){
+                boundCount++;
+            }
+        }
+        isBacklogged = (waitingCount > 0 && (ctx->dec.src.sz - boundCount) < 2 ? 1 : 0);
+    }
+    if(frame != NULL && !isBacklogged && frame->buff.decBuff == NULL && frame->buff.extPtr == NULL && ctx->dec.fd >= 0 && ctx->dec.jpeg.cpu == NULL && ctx->dec.src.sz > 0 && !ctx->flushing.isActive && !ctx->shuttingDown.isActive){
+        STBuffer* buff = NULL;
+        if(0 != Buffers_getUnqueued(&ctx->dec.src, &buff, NULL)){
+            buff = NULL;
+            //try to dequeue a buffer already consumed by the decoder
+            if(ctx->dec.src.enqueuedCount > 0 && 0 != Buffers_dequeue(&ctx->dec.src, ctx->dec.fd, &buff, NULL)){
+                buff = NULL;
+            }
+        }
+        if(buff != NULL && 0 != VideoFrame_bindDecBuff(frame, buff)){
+            K_LOG_VERBOSE("StreamContext, VideoFrame_bindDecBuff failed: '%s'.\n", ctx->cfg.path);
+        }
+    }
+}
+
+void StreamContext_framesTrimToLatency_(STStreamContext* ctx, struct STPlayer_* plyr){
+    if(ctx->cfg.maxLatencyMs > 0 && ctx->file.fd <= 0 && ctx->frames.filled.use > 1){
+        STVideoFrame* oldest = VideoFrames_peek(&ctx->frames.filled, 0);
+        struct timeval now; long msLatency = 0;
+        gettimeofday(&now, NULL);
+        msLatency = msBetweenTimevals(&oldest->state.times.arrival.start, &now);
+        if(msLatency > ctx->cfg.maxLatencyMs){
+            //newest IDR (frames before it are not referenced by it or by the following ones)
+            int iIDR = ctx->frames.filled.use - 1;
+            while(iIDR > 0 && !VideoFrames_peek(&ctx->frames.filled, iIDR)->state.isIndependent){
+                iIDR--;
+            }
+            if(iIDR > 0){
+                int droppedCount = 0; unsigned long long droppedBytes = 0;
+                STVideoFrame* frame = NULL;
+                while(droppedCount < iIDR && 0 == VideoFrames_pullFrameForRead(&ctx->frames.filled, &frame)){
+                    droppedCount++;
+                    droppedBytes += frame->buff.use;
+                    //reuse
+                    if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
+                        K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
+                        VideoFrame_release(frame);
+                        free(frame);
+                    }
+                    frame = NULL;
+                }
+                plyr->stats.curSec.src.frames.dropped += droppedCount;
+                plyr->stats.curSec.src.frames.droppedBytes += droppedBytes;
+                K_LOG_VERBOSE("StreamContext(%lld), %d frames dropped (%llu bytes, %ldms latency, max %dms), queue trimmed to the newest IDR: '%s'.\n", (long long)ctx, droppedCount, droppedBytes, msLatency, ctx->cfg.maxLatencyMs, ctx->cfg.path);
+            }
+        }
+    }
+}
+
+int StreamContext_gopCacheAccepts_(STStreamContext* ctx, struct STPlayer_* plyr, const STVideoFrame* frame){
+    int r = 1;
+    if(frame->state.isIndependent){
+        //older frames are flushed by it
+        ctx->frames.gopCacheIsTruncated = 0;
+    } else if(ctx->frames.gopCacheIsTruncated){
+        //a frame is missing, followers until the next IDR cannot be decoded
+        r = 0;
+    } else if(ctx->dec.fd < 0 && ctx->file.fd <= 0){
+        //decoder closed, keep only the newest IDR and its followers (up to the limit)
+        if(ctx->frames.filled.use <= 0 || !VideoFrames_peek(&ctx->frames.filled, 0)->state.isIndependent){
+            r = 0; //no IDR to start from
+        } else {
+            unsigned long long bytes = frame->buff.use, bytesMax = (unsigned long long)ctx->cfg.gopCacheBytes;
+            int i; for(i = 0; i < ctx->frames.filled.use; i++){
+                bytes += VideoFrames_peek(&ctx->frames.filled, i)->buff.use;
+            }
+            //frames referencing the shm ring hold the producer's space (half of it at most)
+            if(ctx->shm.hdr != NULL && (bytesMax <= 0 || bytesMax > (ctx->shm.hdr->dataSz / 2))){
+                bytesMax = (ctx->shm.hdr->dataSz / 2);
+            }
+            if(bytesMax > 0 && bytes > bytesMax){
+                K_LOG_VERBOSE("StreamContext(%lld), GOP cache truncated at %d frames (%llu bytes, max %llu), frames dropped until the next IDR: '%s'.\n", (long long)ctx, ctx->frames.filled.use, (bytes - frame->buff.use), bytesMax, ctx->cfg.path);
+                ctx->frames.gopCacheIsTruncated = 1;
+                r = 0;
+            }
+        }
+    }
+    if(!r){
+        plyr->stats.curSec.src.frames.dropped++;
+        plyr->stats.curSec.src.frames.droppedBytes += frame->buff.use;
+    }
+    return r;
+}
+
+void StreamContext_decBuffsReclaim_(STStreamContext* ctx){
+    int i; for(i = 0; i < ctx->frames.reusable.use; i++){
+        STVideoFrame* f = VideoFrames_peek(&ctx->frames.reusable, i);
+        if(f->buff.decBuff != NULL){
+            VideoFrame_unbindDecBuff(f, 0);
+        }
+    }
+}
+
+void StreamContext_decBuffsUnbindAll_(STStreamContext* ctx){
+    StreamContext_decBuffsReclaim_(ctx);
+    if(ctx->frames.filling != NULL && ctx->frames.filling->buff.decBuff != NULL){
+        if(0 != VideoFrame_unbindDecBuff(ctx->frames.filling, 1)){
+            K_LOG_ERROR("StreamContext, filling frame could not be moved out of the OUTPUT buffer: '%s'.\n", ctx->cfg.path);
+            ctx->frames.filling->accessUnit.isInvalid = 1;
+        }
+    }
+    {
+        int i; for(i = 0; i < ctx->frames.filled.use; i++){
+            STVideoFrame* f = VideoFrames_peek(&ctx->frames.filled, i);
+            if(f->buff.decBuff != NULL && 0 != VideoFrame_unbindDecBuff(f, 1)){
+                K_LOG_ERROR("StreamContext, queued frame could not be moved out of the OUTPUT buffer: '%s'.\n", ctx->cfg.path);
+                f->accessUnit.isInvalid = 1;
+            }
+        }
+    }
+}
+
+void StreamContext_cnsmFrameOportunity_(STStreamContext* ctx, struct STPlayer_* plyr){
+    int tryAgain = 1;
+    while(tryAgain && ctx->dec.fd >= 0 && !ctx->flushing.isActive && VideoFrames_getFramesForReadCount(&ctx->frames.filled) > 0){
+        STBuffer* buff = NULL;
+        int buffIsDequeued = 0;
+        //use the buffer the frame was assembled in
+        if(buff == NULL && VideoFrames_peek(&ctx->frames.filled, 0)->buff.decBuff != NULL){
+            buff = VideoFrames_peek(&ctx->frames.filled, 0)->buff.decBuff;
+        }
+        //try to use a new buffer
+        if(buff == NULL){
+            StreamContext_decBuffsReclaim_(ctx);
+            if(0 != Buffers_getUnqueued(&ctx->dec.src, &buff, NULL)){
+                buff = NULL;
+            }
+        }
+        //try to dequeue and reuse bufer
+        if(buff == NULL && ctx->dec.src.enqueuedCount > 0){
+            if(0 != Buffers_dequeue(&ctx->dec.src, ctx->dec.fd, &buff, NULL)){
+                buff = NULL;
+            } else {
+                buffIsDequeued = 1;
+            }
+        }
+        //feed frame
+        tryAgain = 0;
+        if(buff == NULL){
+            //
+        } else {
+            STVideoFrame* frame = NULL;
+            if(0 != VideoFrames_pullFrameForRead(&ctx->frames.filled, &frame)){
+                K_LOG_ERROR("StreamContext(%lld), no frame available (program logic error).\n", (long long)ctx);
+            } else {
+                //validate
+                if(buff->planesSz < 0){
+                    K_LOG_ERROR("StreamContext, at least one plane is required.\n");
+                } else if(buff->planes[0].length < frame->buff.use){
+                    K_LOG_ERROR("StreamContext, frame doesnt fit on plane's buffer.\n");
+                } else if(ctx->dec.isWaitingForIDRFrame && !frame->state.isIndependent){
+                    K_LOG_VERBOSE("StreamContext(%lld), frame(#%d) ignored, waiting-for-IDR, %d states-fed.\n", (long long)ctx, (frame->state.iSeq + 1), ctx->dec.frames.fed.use);
+                    tryAgain = 1; //search next frame
+                } else {
+                    ctx->dec.frames.foundCount++;
+                    //feed
+                    if(ctx->dec.frames.foundCount <= ctx->cfg.framesSkip){
+                        K_LOG_INFO("StreamContext, skipping-fed frame (#%d/%d) (user-param 'framesSkip').\n", ctx->dec.frames.foundCount, ctx->cfg.framesSkip);
+                    } else if(ctx->flushing.isActive){
+                        K_LOG_INFO("StreamContext, skipping-fed frame (#%d/%d) (flushing).\n", ctx->dec.frames.foundCount, ctx->cfg.framesSkip);
+                    } else {
+                        struct timeval vTimestamp; //virtual timestamp
+                        memset(&vTimestamp, 0, sizeof(vTimestamp));
+                        //sync record
+                        {
+                            int i;
+                            //first plane
+                            STPlane* p = &buff->planes[0];
+                            if(frame->buff.decBuff == buff){
+                                plyr->stats.curSec.dec.fed.inPlace++; //already there
+                            } else {
+                                memcpy(p->dataPtr, (frame->buff.extPtr != NULL ? frame->buff.extPtr : frame->buff.ptr), frame->buff.use);
+                            }
+                            p->used = frame->buff.use;
+                            //others
+                            for(i = 1; i < buff->planesSz; i++){
+                                STPlane* p = &buff->planes[i];
+                                p->used = 0;
+                            }
+                            //virtual timestamp
+                            VideoFrameState_iSeqToTimestamp(frame->state.iSeq, &vTimestamp);
+                            //processing timestamps
+                            gettimeofday(&frame->state.times.proc.start, NULL);
+                            frame->state.times.proc.end = frame->state.times.proc.start;
+                        }
+                        //queue record
+                        if(0 != Buffers_enqueue(&ctx->dec.src, ctx->dec.fd, buff, &vTimestamp)){
+                            K_LOG_ERROR("StreamContext, frame could not be queued.\n");
+                        } else {
+                            ctx->dec.framesInSinceOpen++;
+                            //first-frame-fed event
+                            if(ctx->dec.framesInSinceOpen == 1){
+                                ctx->dec.msFirstFrameFed = ctx->dec.msOpen;
+                                if(ctx->dec.msFirstFrameFed >= 1000){
+                                    K_LOG_WARN("StreamContext(%lld), %ums to fed first frame (with types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s).\n"
+                                               , (long long)ctx, ctx->dec.msOpen
+                                               , frame->accessUnit.nalsCountPerType[0] ? " 0" : ""
+                                               , frame->accessUnit.nalsCountPerType[1] ? " 1" : ""
+                                               , frame->accessUnit.nalsCountPerType[2] ? " 2" : ""
+                                               , frame->accessUnit.nalsCountPerType[3] ? " 3" : ""
+                                               , frame->accessUnit.nalsCountPerType[4] ? " 4" : ""
+                                               , frame->accessUnit.nalsCountPerType[5] ? " 5" : ""
+                                               , frame->accessUnit.nalsCountPerType[6] ? " 6" : ""
+                                               , frame->accessUnit.nalsCountPerType[7] ? " 7" : ""
+                                               , frame->accessUnit.nalsCountPerType[8] ? " 8" : ""
+                                               , frame->accessUnit.nalsCountPerType[9] ? " 9" : ""
+                                               , frame->accessUnit.nalsCountPerType[10] ? " 10" : ""
+                                               , frame->accessUnit.nalsCountPerType[11] ? " 11" : ""
+                                               , frame->accessUnit.nalsCountPerType[12] ? " 12" : ""
+                                               , frame->accessUnit.nalsCountPerType[13] ? " 13" : ""
+                                               , frame->accessUnit.nalsCountPerType[14] ? " 14" : ""
+                                               , frame->accessUnit.nalsCountPerType[15] ? " 15" : ""
+                                               , frame->accessUnit.nalsCountPerType[16] ? " 16" : ""
+                                               , frame->accessUnit.nalsCountPerType[17] ? " 17" : ""
+                                               , frame->accessUnit.nalsCountPerType[18] ? " 18" : ""
+                                               , frame->accessUnit.nalsCountPerType[19] ? " 19" : ""
+                                               , frame->accessUnit.nalsCountPerType[20] ? " 20" : ""
+                                               , frame->accessUnit.nalsCountPerType[21] ? " 21" : ""
+                                               , frame->accessUnit.nalsCountPerType[22] ? " 22" : ""
+                                               , frame->accessUnit.nalsCountPerType[23] ? " 23" : ""
+                                               , frame->accessUnit.nalsCountPerType[24] ? " 24" : ""
+                                               , frame->accessUnit.nalsCountPerType[25] ? " 25" : ""
+                                               , frame->accessUnit.nalsCountPerType[26] ? " 26" : ""
+                                               , frame->accessUnit.nalsCountPerType[27] ? " 27" : ""
+                                               , frame->accessUnit.nalsCountPerType[28] ? " 28" : ""
+                                               , frame->accessUnit.nalsCountPerType[29] ? " 29" : ""
+                                               , frame->accessUnit.nalsCountPerType[30] ? " 30" : ""
+                                               , frame->accessUnit.nalsCountPerType[31] ? " 31" : ""
+                                               );
+                                } else {
+                                    K_LOG_VERBOSE("StreamContext(%lld), %ums to fed first frame (with types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s).\n"
+                                               , (long long)ctx, ctx->dec.msOpen
+                                               , frame->accessUnit.nalsCountPerType[0] ? " 0" : ""
+                                               , frame->accessUnit.nalsCountPerType[1] ? " 1" : ""
+                                               , frame->accessUnit.nalsCountPerType[2] ? " 2" : ""
+                                               , frame->accessUnit.nalsCountPerType[3] ? " 3" : ""
+                                               , frame->accessUnit.nalsCountPerType[4] ? " 4" : ""
+                                               , frame->accessUnit.nalsCountPerType[5] ? " 5" : ""
+                                               , frame->accessUnit.nalsCountPerType[6] ? " 6" : ""
+                                               , frame->accessUnit.nalsCountPerType[7] ? " 7" : ""
+                                               , frame->accessUnit.nalsCountPerType[8] ? " 8" : ""
+                                               , frame->accessUnit.nalsCountPerType[9] ? " 9" : ""
+                                               , frame->accessUnit.nalsCountPerType[10] ? " 10" : ""
+                                               , frame->accessUnit.nalsCountPerType[11] ? " 11" : ""
+                                               , frame->accessUnit.nalsCountPerType[12] ? " 12" : ""
+                                               , frame->accessUnit.nalsCountPerType[13] ? " 13" : ""
+                                               , frame->accessUnit.nalsCountPerType[14] ? " 14" : ""
+                                               , frame->accessUnit.nalsCountPerType[15] ? " 15" : ""
+                                               , frame->accessUnit.nalsCountPerType[16] ? " 16" : ""
+                                               , frame->accessUnit.nalsCountPerType[17] ? " 17" : ""
+                                               , frame->accessUnit.nalsCountPerType[18] ? " 18" : ""
+                                               , frame->accessUnit.nalsCountPerType[19] ? " 19" : ""
+                                               , frame->accessUnit.nalsCountPerType[20] ? " 20" : ""
+                                               , frame->accessUnit.nalsCountPerType[21] ? " 21" : ""
+                                               , frame->accessUnit.nalsCountPerType[22] ? " 22" : ""
+                                               , frame->accessUnit.nalsCountPerType[23] ? " 23" : ""
+                                               , frame->accessUnit.nalsCountPerType[24] ? " 24" : ""
+                                               , frame->accessUnit.nalsCountPerType[25] ? " 25" : ""
+                                               , frame->accessUnit.nalsCountPerType[26] ? " 26" : ""
+                                               , frame->accessUnit.nalsCountPerType[27] ? " 27" : ""
+                                               , frame->accessUnit.nalsCountPerType[28] ? " 28" : ""
+                                               , frame->accessUnit.nalsCountPerType[29] ? " 29" : ""
+                                               , frame->accessUnit.nalsCountPerType[30] ? " 30" : ""
+                                               , frame->accessUnit.nalsCountPerType[31] ? " 31" : ""
+                                               );
+                                }
+                            }
+                            //Add frame state to processing queue
+                            VideoFrameStates_addNewestCloning(&ctx->dec.frames.fed, &frame->state);
+                            ctx->dec.msWithoutFeedFrame = 0;
+                            ctx->dec.isWaitingForIDRFrame = 0;
+                            //stats
+                            plyr->stats.curSec.dec.fed.count++;
+                            //
+                            tryAgain = 1; //search next frame
+                            ctx->dec.frames.fedCount++;
+                            K_LOG_VERBOSE("StreamContext, frame(#%d, with types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) queued to src-buffs (%s), %d states-fed.\n"
+                                          , (frame->state.iSeq + 1)
+                                          , frame->accessUnit.nalsCountPerType[0] ? " 0" : ""
+                                          , frame->accessUnit.nalsCountPerType[1] ? " 1" : ""
+                                          , frame->accessUnit.nalsCountPerType[2] ? " 2" : ""
+                                          , frame->accessUnit.nalsCountPerType[3] ? " 3" : ""
+                                          , frame->accessUnit.nalsCountPerType[4] ? " 4" : ""
+                                          , frame->accessUnit.nalsCountPerType[5] ? " 5" : ""
+                                          , frame->accessUnit.nalsCountPerType[6] ? " 6" : ""
+                                          , frame->accessUnit.nalsCountPerType[7] ? " 7" : ""
+                                          , frame->accessUnit.nalsCountPerType[8] ? " 8" : ""
+                                          , frame->accessUnit.nalsCountPerType[9] ? " 9" : ""
+                                          , frame->accessUnit.nalsCountPerType[10] ? " 10" : ""
+                                          , frame->accessUnit.nalsCountPerType[11] ? " 11" : ""
+                                          , frame->accessUnit.nalsCountPerType[12] ? " 12" : ""
+                                          , frame->accessUnit.nalsCountPerType[13] ? " 13" : ""
+                                          , frame->accessUnit.nalsCountPerType[14] ? " 14" : ""
+                                          , frame->accessUnit.nalsCountPerType[15] ? " 15" : ""
+                                          , frame->accessUnit.nalsCountPerType[16] ? " 16" : ""
+                                          , frame->accessUnit.nalsCountPerType[17] ? " 17" : ""
+                                          , frame->accessUnit.nalsCountPerType[18] ? " 18" : ""
+                                          , frame->accessUnit.nalsCountPerType[19] ? " 19" : ""
+                                          , frame->accessUnit.nalsCountPerType[20] ? " 20" : ""
+                                          , frame->accessUnit.nalsCountPerType[21] ? " 21" : ""
+                                          , frame->accessUnit.nalsCountPerType[22] ? " 22" : ""
+                                          , frame->accessUnit.nalsCountPerType[23] ? " 23" : ""
+                                          , frame->accessUnit.nalsCountPerType[24] ? " 24" : ""
+                                          , frame->accessUnit.nalsCountPerType[25] ? " 25" : ""
+                                          , frame->accessUnit.nalsCountPerType[26] ? " 26" : ""
+                                          , frame->accessUnit.nalsCountPerType[27] ? " 27" : ""
+                                          , frame->accessUnit.nalsCountPerType[28] ? " 28" : ""
+                                          , frame->accessUnit.nalsCountPerType[29] ? " 29" : ""
+                                          , frame->accessUnit.nalsCountPerType[30] ? " 30" : ""
+                                          , frame->accessUnit.nalsCountPerType[31] ? " 31" : ""
+                                          , (buffIsDequeued ? "dequeued" : "unused"), ctx->dec.frames.fed.use);
+                            //start shutdown after this frame
+                            if(ctx->cfg.framesFeedMax > 0 && ctx->dec.frames.fedCount >= ctx->cfg.framesFeedMax && !ctx->shuttingDown.isActive){
+                                const int isPermanent = 1;
+                                if(0 != StreamContext_shutdownStart(ctx, plyr, isPermanent)){
+                                    K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed.\n");
+                                } else {
+                                    K_LOG_INFO("StreamContext, StreamContext_shutdownStart after %d frames fed (user-param 'framesFeedMax').\n", ctx->dec.frames.fedCount);
+                                }
+                            }
+                        }
+                    }
+                }
+                //reuse (the buffer is queued or free again)
+                if(frame->buff.decBuff != NULL){
+                    VideoFrame_unbindDecBuff(frame, 0);
+                }
+                if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
+                    K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
+                } else {
+                    frame = NULL; //consume
+                }
+                //release (if not consumed)
+                if(frame != NULL){
+                    free(frame);
+                    frame = NULL;
+                }
+                //update poll (last filled-frame was consumed)
+                if(VideoFrames_getFramesForReadCount(&ctx->frames.filled) <= 0){
+                    StreamContext_updatePollMask_(ctx, plyr);
+                }
+            }
+        }
+    }
+}
+
+void StreamContext_cnsmBuffNALOpenNewFilling_(STStreamContext* ctx, struct STPlayer_* plyr, const int flushOldersIfIsIndependent, const int nalType, const int keepCurNalInCurFrame, int* dstFilledAdded){
+    STVideoFrame* frame = NULL;
+    int filledAdded = 0;
+    if(0 != VideoFrames_pullFrameForFill(&ctx->frames.reusable, &frame)){
+        K_LOG_INFO("StreamContext, VideoFrames_pullFrameForFill failed.\n");
+        frame = NULL;
+    } else {
+        int fillingCarryAheadSz = (keepCurNalInCurFrame ? 0 : ctx->frames.fillingNalSz);
+        //initial state
+        gettimeofday(&frame->state.times.arrival.start, NULL);
+        gettimeofday(&frame->state.times.arrival.end, NULL);
+        gettimeofday(&frame->state.times.proc.start, NULL);
+        gettimeofday(&frame->state.times.proc.end, NULL);
+        //carry last partially-copied-nal to next frame
+        if(fillingCarryAheadSz > 0){
+            K_ASSERT(ctx->frames.filling->buff.use >= fillingCarryAheadSz)
+            if(0 != VideoFrame_copy(frame, &ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - fillingCarryAheadSz], fillingCarryAheadSz)){
+                K_LOG_ERROR("VideoFrame_copy failed.\n");
+                VideoFrame_release(ctx->frames.filling);
+                free(ctx->frames.filling);
+                ctx->frames.filling = NULL;
+                ctx->frames.fillingNalSz = 0;
+                //
+                fillingCarryAheadSz = 0;
+            } else {
+                //consume
+                K_ASSERT(frame->buff.use == fillingCarryAheadSz);
+                ctx->frames.filling->buff.use -= fillingCarryAheadSz;
+                //carry nalTypeCount from current frame (already counted) to next frame
+                {
+                    K_ASSERT(nalType >= 0 && nalType < (sizeof(ctx->frames.filling->accessUnit.nalsCountPerType) / sizeof(ctx->frames.filling->accessUnit.nalsCountPerType[0])))
+                    if(nalType >= 0 && nalType < (sizeof(ctx->frames.filling->accessUnit.nalsCountPerType) / sizeof(ctx->frames.filling->accessUnit.nalsCountPerType[0]))){
+                        K_ASSERT(ctx->frames.filling->accessUnit.nalsCountPerType[nalType] > 0)
+                        if(ctx->frames.filling->accessUnit.nalsCountPerType[nalType] > 0){
+                            ctx->frames.filling->accessUnit.nalsCountPerType[nalType]--;
+                        }
+                        K_ASSERT(frame->accessUnit.nalsCountPerType[nalType] == 0)
+                        frame->accessUnit.nalsCountPerType[nalType]++;
+                    }
+                }
+            }
+        }
+        //add to 'filled' or 'reuse' queue
+        if(ctx->frames.filling != NULL){
+            int addedIsIDR = 0, isGopDropped = 0;
+            if(ctx->frames.filling->buff.use <= 0){
+                K_LOG_WARN("StreamContext, ignoring zero-size frame(#%d, %d bytes, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
+            } else if(ctx->frames.filling->accessUnit.isInvalid){
+                K_LOG_WARN("StreamContext, ignoring explicit-invalidated frame(#%d, %d bytes, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
+            } else if(VideoFrame_getNalsCountOfGrp(ctx->frames.filling, ctx->cfg.srcPixFmt, ENNalTypeGrp_VCL) <= 0){
+                K_LOG_WARN("StreamContext, ignoring zero-VCL frame(#%d, %d bytes, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
+            } else if(
+                      ctx->cfg.srcPixFmt != V4L2_PIX_FMT_HEVC
+                      && !(ctx->frames.filling->accessUnit.nalsCountPerType[0] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[1] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[2] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[3] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[4] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[5] >= 1 //one or more slices
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[6] <= 1 //allow SEI (some old cameras includes it)
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[7] >= 1 //one or more SPS (mp4 'avcC' could list several)
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[8] >= 1 //one or more PPS
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[9] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[10] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[11] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[12] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[13] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[14] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[15] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[16] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[17] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[18] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[19] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[20] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[21] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[22] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[23] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[24] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[25] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[26] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[27] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[28] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[29] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[30] == 0
+                        && ctx->frames.filling->accessUnit.nalsCountPerType[31] == 0
+                      )
+                && !(ctx->frames.filling->accessUnit.nalsCountPerType[0] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[1] >= 1 //one or more slices
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[2] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[3] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[4] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[5] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[6] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[7] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[8] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[9] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[10] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[11] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[12] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[13] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[14] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[15] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[16] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[17] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[18] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[19] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[20] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[21] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[22] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[23] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[24] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[25] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[26] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[27] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[28] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[29] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[30] == 0
+                     && ctx->frames.filling->accessUnit.nalsCountPerType[31] == 0
+                     )
+            )
+            {
+                //Tmp-quick-fix: allow only H.264 frames with [8, 7, 5...] or [1...] NALs (one or more slices).
+                K_LOG_WARN("StreamContext, (tmp-quick-fix) ignoring frame not [8, 7, 5...] or [1...] (#%d, %d bytes, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
+            } else {
+                long msToArrive = 0;
+                //final state
+                {
+                    gettimeofday(&ctx->frames.filling->state.times.arrival.end, NULL);
+                    msToArrive = msBetweenTimevals(&ctx->frames.filling->state.times.arrival.start, &ctx->frames.filling->state.times.arrival.end);
+                    if(ctx->cfg.srcPixFmt == V4L2_PIX_FMT_HEVC){
+                        int t; for(t = 16; t <= 23 && !addedIsIDR; t++){
+                            addedIsIDR = (ctx->frames.filling->accessUnit.nalsCountPerType[t] > 0 ? 1 : 0); //IRAP-Picture (BLA, IDR, CRA)
+                        }
+                        ctx->frames.filling->state.isIndependent = addedIsIDR;
+                    } else {
+                        addedIsIDR = ctx->frames.filling->state.isIndependent = (ctx->frames.filling->accessUnit.nalsCountPerType[5] > 0 ? 1 : 0); //IDR-Picture
+                    }
+                    //flush queue (if independent frame arrived)
+                    if(flushOldersIfIsIndependent && ctx->frames.filling->state.isIndependent){
+                        int skippedCount = 0;
+                        STVideoFrame* frame = NULL;
+                        while(0 == VideoFrames_pullFrameForRead(&ctx->frames.filled, &frame)){
+                            skippedCount++;
+                            //reuse
+                            if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
+                                K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
+                            } else {
+                                frame = NULL; //consume
+                            }
+                            //release (if not consumed)
+                            if(frame != NULL){
+                                free(frame);
+                                frame = NULL;
+                            }
+                        }
+                        //
+                        if(skippedCount > 0){
+                            K_LOG_VERBOSE("StreamContext(%lld), %d frames skipped (independent frame arrived).\n", ctx, skippedCount);
+                        }
+                    }
+                }
+                //add
+                if(!StreamContext_gopCacheAccepts_(ctx, plyr, ctx->frames.filling)){
+                    isGopDropped = 1;
+                } else if(0 != VideoFrames_pushFrameOwning(&ctx->frames.filled, ctx->frames.filling)){
+                    K_LOG_ERROR("VideoFrames_pushFrameOwning failed.\n");
+                } else {
+                    //K_LOG_INFO("StreamContext, Frame(#%d, %d bytes, %dms, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, msToArrive, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
+                    ctx->frames.filling = NULL; //consume
+                    ctx->frames.fillingNalSz = 0;
+                    //
+                    filledAdded = 1;
+                }
+            }
+            //stats
+            {
+                if(filledAdded){
+                    plyr->stats.curSec.src.frames.queued++;
+                    if(addedIsIDR){
+                        plyr->stats.curSec.src.frames.queuedIDR++;
+                    }
+                } else if(!isGopDropped){
+                    plyr->stats.curSec.src.frames.ignored++;
+                }
+            }
+            //latency (decoder backlogged or closed)
+            if(filledAdded){
+                StreamContext_framesTrimToLatency_(ctx, plyr);
+            }
+            //release (if not consumed)
+            if(ctx->frames.filling != NULL){
+                if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, ctx->frames.filling)){
+                    K_LOG_ERROR("VideoFrames_pushFrameOwning failed.\n");
+                } else {
+                    ctx->frames.filling = NULL; //consume
+                    ctx->frames.fillingNalSz = 0;
+                }
+            }
+        }
+        //release (if not consumed)
+        if(ctx->frames.filling != NULL){
+            VideoFrame_release(ctx->frames.filling);
+            free(ctx->frames.filling);
+            ctx->frames.filling = NULL;
+            ctx->frames.fillingNalSz = 0;
+        }
+        //set
+        ctx->frames.filling = frame; frame = NULL; //consume
+        ctx->frames.fillingNalSz = fillingCarryAheadSz;
+        //zero-copy
+        StreamContext_decBuffBindFilling_(ctx);
+    }
+    //release (if not consumed)
+    if(frame != NULL){
+        if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
+            K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
+        } else {
+            frame = NULL; //consume
+        }
+        //release (if not consumed)
+        if(frame != NULL){
+            VideoFrame_release(frame);
+            free(frame);
+            frame = NULL;
+        }
+    }
+    //
+    if(dstFilledAdded != NULL){
+        *dstFilledAdded = filledAdded;
+    }
+}
+    
+void StreamContext_cnsmBuffNALChunk_(STStreamContext* ctx, struct STPlayer_* plyr, const int flushOldersIfIsIndependent, const unsigned char* data, const unsigned int dataSz, const int isEndOfNAL){
+    const int filledWasEmpty = (VideoFrames_getFramesForReadCount(&ctx->frames.filled) <= 0 ? 1 : 0);
+    int startNewFrame = 0, keepCurNalInCurFrame = 0; //default is to carry the NAL cahead
+    int filledAddedBefore = 0, filledAddedSlice = 0, filledAddedAfter = 0;
+    int nalType = 0, isNalTypeSet = 0;
+    const int isHevc = (ctx->cfg.srcPixFmt == V4L2_PIX_FMT_HEVC ? 1 : 0);
+    //
+    if(ctx->frames.filling != NULL){
+        K_ASSERT(ctx->frames.filling->buff.use >= ctx->frames.fillingNalSz)
+        //analyze nalType
+        if(ctx->frames.fillingNalSz >= 5){
+            //obtain nalType from current buffer
+            K_ASSERT(ctx->frames.filling->buff.use >= ctx->frames.fillingNalSz);
+            K_ASSERT(ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 0] == 0x00);
+            K_ASSERT(ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 1] == 0x00);
+            K_ASSERT(ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 2] == 0x00);
+            K_ASSERT(ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 3] == 0x01);
+            //
+            nalType = (isHevc ? ((ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 4] >> 1) & 0x3F) : (ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 4] & 0x1F));
+            isNalTypeSet = 1;
+            K_ASSERT(nalType >= 0 && nalType < (isHevc ? 64 : 32))
+            //K_LOG_INFO("StreamContext, nal-type(%d) continuing, frame(%d bytes, %u curNal).\n", nalType, ctx->frames.filling->buff.use, ctx->frames.fillingNalSz);
+        } else if((ctx->frames.fillingNalSz + dataSz) >= 5){
+            K_ASSERT(ctx->frames.filling->buff.use >= ctx->frames.fillingNalSz);
+            K_ASSERT((ctx->frames.fillingNalSz > 0 ? ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 0] : data[0 - ctx->frames.fillingNalSz]) == 0x00);
+            K_ASSERT((ctx->frames.fillingNalSz > 1 ? ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 1] : data[1 - ctx->frames.fillingNalSz]) == 0x00);
+            K_ASSERT((ctx->frames.fillingNalSz > 2 ? ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 2] : data[2 - ctx->frames.fillingNalSz]) == 0x00);
+            K_ASSERT((ctx->frames.fillingNalSz > 3 ? ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 3] : data[3 - ctx->frames.fillingNalSz]) == 0x01);
+            //obtain nalType from input buffer (first time seen)
+            nalType = (isHevc ? ((data[4 - ctx->frames.fillingNalSz] >> 1) & 0x3F) : (data[4 - ctx->frames.fillingNalSz] & 0x1F));
+            isNalTypeSet = 1;
+            //K_LOG_INFO("StreamContext, nal-type(%d) started, frame(%d bytes, %u curNal).\n", nalType, ctx->frames.filling->buff.use, ctx->frames.fillingNalSz);
+            //analyze
+            K_ASSERT(nalType >= 0 && nalType < (isHevc ? 64 : 32))
+            ctx->frames.fillingSliceIsPending = 0;
+            if(isHevc && nalType >= 0 && nalType < 64){
+                //H.265, '7.4.2.4.4 Order of NAL units and coded pictures and their association to access units'
+                if(nalType == 35 /*AUD_NUT*/){
+                    if(!startNewFrame && VideoFrame_getNalsCount(ctx->frames.filling) > 0){
+                        K_LOG_VERBOSE("StreamContext, nal-type(%d) opening new frame ('Access unit delimiter' at non-empty frame).\n", nalType);
+                        startNewFrame = 1;
+                        keepCurNalInCurFrame = 0;
+                    }
+                } else if(nalType <= 31 /*VCL*/){
+                    //decided once 'first_slice_segment_in_pic_flag' is copied (slice segments of the same picture are kept in the same frame).
+                    ctx->frames.fillingSliceIsPending = 1;
+                } else if(
+                   nalType == 32 /*VPS_NUT*/
+                   || nalType == 33 /*SPS_NUT*/
+                   || nalType == 34 /*PPS_NUT*/
+                   || nalType == 39 /*PREFIX_SEI_NUT*/
+                   || (nalType >= 41 && nalType <= 44) /*RSV_NVCL41..RSV_NVCL44*/
+                   || (nalType >= 48 && nalType <= 55) /*UNSPEC48..UNSPEC55*/
+                   )
+                {
+                    if(!startNewFrame && VideoFrame_getNalsCountOfGrp(ctx->frames.filling, ctx->cfg.srcPixFmt, ENNalTypeGrp_VCL) > 0){
+                        K_LOG_VERBOSE("StreamContext, opening new frame (nalType %d after the last VCL NAL).\n", nalType);
+                        startNewFrame = 1;
+                        keepCurNalInCurFrame = 0;
+                    }
+                }
+                //Safety, this should be previouly validated at 'isEndOfNAL'
+                if(!startNewFrame && (ctx->frames.filling->accessUnit.nalsCountPerType[36] || ctx->frames.filling->accessUnit.nalsCountPerType[37])){
+                    K_LOG_VERBOSE("StreamContext, opening new frame ('End of sequence/bitstream' already added).\n");
+                    startNewFrame = 1;
+                    keepCurNalInCurFrame = 0;
+                }
+                //add
+                ctx->frames.filling->accessUnit.nalsCountPerType[nalType]++;
+            } else if(!isHevc && nalType >= 0 && nalType < 32){
+                //Validate start of new access unit
+                if(
+                   nalType == 9 /*Access unit delimiter*/
+                   ){
+                       K_ASSERT((ctx->frames.filling->accessUnit.nalsCountPerType[9] && ctx->frames.filling->accessUnit.delimeter.isPresent) || (!ctx->frames.filling->accessUnit.nalsCountPerType[9] && !ctx->frames.filling->accessUnit.delimeter.isPresent)) //must match
+                       if(!startNewFrame && VideoFrame_getNalsCount(ctx->frames.filling) > 0){
+                           K_LOG_VERBOSE("StreamContext, nal-type(%d) opening new frame ('Access unit delimiter' at non-empty frame).\n", nalType);
+                           startNewFrame = 1;
+                           keepCurNalInCurFrame = 0;
+                       }
+                } else if(
+                   nalType == 1 /*non-IDR slice*/
+                   || nalType == 2 /*slice data partition A*/
+                   || nalType == 5 /*IDR slice*/
+                   )
+                {
+                    //'7.4.1.2.4 Detection of the first VCL NAL unit of a primary coded picture',
+                    //decided once the slice header is copied (slices of the same picture are kept in the same frame).
+                    ctx->frames.fillingSliceIsPending = 1;
+                } else if(
+                   nalType == 7 /*Sequence parameter set*/
+                   || nalType == 8 /*Sequence parameter set*/
+                   || nalType == 6 /*SEI*/
+                   || (nalType >= 14 && nalType <= 18) /*...*/
+                   )
+                {
+                    if(!startNewFrame && VideoFrame_getNalsCountOfGrp(ctx->frames.filling, ctx->cfg.srcPixFmt, ENNalTypeGrp_VCL) > 0){
+                        K_LOG_VERBOSE("StreamContext, opening new frame (nalType %d after the last VCL NAL).\n", nalType);
+                        startNewFrame = 1;
+                        keepCurNalInCurFrame = 0;
+                    }
+                }
+                //Safety, this should be previouly validated at 'isEndOfNAL'
+                K_ASSERT(ctx->frames.filling->accessUnit.nalsCountPerType[10] == 0)
+                if(!startNewFrame && ctx->frames.filling->accessUnit.nalsCountPerType[10]){
+                    K_LOG_VERBOSE("StreamContext, opening new frame ('End of sequence' already added).\n");
+                    startNewFrame = 1;
+                    keepCurNalInCurFrame = 0;
+                }
+                //constrains
+                if(nalType == 13 /*Sequence parameter set extension*/){
+                    if(ctx->frames.filling->accessUnit.lastCompletedNalType != 7 /*Sequence parameter set*/){
+                        if(!ctx->frames.filling->accessUnit.isInvalid){
+                            K_LOG_VERBOSE("StreamContext, invalidating frame ('Sequence parameter set extension' without inmediate-previous 'Sequence parameter set').\n");
+                            ctx->frames.filling->accessUnit.isInvalid = 1;
+                        }
+                    }
+                } else if(nalType == 19 /*coded slice of an auxiliary coded picture without partitioning*/){
+                    const int nalVCLCount = VideoFrame_getNalsCountOfGrp(ctx->frames.filling, ctx->cfg.srcPixFmt, ENNalTypeGrp_VCL);
+                    if(nalVCLCount == 0){
+                        if(!ctx->frames.filling->accessUnit.isInvalid){
+                            K_LOG_VERBOSE("StreamContext, invalidating frame ('auxiliary coded picture' without previous 'primary or redundant coded pictures').\n");
+                            ctx->frames.filling->accessUnit.isInvalid = 1;
+                        }
+                    }
+                } else if(nalType == 0 || nalType == 12 || (nalType >= 20 && nalType <= 31)){
+                    if(!ctx->frames.filling->accessUnit.isInvalid && VideoFrame_getNalsCountOfGrp(ctx->frames.filling, ctx->cfg.srcPixFmt, ENNalTypeGrp_VCL) == 0){
+                        K_LOG_VERBOSE("StreamContext, invalidating frame (nalType %d shall not precede the first VCL of the primary coded picture).\n", nalType);
+                        ctx->frames.filling->accessUnit.isInvalid = 1;
+                    }
+                }
+                //add
+                ctx->frames.filling->accessUnit.nalsCountPerType[nalType]++;
+            }
+        }
+    }
+    //start new frame before copying data (carry cur-nal ahead)
+    if(startNewFrame && !keepCurNalInCurFrame){
+        K_ASSERT(isNalTypeSet)
+        StreamContext_cnsmBuffNALOpenNewFilling_(ctx, plyr, flushOldersIfIsIndependent, nalType, keepCurNalInCurFrame, &filledAddedBefore);
+    }
+    //feed payload to frame
+    if(ctx->frames.filling != NULL && dataSz > 0){
+        if(0 != VideoFrame_copy(ctx->frames.filling, data, dataSz)){
+            K_LOG_ERROR("VideoFrame_copy failed.\n");
+            VideoFrame_release(ctx->frames.filling);
+            free(ctx->frames.filling);
+            ctx->frames.filling = NULL;
+            ctx->frames.fillingNalSz = 0;
+        } else {
+            ctx->frames.fillingNalSz += dataSz;
+        }
+    }
+    //slice header (a new picture starts if it does not match the frame's first slice)
+    if(isHevc && ctx->frames.filling != NULL && ctx->frames.fillingSliceIsPending && isNalTypeSet && (isEndOfNAL || ctx->frames.fillingNalSz >= (4 + 3))){
+        //H.265, 'first_slice_segment_in_pic_flag' u(1) follows the two-bytes NAL header
+        STVideoFrame* frame = ctx->frames.filling;
+        const int hasPrevVcl = (VideoFrame_getNalsCountOfGrp(frame, ctx->cfg.srcPixFmt, ENNalTypeGrp_VCL) > 1 ? 1 : 0); //current slice is already counted
+        const int isFirstSlice = (ctx->frames.fillingNalSz < (4 + 3) ? 1 : (frame->buff.ptr[frame->buff.use - ctx->frames.fillingNalSz + 6] & 0x80) ? 1 : 0);
+        ctx->frames.fillingSliceIsPending = 0;
+        if(hasPrevVcl && isFirstSlice){
+            K_LOG_VERBOSE("StreamContext, opening new frame (nalType %d is the first slice segment of a new picture).\n", nalType);
+            StreamContext_cnsmBuffNALOpenNewFilling_(ctx, plyr, flushOldersIfIsIndependent, nalType, 0 /*carry cur-nal ahead*/, &filledAddedSlice);
+        }
+    } else if(ctx->frames.filling != NULL && ctx->frames.fillingSliceIsPending && isNalTypeSet && (isEndOfNAL || ctx->frames.fillingNalSz >= (4 + K_H264_SLICE_HDR_PEEK_SZ))){
+        STVideoFrame* frame = ctx->frames.filling;
+        STH264SliceHdr hdr;
+        const int isParsed = (0 == H264SliceHdr_parse(&hdr, &frame->buff.ptr[frame->buff.use - ctx->frames.fillingNalSz + 4], (ctx->frames.fillingNalSz - 4), ctx->h264.sps, ctx->h264.pps) ? 1 : 0);
+        const int hasPrevVcl = (VideoFrame_getNalsCountOfGrp(frame, ctx->cfg.srcPixFmt, ENNalTypeGrp_VCL) > 1 ? 1 : 0); //current slice is already counted
+        int isNewPicture = hasPrevVcl; //parameter sets not known, each slice is assumed a new picture
+        if(isParsed && hasPrevVcl && frame->accessUnit.slice.isSet){
+            isNewPicture = H264SliceHdr_isFirstOfNewPicture(&frame->accessUnit.slice.hdr, &hdr);
+        }
+        ctx->frames.fillingSliceIsPending = 0;
+        if(isNewPicture){
+            K_LOG_VERBOSE("StreamContext, opening new frame (nalType %d is the first slice of a new picture).\n", nalType);
+            StreamContext_cnsmBuffNALOpenNewFilling_(ctx, plyr, flushOldersIfIsIndependent, nalType, 0 /*carry cur-nal ahead*/, &filledAddedSlice);
+        }
+        if(isParsed && ctx->frames.filling != NULL && !ctx->frames.filling->accessUnit.slice.isSet){
+            ctx->frames.filling->accessUnit.slice.isSet = 1;
+            ctx->frames.filling->accessUnit.slice.hdr = hdr;
+        }
+    }
+    //analyze current frame after current NAL-end is confirmed
+    if(isEndOfNAL){
+        K_ASSERT(ctx->frames.fillingNalSz <= 4 || isNalTypeSet) //should be empty-nal or type-set
+        ctx->frames.fillingSliceIsPending = 0;
+        if(ctx->frames.fillingNalSz <= 4){
+            K_LOG_WARN("StreamContext, empty-nal found (%d bytes): '%s'.\n", ctx->frames.fillingNalSz, ctx->cfg.path);
+            ctx->frames.filling->buff.use -= ctx->frames.fillingNalSz;
+            ctx->frames.fillingNalSz -= ctx->frames.fillingNalSz;
+        } else if(isNalTypeSet){
+            if(ctx->frames.filling != NULL){
+                ctx->frames.filling->accessUnit.lastCompletedNalType = nalType;
+            }
+            //
+            if(isNalTypeSet && isHevc && (nalType == 36 /*EOS_NUT*/ || nalType == 37 /*EOB_NUT*/)){
+                if(!startNewFrame){
+                    startNewFrame = 1;
+                    keepCurNalInCurFrame = 1;
+                }
+            }
+            //
+            if(isNalTypeSet && !isHevc && nalType == 10 /*End of sequence*/){
+                K_ASSERT(ctx->frames.filling->accessUnit.nalsCountPerType[10]); //should be counted
+                if(!startNewFrame){
+                    //K_LOG_INFO("StreamContext, opening new frame ('End of sequence' completed).\n");
+                    startNewFrame = 1;
+                    keepCurNalInCurFrame = 1;
+                }
+            }
+            //
+            if(isNalTypeSet && !isHevc && nalType == 7 /*Sequence parameter set*/ && ctx->frames.filling != NULL){
+                StreamContext_spsFound_(ctx, plyr, &ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 4], (ctx->frames.fillingNalSz - 4));
+            }
+            //
+            if(isNalTypeSet && !isHevc && nalType == 8 /*Picture parameter set*/ && ctx->frames.filling != NULL){
+                STH264Pps pps;
+                if(0 != H264Pps_parse(&pps, &ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 4], (ctx->frames.fillingNalSz - 4))){
+                    K_LOG_VERBOSE("StreamContext, PPS could not be parsed (%d bytes): '%s'.\n", (ctx->frames.fillingNalSz - 4), ctx->cfg.path);
+                } else {
+                    ctx->h264.pps[pps.pic_parameter_set_id] = pps;
+                }
+            }
+            //
+            if(isNalTypeSet && !isHevc && nalType == 9 /*Access unit delimiter*/){
+                K_ASSERT(ctx->frames.filling->accessUnit.nalsCountPerType[9]); //should be counted
+                if(ctx->frames.fillingNalSz < 6){
+                    K_LOG_ERROR("StreamContext, 'Access unit delimiter' should be 6 bytes or more (including header).\n");
+                    if(!ctx->frames.filling->accessUnit.isInvalid){
+                        K_LOG_INFO("StreamContext, invalidating frame (invalid size of 'Access unit delimiter').\n");
+                        ctx->frames.filling->accessUnit.isInvalid = 1;
+                    }
+                } else {
+                    const int primary_pic_type = (ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 5] & 0xE0) >> 5; //u(3)
+                    if(0 != VideoFrame_setAccessUnitDelimiterFound(ctx->frames.filling, primary_pic_type)){
+                        K_LOG_ERROR("StreamContext, VideoFrame_setAccessUnitDelimiterFound failed.\n");
+                    }
+                }
+            }
+        }
+    }
+    //start new frame after copying data (keep curNal)
+    if(startNewFrame && keepCurNalInCurFrame){
+        K_ASSERT(isNalTypeSet)
+        StreamContext_cnsmBuffNALOpenNewFilling_(ctx, plyr, flushOldersIfIsIndependent, nalType, keepCurNalInCurFrame, &filledAddedAfter);
+    }
+    //notify consumed
+    if(filledAddedBefore || filledAddedSlice || filledAddedAfter){
+        StreamContext_frameFilledNotify_(ctx, plyr, filledWasEmpty);
+    }
+}
+
+void StreamContext_frameFilledNotify_(STStreamContext* ctx, struct STPlayer_* plyr, const int filledWasEmpty){
+    //decoder
+    if(ctx->dec.fd >= 0 && ctx->dec.jpeg.cpu != NULL){
+        //cpu decoder (synchronous)
+        StreamContext_jpegCpuFeed_(ctx, plyr);
+    } else if(ctx->dec.fd >= 0){
+        //auto-start at first NAL arrival
+        if(!ctx->dec.src.isExplicitON){
+            if(0 != Buffers_start(&ctx->dec.src, ctx->dec.fd)){
+                K_LOG_ERROR("StreamContext, Buffers_start failed to '%s'.\n", ctx->cfg.path);
+            } else {
+                K_LOG_VERBOSE("StreamContext(%lld), src-started by frame arrival '%s'.\n", (long long)ctx, ctx->cfg.path);
+            }
+        }
+        //feed (if running and buffers are not queued yet)
+        if(ctx->dec.src.isImplicitON){
+            StreamContext_cnsmFrameOportunity_(ctx, plyr);
+        }
+        //update poll (first filled-frame is available)
+        if(filledWasEmpty){
+            StreamContext_updatePollMask_(ctx, plyr);
+        }
+    }
+}
+    
+//NAL completed (previous 'StreamContext_cnsmBuffNALChunk_' call was 'isEndOfNAL')
+void StreamContext_cnsmBuffNALCompleted_(STStreamContext* ctx, struct STPlayer_* plyr){
+    if(ctx->net.unitsRcvd == 0){
+        STNetPool* pool = Player_netPoolGet(plyr, ctx->cfg.server, ctx->cfg.port, 0);
+        ctx->net.msToFirstUnit = ctx->net.msSinceStart;
+        ctx->net.reconn.attempts = 0; //backoff reset
+        if(ctx->net.msToFirstUnit > 1000){
+            K_LOG_INFO("StreamContext_tick, %u ms to receive first stream-unit%s: '%s'.\n", ctx->net.msToFirstUnit, (ctx->net.isReusedConn ? " (warm)" : ""), ctx->cfg.path);
+        } else {
+            K_LOG_VERBOSE("StreamContext_tick, %u ms to receive first stream-unit%s: '%s'.\n", ctx->net.msToFirstUnit, (ctx->net.isReusedConn ? " (warm)" : ""), ctx->cfg.path);
+        }
+        if(pool != NULL){
+            pool->stats.curSec.msToFirstUnitSum += ctx->net.msToFirstUnit;
+            pool->stats.curSec.msToFirstUnitCount++;
+        }
+    }
+    ctx->net.unitsRcvd++;
+}
+
+//NAL started, the header { 0x00, 0x00, 0x00, 0x01 } is added to the filling frame
+void StreamContext_cnsmBuffNALStarted_(STStreamContext* ctx, struct STPlayer_* plyr){
+    const unsigned char hdr[4] = { 0x00, 0x00, 0x00, 0x01 };
+    //start new frame (if necesary)
+    if(ctx->frames.filling == NULL){
+        //create chunk
+        if(0 != VideoFrames_pullFrameForFill(&ctx->frames.reusable, &ctx->frames.filling)){
+            K_LOG_INFO("StreamContext, VideoFrames_pullFrameForFill failed.\n");
+            ctx->frames.filling = NULL;
+        } else {
+            //initial state
+            //ctx->frames.filling->state.iSeq
+            gettimeofday(&ctx->frames.filling->state.times.arrival.start, NULL);
+            gettimeofday(&ctx->frames.filling->state.times.arrival.end, NULL);
+            gettimeofday(&ctx->frames.filling->state.times.proc.start, NULL);
+            gettimeofday(&ctx->frames.filling->state.times.proc.end, NULL);
+            //zero-copy
+            StreamContext_decBuffBindFilling_(ctx);
+        }
+    }
+    //copy current header
+    if(ctx->frames.filling != NULL){
+        //copy 4 header bytes
+        if(0 != VideoFrame_copy(ctx->frames.filling, hdr, sizeof(hdr))){
+            K_LOG_ERROR("VideoFrame_copy failed.\n");
+            VideoFrame_release(ctx->frames.filling);
+            free(ctx->frames.filling);
+            ctx->frames.filling = NULL;
+            ctx->frames.fillingNalSz = 0;
+        } else {
+            ctx->frames.fillingNalSz = sizeof(hdr);
+        }
+    }
+}
+
+void StreamContext_cnsmBuffNAL_(STStreamContext* ctx, struct STPlayer_* plyr, const int flushOldersIfIsIndependent){
+    const unsigned char* bStart = (const unsigned char*)&ctx->buff.buff[ctx->buff.buffCsmd];
+    const unsigned char* bAfterEnd = (const unsigned char*)&ctx->buff.buff[ctx->buff.buffUse];
+    StreamContext_cnsmNALs_(ctx, plyr, flushOldersIfIsIndependent, bStart, bAfterEnd, 0);
+}
+
+int StreamContext_cnsmNALs_(STStreamContext* ctx, struct STPlayer_* plyr, const int flushOldersIfIsIndependent, const unsigned char* bStart, const unsigned char* bAfterEnd, const int stopAfterFramePushed){
+    const unsigned long lastNALPushedSeq = ctx->frames.filled.iSeqPushNext; //to detect completed frames
+    const unsigned char* b = bStart;
+    const unsigned char* bChunkStart = bStart;
+    unsigned char hdr[4] = { 0x00, 0x00, 0x00, 0x01 };
+    //
+    while(b < bAfterEnd){
+        //next end-of-header (non-zero runs are skipped by blocks)
+        b = nalScanStartCode(b, bAfterEnd, &ctx->buff.nal.zeroesSeqAccum);
+        if(b < bAfterEnd){
+            //analyze end-of-header
+            K_ASSERT(*b == 0x01 && ctx->buff.nal.zeroesSeqAccum >= 3)
+            {
+                plyr->stats.curSec.src.nals.started++;
+                //process data-chunk from before this header
+                if(ctx->frames.filling != NULL && ctx->frames.filling->buff.use > 0){
+                    const int isEndOfNAL = 1;
+                    const int curChunkSz = (const int)((b + 1) - bChunkStart); //(b + 1) because we are still in last-byte-of-header
+                    //
+                    plyr->stats.curSec.src.nals.completed++;
+                    //
+                    if(curChunkSz < sizeof(hdr)){
+                        //partial-header was already added to the frame, remove it
+                        const int toRemoveSz = (sizeof(hdr) - curChunkSz);
+                        //K_LOG_INFO("StreamContext, %d bytes of partial-nal-header removed from current frame.\n", toRemoveSz);
+                        K_ASSERT(ctx->frames.filling->buff.use >= ctx->frames.fillingNalSz)
+                        K_ASSERT(ctx->frames.fillingNalSz >= toRemoveSz)
+                        //K_LOG_INFO("StreamContext, removed %d of %d bytes from previous NAL and closing it.\n", toRemoveSz, ctx->frames.fillingNalSz);
+                        ctx->frames.filling->buff.use -= toRemoveSz;
+                        ctx->frames.fillingNalSz -= toRemoveSz;
+                        //analyze current frame
+                        StreamContext_cnsmBuffNALChunk_(ctx, plyr, flushOldersIfIsIndependent, NULL, 0, isEndOfNAL);
+                    } else {
+                        //process chunk before the current header and analyze current frame
+                        //K_LOG_INFO("StreamContext, adding %d (to %d bytes) to previous NAL and closing it.\n", curChunkSz - sizeof(hdr), ctx->frames.fillingNalSz + (curChunkSz - sizeof(hdr)));
+                        StreamContext_cnsmBuffNALChunk_(ctx, plyr, flushOldersIfIsIndependent, bChunkStart, curChunkSz - sizeof(hdr), isEndOfNAL);
                     }
+                    //
+                    StreamContext_cnsmBuffNALCompleted_(ctx, plyr);
                 }
-                //reuse
-                if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
-                    K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
-                } else {
-                    frame = NULL; //consume
-                }
-                //release (if not consumed)
-                if(frame != NULL){
-                    free(frame);
-                    frame = NULL;
-                }
-                //update poll (last filled-frame was consumed)
-                if(VideoFrames_getFramesForReadCount(&ctx->frames.filled) <= 0){
-                    StreamContext_updatePollMask_(ctx, plyr);
-                }
+                //start new frame (if necesary) and copy current header
+                StreamContext_cnsmBuffNALStarted_(ctx, plyr);
+                //start-of-next-chunk
+                bChunkStart = b + 1;
+            }
+            //reset zeroes-zeq
+            ctx->buff.nal.zeroesSeqAccum = 0;
+            b++;
+            //stop after the header that completed a frame
+            if(stopAfterFramePushed && lastNALPushedSeq != ctx->frames.filled.iSeqPushNext){
+                return (int)(b - bStart);
             }
         }
     }
+    //process last (unconsumed) chunk
+    if(bChunkStart < bAfterEnd && ctx->frames.filling != NULL){
+        const int isEndOfNAL = 0;
+        const int sztoCpy = (int)(bAfterEnd - bChunkStart);
+        StreamContext_cnsmBuffNALChunk_(ctx, plyr, flushOldersIfIsIndependent, bChunkStart, sztoCpy, isEndOfNAL);
+    }
+    return (int)(bAfterEnd - bStart);
 }
 
-void StreamContext_cnsmBuffNALOpenNewFilling_(STStreamContext* ctx, struct STPlayer_* plyr, const int flushOldersIfIsIndependent, const int nalType, const int keepCurNalInCurFrame, int* dstFilledAdded){
-    STVideoFrame* frame = NULL;
-    int filledAdded = 0;
-    if(0 != VideoFrames_pullFrameForFill(&ctx->frames.reusable, &frame)){
-        K_LOG_INFO("StreamContext, VideoFrames_pullFrameForFill failed.\n");
-        frame = NULL;
-    } else {
-        int fillingCarryAheadSz = (keepCurNalInCurFrame ? 0 : ctx->frames.fillingNalSz);
-        //initial state
-        gettimeofday(&frame->state.times.arrival.start, NULL);
-        gettimeofday(&frame->state.times.arrival.end, NULL);
-        gettimeofday(&frame->state.times.proc.start, NULL);
-        gettimeofday(&frame->state.times.proc.end, NULL);
-        //carry last partially-copied-nal to next frame
-        if(fillingCarryAheadSz > 0){
-            K_ASSERT(ctx->frames.filling->buff.use >= fillingCarryAheadSz)
-            if(0 != VideoFrame_copy(frame, &ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - fillingCarryAheadSz], fillingCarryAheadSz)){
-                K_LOG_ERROR("VideoFrame_copy failed.\n");
-                VideoFrame_release(ctx->frames.filling);
-                free(ctx->frames.filling);
-                ctx->frames.filling = NULL;
-                ctx->frames.fillingNalSz = 0;
-                //
-                fillingCarryAheadSz = 0;
-            } else {
-                //consume
-                K_ASSERT(frame->buff.use == fillingCarryAheadSz);
-                ctx->frames.filling->buff.use -= fillingCarryAheadSz;
-                //carry nalTypeCount from current frame (already counted) to next frame
-                {
-                    K_ASSERT(nalType >= 0 && nalType < 32)
-                    if(nalType >= 0 && nalType < 32){
-                        K_ASSERT(ctx->frames.filling->accessUnit.nalsCountPerType[nalType] > 0)
-                        if(ctx->frames.filling->accessUnit.nalsCountPerType[nalType] > 0){
-                            ctx->frames.filling->accessUnit.nalsCountPerType[nalType]--;
-                        }
-                        K_ASSERT(frame->accessUnit.nalsCountPerType[nalType] == 0)
-                        frame->accessUnit.nalsCountPerType[nalType]++;
+void StreamContext_pollCallbackDevice_(STStreamContext* ctx, struct STPlayer_* plyr, int revents){
+    K_LOG_VERBOSE("Device, poll-event(%d):%s%s%s%s%s%s.\n", revents, (revents & POLLERR) ? " errors" : "", (revents & POLLPRI) ? " events": "", (revents & (POLLOUT | POLLWRNORM)) ? " src-hungry": "", (revents & (POLLIN | POLLRDNORM)) ? " dst-populated": "", (revents & (POLLERR | POLLPRI | POLLOUT | POLLWRNORM | POLLIN | POLLRDNORM)) == 0 ? "none" : "", (revents & ~(POLLERR | POLLPRI | POLLOUT | POLLWRNORM | POLLIN | POLLRDNORM)) != 0 ? "others" : "");
+    //error
+    if((revents & (POLLERR))){
+        K_LOG_ERROR("Device, poll-event: error.\n");
+        if(0 != StreamContext_close(ctx, plyr)){
+            K_LOG_ERROR("StreamContext_close failed: '%s'.\n", ctx->cfg.path);
+        }
+        ctx->dec.isWaitingForIDRFrame = 1;
+        ctx->dec.msToReopen = (plyr->cfg.decoderWaitRecopenSecs <= 0 ? 1 : plyr->cfg.decoderWaitRecopenSecs) * 1000;
+        //reset (just in case)
+        {
+            ctx->dec.src.msWithoutEnqueuing = 0;
+            ctx->dec.src.msWithoutDequeuing = 0;
+            //
+            ctx->dec.dst.msWithoutEnqueuing = 0;
+            ctx->dec.dst.msWithoutDequeuing = 0;
+            //
+            ctx->dec.msWithoutFeedFrame = 0;
+        }
+    }
+    //event
+    if((revents & (POLLPRI))){
+        K_LOG_VERBOSE("Device, poll-event: event.\n");
+        int rr = 0, knownPends = 1, eventsDequeuedTotal = 0;
+        int isResolutionChangeEvent = 0;
+        while(rr == 0 && knownPends > 0){
+            struct v4l2_event ev;
+            memset(&ev, 0, sizeof(ev));
+            //
+            rr = v4l2_ioctl(ctx->dec.fd, VIDIOC_DQEVENT, &ev);
+            if(rr != 0){
+                if(errno == EAGAIN){
+                    //no pending events
+                    knownPends = 0;
+                    rr = 0;
+                } else {
+                    //error
+                    const STErrCode* err = _getErrCode(errno);
+                    if(err == NULL){
+                        K_LOG_ERROR("StreamContext, VIDIOC_DQEVENT returned errno(%d).\n", errno);
+                    } else {
+                        K_LOG_ERROR("StreamContext, VIDIOC_DQEVENT returned '%s'.\n", err->str);
                     }
+                    knownPends = 0;
+                    rr = 0;
                 }
-            }
-        }
-        //add to 'filled' or 'reuse' queue
-        if(ctx->frames.filling != NULL){
-            int addedIsIDR = 0;
-            if(ctx->frames.filling->buff.use <= 0){
-                K_LOG_WARN("StreamContext, ignoring zero-size frame(#%d, %d bytes, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
-            } else if(ctx->frames.filling->accessUnit.isInvalid){
-                K_LOG_WARN("StreamContext, ignoring explicit-invalidated frame(#%d, %d bytes, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
-            } else if(VideoFrame_getNalsCountOfGrp(ctx->frames.filling, ENNalTypeGrp_VCL) <= 0){
-                K_LOG_WARN("StreamContext, ignoring zero-VCL frame(#%d, %d bytes, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
-            } else if(
-                      !(ctx->frames.filling->accessUnit.nalsCountPerType[0] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[1] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[2] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[3] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[4] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[5] == 1
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[6] <= 1 //allow SEI (some old cameras includes it)
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[7] == 1
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[8] == 1
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[9] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[10] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[11] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[12] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[13] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[14] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[15] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[16] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[17] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[18] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[19] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[20] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[21] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[22] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[23] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[24] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[25] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[26] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[27] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[28] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[29] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[30] == 0
-                        && ctx->frames.filling->accessUnit.nalsCountPerType[31] == 0
-                      )
-                && !(ctx->frames.filling->accessUnit.nalsCountPerType[0] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[1] == 1
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[2] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[3] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[4] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[5] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[6] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[7] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[8] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[9] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[10] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[11] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[12] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[13] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[14] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[15] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[16] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[17] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[18] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[19] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[20] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[21] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[22] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[23] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[24] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[25] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[26] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[27] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[28] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[29] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[30] == 0
-                     && ctx->frames.filling->accessUnit.nalsCountPerType[31] == 0
-                     )
-            )
-            {
-                //Tmp-quick-fix: allow only frames with [8, 7, 5] or [1] NALs.
-                K_LOG_WARN("StreamContext, (tmp-quick-fix) ignoring frame not [8, 7, 5] or [1] (#%d, %d bytes, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
             } else {
-                long msToArrive = 0;
-                //final state
-                {
-                    gettimeofday(&ctx->frames.filling->state.times.arrival.end, NULL);
-                    msToArrive = msBetweenTimevals(&ctx->frames.filling->state.times.arrival.start, &ctx->frames.filling->state.times.arrival.end);
-                    addedIsIDR = ctx->frames.filling->state.isIndependent = (ctx->frames.filling->accessUnit.nalsCountPerType[5] > 0 ? 1 : 0); //IDR-Picture
-                    //flush queue (if independent frame arrived)
-                    if(flushOldersIfIsIndependent && ctx->frames.filling->state.isIndependent){
-                        int skippedCount = 0;
-                        STVideoFrame* frame = NULL;
-                        while(0 == VideoFrames_pullFrameForRead(&ctx->frames.filled, &frame)){
-                            skippedCount++;
-                            //reuse
-                            if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
-                                K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
+                //analyze event
+                switch(ev.type){
+                    //V4L2_EVENT_RESOLUTION_CHANGE == V4L2_EVENT_SOURCE_CHANGE
+#                   ifdef V4L2_EVENT_RESOLUTION_CHANGE
+                    case V4L2_EVENT_RESOLUTION_CHANGE:
+                        {
+                            K_LOG_VERBOSE("StreamContext, event(V4L2_EVENT_RESOLUTION_CHANGE).\n");
+                            isResolutionChangeEvent = 1;
+                        }
+                        break;
+#                   else
+                    case V4L2_EVENT_SOURCE_CHANGE:
+                        /*
+                        https://www.kernel.org/doc/html/latest/userspace-api/media/v4l/dev-decoder.html
+                        Means:
+                        - coded resolution (OUTPUT width and height),
+                        - visible resolution (selection rectangles),
+                        - the minimum number of buffers needed for decoding,
+                        - bit-depth of the bitstream has been changed.
+                        */
+                        {
+                            //specifies a flag for resolution changes
+                            struct v4l2_event_src_change* src_change = &ev.u.src_change;
+                            isResolutionChangeEvent = 1;
+                            //
+                            if((src_change->changes & V4L2_EVENT_SRC_CH_RESOLUTION)){
+                                K_LOG_VERBOSE("StreamContext, event(V4L2_EVENT_SOURCE_CHANGE) change(CH_RESOLUTION).\n");
+                                src_change->changes &= ~V4L2_EVENT_SRC_CH_RESOLUTION;
                             } else {
-                                frame = NULL; //consume
+                                K_LOG_VERBOSE("StreamContext, event(V4L2_EVENT_SOURCE_CHANGE).\n");
                             }
-                            //release (if not consumed)
-                            if(frame != NULL){
-                                free(frame);
-                                frame = NULL;
+                            if(src_change->changes){
+                                K_LOG_VERBOSE("                 change: UNKNOWN(%u).\n", src_change->changes);
                             }
                         }
-                        //
-                        if(skippedCount > 0){
-                            K_LOG_VERBOSE("StreamContext(%lld), %d frames skipped (independent frame arrived).\n", ctx, skippedCount);
-                        }
-                    }
+                        break;
+#                   endif
+                    case V4L2_EVENT_EOS: //last frame has been decoded
+                        K_LOG_INFO("StreamContext, event(V4L2_EVENT_EOS).\n");
+                        break;
+                    default:
+                        K_LOG_INFO("StreamContext, event(%d, UNSUPPORTED BY THIS CODE).\n", ev.type);
+                        break;
                 }
-                //add
-                if(0 != VideoFrames_pushFrameOwning(&ctx->frames.filled, ctx->frames.filling)){
-                    K_LOG_ERROR("VideoFrames_pushFrameOwning failed.\n");
-                } else {
-                    //K_LOG_INFO("StreamContext, Frame(#%d, %d bytes, %dms, types:%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s) completed (%d filled-frames in queue).\n", (ctx->frames.filling->state.iSeq + 1), ctx->frames.filling->buff.use, msToArrive, ctx->frames.filling->accessUnit.nalsCountPerType[0] ? " 0" : "", ctx->frames.filling->accessUnit.nalsCountPerType[1] ? " 1" : "", ctx->frames.filling->accessUnit.nalsCountPerType[2] ? " 2" : "", ctx->frames.filling->accessUnit.nalsCountPerType[3] ? " 3" : "", ctx->frames.filling->accessUnit.nalsCountPerType[4] ? " 4" : "", ctx->frames.filling->accessUnit.nalsCountPerType[5] ? " 5" : "", ctx->frames.filling->accessUnit.nalsCountPerType[6] ? " 6" : "", ctx->frames.filling->accessUnit.nalsCountPerType[7] ? " 7" : "", ctx->frames.filling->accessUnit.nalsCountPerType[8] ? " 8" : "", ctx->frames.filling->accessUnit.nalsCountPerType[9] ? " 9" : "", ctx->frames.filling->accessUnit.nalsCountPerType[10] ? " 10" : "", ctx->frames.filling->accessUnit.nalsCountPerType[11] ? " 11" : "", ctx->frames.filling->accessUnit.nalsCountPerType[12] ? " 12" : "", ctx->frames.filling->accessUnit.nalsCountPerType[13] ? " 13" : "", ctx->frames.filling->accessUnit.nalsCountPerType[14] ? " 14" : "", ctx->frames.filling->accessUnit.nalsCountPerType[15] ? " 15" : "", ctx->frames.filling->accessUnit.nalsCountPerType[16] ? " 16" : "", ctx->frames.filling->accessUnit.nalsCountPerType[17] ? " 17" : "", ctx->frames.filling->accessUnit.nalsCountPerType[18] ? " 18" : "", ctx->frames.filling->accessUnit.nalsCountPerType[19] ? " 19" : "", ctx->frames.filling->accessUnit.nalsCountPerType[20] ? " 20" : "", ctx->frames.filling->accessUnit.nalsCountPerType[21] ? " 21" : "", ctx->frames.filling->accessUnit.nalsCountPerType[22] ? " 22" : "", ctx->frames.filling->accessUnit.nalsCountPerType[23] ? " 23" : "", ctx->frames.filling->accessUnit.nalsCountPerType[24] ? " 24" : "", ctx->frames.filling->accessUnit.nalsCountPerType[25] ? " 25" : "", ctx->frames.filling->accessUnit.nalsCountPerType[26] ? " 26" : "", ctx->frames.filling->accessUnit.nalsCountPerType[27] ? " 27" : "", ctx->frames.filling->accessUnit.nalsCountPerType[28] ? " 28" : "", ctx->frames.filling->accessUnit.nalsCountPerType[29] ? " 29" : "", ctx->frames.filling->accessUnit.nalsCountPerType[30] ? " 30" : "", ctx->frames.filling->accessUnit.nalsCountPerType[31] ? " 31" : "", ctx->frames.filled.use);
-                    ctx->frames.filling = NULL; //consume
-                    ctx->frames.fillingNalSz = 0;
-                    //
-                    filledAdded = 1;
+                //
+                if(ev.pending > 0){
+                    K_LOG_INFO("StreamContext, %d pending after this one.\n", ev.pending);
                 }
-            }
-            //stats
-            {
-                if(filledAdded){
-                    plyr->stats.curSec.src.frames.queued++;
-                    if(addedIsIDR){
-                        plyr->stats.curSec.src.frames.queuedIDR++;
+                //apply resolution change inmediatly
+                if(isResolutionChangeEvent){
+                    ctx->dec.dst.isImplicitON = 0; //resolution-change events internally stops the dst-side of the devie
+                    //remove current buffers
+                    if(ctx->dec.dst.isExplicitON){
+                        if(0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.dst, ctx->dec.fd)){
+                            K_LOG_WARN("StreamContext_stopAndCleanupBuffs(dst) failed: '%s'.\n", ctx->cfg.device);
+                        } else {
+                            K_LOG_INFO("StreamContext, dst uninited: '%s'.\n", ctx->cfg.device);
+                        }
+                    }
+                    //create new buffers
+                    if(0 != StreamContext_initAndStartDst(ctx, plyr)){
+                        K_LOG_ERROR("StreamContext_initAndStartDst(dst, %d buffers) failed: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
+                    } else {
+                        K_LOG_VERBOSE("StreamContext, dst inited and started (%d buffers): '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
                     }
-                } else {
-                    plyr->stats.curSec.src.frames.ignored++;
-                }
-            }
-            //release (if not consumed)
-            if(ctx->frames.filling != NULL){
-                if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, ctx->frames.filling)){
-                    K_LOG_ERROR("VideoFrames_pushFrameOwning failed.\n");
-                } else {
-                    ctx->frames.filling = NULL; //consume
-                    ctx->frames.fillingNalSz = 0;
                 }
+                knownPends = ev.pending;
             }
         }
-        //release (if not consumed)
-        if(ctx->frames.filling != NULL){
-            VideoFrame_release(ctx->frames.filling);
-            free(ctx->frames.filling);
-            ctx->frames.filling = NULL;
-            ctx->frames.fillingNalSz = 0;
-        }
-        //set
-        ctx->frames.filling = frame; frame = NULL; //consume
-        ctx->frames.fillingNalSz = fillingCarryAheadSz;
-    }
-    //release (if not consumed)
-    if(frame != NULL){
-        if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
-            K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
-        } else {
-            frame = NULL; //consume
-        }
-        //release (if not consumed)
-        if(frame != NULL){
-            VideoFrame_release(frame);
-            free(frame);
-            frame = NULL;
-        }
     }
-    //
-    if(dstFilledAdded != NULL){
-        *dstFilledAdded = filledAdded;
+    //src is ready for new input
+    if((revents & (POLLOUT | POLLWRNORM))){
+        K_LOG_VERBOSE("StreamContext(%lld), poll-event: src-hungry.\n", (long long)ctx);
+        StreamContext_cnsmFrameOportunity_(ctx, plyr);
     }
-}
-    
-void StreamContext_cnsmBuffNALChunk_(STStreamContext* ctx, struct STPlayer_* plyr, const int flushOldersIfIsIndependent, const unsigned char* data, const unsigned int dataSz, const int isEndOfNAL){
-    const int filledWasEmpty = (VideoFrames_getFramesForReadCount(&ctx->frames.filled) <= 0 ? 1 : 0);
-    int startNewFrame = 0, keepCurNalInCurFrame = 0; //default is to carry the NAL cahead
-    int filledAddedBefore = 0, filledAddedAfter = 0;
-    int nalType = 0, isNalTypeSet = 0;
-    //
-    if(ctx->frames.filling != NULL){
-        K_ASSERT(ctx->frames.filling->buff.use >= ctx->frames.fillingNalSz)
-        //analyze nalType
-        if(ctx->frames.fillingNalSz >= 5){
-            //obtain nalType from current buffer
-            K_ASSERT(ctx->frames.filling->buff.use >= ctx->frames.fillingNalSz);
-            K_ASSERT(ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 0] == 0x00);
-            K_ASSERT(ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 1] == 0x00);
-            K_ASSERT(ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 2] == 0x00);
-            K_ASSERT(ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 3] == 0x01);
-            //
-            nalType = (ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 4] & 0x1F);
-            isNalTypeSet = 1;
-            K_ASSERT(nalType >= 0 && nalType < 32)
-            //K_LOG_INFO("StreamContext, nal-type(%d) continuing, frame(%d bytes, %u curNal).\n", nalType, ctx->frames.filling->buff.use, ctx->frames.fillingNalSz);
-        } else if((ctx->frames.fillingNalSz + dataSz) >= 5){
-            K_ASSERT(ctx->frames.filling->buff.use >= ctx->frames.fillingNalSz);
-            K_ASSERT((ctx->frames.fillingNalSz > 0 ? ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 0] : data[0 - ctx->frames.fillingNalSz]) == 0x00);
-            K_ASSERT((ctx->frames.fillingNalSz > 1 ? ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 1] : data[1 - ctx->frames.fillingNalSz]) == 0x00);
-            K_ASSERT((ctx->frames.fillingNalSz > 2 ? ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 2] : data[2 - ctx->frames.fillingNalSz]) == 0x00);
-            K_ASSERT((ctx->frames.fillingNalSz > 3 ? ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 3] : data[3 - ctx->frames.fillingNalSz]) == 0x01);
-            //obtain nalType from input buffer (first time seen)
-            nalType = (data[4 - ctx->frames.fillingNalSz] & 0x1F);
-            isNalTypeSet = 1;
-            //K_LOG_INFO("StreamContext, nal-type(%d) started, frame(%d bytes, %u curNal).\n", nalType, ctx->frames.filling->buff.use, ctx->frames.fillingNalSz);
-            //analyze
-            K_ASSERT(nalType >= 0 && nalType < 32)
-            if(nalType >= 0 && nalType < 32){
-                //Validate start of new access unit
-                if(
-                   nalType == 9 /*Access unit delimiter*/
-                   ){
-                       K_ASSERT((ctx->frames.filling->accessUnit.nalsCountPerType[9] && ctx->frames.filling->accessUnit.delimeter.isPresent) || (!ctx->frames.filling->accessUnit.nalsCountPerType[9] && !ctx->frames.filling->accessUnit.delimeter.isPresent)) //must match
-                       if(!startNewFrame && VideoFrame_getNalsCount(ctx->frames.filling) > 0){
-                           K_LOG_VERBOSE("StreamContext, nal-type(%d) opening new frame ('Access unit delimiter' at non-empty frame).\n", nalType);
-                           startNewFrame = 1;
-                           keepCurNalInCurFrame = 0;
-                       }
-                } else if(
-                   nalType == 7 /*Sequence parameter set*/
-                   || nalType == 8 /*Sequence parameter set*/
-                   || nalType == 6 /*SEI*/
-                   || (nalType >= 14 && nalType <= 18) /*...*/
-                   //ToDo: implement '7.4.1.2.4 Detection of the first VCL NAL unit of a primary coded picture'.
-                   //Asuming all VCL NALs are the first NAL of a primary coded.
-                   || _naluDefs[nalType].grp == ENNalTypeGrp_VCL /*first VCL NAL unit of a primary coded picture*/
-                   )
-                {
-                    if(!startNewFrame && VideoFrame_getNalsCountOfGrp(ctx->frames.filling, ENNalTypeGrp_VCL) > 0){
-                        K_LOG_VERBOSE("StreamContext, opening new frame (nalType %d after the last VCL NAL).\n", nalType);
-                        startNewFrame = 1;
-                        keepCurNalInCurFrame = 0;
+    //dst has new output ready
+    if((revents & (POLLIN | POLLRDNORM))){
+        K_LOG_VERBOSE("StreamContext, poll-event: dst-populated.\n");
+        {
+            STBuffer* buff = NULL;
+            struct timeval timestamp;
+            memset(&timestamp, 0, sizeof(timestamp));
+            if(0 != Buffers_dequeue(&ctx->dec.dst, ctx->dec.fd, &buff, &timestamp)){
+                buff = NULL;
+            } else {
+                int framesSkippedByDecoderCount = 0;
+                unsigned long frameSeqIdx = 0; STVideoFrameState frameState;
+                //
+                ctx->dec.framesOutSinceOpen++;
+                if(ctx->dec.framesOutSinceOpen == 1){
+                    ctx->dec.msFirstFrameOut = ctx->dec.msOpen;
+                    if(ctx->dec.msFirstFrameOut >= 1000){
+                        K_LOG_INFO("StreamContext, %ums + %ums to produce first decoded frame.\n", ctx->dec.msFirstFrameFed, (ctx->dec.msFirstFrameOut - ctx->dec.msFirstFrameFed));
+                    } else {
+                        K_LOG_VERBOSE("StreamContext, %ums + %ums to produce first decoded frame.\n", ctx->dec.msFirstFrameFed, (ctx->dec.msFirstFrameOut - ctx->dec.msFirstFrameFed));
                     }
                 }
-                //Safety, this should be previouly validated at 'isEndOfNAL'
-                K_ASSERT(ctx->frames.filling->accessUnit.nalsCountPerType[10] == 0)
-                if(!startNewFrame && ctx->frames.filling->accessUnit.nalsCountPerType[10]){
-                    K_LOG_VERBOSE("StreamContext, opening new frame ('End of sequence' already added).\n");
-                    startNewFrame = 1;
-                    keepCurNalInCurFrame = 0;
+                //
+                VideoFrameState_init(&frameState);
+                VideoFrameState_timestampToSeqIdx(&timestamp, &frameSeqIdx);
+                VideoFrameStates_getStateCloningAndRemoveOlder(&ctx->dec.frames.fed, frameSeqIdx, &frameState, &framesSkippedByDecoderCount);
+                if(frameState.iSeq == frameSeqIdx){
+                    gettimeofday(&frameState.times.proc.end, NULL);
+                    long msToArrive = msBetweenTimevals(&frameState.times.proc.start, &frameState.times.proc.end);
+                    plyr->stats.curSec.dec.got.msSum += msToArrive;
+                    if(plyr->stats.curSec.dec.got.count == 0){
+                        plyr->stats.curSec.dec.got.msMin = msToArrive;
+                        plyr->stats.curSec.dec.got.msMax = msToArrive;
+                    } else {
+                        if(plyr->stats.curSec.dec.got.msMin > msToArrive) plyr->stats.curSec.dec.got.msMin = msToArrive;
+                        if(plyr->stats.curSec.dec.got.msMax < msToArrive) plyr->stats.curSec.dec.got.msMax = msToArrive;
+                    }
+                    K_LOG_VERBOSE("StreamContext, frame(#%d) output obtained (%dms inside device).\n", (frameSeqIdx + 1), msToArrive);
+                } else {
+                    //stats
+                    plyr->stats.curSec.dec.got.count++;
+                    K_LOG_VERBOSE("StreamContext, frame(#%d) output obtained (no state-fed found).\n", (frameSeqIdx + 1));
                 }
-                //constrains
-                if(nalType == 13 /*Sequence parameter set extension*/){
-                    if(ctx->frames.filling->accessUnit.lastCompletedNalType != 7 /*Sequence parameter set*/){
-                        if(!ctx->frames.filling->accessUnit.isInvalid){
-                            K_LOG_VERBOSE("StreamContext, invalidating frame ('Sequence parameter set extension' without inmediate-previous 'Sequence parameter set').\n");
-                            ctx->frames.filling->accessUnit.isInvalid = 1;
+                plyr->stats.curSec.dec.got.count++;
+                plyr->stats.curSec.dec.got.skipped += framesSkippedByDecoderCount;
+                if(framesSkippedByDecoderCount > 0){
+                    K_LOG_WARN("StreamContext, decoder skipped %d frames fed (when obtaining frame #%u).\n", framesSkippedByDecoderCount, frameSeqIdx + 1);
+                }
+                //flag framebuffers-grps where this frame will be used
+                {
+                    int i; for(i = 0; i < plyr->fbs.grps.use; i++){
+                        STFramebuffsGrp* grp = &plyr->fbs.grps.arr[i];
+                        if(grp->pixFmt == ctx->drawPlan.lastPixelformat){
+                            if(0 == FramebuffsGrp_layoutFindStreamId(grp, ctx->streamId)){
+                                //flag as dirty
+                                grp->isSynced = 0;
+                            }
+                        }
+                    }
+                }
+                //enqueue buffers
+                while(ctx->dec.dst.enqueuedCount < ctx->dec.dst.enqueuedRequiredMin){
+                    STBuffer* buffFnd = NULL;
+                    //find another available buffer to queue, to avoid cloning current buffer.
+                    if(0 != Buffers_getUnqueued(&ctx->dec.dst, &buffFnd, buff)){
+                        buffFnd = NULL;
+                    } else {
+                        //(other) available buffer found
+                        //sync record (empty)
+                        {
+                            //others
+                            int i; for(i = 0; i < buffFnd->planesSz; i++){
+                                STPlane* p = &buffFnd->planes[i];
+                                p->used = 0;
+                            }
+                        }
+                        if(0 != Buffers_enqueue(&ctx->dec.dst, ctx->dec.fd, buffFnd, NULL)){
+                            K_LOG_ERROR("StreamContext, dst-buff could not be queued.\n");
+                            buffFnd = NULL;
+                        } else {
+                            //
+                        }
+                    }
+                    //add current bufer if necesary
+                    if(buffFnd == NULL && buff != NULL){
+                        //keep last as a clone
+                        //ToDo: clone or not clone (memory consume)
+                        /*if(0 != Buffers_keepLastAsClone(&ctx->dec.dst, buff)){
+                            K_LOG_ERROR("StreamContext, frame(#%d) could not be cloned to 'last'.\n", (frameSeqIdx + 1));
+                        }*/
+                        buffFnd = buff; buff = NULL;
+                        //sync record (empty)
+                        {
+                            //others
+                            int i; for(i = 0; i < buffFnd->planesSz; i++){
+                                STPlane* p = &buffFnd->planes[i];
+                                p->used = 0;
+                            }
                         }
-                    }
-                } else if(nalType == 19 /*coded slice of an auxiliary coded picture without partitioning*/){
-                    const int nalVCLCount = VideoFrame_getNalsCountOfGrp(ctx->frames.filling, ENNalTypeGrp_VCL);
-                    if(nalVCLCount == 0){
-                        if(!ctx->frames.filling->accessUnit.isInvalid){
-                            K_LOG_VERBOSE("StreamContext, invalidating frame ('auxiliary coded picture' without previous 'primary or redundant coded pictures').\n");
-                            ctx->frames.filling->accessUnit.isInvalid = 1;
+                        if(0 != Buffers_enqueue(&ctx->dec.dst, ctx->dec.fd, buffFnd, NULL)){
+                            K_LOG_ERROR("StreamContext, dst-buff could not be queued.\n");
+                            buffFnd = NULL;
+                        } else {
+                            //
                         }
                     }
-                } else if(nalType == 0 || nalType == 12 || (nalType >= 20 && nalType <= 31)){
-                    if(!ctx->frames.filling->accessUnit.isInvalid && VideoFrame_getNalsCountOfGrp(ctx->frames.filling, ENNalTypeGrp_VCL) == 0){
-                        K_LOG_VERBOSE("StreamContext, invalidating frame (nalType %d shall not precede the first VCL of the primary coded picture).\n", nalType);
-                        ctx->frames.filling->accessUnit.isInvalid = 1;
+                    //stop if no activity
+                    if(buffFnd == NULL){
+                        break;
                     }
                 }
-                //add
-                ctx->frames.filling->accessUnit.nalsCountPerType[nalType]++;
+                VideoFrameState_release(&frameState);
             }
         }
     }
-    //start new frame before copying data (carry cur-nal ahead)
-    if(startNewFrame && !keepCurNalInCurFrame){
-        K_ASSERT(isNalTypeSet)
-        StreamContext_cnsmBuffNALOpenNewFilling_(ctx, plyr, flushOldersIfIsIndependent, nalType, keepCurNalInCurFrame, &filledAddedBefore);
-    }
-    //feed payload to frame
-    if(ctx->frames.filling != NULL && dataSz > 0){
-        if(0 != VideoFrame_copy(ctx->frames.filling, data, dataSz)){
-            K_LOG_ERROR("VideoFrame_copy failed.\n");
-            VideoFrame_release(ctx->frames.filling);
-            free(ctx->frames.filling);
-            ctx->frames.filling = NULL;
-            ctx->frames.fillingNalSz = 0;
+}
+
+int StreamContext_shutdownStartByFileClosed_(STStreamContext* ctx, struct STPlayer_* plyr, const char* reason){
+    int r = 0;
+    //shutdown permanently (file will not be opened again)
+    const int isPermanent = 1;
+    if(ctx->shuttingDown.isActive){
+        ctx->shuttingDown.isPermanent = isPermanent;
+        //K_LOG_INFO("StreamContext, shutdownStartByFileClosed_ current shutdown flagged (at '%s').\n", reason);
+    } else {
+        if(0 != StreamContext_shutdownStart(ctx, plyr, isPermanent)){
+            K_LOG_ERROR("StreamContext, shutdownStartByFileClosed_ failed (at '%s').\n", reason);
         } else {
-            ctx->frames.fillingNalSz += dataSz;
+            //K_LOG_INFO("StreamContext, shutdownStartByFileClosed_ shutdown started (at '%s').\n", reason);
         }
     }
-    //analyze current frame after current NAL-end is confirmed
-    if(isEndOfNAL){
-        K_ASSERT(ctx->frames.fillingNalSz <= 4 || isNalTypeSet) //should be empty-nal or type-set
-        if(ctx->frames.fillingNalSz <= 4){
-            K_LOG_WARN("StreamContext, empty-nal found (%d bytes): '%s'.\n", ctx->frames.fillingNalSz, ctx->cfg.path);
-            ctx->frames.filling->buff.use -= ctx->frames.fillingNalSz;
-            ctx->frames.fillingNalSz -= ctx->frames.fillingNalSz;
-        } else if(isNalTypeSet){
-            if(ctx->frames.filling != NULL){
-                ctx->frames.filling->accessUnit.lastCompletedNalType = nalType;
-            }
-            //
-            if(isNalTypeSet && nalType == 10 /*End of sequence*/){
-                K_ASSERT(ctx->frames.filling->accessUnit.nalsCountPerType[10]); //should be counted
-                if(!startNewFrame){
-                    //K_LOG_INFO("StreamContext, opening new frame ('End of sequence' completed).\n");
-                    startNewFrame = 1;
-                    keepCurNalInCurFrame = 1;
+    //close file
+    StreamContext_fileMapClose_(ctx);
+    if(ctx->file.fd > 0){
+        Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcFile, ctx, ctx->file.fd);
+        close(ctx->file.fd);
+        ctx->file.fd = -1;
+    }
+    ctx->file.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
+    return r;
+}
+
+void StreamContext_pollCallbackFile_(STStreamContext* ctx, struct STPlayer_* plyr, int revents){
+    //error
+    if((revents & (POLLERR))){
+        const char* reason = "file poll-err";
+        if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
+            K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
+        }
+    } else {
+        if((revents & POLLIN)){
+            int rcvd = 1;
+            unsigned long lastNALPushedSeq = ctx->frames.filled.iSeqPushNext; //to detect completed nals parsed
+            //read untill no data is returned or explicit-stop-reading
+            while(
+                  !ctx->flushing.isActive //not flushing
+                  && lastNALPushedSeq == ctx->frames.filled.iSeqPushNext //rading same NAL
+                  && rcvd > 0 //data read
+                  )
+            {
+                rcvd = 0;
+                //empty buffer if fully consumed (lock is not necesary)
+                if(ctx->buff.buffCsmd >= ctx->buff.buffUse){
+                    ctx->buff.buffCsmd = 0;
+                    ctx->buff.buffUse = 0;
                 }
-            }
-            //
-            if(isNalTypeSet && nalType == 9 /*Access unit delimiter*/){
-                K_ASSERT(ctx->frames.filling->accessUnit.nalsCountPerType[9]); //should be counted
-                if(ctx->frames.fillingNalSz < 6){
-                    K_LOG_ERROR("StreamContext, 'Access unit delimiter' should be 6 bytes or more (including header).\n");
-                    if(!ctx->frames.filling->accessUnit.isInvalid){
-                        K_LOG_INFO("StreamContext, invalidating frame (invalid size of 'Access unit delimiter').\n");
-                        ctx->frames.filling->accessUnit.isInvalid = 1;
-                    }
-                } else {
-                    const int primary_pic_type = (ctx->frames.filling->buff.ptr[ctx->frames.filling->buff.use - ctx->frames.fillingNalSz + 5] & 0xE0) >> 5; //u(3)
-                    if(0 != VideoFrame_setAccessUnitDelimiterFound(ctx->frames.filling, primary_pic_type)){
-                        K_LOG_ERROR("StreamContext, VideoFrame_setAccessUnitDelimiterFound failed.\n");
+                //produce
+                if(ctx->buff.buffUse < ctx->buff.buffSz){
+                    //produce (unlocked)
+                    rcvd = (int)read(ctx->file.fd, &ctx->buff.buff[ctx->buff.buffUse], (ctx->buff.buffSz - ctx->buff.buffUse));
+                    if(rcvd > 0){
+                        StreamContext_cnsmFileRead_(ctx, plyr, rcvd);
+                    } else if(rcvd != 0){ //zero = socket propperly shuteddown
+                        if(errno == EAGAIN || errno == EWOULDBLOCK){
+                            //non-blocking
+                        } else {
+                            const char* reason = "file-read-failed";
+                            if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
+                                K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
+                            }
+                        }
                     }
                 }
             }
         }
     }
-    //start new frame after copying data (keep curNal)
-    if(startNewFrame && keepCurNalInCurFrame){
-        K_ASSERT(isNalTypeSet)
-        StreamContext_cnsmBuffNALOpenNewFilling_(ctx, plyr, flushOldersIfIsIndependent, nalType, keepCurNalInCurFrame, &filledAddedAfter);
-    }
-    //notify consumed
-    if(filledAddedBefore || filledAddedAfter){
-        //decoder
-        if(ctx->dec.fd >= 0){
-            //auto-start at first NAL arrival
-            if(!ctx->dec.src.isExplicitON){
-                if(0 != Buffers_start(&ctx->dec.src, ctx->dec.fd)){
-                    K_LOG_ERROR("StreamContext, Buffers_start failed to '%s'.\n", ctx->cfg.path);
-                } else {
-                    K_LOG_VERBOSE("StreamContext(%lld), src-started by frame arrival '%s'.\n", (long long)ctx, ctx->cfg.path);
-                }
-            }
-            //feed (if running and buffers are not queued yet)
-            if(ctx->dec.src.isImplicitON){
-                StreamContext_cnsmFrameOportunity_(ctx, plyr);
-            }
-            //update poll (first filled-frame is available)
-            if(filledWasEmpty){
-                StreamContext_updatePollMask_(ctx, plyr);
-            }
-        }
-    }
 }
-    
-void StreamContext_cnsmBuffNAL_(STStreamContext* ctx, struct STPlayer_* plyr, const int flushOldersIfIsIndependent){
-    const unsigned char* bStart = (const unsigned char*)&ctx->buff.buff[ctx->buff.buffCsmd];
-    const unsigned char* bAfterEnd = (const unsigned char*)&ctx->buff.buff[ctx->buff.buffUse];
-    const unsigned char* b = bStart;
-    const unsigned char* bChunkStart = bStart;
-    unsigned char hdr[4] = { 0x00, 0x00, 0x00, 0x01 };
-    //
-    while(b < bAfterEnd){
-        if(*b == 0x00){
-            ctx->buff.nal.zeroesSeqAccum++;
-        } else {
-            //analyze end-of-header
-            if(*b == 0x01 && ctx->buff.nal.zeroesSeqAccum >= 3){
-                plyr->stats.curSec.src.nals.started++;
-                //process data-chunk from before this header
-                if(ctx->frames.filling != NULL && ctx->frames.filling->buff.use > 0){
-                    const int isEndOfNAL = 1;
-                    const int curChunkSz = (const int)((b + 1) - bChunkStart); //(b + 1) because we are still in last-byte-of-header
-                    //
-                    plyr->stats.curSec.src.nals.completed++;
-                    //
-                    if(curChunkSz < sizeof(hdr)){
-                        //partial-header was already added to the frame, remove it
-                        const int toRemoveSz = (sizeof(hdr) - curChunkSz);
-                        //K_LOG_INFO("StreamContext, %d bytes of partial-nal-header removed from current frame.\n", toRemoveSz);
-                        K_ASSERT(ctx->frames.filling->buff.use >= ctx->frames.fillingNalSz)
-                        K_ASSERT(ctx->frames.fillingNalSz >= toRemoveSz)
-                        //K_LOG_INFO("StreamContext, removed %d of %d bytes from previous NAL and closing it.\n", toRemoveSz, ctx->frames.fillingNalSz);
-                        ctx->frames.filling->buff.use -= toRemoveSz;
-                        ctx->frames.fillingNalSz -= toRemoveSz;
-                        //analyze current frame
-                        StreamContext_cnsmBuffNALChunk_(ctx, plyr, flushOldersIfIsIndependent, NULL, 0, isEndOfNAL);
-                    } else {
-                        //process chunk before the current header and analyze current frame
-                        //K_LOG_INFO("StreamContext, adding %d (to %d bytes) to previous NAL and closing it.\n", curChunkSz - sizeof(hdr), ctx->frames.fillingNalSz + (curChunkSz - sizeof(hdr)));
-                        StreamContext_cnsmBuffNALChunk_(ctx, plyr, flushOldersIfIsIndependent, bChunkStart, curChunkSz - sizeof(hdr), isEndOfNAL);
-                    }
-                    //
-                    if(ctx->net.unitsRcvd == 0){
-                        ctx->net.msToFirstUnit = ctx->net.msSinceStart;
-                        if(ctx->net.msToFirstUnit > 1000){
-                            K_LOG_INFO("StreamContext_tick, %u ms to receive first stream-unit: '%s'.\n", ctx->net.msToFirstUnit, ctx->cfg.path);
+
+void StreamContext_pollCallbackSocket_(STStreamContext* ctx, struct STPlayer_* plyr, int revents){
+    //error
+    if((revents & (POLLERR))){
+        K_LOG_ERROR("StreamContext, poll-err-flag active at socket '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
+        Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
+        close(ctx->net.socket);
+        ctx->net.socket = 0;
+        StreamContext_netScheduleReconnect_(ctx, plyr);
+    } else if(ctx->cfg.netProto == ENStreamNetProto_RtpUdp){
+        //read (datagrams)
+        if((revents & POLLIN)){
+            StreamContext_netUdpRead_(ctx, plyr);
+        }
+    } else {
+        //write
+        if((revents & POLLOUT)){
+            //send
+            if(ctx->net.req.payCsmd < ctx->net.req.payUse){
+                const int sent = (int)send(ctx->net.socket, &ctx->net.req.pay[ctx->net.req.payCsmd], (ctx->net.req.payUse - ctx->net.req.payCsmd), 0);
+                if(sent > 0){
+                    if(ctx->net.bytesSent == 0){
+                        STNetPool* pool = Player_netPoolGet(plyr, ctx->cfg.server, ctx->cfg.port, 0);
+                        ctx->net.msToConnect = ctx->net.msSinceStart;
+                        if(ctx->net.msToConnect > 1000){
+                            K_LOG_INFO("StreamContext_tick, %u ms to connect%s: '%s'.\n", ctx->net.msToConnect, (ctx->net.isReusedConn ? " (warm)" : ""), ctx->cfg.path);
                         } else {
-                            K_LOG_VERBOSE("StreamContext_tick, %u ms to receive first stream-unit: '%s'.\n", ctx->net.msToFirstUnit, ctx->cfg.path);
+                            K_LOG_VERBOSE("StreamContext_tick, %u ms to connect%s: '%s'.\n", ctx->net.msToConnect, (ctx->net.isReusedConn ? " (warm)" : ""), ctx->cfg.path);
+                        }
+                        if(pool != NULL){
+                            pool->stats.curSec.msToConnectSum += ctx->net.msToConnect;
+                            pool->stats.curSec.msToConnectCount++;
                         }
                     }
-                    ctx->net.unitsRcvd++;
-                }
-                //start new frame (if necesary)
-                if(ctx->frames.filling == NULL){
-                    //create chunk
-                    if(0 != VideoFrames_pullFrameForFill(&ctx->frames.reusable, &ctx->frames.filling)){
-                        K_LOG_INFO("StreamContext, VideoFrames_pullFrameForFill failed.\n");
-                        ctx->frames.filling = NULL;
+                    ctx->net.bytesSent += sent;
+                    ctx->net.msWithoutSend = 0;
+                    ctx->net.req.payCsmd += sent;
+                    if(ctx->net.req.payUse == ctx->net.req.payCsmd){
+                        K_LOG_VERBOSE("StreamContext, request sent (%d bytes) to '%s:%d'.\n", ctx->net.req.payCsmd, ctx->cfg.server, ctx->cfg.port);
+                        K_LOG_VERBOSE("StreamContext, -->\n%s\n<--\n", ctx->net.req.pay);
+                        //stop writting, start reading-only (io_uring: recv is posted instead of polled; shm: ring and doorbells are always polled)
+                        const int isUringRead = (plyr->uring.isActive && ctx->cfg.netProto != ENStreamNetProto_Shm);
+                        if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket, (isUringRead ? 0 : POLLIN), NULL) || (isUringRead && StreamContext_uringPostRead_(ctx, plyr, ENPlayerPollFdType_SrcSocket) < 0)){ //read
+                            K_LOG_ERROR("StreamContext, poll-update-failed to '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
+                            Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
+                            close(ctx->net.socket);
+                            ctx->net.socket = 0;
+                            StreamContext_netScheduleReconnect_(ctx, plyr);
+                        }
+                    }
+                } else if(sent != 0){ //zero = socket propperly shuteddown
+                    if(errno == EAGAIN || errno == EWOULDBLOCK){
+                        //non-blocking
                     } else {
-                        //initial state
-                        //ctx->frames.filling->state.iSeq
-                        gettimeofday(&ctx->frames.filling->state.times.arrival.start, NULL);
-                        gettimeofday(&ctx->frames.filling->state.times.arrival.end, NULL);
-                        gettimeofday(&ctx->frames.filling->state.times.proc.start, NULL);
-                        gettimeofday(&ctx->frames.filling->state.times.proc.end, NULL);
+                        K_LOG_ERROR("StreamContext, send failed to '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
+                        Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
+                        close(ctx->net.socket);
+                        ctx->net.socket = 0;
+                        StreamContext_netScheduleReconnect_(ctx, plyr);
                     }
                 }
-                //copy current header
-                if(ctx->frames.filling != NULL){
-                    //copy 4 header bytes
-                    if(0 != VideoFrame_copy(ctx->frames.filling, hdr, sizeof(hdr))){
-                        K_LOG_ERROR("VideoFrame_copy failed.\n");
-                        VideoFrame_release(ctx->frames.filling);
-                        free(ctx->frames.filling);
-                        ctx->frames.filling = NULL;
-                        ctx->frames.fillingNalSz = 0;
-                    } else {
-                        ctx->frames.fillingNalSz = sizeof(hdr);
+            }
+        }
+        //read (untill no more data is available or the per-wakeup budget is consumed)
+        if((revents & POLLIN) && ctx->cfg.netProto == ENStreamNetProto_Shm){
+            StreamContext_shmRead_(ctx, plyr);
+        } else if((revents & POLLIN)){
+            int rcvd = 0, rcvdTotal = 0, isDrained = 0;
+            const int bytesBudget = (plyr->cfg.netReadBudgetKB > 0 ? plyr->cfg.netReadBudgetKB * 1024 : 0);
+            const unsigned long framesBudget = (plyr->cfg.netReadBudgetFrames > 0 ? plyr->cfg.netReadBudgetFrames : 0);
+            const unsigned long lastNALPushedSeq = ctx->frames.filled.iSeqPushNext; //to detect completed nals parsed
+            //recv untill no data is returned or budget is consumed (remaining data is read after other streams, at next poll)
+            do {
+                int rcvdReq = 0;
+                rcvd = 0;
+                //empty buffer if fully consumed (lock is not necesary)
+                if(ctx->buff.buffCsmd >= ctx->buff.buffUse){
+                    ctx->buff.buffCsmd = 0;
+                    ctx->buff.buffUse = 0;
+                }
+                //produce
+                if(ctx->buff.buffUse < ctx->buff.buffSz){
+                    //produce (unlocked)
+                    rcvdReq = (ctx->buff.buffSz - ctx->buff.buffUse);
+                    rcvd = (int)recv(ctx->net.socket, &ctx->buff.buff[ctx->buff.buffUse], rcvdReq, 0);
+                    ctx->net.tune.stats.curSec.recvs++;
+                    if(rcvd > 0){
+                        StreamContext_cnsmNetRcvd_(ctx, plyr, rcvd);
+                        rcvdTotal += rcvd;
+                        //short read, the kernel buffer was emptied (avoids the EAGAIN syscall)
+                        if(rcvd < rcvdReq){
+                            isDrained = 1;
+                        }
+                    } else if(rcvd != 0){ //zero = socket propperly shuteddown
+                        if(errno == EAGAIN || errno == EWOULDBLOCK){
+                            //non-blocking
+                            isDrained = 1;
+                        } else {
+                            K_LOG_ERROR("StreamContext, recv failed to '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
+                            Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
+                            close(ctx->net.socket);
+                            ctx->net.socket = 0;
+                            StreamContext_netScheduleReconnect_(ctx, plyr);
+                        }
                     }
                 }
-                //start-of-next-chunk
-                bChunkStart = b + 1;
+            } while(
+                    rcvd > 0 && !isDrained && ctx->net.socket > 0
+                    && (bytesBudget <= 0 || rcvdTotal < bytesBudget)
+                    && (framesBudget <= 0 || (ctx->frames.filled.iSeqPushNext - lastNALPushedSeq) < framesBudget)
+                    );
+            //quick-ack is not permanent (re-armed once per wakeup)
+            if(plyr->cfg.netTcpQuickAck && ctx->net.socket > 0){
+                const int v = 1;
+                setsockopt(ctx->net.socket, IPPROTO_TCP, TCP_QUICKACK, &v, sizeof(v));
+            }
+        }
+    }
+}
+
+//mapped file (NALs parsed from the mapping, paced by monotonic deadlines, loop playback)
+
+int StreamContext_fileMapOpen_(STStreamContext* ctx, const int fd){
+    int r = -1;
+    struct stat st;
+    if(0 != fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size <= 0){
+        K_LOG_VERBOSE("StreamContext, file not mappable, it will be read: '%s'.\n", ctx->cfg.path);
+    } else {
+        void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(map == MAP_FAILED){
+            K_LOG_WARN("StreamContext, file mmap failed (%s), it will be read: '%s'.\n", strerror(errno), ctx->cfg.path);
+        } else {
+            if(0 != madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL)){
+                K_LOG_VERBOSE("StreamContext, file madvise(MADV_SEQUENTIAL) failed: '%s'.\n", ctx->cfg.path);
+            }
+            ctx->file.map = (const unsigned char*)map;
+            ctx->file.mapSz = (unsigned long)st.st_size;
+            ctx->file.mapPos = 0;
+            ctx->file.usNextFrame = 0;
+            ctx->file.mp4Sample = 0;
+            //format (mp4 sample table is indexed once)
+            if(ctx->file.mapSz >= 8 && memcmp(&ctx->file.map[4], "ftyp", 4) == 0){
+                if(0 != Mp4Track_parse(&ctx->file.mp4, ctx->file.map, ctx->file.mapSz)){
+                    K_LOG_ERROR("StreamContext, file, mp4 video track (not fragmented, avc1/hvc1) not found: '%s'.\n", ctx->cfg.path);
+                } else if(ctx->file.mp4.pixFmt != ctx->cfg.srcPixFmt){
+                    K_LOG_ERROR("StreamContext, file, mp4 video track is %s, set '--srcFmt %s' before '--file': '%s'.\n", (ctx->file.mp4.pixFmt == V4L2_PIX_FMT_HEVC ? "H.265" : "H.264"), (ctx->file.mp4.pixFmt == V4L2_PIX_FMT_HEVC ? "hevc" : "h264"), ctx->cfg.path);
+                } else {
+                    K_LOG_INFO("StreamContext, file, mp4 video track: %lu samples, %d-bytes NAL lengths, %d bytes of parameter sets, %luus per sample: '%s'.\n", ctx->file.mp4.samplesUse, ctx->file.mp4.lenSz, ctx->file.mp4.prmsSz, ctx->file.mp4.frameUs, ctx->cfg.path);
+                    ctx->file.fmt = ENStreamFileFmt_Mp4;
+                    r = 0;
+                }
+            } else if(nalsAreLengthPrefixed(ctx->file.map, ctx->file.mapSz, 4)){
+                K_LOG_INFO("StreamContext, file, length-prefixed NALs (AVCC): '%s'.\n", ctx->cfg.path);
+                ctx->file.fmt = ENStreamFileFmt_Avcc;
+                r = 0;
+            } else {
+                ctx->file.fmt = ENStreamFileFmt_AnnexB;
+                r = 0;
+            }
+            if(r == 0){
+                K_LOG_INFO("StreamContext, file mapped (%luKB): '%s'.\n", (ctx->file.mapSz / 1024), ctx->cfg.path);
+            } else {
+                StreamContext_fileMapClose_(ctx);
             }
-            //reset zeroes-zeq
-            ctx->buff.nal.zeroesSeqAccum = 0;
         }
-        b++;
     }
-    //process last (unconsumed) chunk
-    if(bChunkStart < bAfterEnd && ctx->frames.filling != NULL){
-        const int isEndOfNAL = 0;
-        const int sztoCpy = (int)(bAfterEnd - bChunkStart);
-        StreamContext_cnsmBuffNALChunk_(ctx, plyr, flushOldersIfIsIndependent, bChunkStart, sztoCpy, isEndOfNAL);
+    return r;
+}
+
+void StreamContext_fileMapClose_(STStreamContext* ctx){
+    if(ctx->file.map != NULL){
+        munmap((void*)ctx->file.map, ctx->file.mapSz);
+        ctx->file.map = NULL;
     }
+    ctx->file.mapSz = 0;
+    ctx->file.mapPos = 0;
+    ctx->file.usNextFrame = 0;
+    ctx->file.fmt = ENStreamFileFmt_AnnexB;
+    ctx->file.mp4Sample = 0;
+    Mp4Track_release(&ctx->file.mp4);
 }
 
-void StreamContext_pollCallbackDevice_(STStreamContext* ctx, struct STPlayer_* plyr, int revents){
-    K_LOG_VERBOSE("Device, poll-event(%d):%s%s%s%s%s%s.\n", revents, (revents & POLLERR) ? " errors" : "", (revents & POLLPRI) ? " events": "", (revents & (POLLOUT | POLLWRNORM)) ? " src-hungry": "", (revents & (POLLIN | POLLRDNORM)) ? " dst-populated": "", (revents & (POLLERR | POLLPRI | POLLOUT | POLLWRNORM | POLLIN | POLLRDNORM)) == 0 ? "none" : "", (revents & ~(POLLERR | POLLPRI | POLLOUT | POLLWRNORM | POLLIN | POLLRDNORM)) != 0 ? "others" : "");
-    //error
-    if((revents & (POLLERR))){
-        K_LOG_ERROR("Device, poll-event: error.\n");
-        if(0 != StreamContext_close(ctx, plyr)){
-            K_LOG_ERROR("StreamContext_close failed: '%s'.\n", ctx->cfg.path);
-        }
-        ctx->dec.isWaitingForIDRFrame = 1;
-        ctx->dec.msToReopen = (plyr->cfg.decoderWaitRecopenSecs <= 0 ? 1 : plyr->cfg.decoderWaitRecopenSecs) * 1000;
-        //reset (just in case)
-        {
-            ctx->dec.src.msWithoutEnqueuing = 0;
-            ctx->dec.src.msWithoutDequeuing = 0;
-            //
-            ctx->dec.dst.msWithoutEnqueuing = 0;
-            ctx->dec.dst.msWithoutDequeuing = 0;
-            //
-            ctx->dec.msWithoutFeedFrame = 0;
+unsigned long StreamContext_fileMapFrameUs_(STStreamContext* ctx){
+    unsigned long r = 0;
+    if(ctx->cfg.fileFps > 0){
+        r = (1000000UL / ctx->cfg.fileFps);
+    } else if(ctx->file.fmt == ENStreamFileFmt_Mp4 && ctx->file.mp4.frameUs >= 1000 && ctx->file.mp4.frameUs <= 1000000){ //1 to 1000 fps
+        r = ctx->file.mp4.frameUs;
+    } else if(ctx->cfg.srcPixFmt == V4L2_PIX_FMT_H264 && ctx->drawPlan.lastSps.num_units_in_tick > 0 && ctx->drawPlan.lastSps.time_scale > 0){
+        //a frame is two fields
+        const unsigned long long us = (2ULL * ctx->drawPlan.lastSps.num_units_in_tick * 1000000ULL) / ctx->drawPlan.lastSps.time_scale;
+        if(us >= 1000 && us <= 1000000){ //1 to 1000 fps
+            r = (unsigned long)us;
         }
     }
-    //event
-    if((revents & (POLLPRI))){
-        K_LOG_VERBOSE("Device, poll-event: event.\n");
-        int rr = 0, knownPends = 1, eventsDequeuedTotal = 0;
-        int isResolutionChangeEvent = 0;
-        while(rr == 0 && knownPends > 0){
-            struct v4l2_event ev;
-            memset(&ev, 0, sizeof(ev));
-            //
-            rr = v4l2_ioctl(ctx->dec.fd, VIDIOC_DQEVENT, &ev);
-            if(rr != 0){
-                if(errno == EAGAIN){
-                    //no pending events
-                    knownPends = 0;
-                    rr = 0;
-                } else {
-                    //error
-                    const STErrCode* err = _getErrCode(errno);
-                    if(err == NULL){
-                        K_LOG_ERROR("StreamContext, VIDIOC_DQEVENT returned errno(%d).\n", errno);
-                    } else {
-                        K_LOG_ERROR("StreamContext, VIDIOC_DQEVENT returned '%s'.\n", err->str);
-                    }
-                    knownPends = 0;
-                    rr = 0;
+    return r;
+}
+
+int StreamContext_fileMapParseFrame_(STStreamContext* ctx, struct STPlayer_* plyr){
+    const unsigned long lastNALPushedSeq = ctx->frames.filled.iSeqPushNext;
+    const unsigned char startCode[4] = { 0x00, 0x00, 0x00, 0x01 };
+    unsigned long parsed = 0;
+    while(ctx->file.map != NULL && lastNALPushedSeq == ctx->frames.filled.iSeqPushNext && parsed <= ctx->file.mapSz){
+        if(ctx->file.fmt == ENStreamFileFmt_AnnexB){
+            //up to the header that completes the next frame
+            const unsigned long avail = (ctx->file.mapSz - ctx->file.mapPos);
+            const unsigned char* bStart = &ctx->file.map[ctx->file.mapPos];
+            const int csmd = StreamContext_cnsmNALs_(ctx, plyr, 0 /*flushOldersIfIsIndependent*/, bStart, bStart + (avail < K_FILE_MAP_PARSE_MAX ? avail : K_FILE_MAP_PARSE_MAX), 1);
+            parsed += csmd;
+            ctx->file.mapPos += csmd;
+            if(ctx->file.mapPos >= ctx->file.mapSz){
+                //loop (the first header completes the last frame)
+                K_LOG_VERBOSE("StreamContext, file end reached, playing from start: '%s'.\n", ctx->cfg.path);
+                ctx->file.mapPos = 0;
+            }
+        } else {
+            //length-prefixed NALs, inside the current sample (mp4) or the whole file (avcc)
+            const int isMp4 = (ctx->file.fmt == ENStreamFileFmt_Mp4 ? 1 : 0);
+            const STMp4Sample* smpl = (isMp4 ? &ctx->file.mp4.samples[ctx->file.mp4Sample] : NULL);
+            const unsigned char* rgn = (isMp4 ? &ctx->file.map[smpl->off] : ctx->file.map);
+            const unsigned long rgnSz = (isMp4 ? smpl->sz : ctx->file.mapSz);
+            const int lenSz = (isMp4 ? ctx->file.mp4.lenSz : 4);
+            unsigned long nalSz = 0;
+            //parameter sets (from 'avcC' or 'hvcC') before each sync sample not carrying its own, the decoder could be opened at any of them
+            if(isMp4 && ctx->file.mapPos == 0 && smpl->isSync && ctx->file.mp4.prmsSz > 0 && !Mp4Track_sampleHasPrms(&ctx->file.mp4, rgn, rgnSz)){
+                StreamContext_cnsmNALs_(ctx, plyr, 0 /*flushOldersIfIsIndependent*/, ctx->file.mp4.prms, ctx->file.mp4.prms + ctx->file.mp4.prmsSz, 0);
+            }
+            if((ctx->file.mapPos + lenSz) <= rgnSz){
+                int i; for(i = 0; i < lenSz; i++){
+                    nalSz = (nalSz << 8) | rgn[ctx->file.mapPos + i];
+                }
+                if(nalSz == 0 || nalSz > (rgnSz - ctx->file.mapPos - lenSz)){
+                    K_LOG_VERBOSE("StreamContext, file, NAL length (%lu) beyond the %s, rest ignored: '%s'.\n", nalSz, (isMp4 ? "sample" : "file"), ctx->cfg.path);
+                    nalSz = 0;
+                }
+            }
+            if(nalSz == 0){
+                //next sample, or loop (the first NAL completes the last frame)
+                parsed += (rgnSz - ctx->file.mapPos) + 1;
+                ctx->file.mapPos = 0;
+                if(!isMp4 || ++ctx->file.mp4Sample >= ctx->file.mp4.samplesUse){
+                    K_LOG_VERBOSE("StreamContext, file end reached, playing from start: '%s'.\n", ctx->cfg.path);
+                    ctx->file.mp4Sample = 0;
                 }
             } else {
-                //analyze event
-                switch(ev.type){
-                    //V4L2_EVENT_RESOLUTION_CHANGE == V4L2_EVENT_SOURCE_CHANGE
-#                   ifdef V4L2_EVENT_RESOLUTION_CHANGE
-                    case V4L2_EVENT_RESOLUTION_CHANGE:
-                        {
-                            K_LOG_VERBOSE("StreamContext, event(V4L2_EVENT_RESOLUTION_CHANGE).\n");
-                            isResolutionChangeEvent = 1;
-                        }
-                        break;
-#                   else
-                    case V4L2_EVENT_SOURCE_CHANGE:
-                        /*
-                        https://www.kernel.org/doc/html/latest/userspace-api/media/v4l/dev-decoder.html
-                        Means:
-                        - coded resolution (OUTPUT width and height),
-                        - visible resolution (selection rectangles),
-                        - the minimum number of buffers needed for decoding,
-                        - bit-depth of the bitstream has been changed.
-                        */
-                        {
-                            //specifies a flag for resolution changes
-                            struct v4l2_event_src_change* src_change = &ev.u.src_change;
-                            isResolutionChangeEvent = 1;
-                            //
-                            if((src_change->changes & V4L2_EVENT_SRC_CH_RESOLUTION)){
-                                K_LOG_VERBOSE("StreamContext, event(V4L2_EVENT_SOURCE_CHANGE) change(CH_RESOLUTION).\n");
-                                src_change->changes &= ~V4L2_EVENT_SRC_CH_RESOLUTION;
-                            } else {
-                                K_LOG_VERBOSE("StreamContext, event(V4L2_EVENT_SOURCE_CHANGE).\n");
-                            }
-                            if(src_change->changes){
-                                K_LOG_VERBOSE("                 change: UNKNOWN(%u).\n", src_change->changes);
-                            }
-                        }
-                        break;
-#                   endif
-                    case V4L2_EVENT_EOS: //last frame has been decoded
-                        K_LOG_INFO("StreamContext, event(V4L2_EVENT_EOS).\n");
-                        break;
-                    default:
-                        K_LOG_INFO("StreamContext, event(%d, UNSUPPORTED BY THIS CODE).\n", ev.type);
-                        break;
-                }
-                //
-                if(ev.pending > 0){
-                    K_LOG_INFO("StreamContext, %d pending after this one.\n", ev.pending);
-                }
-                //apply resolution change inmediatly
-                if(isResolutionChangeEvent){
-                    ctx->dec.dst.isImplicitON = 0; //resolution-change events internally stops the dst-side of the devie
-                    //remove current buffers
-                    if(ctx->dec.dst.isExplicitON){
-                        if(0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.dst, ctx->dec.fd)){
-                            K_LOG_WARN("StreamContext_stopAndCleanupBuffs(dst) failed: '%s'.\n", ctx->cfg.device);
-                        } else {
-                            K_LOG_INFO("StreamContext, dst uninited: '%s'.\n", ctx->cfg.device);
-                        }
-                    }
-                    //create new buffers
-                    if(0 != StreamContext_initAndStartDst(ctx, plyr)){
-                        K_LOG_ERROR("StreamContext_initAndStartDst(dst, %d buffers) failed: '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
-                    } else {
-                        K_LOG_VERBOSE("StreamContext, dst inited and started (%d buffers): '%s'.\n", ctx->dec.dst.sz, ctx->cfg.device);
-                    }
+                //start code and NAL, fed from the mapping (by parts for huge NALs)
+                const unsigned char* nal = &rgn[ctx->file.mapPos + lenSz];
+                unsigned long fed = 0;
+                StreamContext_cnsmNALs_(ctx, plyr, 0 /*flushOldersIfIsIndependent*/, startCode, startCode + sizeof(startCode), 0);
+                while(fed < nalSz && ctx->file.map != NULL){
+                    const unsigned long partSz = ((nalSz - fed) < K_FILE_MAP_PARSE_MAX ? (nalSz - fed) : K_FILE_MAP_PARSE_MAX);
+                    StreamContext_cnsmNALs_(ctx, plyr, 0 /*flushOldersIfIsIndependent*/, &nal[fed], &nal[fed + partSz], 0);
+                    fed += partSz;
                 }
-                knownPends = ev.pending;
+                ctx->file.mapPos += lenSz + nalSz;
+                parsed += lenSz + nalSz;
             }
         }
     }
-    //src is ready for new input
-    if((revents & (POLLOUT | POLLWRNORM))){
-        K_LOG_VERBOSE("StreamContext(%lld), poll-event: src-hungry.\n", (long long)ctx);
-        StreamContext_cnsmFrameOportunity_(ctx, plyr);
+    return (lastNALPushedSeq != ctx->frames.filled.iSeqPushNext ? 1 : 0);
+}
+
+void StreamContext_fileMapTick_(STStreamContext* ctx, struct STPlayer_* plyr){
+    const unsigned long frameUs = StreamContext_fileMapFrameUs_(ctx);
+    unsigned long long usNow = 0;
+    int framesCount = 0;
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        usNow = ((unsigned long long)now.tv_sec * 1000000ULL) + (unsigned long long)(now.tv_nsec / 1000);
     }
-    //dst has new output ready
-    if((revents & (POLLIN | POLLRDNORM))){
-        K_LOG_VERBOSE("StreamContext, poll-event: dst-populated.\n");
-        {
-            STBuffer* buff = NULL;
-            struct timeval timestamp;
-            memset(&timestamp, 0, sizeof(timestamp));
-            if(0 != Buffers_dequeue(&ctx->dec.dst, ctx->dec.fd, &buff, &timestamp)){
-                buff = NULL;
+    if(frameUs > 0 && (ctx->file.usNextFrame == 0 || (ctx->file.usNextFrame + (K_FILE_MAP_RESYNC_MS * 1000ULL)) < usNow)){
+        ctx->file.usNextFrame = usNow;
+    }
+    while(ctx->file.map != NULL && !ctx->flushing.isActive && framesCount < K_FILE_MAP_FRAMES_PER_TICK){
+        if(frameUs > 0){
+            if(ctx->file.usNextFrame > usNow){
+                break; //not due yet
+            }
+        } else if(ctx->buff.screenRefreshSeqBlocking > 0 && ctx->buff.screenRefreshSeqBlocking == plyr->anim.tickSeq){
+            break; //no timing known, one frame per screen refresh
+        }
+        //parse up to the next completed frame
+        if(!StreamContext_fileMapParseFrame_(ctx, plyr)){
+            break; //no frame found (the read-timeout will reopen the file)
+        }
+        ctx->file.msWithoutRead = 0;
+        framesCount++;
+        if(frameUs > 0){
+            ctx->file.usNextFrame += frameUs;
+        } else {
+            ctx->buff.screenRefreshSeqBlocking = plyr->anim.tickSeq;
+            break;
+        }
+    }
+}
+
+void StreamContext_cnsmFileRead_(STStreamContext* ctx, struct STPlayer_* plyr, const int rcvd){
+    const unsigned long lastNALPushedSeq = ctx->frames.filled.iSeqPushNext; //to detect completed nals parsed
+    K_LOG_VERBOSE("File, %d/%d read.\n", rcvd, (ctx->buff.buffSz - ctx->buff.buffUse));
+    ctx->buff.buffUse += rcvd;
+    //read body (NALs)
+    StreamContext_cnsmBuffNAL_(ctx, plyr, 0 /*flushOldersIfIsIndependent*/);
+    //mark as fully consumed
+    ctx->file.msWithoutRead = 0;
+    ctx->buff.buffCsmd = ctx->buff.buffUse;
+    //new frame arrived, wait for screen refresh
+    if(lastNALPushedSeq != ctx->frames.filled.iSeqPushNext){
+        //wait untill screen refresh
+        ctx->buff.screenRefreshSeqBlocking = plyr->anim.tickSeq;
+        if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_SrcFile, ctx, ctx->file.fd, 0, NULL)){ //nothing
+            const char* reason = "poll-update-failed";
+            if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
+                K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
+            }
+        }
+    }
+}
+
+//rtsp
+
+int StreamContext_netSendRequest_(STStreamContext* ctx, struct STPlayer_* plyr){
+    int r = -1;
+    if(ctx->net.socket > 0){
+        StreamContext_netBuildRequest_(ctx);
+        //write (and keep reading, io_uring: recv is posted instead of polled)
+        if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket, (plyr->uring.isActive ? POLLOUT : (POLLOUT | POLLIN)), NULL)){
+            K_LOG_ERROR("StreamContext, poll-update-failed to '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
+        } else {
+            r = 0;
+        }
+    }
+    return r;
+}
+
+void StreamContext_rtspSdpLine_(STStreamContext* ctx, const char* line){
+    if(strncmp(line, "m=", 2) == 0){
+        ctx->net.rtsp.isVideoMedia = (strncmp(line, "m=video", 7) == 0 ? 1 : 0);
+    } else if(ctx->net.rtsp.isVideoMedia && strncmp(line, "a=rtpmap:", 9) == 0){
+        //'a=rtpmap:<payload type> <encoding name>/<clock rate>'
+        const char* enc = strchr(&line[9], ' ');
+        if(enc != NULL){
+            const int isH264 = (strncasecmp(enc + 1, "H264/", 5) == 0 ? 1 : 0);
+            const int isH265 = (strncasecmp(enc + 1, "H265/", 5) == 0 ? 1 : 0);
+            if((isH264 && ctx->cfg.srcPixFmt == V4L2_PIX_FMT_HEVC) || (isH265 && ctx->cfg.srcPixFmt != V4L2_PIX_FMT_HEVC)){
+                K_LOG_ERROR("StreamContext, rtsp, video track is %s but the stream is not (see '--srcFmt'): '%s'.\n", (isH265 ? "H.265" : "H.264"), ctx->cfg.path);
+                ctx->net.rtsp.isCodecMismatch = 1;
+            }
+        }
+    } else if(ctx->net.rtsp.isVideoMedia && ctx->net.rtsp.control[0] == '\0' && strncmp(line, "a=control:", 10) == 0){
+        const char* val = &line[10];
+        const int baseLen = strlen(ctx->net.rtsp.base);
+        if(strncasecmp(val, "rtsp://", 7) == 0){
+            //absolute
+            snprintf(ctx->net.rtsp.control, sizeof(ctx->net.rtsp.control), "%s", val);
+        } else if(strcmp(val, "*") == 0){
+            snprintf(ctx->net.rtsp.control, sizeof(ctx->net.rtsp.control), "%s", ctx->net.rtsp.base);
+        } else {
+            //relative to base
+            snprintf(ctx->net.rtsp.control, sizeof(ctx->net.rtsp.control), "%s%s%s", ctx->net.rtsp.base, (baseLen > 0 && ctx->net.rtsp.base[baseLen - 1] == '/' ? "" : "/"), val);
+        }
+        K_LOG_VERBOSE("StreamContext, rtsp, video track: '%s'.\n", ctx->net.rtsp.control);
+    }
+}
+
+int StreamContext_rtspRespCompleted_(STStreamContext* ctx, struct STPlayer_* plyr){
+    int r = 0;
+    //last sdp line (without '\n')
+    if(ctx->net.rtsp.state == ENRtspState_Describe && ctx->net.resp.line.use > 0){
+        ctx->net.resp.line.str[ctx->net.resp.line.use] = '\0';
+        StreamContext_rtspSdpLine_(ctx, ctx->net.resp.line.str);
+    }
+    //next request
+    switch(ctx->net.rtsp.state){
+        case ENRtspState_Describe:
+            if(ctx->net.rtsp.control[0] == '\0'){
+                K_LOG_ERROR("StreamContext, rtsp, no video track found at '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                r = -1;
+            } else if(ctx->net.rtsp.isCodecMismatch){
+                r = -1;
             } else {
-                int framesSkippedByDecoderCount = 0;
-                unsigned long frameSeqIdx = 0; STVideoFrameState frameState;
-                //
-                ctx->dec.framesOutSinceOpen++;
-                if(ctx->dec.framesOutSinceOpen == 1){
-                    ctx->dec.msFirstFrameOut = ctx->dec.msOpen;
-                    if(ctx->dec.msFirstFrameOut >= 1000){
-                        K_LOG_INFO("StreamContext, %ums + %ums to produce first decoded frame.\n", ctx->dec.msFirstFrameFed, (ctx->dec.msFirstFrameOut - ctx->dec.msFirstFrameFed));
-                    } else {
-                        K_LOG_VERBOSE("StreamContext, %ums + %ums to produce first decoded frame.\n", ctx->dec.msFirstFrameFed, (ctx->dec.msFirstFrameOut - ctx->dec.msFirstFrameFed));
-                    }
+                ctx->net.rtsp.state = ENRtspState_Setup;
+                ctx->net.rtsp.cseq++;
+                r = StreamContext_netSendRequest_(ctx, plyr);
+            }
+            break;
+        case ENRtspState_Setup:
+            if(ctx->net.rtsp.session[0] == '\0'){
+                K_LOG_ERROR("StreamContext, rtsp, no session returned by '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                r = -1;
+            } else {
+                ctx->net.rtsp.state = ENRtspState_Play;
+                ctx->net.rtsp.cseq++;
+                r = StreamContext_netSendRequest_(ctx, plyr);
+            }
+            break;
+        case ENRtspState_Play:
+            K_LOG_VERBOSE("StreamContext, rtsp, playing (session '%s', timeout %ds): '%s'.\n", ctx->net.rtsp.session, ctx->net.rtsp.timeoutSecs, ctx->cfg.path);
+            ctx->net.rtsp.state = ENRtspState_Playing;
+            ctx->net.rtsp.msSinceKeepAlive = 0;
+            break;
+        default:
+            //keep-alive response
+            break;
+    }
+    //reset for next response
+    ctx->net.resp.headerEnded = 0;
+    ctx->net.resp.statusCode = 0;
+    ctx->net.resp.contentLength = -1;
+    ctx->net.resp.line.use = 0;
+    ctx->net.resp.line.count = 0;
+    ctx->net.rtsp.bodyRemain = 0;
+    ctx->net.rtsp.isVideoMedia = 0;
+    return r;
+}
+
+//One NAL (or part of it) from a RTP payload.
+void StreamContext_rtpNal_(STStreamContext* ctx, struct STPlayer_* plyr, const unsigned char* data, const int dataSz, const int isStart, const int isEnd){
+    if(isStart){
+        plyr->stats.curSec.src.nals.started++;
+        StreamContext_cnsmBuffNALStarted_(ctx, plyr);
+    }
+    if(ctx->frames.filling != NULL){
+        StreamContext_cnsmBuffNALChunk_(ctx, plyr, 1 /*flushOldersIfIsIndependent*/, data, dataSz, isEnd);
+        if(isEnd){
+            plyr->stats.curSec.src.nals.completed++;
+            StreamContext_cnsmBuffNALCompleted_(ctx, plyr);
+        }
+    }
+}
+
+//RTP payload (RFC 7798 single NAL, AP and FU payloads, without DONL fields).
+void StreamContext_rtpPayloadHevc_(STStreamContext* ctx, struct STPlayer_* plyr, const unsigned char* pay, const int paySz){
+    const int nalType = (paySz >= 2 ? ((pay[0] >> 1) & 0x3F) : -1);
+    if(nalType >= 0 && nalType <= 47){
+        //single NAL
+        StreamContext_rtpNal_(ctx, plyr, pay, paySz, 1, 1);
+    } else if(nalType == 48){
+        //AP: [hdr16] ([size16] [nal])+
+        int i = 2;
+        while((i + 2) <= paySz){
+            const int nalSz = ((pay[i] << 8) | pay[i + 1]);
+            i += 2;
+            if(nalSz <= 0 || (i + nalSz) > paySz){
+                break;
+            }
+            StreamContext_rtpNal_(ctx, plyr, &pay[i], nalSz, 1, 1);
+            i += nalSz;
+        }
+    } else if(nalType == 49 && paySz > 3){
+        //FU: [hdr16] [S E type6] [fragment]
+        const unsigned char fuHdr = pay[2];
+        if(fuHdr & 0x80){
+            const unsigned char nalHdr[2] = { (unsigned char)((pay[0] & 0x81) | ((fuHdr & 0x3F) << 1)), pay[1] };
+            if(ctx->net.rtp.isFuActive && ctx->frames.filling != NULL){
+                //previous fragmented NAL never ended
+                StreamContext_cnsmBuffNALChunk_(ctx, plyr, 1 /*flushOldersIfIsIndependent*/, NULL, 0, 1 /*isEndOfNAL*/);
+                ctx->frames.filling->accessUnit.isInvalid = 1;
+            }
+            StreamContext_rtpNal_(ctx, plyr, nalHdr, 2, 1, 0);
+            ctx->net.rtp.isFuActive = 1;
+        }
+        if(ctx->net.rtp.isFuActive){
+            const int isEnd = ((fuHdr & 0x40) ? 1 : 0);
+            StreamContext_rtpNal_(ctx, plyr, &pay[3], (paySz - 3), 0, isEnd);
+            if(isEnd){
+                ctx->net.rtp.isFuActive = 0;
+            }
+        }
+    }
+    //others (PACI) are not expected
+}
+
+//RTP packet (RFC 6184 single NAL, STAP-A and FU-A payloads; RFC 7798 for H.265).
+void StreamContext_rtpPacket_(STStreamContext* ctx, struct STPlayer_* plyr, const unsigned char* pkt, int pktSz){
+    int hdrSz = 12;
+    if(pktSz < 12 || (pkt[0] >> 6) != 2){
+        return;
+    }
+    hdrSz += (pkt[0] & 0x0F) * 4; //CSRCs
+    if((pkt[0] & 0x10) && (hdrSz + 4) <= pktSz){ //extension
+        hdrSz += 4 + (((pkt[hdrSz + 2] << 8) | pkt[hdrSz + 3]) * 4);
+    }
+    if((pkt[0] & 0x20) && pktSz > 0){ //padding
+        pktSz -= pkt[pktSz - 1];
+    }
+    if(hdrSz >= pktSz){
+        return;
+    }
+    //sequence (a lost packet invalidates the frame being filled, next frames are ignored until an IDR)
+    {
+        const unsigned short seq = (unsigned short)((pkt[2] << 8) | pkt[3]);
+        if(ctx->net.rtp.isSeqSet && seq != ctx->net.rtp.seqNext){
+            ctx->net.rtp.pktsLost += (unsigned short)(seq - ctx->net.rtp.seqNext);
+            if(ctx->net.rtp.isFuActive){
+                ctx->net.rtp.isFuActive = 0;
+                if(ctx->frames.filling != NULL){
+                    StreamContext_cnsmBuffNALChunk_(ctx, plyr, 1 /*flushOldersIfIsIndependent*/, NULL, 0, 1 /*isEndOfNAL*/);
                 }
-                //
-                VideoFrameState_init(&frameState);
-                VideoFrameState_timestampToSeqIdx(&timestamp, &frameSeqIdx);
-                VideoFrameStates_getStateCloningAndRemoveOlder(&ctx->dec.frames.fed, frameSeqIdx, &frameState, &framesSkippedByDecoderCount);
-                if(frameState.iSeq == frameSeqIdx){
-                    gettimeofday(&frameState.times.proc.end, NULL);
-                    long msToArrive = msBetweenTimevals(&frameState.times.proc.start, &frameState.times.proc.end);
-                    plyr->stats.curSec.dec.got.msSum += msToArrive;
-                    if(plyr->stats.curSec.dec.got.count == 0){
-                        plyr->stats.curSec.dec.got.msMin = msToArrive;
-                        plyr->stats.curSec.dec.got.msMax = msToArrive;
-                    } else {
-                        if(plyr->stats.curSec.dec.got.msMin > msToArrive) plyr->stats.curSec.dec.got.msMin = msToArrive;
-                        if(plyr->stats.curSec.dec.got.msMax < msToArrive) plyr->stats.curSec.dec.got.msMax = msToArrive;
-                    }
-                    K_LOG_VERBOSE("StreamContext, frame(#%d) output obtained (%dms inside device).\n", (frameSeqIdx + 1), msToArrive);
-                } else {
-                    //stats
-                    plyr->stats.curSec.dec.got.count++;
-                    K_LOG_VERBOSE("StreamContext, frame(#%d) output obtained (no state-fed found).\n", (frameSeqIdx + 1));
+            }
+            if(ctx->frames.filling != NULL){
+                ctx->frames.filling->accessUnit.isInvalid = 1;
+            }
+            ctx->dec.isWaitingForIDRFrame = 1;
+            K_LOG_VERBOSE("StreamContext, rtp, seq %u received, %u expected: '%s'.\n", seq, ctx->net.rtp.seqNext, ctx->cfg.path);
+        }
+        ctx->net.rtp.seqNext = (unsigned short)(seq + 1);
+        ctx->net.rtp.isSeqSet = 1;
+    }
+    //payload
+    {
+        const unsigned char* pay = &pkt[hdrSz];
+        const int paySz = pktSz - hdrSz;
+        const int nalType = (pay[0] & 0x1F);
+        if(ctx->cfg.srcPixFmt == V4L2_PIX_FMT_HEVC){
+            StreamContext_rtpPayloadHevc_(ctx, plyr, pay, paySz);
+        } else if(nalType >= 1 && nalType <= 23){
+            //single NAL
+            StreamContext_rtpNal_(ctx, plyr, pay, paySz, 1, 1);
+        } else if(nalType == 24){
+            //STAP-A: [hdr] ([size16] [nal])+
+            int i = 1;
+            while((i + 2) <= paySz){
+                const int nalSz = ((pay[i] << 8) | pay[i + 1]);
+                i += 2;
+                if(nalSz <= 0 || (i + nalSz) > paySz){
+                    break;
                 }
-                plyr->stats.curSec.dec.got.count++;
-                plyr->stats.curSec.dec.got.skipped += framesSkippedByDecoderCount;
-                if(framesSkippedByDecoderCount > 0){
-                    K_LOG_WARN("StreamContext, decoder skipped %d frames fed (when obtaining frame #%u).\n", framesSkippedByDecoderCount, frameSeqIdx + 1);
+                StreamContext_rtpNal_(ctx, plyr, &pay[i], nalSz, 1, 1);
+                i += nalSz;
+            }
+        } else if(nalType == 28 && paySz > 2){
+            //FU-A: [indicator] [S E R type] [fragment]
+            const unsigned char fuHdr = pay[1];
+            if(fuHdr & 0x80){
+                const unsigned char nalHdr = ((pay[0] & 0xE0) | (fuHdr & 0x1F));
+                if(ctx->net.rtp.isFuActive && ctx->frames.filling != NULL){
+                    //previous fragmented NAL never ended
+                    StreamContext_cnsmBuffNALChunk_(ctx, plyr, 1 /*flushOldersIfIsIndependent*/, NULL, 0, 1 /*isEndOfNAL*/);
+                    ctx->frames.filling->accessUnit.isInvalid = 1;
                 }
-                //flag framebuffers-grps where this frame will be used
-                {
-                    int i; for(i = 0; i < plyr->fbs.grps.use; i++){
-                        STFramebuffsGrp* grp = &plyr->fbs.grps.arr[i];
-                        if(grp->pixFmt == ctx->drawPlan.lastPixelformat){
-                            if(0 == FramebuffsGrp_layoutFindStreamId(grp, ctx->streamId)){
-                                //flag as dirty
-                                grp->isSynced = 0;
-                            }
-                        }
-                    }
+                StreamContext_rtpNal_(ctx, plyr, &nalHdr, 1, 1, 0);
+                ctx->net.rtp.isFuActive = 1;
+            }
+            if(ctx->net.rtp.isFuActive){
+                const int isEnd = ((fuHdr & 0x40) ? 1 : 0);
+                StreamContext_rtpNal_(ctx, plyr, &pay[2], (paySz - 2), 0, isEnd);
+                if(isEnd){
+                    ctx->net.rtp.isFuActive = 0;
                 }
-                //enqueue buffers
-                while(ctx->dec.dst.enqueuedCount < ctx->dec.dst.enqueuedRequiredMin){
-                    STBuffer* buffFnd = NULL;
-                    //find another available buffer to queue, to avoid cloning current buffer.
-                    if(0 != Buffers_getUnqueued(&ctx->dec.dst, &buffFnd, buff)){
-                        buffFnd = NULL;
-                    } else {
-                        //(other) available buffer found
-                        //sync record (empty)
-                        {
-                            //others
-                            int i; for(i = 0; i < buffFnd->planesSz; i++){
-                                STPlane* p = &buffFnd->planes[i];
-                                p->used = 0;
-                            }
-                        }
-                        if(0 != Buffers_enqueue(&ctx->dec.dst, ctx->dec.fd, buffFnd, NULL)){
-                            K_LOG_ERROR("StreamContext, dst-buff could not be queued.\n");
-                            buffFnd = NULL;
+            }
+        }
+        //others (STAP-B, MTAP, FU-B) are not expected in non-interleaved mode
+    }
+}
+
+//Consumes 'buff[buffCsmd, buffUse)': responses, sdp and interleaved RTP frames.
+int StreamContext_cnsmRtspRcvd_(STStreamContext* ctx, struct STPlayer_* plyr){ //-1 = close connection
+    int r = 0;
+    while(r == 0 && ctx->buff.buffCsmd < ctx->buff.buffUse){
+        const unsigned char c = ctx->buff.buff[ctx->buff.buffCsmd];
+        if(ctx->net.rtsp.state == ENRtspState_Playing && (ctx->net.rtsp.itl.state != ENRtspItlState_Magic || (c == '$' && !ctx->net.resp.headerEnded && ctx->net.resp.line.use == 0 && ctx->net.resp.line.count == 0))){
+            //interleaved frame
+            switch(ctx->net.rtsp.itl.state){
+                case ENRtspItlState_Magic: ctx->net.rtsp.itl.state = ENRtspItlState_Channel; ctx->buff.buffCsmd++; break;
+                case ENRtspItlState_Channel: ctx->net.rtsp.itl.channel = c; ctx->net.rtsp.itl.state = ENRtspItlState_Len0; ctx->buff.buffCsmd++; break;
+                case ENRtspItlState_Len0: ctx->net.rtsp.itl.len = (c << 8); ctx->net.rtsp.itl.state = ENRtspItlState_Len1; ctx->buff.buffCsmd++; break;
+                case ENRtspItlState_Len1:
+                    ctx->net.rtsp.itl.len |= c;
+                    ctx->net.rtsp.itl.use = 0;
+                    ctx->net.rtsp.itl.state = (ctx->net.rtsp.itl.len > 0 ? ENRtspItlState_Payload : ENRtspItlState_Magic);
+                    ctx->buff.buffCsmd++;
+                    break;
+                default:
+                    {
+                        const int avail = (ctx->buff.buffUse - ctx->buff.buffCsmd);
+                        const int remain = (ctx->net.rtsp.itl.len - ctx->net.rtsp.itl.use);
+                        const int toCsm = (avail < remain ? avail : remain);
+                        if(ctx->net.rtsp.itl.channel != 0){
+                            //RTCP or other tracks (ignored)
+                            ctx->net.rtsp.itl.use += toCsm;
+                        } else if(ctx->net.rtsp.itl.use == 0 && toCsm == remain){
+                            //complete frame in buffer (no copy)
+                            StreamContext_rtpPacket_(ctx, plyr, &ctx->buff.buff[ctx->buff.buffCsmd], ctx->net.rtsp.itl.len);
+                            ctx->net.rtsp.itl.use += toCsm;
                         } else {
-                            //
-                        }
-                    }
-                    //add current bufer if necesary
-                    if(buffFnd == NULL && buff != NULL){
-                        //keep last as a clone
-                        //ToDo: clone or not clone (memory consume)
-                        /*if(0 != Buffers_keepLastAsClone(&ctx->dec.dst, buff)){
-                            K_LOG_ERROR("StreamContext, frame(#%d) could not be cloned to 'last'.\n", (frameSeqIdx + 1));
-                        }*/
-                        buffFnd = buff; buff = NULL;
-                        //sync record (empty)
-                        {
-                            //others
-                            int i; for(i = 0; i < buffFnd->planesSz; i++){
-                                STPlane* p = &buffFnd->planes[i];
-                                p->used = 0;
+                            //frame split between reads
+                            if(ctx->net.rtsp.itl.buff == NULL){
+                                ctx->net.rtsp.itl.buff = (unsigned char*)malloc(0xFFFF);
+                            }
+                            if(ctx->net.rtsp.itl.buff == NULL){
+                                r = -1;
+                                break;
+                            }
+                            memcpy(&ctx->net.rtsp.itl.buff[ctx->net.rtsp.itl.use], &ctx->buff.buff[ctx->buff.buffCsmd], toCsm);
+                            ctx->net.rtsp.itl.use += toCsm;
+                            if(ctx->net.rtsp.itl.use == ctx->net.rtsp.itl.len){
+                                StreamContext_rtpPacket_(ctx, plyr, ctx->net.rtsp.itl.buff, ctx->net.rtsp.itl.len);
                             }
                         }
-                        if(0 != Buffers_enqueue(&ctx->dec.dst, ctx->dec.fd, buffFnd, NULL)){
-                            K_LOG_ERROR("StreamContext, dst-buff could not be queued.\n");
-                            buffFnd = NULL;
-                        } else {
-                            //
+                        ctx->buff.buffCsmd += toCsm;
+                        if(ctx->net.rtsp.itl.use == ctx->net.rtsp.itl.len){
+                            ctx->net.rtsp.itl.state = ENRtspItlState_Magic;
                         }
                     }
-                    //stop if no activity
-                    if(buffFnd == NULL){
-                        break;
+                    break;
+            }
+        } else if(!ctx->net.resp.headerEnded){
+            //response header
+            if(0 != StreamContext_cnsmRespHttpHeader_(ctx)){
+                r = -1;
+            } else if(ctx->net.resp.headerEnded){
+                ctx->net.rtsp.bodyRemain = (ctx->net.resp.contentLength > 0 ? ctx->net.resp.contentLength : 0);
+                ctx->net.resp.line.use = 0;
+                if(ctx->net.rtsp.bodyRemain == 0){
+                    r = StreamContext_rtspRespCompleted_(ctx, plyr);
+                }
+            }
+        } else {
+            //response body (sdp lines are parsed)
+            if(ctx->net.rtsp.state == ENRtspState_Describe){
+                if(c == '\n'){
+                    if(ctx->net.resp.line.use > 0 && ctx->net.resp.line.str[ctx->net.resp.line.use - 1] == '\r'){
+                        ctx->net.resp.line.use--;
                     }
+                    ctx->net.resp.line.str[ctx->net.resp.line.use] = '\0';
+                    StreamContext_rtspSdpLine_(ctx, ctx->net.resp.line.str);
+                    ctx->net.resp.line.use = 0;
+                } else if((ctx->net.resp.line.use + 1) < K_HTTP_LINE_MAX){
+                    ctx->net.resp.line.str[ctx->net.resp.line.use++] = (char)c;
                 }
-                VideoFrameState_release(&frameState);
+            }
+            ctx->buff.buffCsmd++;
+            if(--ctx->net.rtsp.bodyRemain <= 0){
+                r = StreamContext_rtspRespCompleted_(ctx, plyr);
             }
         }
     }
+    return r;
 }
 
-int StreamContext_shutdownStartByFileClosed_(STStreamContext* ctx, struct STPlayer_* plyr, const char* reason){
-    int r = 0;
-    //shutdown permanently (file will not be opened again)
-    const int isPermanent = 1;
-    if(ctx->shuttingDown.isActive){
-        ctx->shuttingDown.isPermanent = isPermanent;
-        //K_LOG_INFO("StreamContext, shutdownStartByFileClosed_ current shutdown flagged (at '%s').\n", reason);
+//rtp (udp)
+
+//Releases the waiting packets in sequence order; a missing packet is skipped after
+//the next waiting one is 'rtpJitterMs' old (or inmediatly if 'isFlush').
+void StreamContext_rtpJitterDrain_(STStreamContext* ctx, struct STPlayer_* plyr, struct timeval* now, const int isFlush){
+    while(ctx->net.rtp.jitter.use > 0){
+        STRtpPkt* pkt = &ctx->net.rtp.jitter.slots[ctx->net.rtp.jitter.seqNext % K_RTP_JITTER_SLOTS];
+        if(pkt->isUsed && pkt->seq == ctx->net.rtp.jitter.seqNext){
+            //in order
+            StreamContext_rtpPacket_(ctx, plyr, pkt->data, pkt->sz);
+            pkt->isUsed = 0;
+            ctx->net.rtp.jitter.use--;
+            ctx->net.rtp.jitter.seqNext++;
+        } else {
+            //gap, find next waiting packet
+            STRtpPkt* nxt = NULL; unsigned short dist = 1;
+            for(; dist < K_RTP_JITTER_SLOTS; dist++){
+                STRtpPkt* p2 = &ctx->net.rtp.jitter.slots[(unsigned short)(ctx->net.rtp.jitter.seqNext + dist) % K_RTP_JITTER_SLOTS];
+                if(p2->isUsed && p2->seq == (unsigned short)(ctx->net.rtp.jitter.seqNext + dist)){
+                    nxt = p2;
+                    break;
+                }
+            }
+            if(nxt == NULL){
+                //program logic error, 'use' is not consistent
+                memset(ctx->net.rtp.jitter.slots, 0, sizeof(STRtpPkt) * K_RTP_JITTER_SLOTS);
+                ctx->net.rtp.jitter.use = 0;
+                break;
+            } else if(!isFlush && msBetweenTimevals(&nxt->arrival, now) < plyr->cfg.rtpJitterMs){
+                //keep waiting
+                break;
+            } else {
+                //skip missing (depacketizer will detect the gap)
+                ctx->net.rtp.stats.curSec.lost += dist;
+                ctx->net.rtp.jitter.seqNext = nxt->seq;
+            }
+        }
+    }
+}
+
+void StreamContext_rtpJitterPush_(STStreamContext* ctx, struct STPlayer_* plyr, const unsigned char* data, const int dataSz, struct timeval* now){
+    if(dataSz >= 12 && dataSz < K_RTP_PKT_MAX){ //bigger were truncated
+        const unsigned short seq = (unsigned short)((data[2] << 8) | data[3]);
+        const unsigned int ssrc = ((unsigned int)data[8] << 24) | ((unsigned int)data[9] << 16) | ((unsigned int)data[10] << 8) | (unsigned int)data[11];
+        short dist = 0;
+        if(!ctx->net.rtp.jitter.isSeqSet){
+            ctx->net.rtp.jitter.seqNext = seq;
+            ctx->net.rtp.jitter.ssrc = ssrc;
+            ctx->net.rtp.jitter.isSeqSet = 1;
+        }
+        dist = (short)(seq - ctx->net.rtp.jitter.seqNext);
+        if(dist >= K_RTP_JITTER_SLOTS){
+            //too far ahead (long loss or source restarted), release waiting ones
+            StreamContext_rtpJitterDrain_(ctx, plyr, now, 1);
+            ctx->net.rtp.stats.curSec.lost += (unsigned short)(seq - ctx->net.rtp.jitter.seqNext);
+            ctx->net.rtp.jitter.seqNext = seq;
+            dist = 0;
+        }
+        if(dist < -K_RTP_JITTER_SLOTS || ssrc != ctx->net.rtp.jitter.ssrc){
+            //too far behind or new source (camera/encoder restarted with a new initial seq), release waiting ones and resync
+            K_LOG_INFO("StreamContext, rtp, resync (seq %u, %u expected, ssrc %u, %u expected): '%s'.\n", seq, ctx->net.rtp.jitter.seqNext, ssrc, ctx->net.rtp.jitter.ssrc, ctx->cfg.path);
+            StreamContext_rtpJitterDrain_(ctx, plyr, now, 1);
+            ctx->net.rtp.jitter.seqNext = seq;
+            ctx->net.rtp.jitter.ssrc = ssrc;
+            dist = 0;
+            //the depacketizer restarts its sequence, the partial frame is discarded
+            if(ctx->net.rtp.isFuActive){
+                ctx->net.rtp.isFuActive = 0;
+                if(ctx->frames.filling != NULL){
+                    StreamContext_cnsmBuffNALChunk_(ctx, plyr, 1 /*flushOldersIfIsIndependent*/, NULL, 0, 1 /*isEndOfNAL*/);
+                }
+            }
+            if(ctx->frames.filling != NULL){
+                ctx->frames.filling->accessUnit.isInvalid = 1;
+            }
+            ctx->net.rtp.isSeqSet = 0;
+            ctx->dec.isWaitingForIDRFrame = 1;
+        }
+        ctx->net.rtp.stats.curSec.pkts++;
+        if(dist < 0){
+            //already released or skipped
+            ctx->net.rtp.stats.curSec.late++;
+        } else if(dist == 0 && ctx->net.rtp.jitter.use == 0){
+            //in order, nothing waiting (no copy)
+            StreamContext_rtpPacket_(ctx, plyr, data, dataSz);
+            ctx->net.rtp.jitter.seqNext++;
+        } else {
+            STRtpPkt* pkt = &ctx->net.rtp.jitter.slots[seq % K_RTP_JITTER_SLOTS];
+            if(pkt->isUsed){
+                //duplicated
+                ctx->net.rtp.stats.curSec.late++;
+            } else {
+                memcpy(pkt->data, data, dataSz);
+                pkt->sz         = dataSz;
+                pkt->seq        = seq;
+                pkt->arrival    = *now;
+                pkt->isUsed     = 1;
+                ctx->net.rtp.jitter.use++;
+                if(dist == 0){
+                    ctx->net.rtp.stats.curSec.reordered++;
+                }
+                StreamContext_rtpJitterDrain_(ctx, plyr, now, 0);
+            }
+        }
+    }
+}
+
+//Reads datagrams in batches untill no more data is available or the per-wakeup budget is consumed.
+void StreamContext_netUdpRead_(STStreamContext* ctx, struct STPlayer_* plyr){
+    int rcvd = 0, bytesTotal = 0;
+    const int bytesBudget = (plyr->cfg.netReadBudgetKB > 0 ? plyr->cfg.netReadBudgetKB * 1024 : 0);
+    const unsigned long framesBudget = (plyr->cfg.netReadBudgetFrames > 0 ? plyr->cfg.netReadBudgetFrames : 0);
+    const unsigned long lastNALPushedSeq = ctx->frames.filled.iSeqPushNext; //to detect completed nals parsed
+    do {
+        rcvd = recvmmsg(ctx->net.socket, ctx->net.rtp.batch.msgs, K_RTP_UDP_BATCH, MSG_DONTWAIT, NULL);
+        ctx->net.tune.stats.curSec.recvs++;
+        if(rcvd > 0){
+            struct timeval now;
+            gettimeofday(&now, NULL);
+            if(ctx->net.bytesRcvd == 0){
+                ctx->net.msToRespStart = ctx->net.msSinceStart;
+            }
+            ctx->net.rtp.stats.curSec.batches++;
+            {
+                int i; for(i = 0; i < rcvd; i++){
+                    const int sz = (int)ctx->net.rtp.batch.msgs[i].msg_len;
+                    StreamContext_rtpJitterPush_(ctx, plyr, &ctx->net.rtp.batch.buff[i * K_RTP_PKT_MAX], sz, &now);
+                    ctx->net.bytesRcvd += sz;
+                    bytesTotal += sz;
+                }
+            }
+            ctx->net.msWithoutRecv = 0;
+        } else if(rcvd < 0 && !(errno == EAGAIN || errno == EWOULDBLOCK)){
+            K_LOG_ERROR("StreamContext, recvmmsg failed at '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
+            Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
+            close(ctx->net.socket);
+            ctx->net.socket = 0;
+            StreamContext_netScheduleReconnect_(ctx, plyr);
+        }
+    } while(
+            rcvd == K_RTP_UDP_BATCH && ctx->net.socket > 0 //a short batch means the kernel queue was emptied
+            && (bytesBudget <= 0 || bytesTotal < bytesBudget)
+            && (framesBudget <= 0 || (ctx->frames.filled.iSeqPushNext - lastNALPushedSeq) < framesBudget)
+            );
+}
+
+//shm (local producer's ring)
+
+void StreamContext_shmConnect_(STStreamContext* ctx, struct STPlayer_* plyr){
+    SOCKET sckt = 0;
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    //previous ring (frames referencing it are discarded)
+    StreamContext_shmUnmap_(ctx);
+    //connect
+    if(strlen(ctx->cfg.server) >= sizeof(addr.sun_path)){
+        K_LOG_ERROR("StreamContext_shmConnect_, socket path too long: '%s'.\n", ctx->cfg.server);
+    } else if((sckt = socket(AF_UNIX, SOCK_STREAM, 0)) < 0){
+        K_LOG_ERROR("StreamContext_shmConnect_, socket creation failed: '%s'.\n", ctx->cfg.path);
+        sckt = 0;
     } else {
-        if(0 != StreamContext_shutdownStart(ctx, plyr, isPermanent)){
-            K_LOG_ERROR("StreamContext, shutdownStartByFileClosed_ failed (at '%s').\n", reason);
+        const int flags = fcntl(sckt, F_GETFL, 0);
+        strncpy(addr.sun_path, ctx->cfg.server, sizeof(addr.sun_path) - 1);
+        if(flags == -1 || fcntl(sckt, F_SETFL, flags | O_NONBLOCK) == -1){
+            K_LOG_ERROR("StreamContext_shmConnect_, O_NONBLOCK option failed: '%s'.\n", ctx->cfg.path);
+            close(sckt);
+            sckt = 0;
+        } else if(connect(sckt, (struct sockaddr*)&addr, sizeof(addr)) != 0 && errno != EINPROGRESS){
+            K_LOG_ERROR("StreamContext_shmConnect_, connect failed to '%s': '%s'.\n", ctx->cfg.server, ctx->cfg.path);
+            close(sckt);
+            sckt = 0;
+        }
+    }
+    //request stream (ring is received as response)
+    if(sckt){
+        StreamContext_netAttachSocket_(ctx, plyr, sckt, 0);
+    }
+}
+
+void StreamContext_shmUnmap_(STStreamContext* ctx){
+    if(ctx->shm.map != NULL){
+        //frames referencing the ring
+        STVideoFrame* frame = NULL;
+        while(0 == VideoFrames_pullFrameForRead(&ctx->frames.filled, &frame)){
+            if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
+                K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
+                VideoFrame_release(frame);
+                free(frame);
+            }
+            frame = NULL;
+        }
+        munmap(ctx->shm.map, ctx->shm.mapSz);
+        ctx->shm.map = NULL;
+    }
+    ctx->shm.mapSz = 0;
+    ctx->shm.hdr = NULL;
+    ctx->shm.readPos = 0;
+}
+
+void StreamContext_shmRelease_(STStreamContext* ctx){
+    if(ctx->shm.hdr != NULL){
+        //the oldest queued frame is the first record still referenced
+        uint64_t tail = ctx->shm.readPos;
+        int i; for(i = 0; i < ctx->frames.filled.use; i++){
+            const STVideoFrame* f = VideoFrames_peek(&ctx->frames.filled, i);
+            if(f->buff.extPtr != NULL){
+                tail = f->buff.extPos;
+                break;
+            }
+        }
+        if(tail != __atomic_load_n(&ctx->shm.hdr->tail, __ATOMIC_RELAXED)){
+            __atomic_store_n(&ctx->shm.hdr->tail, tail, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+//Queues the published records as frames referencing the ring (no copy).
+int StreamContext_shmQueue_(STStreamContext* ctx, struct STPlayer_* plyr){ //-1 = malformed ring
+    int r = 0, filledAdded = 0;
+    const int filledWasEmpty = (VideoFrames_getFramesForReadCount(&ctx->frames.filled) <= 0 ? 1 : 0);
+    const uint64_t head = __atomic_load_n(&ctx->shm.hdr->head, __ATOMIC_ACQUIRE);
+    const uint64_t dataSz = ctx->shm.hdr->dataSz;
+    while(r == 0 && ctx->shm.readPos < head){
+        const uint64_t off = (ctx->shm.readPos & (dataSz - 1));
+        const STShmRecHdr* rec = (const STShmRecHdr*)&ctx->shm.map[K_SHM_RING_HDR_SZ + off];
+        uint64_t recSz = 0;
+        if(rec->sz == K_SHM_REC_PAD){
+            ctx->shm.readPos += (dataSz - off);
+            continue;
+        }
+        recSz = ((sizeof(STShmRecHdr) + (uint64_t)rec->sz + 15) & ~(uint64_t)15);
+        if((off + recSz) > dataSz || (ctx->shm.readPos + recSz) > head){
+            K_LOG_ERROR("StreamContext, shm, malformed record (%u bytes at %llu): '%s'.\n", rec->sz, (unsigned long long)ctx->shm.readPos, ctx->cfg.path);
+            r = -1;
+            break;
+        }
+        if(rec->flags & K_SHM_REC_FLAG_DISCONTINUITY){
+            ctx->dec.isWaitingForIDRFrame = 1;
+        }
+        if((rec->nalTypes & ((1 << 1) | (1 << 5))) == 0){
+            //no VCL (like 'zero-VCL frame' at NALs parsing)
+            plyr->stats.curSec.src.frames.ignored++;
         } else {
-            //K_LOG_INFO("StreamContext, shutdownStartByFileClosed_ shutdown started (at '%s').\n", reason);
+            STVideoFrame* frame = NULL;
+            if(0 != VideoFrames_pullFrameForFill(&ctx->frames.reusable, &frame)){
+                K_LOG_INFO("StreamContext, VideoFrames_pullFrameForFill failed.\n");
+            } else {
+                int t;
+                gettimeofday(&frame->state.times.arrival.start, NULL);
+                frame->state.times.arrival.end = frame->state.times.proc.start = frame->state.times.proc.end = frame->state.times.arrival.start;
+                for(t = 0; t < 32; t++){
+                    frame->accessUnit.nalsCountPerType[t] = ((rec->nalTypes >> t) & 0x1);
+                }
+                frame->state.isIndependent = frame->accessUnit.nalsCountPerType[5]; //IDR-Picture
+                frame->buff.extPtr = (const unsigned char*)(rec + 1);
+                frame->buff.extPos = ctx->shm.readPos;
+                frame->buff.use    = (int)rec->sz;
+                //flush queue (if independent frame arrived)
+                if(frame->state.isIndependent){
+                    STVideoFrame* f2 = NULL;
+                    while(0 == VideoFrames_pullFrameForRead(&ctx->frames.filled, &f2)){
+                        if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, f2)){
+                            K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
+                            VideoFrame_release(f2);
+                            free(f2);
+                        }
+                        f2 = NULL;
+                    }
+                }
+                //add
+                if(!StreamContext_gopCacheAccepts_(ctx, plyr, frame)){
+                    if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
+                        VideoFrame_release(frame);
+                        free(frame);
+                    }
+                } else if(0 != VideoFrames_pushFrameOwning(&ctx->frames.filled, frame)){
+                    K_LOG_ERROR("VideoFrames_pushFrameOwning failed.\n");
+                    VideoFrame_release(frame);
+                    free(frame);
+                } else {
+                    plyr->stats.curSec.src.frames.queued++;
+                    if(frame->state.isIndependent){
+                        plyr->stats.curSec.src.frames.queuedIDR++;
+                    }
+                    StreamContext_cnsmBuffNALCompleted_(ctx, plyr);
+                    filledAdded = 1;
+                }
+                frame = NULL;
+            }
         }
+        ctx->shm.readPos += recSz;
     }
-    //close file
-    if(ctx->file.fd > 0){
-        Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcFile, ctx, ctx->file.fd);
-        close(ctx->file.fd);
-        ctx->file.fd = -1;
+    //latency (decoder backlogged or closed)
+    if(filledAdded){
+        StreamContext_framesTrimToLatency_(ctx, plyr);
+    }
+    //records before the oldest queued frame are not needed anymore
+    StreamContext_shmRelease_(ctx);
+    //notify
+    if(filledAdded){
+        StreamContext_frameFilledNotify_(ctx, plyr, filledWasEmpty);
     }
-    ctx->file.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
     return r;
 }
 
-void StreamContext_pollCallbackFile_(STStreamContext* ctx, struct STPlayer_* plyr, int revents){
-    //error
-    if((revents & (POLLERR))){
-        const char* reason = "file poll-err";
-        if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
-            K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
+//Receives the ring (first message, memfd as SCM_RIGHTS) or the doorbells (one byte per published record).
+void StreamContext_shmRead_(STStreamContext* ctx, struct STPlayer_* plyr){
+    int closeConnn = 0;
+    if(ctx->shm.hdr == NULL){
+        char pay[4]; //'NBSR', exact size to not consume doorbells
+        char ctrl[CMSG_SPACE(sizeof(int))];
+        struct iovec iov;
+        struct msghdr msg;
+        ssize_t rcvd = 0;
+        iov.iov_base = pay;
+        iov.iov_len = sizeof(pay);
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = ctrl;
+        msg.msg_controllen = sizeof(ctrl);
+        rcvd = recvmsg(ctx->net.socket, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+        if(rcvd == 0 || (rcvd < 0 && !(errno == EAGAIN || errno == EWOULDBLOCK))){
+            K_LOG_ERROR("StreamContext, shm, producer closed before sending the ring '%s': '%s'.\n", ctx->cfg.server, ctx->cfg.path);
+            closeConnn = 1;
+        } else if(rcvd > 0){
+            int fd = -1;
+            struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            if(cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS){
+                memcpy(&fd, CMSG_DATA(cmsg), sizeof(fd));
+            }
+            ctx->net.bytesRcvd += rcvd;
+            ctx->net.msWithoutRecv = 0;
+            if(fd < 0 || rcvd != sizeof(pay) || memcmp(pay, "NBSR", sizeof(pay)) != 0){
+                K_LOG_ERROR("StreamContext, shm, unexpected response (no ring) from '%s': '%s'.\n", ctx->cfg.server, ctx->cfg.path);
+                closeConnn = 1;
+            } else {
+                struct stat st;
+                unsigned char* map = MAP_FAILED;
+                if(fstat(fd, &st) != 0 || st.st_size < (K_SHM_RING_HDR_SZ + 16)){
+                    K_LOG_ERROR("StreamContext, shm, ring fstat failed or too small: '%s'.\n", ctx->cfg.path);
+                } else if((map = (unsigned char*)mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED){
+                    K_LOG_ERROR("StreamContext, shm, ring mmap failed: '%s'.\n", ctx->cfg.path);
+                } else {
+                    STShmRingHdr* hdr = (STShmRingHdr*)map;
+                    if(hdr->magic != K_SHM_RING_MAGIC || hdr->version != K_SHM_RING_VERSION || hdr->dataSz < 16 || (hdr->dataSz & (hdr->dataSz - 1)) != 0 || (K_SHM_RING_HDR_SZ + (unsigned long)hdr->dataSz) > (unsigned long)st.st_size){
+                        K_LOG_ERROR("StreamContext, shm, ring header not valid: '%s'.\n", ctx->cfg.path);
+                        munmap(map, st.st_size);
+                    } else {
+                        K_LOG_VERBOSE("StreamContext, shm, ring received (%u KBs): '%s'.\n", (hdr->dataSz / 1024), ctx->cfg.path);
+                        ctx->shm.map = map;
+                        ctx->shm.mapSz = st.st_size;
+                        ctx->shm.hdr = hdr;
+                        ctx->shm.readPos = __atomic_load_n(&hdr->tail, __ATOMIC_ACQUIRE);
+                    }
+                }
+                close(fd); //mapping remains
+                if(ctx->shm.hdr == NULL){
+                    closeConnn = 1;
+                }
+            }
         }
     } else {
-        if((revents & POLLIN)){
-            int rcvd = 1;
-            unsigned long lastNALPushedSeq = ctx->frames.filled.iSeqPushNext; //to detect completed nals parsed
-            const unsigned long curScreenRefreshSeq = plyr->anim.tickSeq;
-            //read untill no data is returned or explicit-stop-reading
-            while(
-                  !ctx->flushing.isActive //not flushing
-                  && lastNALPushedSeq == ctx->frames.filled.iSeqPushNext //rading same NAL
-                  && rcvd > 0 //data read
-                  )
-            {
-                rcvd = 0;
-                //empty buffer if fully consumed (lock is not necesary)
-                if(ctx->buff.buffCsmd >= ctx->buff.buffUse){
-                    ctx->buff.buffCsmd = 0;
-                    ctx->buff.buffUse = 0;
+        //doorbells (content ignored, the ring's head is read instead)
+        unsigned char tmp[256];
+        ssize_t rcvd = 0;
+        do {
+            rcvd = recv(ctx->net.socket, tmp, sizeof(tmp), MSG_DONTWAIT);
+            if(rcvd > 0){
+                ctx->net.bytesRcvd += rcvd;
+                ctx->net.msWithoutRecv = 0;
+            }
+        } while(rcvd == sizeof(tmp));
+        if(rcvd == 0 || (rcvd < 0 && !(errno == EAGAIN || errno == EWOULDBLOCK))){
+            K_LOG_WARN("StreamContext, shm, producer closed '%s': '%s'.\n", ctx->cfg.server, ctx->cfg.path);
+            closeConnn = 1;
+        }
+    }
+    //queue published records (also the ones published before closing)
+    if(ctx->shm.hdr != NULL && 0 != StreamContext_shmQueue_(ctx, plyr)){
+        closeConnn = 1;
+    }
+    //close (reconnect after wait, mapping is kept while frames reference it)
+    if(closeConnn && ctx->net.socket > 0){
+        Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
+        close(ctx->net.socket);
+        ctx->net.socket = 0;
+        StreamContext_netScheduleReconnect_(ctx, plyr);
+    }
+}
+
+//multipart (parts are JPEGs, MJPEG streams)
+
+//Adds payload to the current part; a part received completely in a single read is referenced in place (no copy).
+void StreamContext_partPayload_(STStreamContext* ctx, const unsigned char* data, const int dataSz, const int isPartEnd){
+    STVideoFrame* frame = ctx->frames.filling;
+    if(frame != NULL && dataSz > 0){
+        if(isPartEnd && frame->buff.use == 0){
+            frame->buff.extPtr = data;
+            frame->buff.use = dataSz;
+        } else if((frame->buff.use + dataSz) > K_HTTP_PART_MAX || 0 != VideoFrame_copy(frame, data, dataSz)){
+            K_LOG_ERROR("StreamContext, multipart, part dropped (%d bytes): '%s'.\n", (frame->buff.use + dataSz), ctx->cfg.path);
+            if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
+                VideoFrame_release(frame);
+                free(frame);
+            }
+            ctx->frames.filling = NULL;
+        }
+    }
+}
+
+//Queues the current part as an independent frame (older queued frames are not needed anymore).
+void StreamContext_partCompleted_(STStreamContext* ctx, struct STPlayer_* plyr, int* dstFilledAdded){
+    STVideoFrame* frame = ctx->frames.filling;
+    ctx->frames.filling = NULL;
+    if(frame != NULL){
+        const unsigned char* pay = (frame->buff.extPtr != NULL ? frame->buff.extPtr : frame->buff.ptr);
+        if(frame->buff.use < 4 || pay[0] != 0xFF || pay[1] != 0xD8){
+            //SOI marker is required
+            K_LOG_VERBOSE("StreamContext, multipart, part ignored (not a JPEG, %d bytes): '%s'.\n", frame->buff.use, ctx->cfg.path);
+            plyr->stats.curSec.src.frames.ignored++;
+        } else {
+            STVideoFrame* f2 = NULL;
+            gettimeofday(&frame->state.times.arrival.end, NULL);
+            frame->state.isIndependent = 1;
+            //flush queue
+            while(0 == VideoFrames_pullFrameForRead(&ctx->frames.filled, &f2)){
+                if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, f2)){
+                    K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
+                    VideoFrame_release(f2);
+                    free(f2);
                 }
-                //produce
-                if(ctx->buff.buffUse < ctx->buff.buffSz){
-                    //produce (unlocked)
-                    rcvd = (int)read(ctx->file.fd, &ctx->buff.buff[ctx->buff.buffUse], (ctx->buff.buffSz - ctx->buff.buffUse));
-                    if(rcvd > 0){
-                        K_LOG_VERBOSE("File, %d/%d read.\n", rcvd, (ctx->buff.buffSz - ctx->buff.buffUse));
-                        ctx->buff.buffUse += rcvd;
-                        //read body (NALs)
-                        StreamContext_cnsmBuffNAL_(ctx, plyr, 0 /*flushOldersIfIsIndependent*/);
-                        //mark as fully consumed
-                        ctx->file.msWithoutRead = 0;
-                        ctx->buff.buffCsmd = ctx->buff.buffUse;
-                        //new frame arrived, wait for screen refresh
-                        if(lastNALPushedSeq != ctx->frames.filled.iSeqPushNext){
-                            //wait untill screen refresh
-                            ctx->buff.screenRefreshSeqBlocking = curScreenRefreshSeq;
-                            if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_SrcFile, ctx, ctx->file.fd, 0, NULL)){ //nothing
-                                const char* reason = "poll-update-failed";
-                                if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
-                                    K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
-                                }
-                            }
-                        }
-                    } else if(rcvd != 0){ //zero = socket propperly shuteddown
-                        if(errno == EAGAIN || errno == EWOULDBLOCK){
-                            //non-blocking
-                        } else {
-                            const char* reason = "file-read-failed";
-                            if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
-                                K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
+                f2 = NULL;
+            }
+            //add
+            if(0 != VideoFrames_pushFrameOwning(&ctx->frames.filled, frame)){
+                K_LOG_ERROR("VideoFrames_pushFrameOwning failed.\n");
+                VideoFrame_release(frame);
+                free(frame);
+            } else {
+                plyr->stats.curSec.src.frames.queued++;
+                plyr->stats.curSec.src.frames.queuedIDR++;
+                StreamContext_cnsmBuffNALCompleted_(ctx, plyr);
+                *dstFilledAdded = 1;
+            }
+            frame = NULL;
+        }
+        //reuse
+        if(frame != NULL){
+            if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
+                VideoFrame_release(frame);
+                free(frame);
+            }
+            frame = NULL;
+        }
+    }
+}
+
+//Parses 'buff[buffCsmd, buffUse)' as a multipart body: delimiters, part headers and payloads.
+//Frames still referencing the read after notifying the decoder are copied before returning.
+int StreamContext_cnsmMultipart_(STStreamContext* ctx, struct STPlayer_* plyr){ //-1 = malformed, 1 = close-delimiter found
+    int r = 0, filledAdded = 0;
+    const int filledWasEmpty = (VideoFrames_getFramesForReadCount(&ctx->frames.filled) <= 0 ? 1 : 0);
+    const unsigned char* data = &ctx->buff.buff[ctx->buff.buffCsmd];
+    const int dataSz = (ctx->buff.buffUse - ctx->buff.buffCsmd);
+    const char* delim = ctx->net.resp.part.delim;
+    const int delimLen = ctx->net.resp.part.delimLen;
+    int i = 0;
+    while(r == 0 && i < dataSz){
+        if(ctx->net.resp.part.state == ENHttpPartState_Boundary){
+            //skip until the delimiter
+            int m = ctx->net.resp.part.delimMatched;
+            while(i < dataSz && m < delimLen){
+                if(m == 0){
+                    const unsigned char* d0 = (const unsigned char*)memchr(&data[i], delim[0], (dataSz - i));
+                    if(d0 == NULL){
+                        i = dataSz;
+                        break;
+                    }
+                    i = (int)(d0 - data);
+                }
+                if(data[i] == (unsigned char)delim[m]){
+                    m++;
+                    i++;
+                } else if(m > 0){
+                    m = 0; //this byte could start the delimiter
+                } else {
+                    i++;
+                }
+            }
+            if(m == delimLen){
+                m = 0;
+                ctx->net.resp.part.state = ENHttpPartState_Headers;
+                ctx->net.resp.part.linesCount = 0;
+                ctx->net.resp.part.contentLength = -1;
+                ctx->net.resp.part.isSkipped = 0;
+                ctx->net.resp.line.use = 0;
+            }
+            ctx->net.resp.part.delimMatched = m;
+        } else if(ctx->net.resp.part.state == ENHttpPartState_Headers){
+            const unsigned char c = data[i++];
+            if(c == '\n'){
+                //line completed (without '\r')
+                char* line = ctx->net.resp.line.str;
+                int lineLen = ctx->net.resp.line.use;
+                if(lineLen > 0 && line[lineLen - 1] == '\r'){
+                    lineLen--;
+                }
+                line[lineLen] = '\0';
+                ctx->net.resp.line.use = 0;
+                if(ctx->net.resp.part.linesCount++ == 0){
+                    //rest of the delimiter line, '--' after the boundary is the close-delimiter
+                    if(lineLen >= 2 && line[0] == '-' && line[1] == '-'){
+                        r = 1;
+                    }
+                } else if(lineLen > 0){
+                    //header: 'Name: value'
+                    const char* colon = strchr(line, ':');
+                    if(colon != NULL){
+                        const int nameLen = (int)(colon - line);
+                        const char* val = colon + 1;
+                        while(*val == ' ' || *val == '\t') val++;
+                        if(nameLen == 14 && strncasecmp(line, "Content-Length", 14) == 0){
+                            ctx->net.resp.part.contentLength = atoi(val);
+                            if(ctx->net.resp.part.contentLength < 0 || ctx->net.resp.part.contentLength > K_HTTP_PART_MAX){
+                                K_LOG_ERROR("StreamContext, multipart, part content-length '%s' not valid: '%s'.\n", val, ctx->cfg.path);
+                                r = -1;
                             }
+                        } else if(nameLen == 12 && strncasecmp(line, "Content-Type", 12) == 0){
+                            if(strncasecmp(val, "image/", 6) != 0){
+                                K_LOG_VERBOSE("StreamContext, multipart, part content-type '%s' skipped: '%s'.\n", val, ctx->cfg.path);
+                                ctx->net.resp.part.isSkipped = 1;
+                            }
+                        }
+                    }
+                } else {
+                    //payload starts
+                    ctx->net.resp.part.state = ENHttpPartState_Body;
+                    ctx->net.resp.part.remain = ctx->net.resp.part.contentLength;
+                    ctx->net.resp.part.delimMatched = 0;
+                    if(!ctx->net.resp.part.isSkipped){
+                        if(ctx->frames.filling == NULL && 0 != VideoFrames_pullFrameForFill(&ctx->frames.reusable, &ctx->frames.filling)){
+                            K_LOG_INFO("StreamContext, VideoFrames_pullFrameForFill failed.\n");
+                            ctx->frames.filling = NULL;
+                        } else {
+                            STVideoFrame* frame = ctx->frames.filling;
+                            frame->buff.use = 0;
+                            frame->buff.extPtr = NULL;
+                            gettimeofday(&frame->state.times.arrival.start, NULL);
+                            frame->state.times.arrival.end = frame->state.times.proc.start = frame->state.times.proc.end = frame->state.times.arrival.start;
                         }
                     }
+                    //empty part
+                    if(ctx->net.resp.part.remain == 0){
+                        StreamContext_partCompleted_(ctx, plyr, &filledAdded);
+                        ctx->net.resp.part.state = ENHttpPartState_Boundary;
+                        ctx->net.resp.part.delimMatched = 2; //CRLF before the delimiter is optional after a sized part
+                    }
+                }
+            } else if((ctx->net.resp.line.use + 1) < K_HTTP_LINE_MAX){
+                //accumulate (longer lines are truncated)
+                ctx->net.resp.line.str[ctx->net.resp.line.use++] = (char)c;
+            }
+        } else if(ctx->net.resp.part.remain >= 0){
+            //sized payload
+            int spanSz = (dataSz - i);
+            if(spanSz > ctx->net.resp.part.remain){
+                spanSz = ctx->net.resp.part.remain;
+            }
+            ctx->net.resp.part.remain -= spanSz;
+            StreamContext_partPayload_(ctx, &data[i], spanSz, (ctx->net.resp.part.remain == 0 ? 1 : 0));
+            i += spanSz;
+            if(ctx->net.resp.part.remain == 0){
+                StreamContext_partCompleted_(ctx, plyr, &filledAdded);
+                ctx->net.resp.part.state = ENHttpPartState_Boundary;
+                ctx->net.resp.part.delimMatched = 2; //CRLF before the delimiter is optional after a sized part
+            }
+        } else {
+            //unsized payload, until the delimiter (a partial match at the end of the read is pending)
+            const int payStart = i;
+            int m = ctx->net.resp.part.delimMatched, mPrev = m, isFound = 0;
+            while(i < dataSz){
+                if(m == 0){
+                    const unsigned char* d0 = (const unsigned char*)memchr(&data[i], delim[0], (dataSz - i));
+                    if(d0 == NULL){
+                        i = dataSz;
+                        break;
+                    }
+                    i = (int)(d0 - data);
+                }
+                if(data[i] == (unsigned char)delim[m]){
+                    m++;
+                    i++;
+                    if(m == delimLen){
+                        isFound = 1;
+                        break;
+                    }
+                } else {
+                    //the previous read's pending bytes were payload
+                    if(mPrev > 0){
+                        StreamContext_partPayload_(ctx, (const unsigned char*)delim, mPrev, 0);
+                        mPrev = 0;
+                    }
+                    if(m > 0){
+                        m = 0; //this byte could start the delimiter
+                    } else {
+                        i++;
+                    }
+                }
+            }
+            if(isFound){
+                //payload ends before the delimiter (that could start at the previous read)
+                const int payEnd = (i - (delimLen - mPrev));
+                StreamContext_partPayload_(ctx, &data[payStart], (payEnd - payStart), 1);
+                StreamContext_partCompleted_(ctx, plyr, &filledAdded);
+                ctx->net.resp.part.state = ENHttpPartState_Headers;
+                ctx->net.resp.part.linesCount = 0;
+                ctx->net.resp.part.contentLength = -1;
+                ctx->net.resp.part.isSkipped = 0;
+                ctx->net.resp.line.use = 0;
+                m = 0;
+            } else {
+                //payload until the pending bytes
+                StreamContext_partPayload_(ctx, &data[payStart], (dataSz - (m - mPrev) - payStart), 0);
+            }
+            ctx->net.resp.part.delimMatched = m;
+        }
+    }
+    //notify
+    if(filledAdded){
+        StreamContext_frameFilledNotify_(ctx, plyr, filledWasEmpty);
+    }
+    //frames still referencing this read (not consumed yet) are copied before the buffer is reused
+    {
+        int i; for(i = 0; i < ctx->frames.filled.use; i++){
+            STVideoFrame* f = VideoFrames_peek(&ctx->frames.filled, i);
+            if(f->buff.extPtr != NULL){
+                const unsigned char* ext = f->buff.extPtr;
+                const int extSz = f->buff.use;
+                f->buff.extPtr = NULL;
+                f->buff.use = 0;
+                if(0 != VideoFrame_copy(f, ext, extSz)){
+                    K_LOG_ERROR("StreamContext, multipart, queued part could not be copied: '%s'.\n", ctx->cfg.path);
+                    f->accessUnit.isInvalid = 1;
                 }
             }
         }
     }
+    return r;
 }
 
-void StreamContext_pollCallbackSocket_(STStreamContext* ctx, struct STPlayer_* plyr, int revents){
-    //error
-    if((revents & (POLLERR))){
-        K_LOG_ERROR("StreamContext, poll-err-flag active at socket '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
+void StreamContext_cnsmNetRcvd_(STStreamContext* ctx, struct STPlayer_* plyr, const int rcvd){
+    const int bytesRcvdBefore = ctx->net.bytesRcvd;
+    int closeConnn = 0;
+    K_LOG_VERBOSE("Net, %d/%d revd.\n", rcvd, (ctx->buff.buffSz - ctx->buff.buffUse));
+    if(ctx->net.bytesRcvd == 0){
+        ctx->net.msToRespStart = ctx->net.msSinceStart;
+        if(ctx->net.msToRespStart > 1000){
+            K_LOG_INFO("StreamContext_tick, %u ms to start receiving response: '%s'.\n", ctx->net.msToRespStart, ctx->cfg.path);
+        } else {
+            K_LOG_VERBOSE("StreamContext_tick, %u ms to start receiving response: '%s'.\n", ctx->net.msToRespStart, ctx->cfg.path);
+        }
+    }
+    ctx->net.bytesRcvd += rcvd;
+    ctx->buff.buffUse += rcvd;
+    //rtsp (responses and interleaved rtp)
+    if(ctx->cfg.netProto == ENStreamNetProto_Rtsp){
+        if(0 != StreamContext_cnsmRtspRcvd_(ctx, plyr)){
+            closeConnn = 1;
+        }
+    }
+    //read header
+    if(ctx->cfg.netProto == ENStreamNetProto_Http && !ctx->net.resp.headerEnded){
+        if(0 != StreamContext_cnsmRespHttpHeader_(ctx)){
+            //rejected (status-code, content-type), fail fast
+            closeConnn = 1;
+        } else if(ctx->net.resp.headerEnded){
+            ctx->net.msToRespHead = ctx->net.msSinceStart;
+            if(ctx->net.msToRespHead > 1000){
+                K_LOG_INFO("StreamContext_tick, %u ms to receive response header: '%s'.\n", ctx->net.msToRespHead, ctx->cfg.path);
+            } else {
+                K_LOG_VERBOSE("StreamContext_tick, %u ms to receive response header: '%s'.\n", ctx->net.msToRespHead, ctx->cfg.path);
+            }
+            //body format must match the decoder's
+            if((ctx->net.resp.part.delimLen > 0 ? 1 : 0) != (ctx->cfg.srcPixFmt == V4L2_PIX_FMT_MJPEG ? 1 : 0)){
+                K_LOG_ERROR("StreamContext, net, response body is%s multipart but the stream is%s MJPEG (see '--srcFmt') from '%s:%d': '%s'.\n", (ctx->net.resp.part.delimLen > 0 ? "" : " not"), (ctx->cfg.srcPixFmt == V4L2_PIX_FMT_MJPEG ? "" : " not"), ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                closeConnn = 1;
+            }
+        }
+    }
+    //remove chunks framing (in place, before NALs parsing)
+    if(ctx->cfg.netProto == ENStreamNetProto_Http && ctx->net.resp.headerEnded && ctx->net.resp.isChunked && ctx->buff.buffCsmd < ctx->buff.buffUse){
+        const int rr = StreamContext_cnsmRespHttpChunked_(ctx);
+        if(rr < 0){
+            K_LOG_ERROR("StreamContext, net, malformed chunked body from '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+            closeConnn = 1;
+        } else if(rr > 0){
+            K_LOG_WARN("StreamContext, net, chunked body ended by '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+            closeConnn = 1;
+        }
+    }
+    //read body (NALs or parts)
+    if(ctx->cfg.netProto == ENStreamNetProto_Http && ctx->net.resp.headerEnded && !closeConnn && ctx->buff.buffCsmd < ctx->buff.buffUse){
+        if(bytesRcvdBefore < ctx->net.resp.headerSz && ctx->net.bytesRcvd >= ctx->net.resp.headerSz){
+            ctx->net.msToRespBody = ctx->net.msSinceStart;
+            if(ctx->net.msToRespBody > 1000){
+                K_LOG_INFO("StreamContext_tick, %u ms to start receiving body: '%s'.\n", ctx->net.msToRespBody, ctx->cfg.path);
+            } else {
+                K_LOG_VERBOSE("StreamContext_tick, %u ms to start receiving body: '%s'.\n", ctx->net.msToRespBody, ctx->cfg.path);
+            }
+        }
+        if(ctx->net.resp.part.delimLen > 0){
+            const int rr = StreamContext_cnsmMultipart_(ctx, plyr);
+            if(rr < 0){
+                K_LOG_ERROR("StreamContext, net, malformed multipart body from '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                closeConnn = 1;
+            } else if(rr > 0){
+                K_LOG_WARN("StreamContext, net, multipart body ended by '%s:%d': '%s'.\n", ctx->cfg.server, ctx->cfg.port, ctx->cfg.path);
+                closeConnn = 1;
+            }
+        } else {
+            StreamContext_cnsmBuffNAL_(ctx, plyr, 1/*flushOldersIfIsIndependent*/);
+        }
+    }
+    //mark as fully consumed
+    ctx->net.msWithoutRecv = 0;
+    ctx->buff.buffCsmd = ctx->buff.buffUse;
+    //close (reconnect after wait)
+    if(closeConnn && ctx->net.socket > 0){
         Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
         close(ctx->net.socket);
         ctx->net.socket = 0;
-        ctx->net.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
+        StreamContext_netScheduleReconnect_(ctx, plyr);
+    }
+}
+
+//uring (optional src-ingest backend)
+
+int StreamContext_uringPostRead_(STStreamContext* ctx, struct STPlayer_* plyr, const ENPlayerPollFdType type){ //0 = posted, 1 = previous still pending
+    int r = -1;
+    const int fd = (type == ENPlayerPollFdType_SrcSocket ? ctx->net.socket : ctx->file.fd);
+    if(fd <= 0){
+        r = -1;
+    } else if(Player_uringIsPending(plyr, type, ctx)){
+        r = 1;
     } else {
-        //write
-        if((revents & POLLOUT)){
-            //send
-            if(ctx->net.req.payCsmd < ctx->net.req.payUse){
-                const int sent = (int)send(ctx->net.socket, &ctx->net.req.pay[ctx->net.req.payCsmd], (ctx->net.req.payUse - ctx->net.req.payCsmd), 0);
-                if(sent > 0){
-                    if(ctx->net.bytesSent == 0){
-                        ctx->net.msToConnect = ctx->net.msSinceStart;
-                        if(ctx->net.msToConnect > 1000){
-                            K_LOG_INFO("StreamContext_tick, %u ms to connect: '%s'.\n", ctx->net.msToConnect, ctx->cfg.path);
-                        } else {
-                            K_LOG_VERBOSE("StreamContext_tick, %u ms to connect: '%s'.\n", ctx->net.msToConnect, ctx->cfg.path);
-                        }
-                    }
-                    ctx->net.bytesSent += sent;
-                    ctx->net.msWithoutSend = 0;
-                    ctx->net.req.payCsmd += sent;
-                    if(ctx->net.req.payUse == ctx->net.req.payCsmd){
-                        K_LOG_VERBOSE("StreamContext, request sent (%d bytes) to '%s:%d'.\n", ctx->net.req.payCsmd, ctx->cfg.server, ctx->cfg.port);
-                        K_LOG_VERBOSE("StreamContext, -->\n%s\n<--\n", ctx->net.req.pay);
-                        //stop writting, start reading-only
-                        if(0 != Player_pollUpdate(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket, POLLIN, NULL)){ //read
-                            K_LOG_ERROR("StreamContext, poll-update-failed to '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
-                            Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
-                            close(ctx->net.socket);
-                            ctx->net.socket = 0;
-                            ctx->net.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
-                        }
-                    }
-                } else if(sent != 0){ //zero = socket propperly shuteddown
-                    if(errno == EAGAIN || errno == EWOULDBLOCK){
-                        //non-blocking
-                    } else {
-                        K_LOG_ERROR("StreamContext, send failed to '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
-                        Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
-                        close(ctx->net.socket);
-                        ctx->net.socket = 0;
-                        ctx->net.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
-                    }
-                }
-            }
+        //empty buffer if fully consumed (lock is not necesary)
+        if(ctx->buff.buffCsmd >= ctx->buff.buffUse){
+            ctx->buff.buffCsmd = 0;
+            ctx->buff.buffUse = 0;
         }
-        //read (ToDo: read untill no more data is available)
-        if((revents & POLLIN)){
-            int rcvd = 0, bytesRcvdBefore = 0;
-            unsigned long lastNALPushedSeq = ctx->frames.filled.iSeqPushNext; //to detect completed nals parsed
-            //recv untill no data is returned or explicit-stop-reading
-            do {
-                rcvd = 0;
-                //empty buffer if fully consumed (lock is not necesary)
-                if(ctx->buff.buffCsmd >= ctx->buff.buffUse){
-                    ctx->buff.buffCsmd = 0;
-                    ctx->buff.buffUse = 0;
-                }
-                //produce
-                if(ctx->buff.buffUse < ctx->buff.buffSz){
-                    //produce (unlocked)
-                    bytesRcvdBefore = ctx->net.bytesRcvd;
-                    rcvd = (int)recv(ctx->net.socket, &ctx->buff.buff[ctx->buff.buffUse], (ctx->buff.buffSz - ctx->buff.buffUse), 0);
-                    if(rcvd > 0){
-                        K_LOG_VERBOSE("Net, %d/%d revd.\n", rcvd, (ctx->buff.buffSz - ctx->buff.buffUse));
-                        if(ctx->net.bytesRcvd == 0){
-                            ctx->net.msToRespStart = ctx->net.msSinceStart;
-                            if(ctx->net.msToRespStart > 1000){
-                                K_LOG_INFO("StreamContext_tick, %u ms to start receiving response: '%s'.\n", ctx->net.msToRespStart, ctx->cfg.path);
-                            } else {
-                                K_LOG_VERBOSE("StreamContext_tick, %u ms to start receiving response: '%s'.\n", ctx->net.msToRespStart, ctx->cfg.path);
-                            }
-                        }
-                        ctx->net.bytesRcvd += rcvd;
-                        ctx->buff.buffUse += rcvd;
-                        //read header
-                        if(!ctx->net.resp.headerEnded){
-                            StreamContext_cnsmRespHttpHeader_(ctx);
-                            if(ctx->net.resp.headerEnded){
-                                ctx->net.msToRespHead = ctx->net.msSinceStart;
-                                if(ctx->net.msToRespHead > 1000){
-                                    K_LOG_INFO("StreamContext_tick, %u ms to receive response header: '%s'.\n", ctx->net.msToRespHead, ctx->cfg.path);
-                                } else {
-                                    K_LOG_VERBOSE("StreamContext_tick, %u ms to receive response header: '%s'.\n", ctx->net.msToRespHead, ctx->cfg.path);
-                                }
-                            }
-                        }
-                        //read body (NALs)
-                        if(ctx->net.resp.headerEnded && ctx->buff.buffCsmd < ctx->buff.buffUse){
-                            if(bytesRcvdBefore < ctx->net.resp.headerSz && ctx->net.bytesRcvd >= ctx->net.resp.headerSz){
-                                ctx->net.msToRespBody = ctx->net.msSinceStart;
-                                if(ctx->net.msToRespBody > 1000){
-                                    K_LOG_INFO("StreamContext_tick, %u ms to start receiving body: '%s'.\n", ctx->net.msToRespBody, ctx->cfg.path);
-                                } else {
-                                    K_LOG_VERBOSE("StreamContext_tick, %u ms to start receiving body: '%s'.\n", ctx->net.msToRespBody, ctx->cfg.path);
-                                }
-                            }
-                            StreamContext_cnsmBuffNAL_(ctx, plyr, 1/*flushOldersIfIsIndependent*/);
-                        }
-                        //mark as fully consumed
-                        ctx->net.msWithoutRecv = 0;
-                        ctx->buff.buffCsmd = ctx->buff.buffUse;
-                    } else if(rcvd != 0){ //zero = socket propperly shuteddown
-                        if(errno == EAGAIN || errno == EWOULDBLOCK){
-                            //non-blocking
-                        } else {
-                            K_LOG_ERROR("StreamContext, recv failed to '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
-                            Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
-                            close(ctx->net.socket);
-                            ctx->net.socket = 0;
-                            ctx->net.msToReconnect = (plyr->cfg.connWaitReconnSecs > 0 ? plyr->cfg.connWaitReconnSecs : 1) * 1000;
-                        }
-                    }
+        if(ctx->buff.buffUse < ctx->buff.buffSz){
+            r = Player_uringRead(plyr, type, StreamContext_uringCallback, ctx, fd, &ctx->buff.buff[ctx->buff.buffUse], (ctx->buff.buffSz - ctx->buff.buffUse), (type == ENPlayerPollFdType_SrcSocket));
+        }
+    }
+    return r;
+}
+
+void StreamContext_uringCallback(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, const int res){
+    STStreamContext* ctx = (STStreamContext*)userParam;
+    if(type == ENPlayerPollFdType_SrcSocket){
+        ctx->net.tune.stats.curSec.recvs++;
+        if(ctx->net.socket > 0){
+            int closeConnn = 0;
+            if(res > 0){
+                StreamContext_cnsmNetRcvd_(ctx, plyr, res);
+            } else if(res == 0){
+                K_LOG_ERROR("StreamContext, uring, conn closed by '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
+                closeConnn = 1;
+            } else if(res != -EAGAIN && res != -EINTR){
+                K_LOG_ERROR("StreamContext, uring, recv failed errno(%d) to '%s:%d'.\n", -res, ctx->cfg.server, ctx->cfg.port);
+                closeConnn = 1;
+            }
+            //continue reading
+            if(!closeConnn && ctx->net.socket > 0 && StreamContext_uringPostRead_(ctx, plyr, type) < 0){
+                K_LOG_ERROR("StreamContext, uring, recv post failed to '%s:%d'.\n", ctx->cfg.server, ctx->cfg.port);
+                closeConnn = 1;
+            }
+            if(closeConnn && ctx->net.socket > 0){
+                Player_pollAutoRemove(plyr, ENPlayerPollFdType_SrcSocket, ctx, ctx->net.socket);
+                close(ctx->net.socket);
+                ctx->net.socket = 0;
+                StreamContext_netScheduleReconnect_(ctx, plyr);
+            }
+        }
+    } else if(type == ENPlayerPollFdType_SrcFile){
+        if(ctx->file.fd > 0){
+            if(res > 0){
+                StreamContext_cnsmFileRead_(ctx, plyr, res);
+            } else if(res < 0 && res != -EAGAIN && res != -EINTR){
+                const char* reason = "file-read-failed";
+                if(0 != StreamContext_shutdownStartByFileClosed_(ctx, plyr, reason)){
+                    K_LOG_ERROR("StreamContext, StreamContext_shutdownStart failed (at '%s').\n", reason);
                 }
-            } while(rcvd > 0 && lastNALPushedSeq == ctx->frames.filled.iSeqPushNext);
+            }
+            //continue reading (end-of-file and blocked reads are posted again at tick)
+            if(res > 0 && ctx->file.fd > 0 && (StreamContext_getPollEventsMaskFile(ctx, plyr) & POLLIN)){
+                StreamContext_updatePollMaskFile_(ctx, plyr);
+            }
         }
     }
 }
@@ -5397,8 +9777,24 @@ int StreamContext_open(STStreamContext* ctx, struct STPlayer_* plyr, const char*
         K_LOG_ERROR("StreamContext_open, context was previously shutted-down permnently (program logic error).\n");
         K_ASSERT(!(ctx->shuttingDown.isActive && ctx->shuttingDown.isPermanent));
     } else {
-        K_LOG_VERBOSE("StreamContext_open, opening device: '%s'...\n", resPath);
-        int fd = v4l2_open(device, O_RDWR | O_NONBLOCK);
+        STDecoderParked* parked = NULL;
+        struct timespec tsStart;
+        int fd = -1;
+        clock_gettime(CLOCK_MONOTONIC, &tsStart);
+        //parked decoder (already opened, buffers mapped)
+        if(plyr->cfg.decoderPool){
+            parked = Player_decPoolTake(plyr, device, srcPixFmt, dstPixFmt);
+            if(parked == NULL){
+                Player_decPoolTrim(plyr, 1); //room for the new handle
+            }
+        }
+        if(parked != NULL){
+            K_LOG_VERBOSE("StreamContext_open, reassigning parked device (%llums parked): '%s'...\n", (plyr->msRunning - parked->msParked), resPath);
+            fd = parked->fd; parked->fd = -1; //consume
+        } else {
+            K_LOG_VERBOSE("StreamContext_open, opening device: '%s'...\n", resPath);
+            fd = v4l2_open(device, O_RDWR | O_NONBLOCK);
+        }
         if(fd < 0){
             K_LOG_ERROR("StreamContext_open, device failed to open: '%s'.\n", resPath);
         } else {
@@ -5411,23 +9807,29 @@ int StreamContext_open(STStreamContext* ctx, struct STPlayer_* plyr, const char*
             if(printDev != NULL){ PrintedInfo_touch(printDev); }
             if(printSrcFmt != NULL){ PrintedInfo_touch(printSrcFmt); }
             //
-            if(0 != v4lDevice_queryCaps(fd, (printDev != NULL ? 1 : 0))){
+            if(parked != NULL && 0 != StreamContext_openParked_(ctx, plyr, parked, fd, srcPixFmt, buffersAmmount, planesPerBuffer, sizePerPlane, (printSrcFmt != NULL ? 1 : 0))){
+                K_LOG_ERROR("StreamContext_openParked_ failed: '%s'.\n", resPath);
+            } else if(parked == NULL && 0 != v4lDevice_queryCaps(fd, (printDev != NULL ? 1 : 0))){
                 //device is not v4l?
                 K_LOG_ERROR("v4lDevice_queryCaps failed: '%s'.\n", resPath);
-            } else if(0 != Buffers_queryFmts(&ctx->dec.src, fd, srcPixFmt, &srcPixFmtWasFound, (printSrcFmt != NULL ? 1 : 0))){
+            } else if(parked == NULL && 0 != Buffers_queryFmts(&ctx->dec.src, fd, srcPixFmt, &srcPixFmtWasFound, (printSrcFmt != NULL ? 1 : 0))){
                 K_LOG_ERROR("Buffers_queryFmts(src) failed: '%s'.\n", resPath);
-            } else if(!srcPixFmtWasFound){
+            } else if(parked == NULL && !srcPixFmtWasFound && srcPixFmt != V4L2_PIX_FMT_MJPEG){
                 K_LOG_ERROR("Buffers_queryFmts src-fmt unsupported: '%s'.\n", resPath);
-            } else if(0 != Buffers_setFmt(&ctx->dec.src, fd, srcPixFmt, planesPerBuffer, sizePerPlane, 0 /*getCompositionRect*/, (printSrcFmt != NULL ? 1 : 0))){
+            } else if(parked == NULL && !srcPixFmtWasFound && 0 != StreamContext_jpegCpuOpen_(ctx, dstPixFmt, &fd)){
+                //MJPEG without device support is decoded at the cpu
+                K_LOG_ERROR("StreamContext_open, src-fmt unsupported by device and cpu decoder not available for dst-fmt('%c%c%c%c'): '%s'.\n", dstPixFmtChars[0], dstPixFmtChars[1], dstPixFmtChars[2], dstPixFmtChars[3], resPath);
+            } else if(parked == NULL && ctx->dec.jpeg.cpu == NULL && 0 != Buffers_setFmt(&ctx->dec.src, fd, srcPixFmt, planesPerBuffer, sizePerPlane, 0 /*getCompositionRect*/, (printSrcFmt != NULL ? 1 : 0))){
                 K_LOG_ERROR("Buffers_setFmt failed: '%s'.\n", resPath);
-            } else if(0 != Buffers_queryFmts(&ctx->dec.dst, fd, dstPixFmt, &dstPixFmtWasFound, (printSrcFmt != NULL ? 1 : 0))){
+            } else if(parked == NULL && ctx->dec.jpeg.cpu == NULL && 0 != Buffers_queryFmts(&ctx->dec.dst, fd, dstPixFmt, &dstPixFmtWasFound, (printSrcFmt != NULL ? 1 : 0))){
                 K_LOG_ERROR("Buffers_queryFmts(dst) failed: '%s'.\n", resPath);
-            } else if(!dstPixFmtWasFound){
+            } else if(parked == NULL && ctx->dec.jpeg.cpu == NULL && !dstPixFmtWasFound){
                 K_LOG_ERROR("Buffers_queryFmts dst-fmt('%c%c%c%c') unsupported: '%s'.\n", dstPixFmtChars[0], dstPixFmtChars[1], dstPixFmtChars[2], dstPixFmtChars[3], resPath);
-            } else if(0 != StreamContext_initAndPrepareSrc(ctx, fd, buffersAmmount, (printSrcFmt != NULL ? 1 : 0))){
+            } else if(parked == NULL && ctx->dec.jpeg.cpu == NULL && 0 != StreamContext_initAndPrepareSrc(ctx, fd, buffersAmmount, (printSrcFmt != NULL ? 1 : 0))){
                 K_LOG_ERROR("StreamContext_initAndPrepareSrc(%d) failed: '%s'.\n", buffersAmmount, resPath);
             } else {
-                if(0 != StreamContext_eventsSubscribe(ctx, fd)){
+                //parked decoders keep their events subscription
+                if(parked == NULL && ctx->dec.jpeg.cpu == NULL && 0 != StreamContext_eventsSubscribe(ctx, fd)){
                     K_LOG_ERROR("StreamContext_eventsSubscribe failed to '%s'.\n", resPath);
                 } else {
                     if(0 != Player_pollAdd(plyr, ENPlayerPollFdType_Decoder, StreamContext_pollCallback, ctx, fd, StreamContext_getPollEventsMask(ctx))){ //write
@@ -5507,36 +9909,75 @@ int StreamContext_open(STStreamContext* ctx, struct STPlayer_* plyr, const char*
                                 VideoFrameStates_empty(&ctx->dec.frames.fed);
                             }
                         }
+                        //stats
+                        {
+                            struct timespec tsEnd;
+                            clock_gettime(CLOCK_MONOTONIC, &tsEnd);
+                            const unsigned long us = (unsigned long)((((unsigned long long)tsEnd.tv_sec * 1000000ULL) + (unsigned long long)(tsEnd.tv_nsec / 1000)) - (((unsigned long long)tsStart.tv_sec * 1000000ULL) + (unsigned long long)(tsStart.tv_nsec / 1000)));
+                            if(parked != NULL){
+                                plyr->decPool.stats.curSec.hits++;
+                                plyr->decPool.stats.curSec.usToReassignSum += us;
+                                if(plyr->decPool.stats.curSec.usToReassignMax < us){
+                                    plyr->decPool.stats.curSec.usToReassignMax = us;
+                                }
+                                K_LOG_VERBOSE("StreamContext_open, parked device reassigned in %luus (%d src, %d dst buffers kept): '%s'.\n", us, ctx->dec.src.sz, ctx->dec.dst.sz, resPath);
+                            } else if(ctx->dec.jpeg.cpu == NULL){
+                                plyr->decPool.stats.curSec.misses++;
+                                plyr->decPool.stats.curSec.usToOpenSum += us;
+                            }
+                        }
                         //success
                         r = 0;
                     }
                     //revert
-                    if(r != 0 && fd >= 0){
+                    if(r != 0 && fd >= 0 && ctx->dec.jpeg.cpu == NULL){
                         if(0 != StreamContext_eventsUnsubscribe(ctx, fd)){
                             K_LOG_WARN("StreamContext_eventsUnsubscribe failed.\n");
                         }
                     }
                 }
                 //revert
-                if(r != 0 && fd >= 0){
+                if(r != 0 && fd >= 0 && ctx->dec.jpeg.cpu == NULL){
+                    if(ctx->dec.dst.sz > 0 && 0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.dst, fd)){ //parked
+                        K_LOG_WARN("StreamContext_stopAndCleanupBuffs(dst) failed.\n");
+                    }
                     if(0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.src, fd)){
                         K_LOG_WARN("StreamContext_stopAndCleanupBuffs(src) failed.\n");
                     }
                 }
             }
             //release (if not consumed)
-            if(fd >= 0){
+            if(fd >= 0 && ctx->dec.jpeg.cpu != NULL){
+                close(fd);
+                fd = -1;
+                StreamContext_jpegCpuClose_(ctx);
+            } else if(fd >= 0){
                 v4l2_close(fd);
                 fd = -1;
             }
         }
+        //parked record (fd and buffers were consumed)
+        if(parked != NULL){
+            DecoderParked_release(parked);
+            free(parked);
+            parked = NULL;
+        }
     }
     //
     return r;
 }
 
 int StreamContext_close(STStreamContext* ctx, struct STPlayer_* plyr){
-    if(ctx->dec.fd >= 0){
+    if(ctx->dec.fd >= 0 && ctx->dec.jpeg.cpu != NULL){
+        if(0 != Player_pollAutoRemove(plyr, ENPlayerPollFdType_Decoder, ctx, ctx->dec.fd)){
+            K_LOG_ERROR("StreamContext, Player_pollAutoRemove failed.\n");
+        }
+        close(ctx->dec.fd);
+        ctx->dec.fd = -1;
+        StreamContext_jpegCpuClose_(ctx);
+    } else if(ctx->dec.fd >= 0){
+        //frames assembled in the OUTPUT buffers are moved before unmapping
+        StreamContext_decBuffsUnbindAll_(ctx);
         if(0 != StreamContext_stopAndCleanupBuffs(ctx, &ctx->dec.dst, ctx->dec.fd)){
             K_LOG_WARN("StreamContext_stopAndCleanupBuffs(dst) failed.\n");
         }
@@ -5558,6 +9999,7 @@ int StreamContext_close(STStreamContext* ctx, struct STPlayer_* plyr){
         ctx->dec.msFirstFrameFed = 0;
         ctx->dec.framesInSinceOpen = 0;
         ctx->dec.framesOutSinceOpen = 0;
+        ctx->dec.isFaulty = 0;
         //
         ctx->dec.src.isExplicitON = 0;
         ctx->dec.src.isImplicitON = 0;
@@ -5576,7 +10018,371 @@ int StreamContext_close(STStreamContext* ctx, struct STPlayer_* plyr){
         K_LOG_VERBOSE("StreamContext, %d fed-states discarded at close.\n", ctx->dec.frames.fed.use);
         VideoFrameStates_empty(&ctx->dec.frames.fed);
     }
-    return 0;
+    return 0;
+}
+
+int StreamContext_park(STStreamContext* ctx, struct STPlayer_* plyr){
+    if(ctx->dec.fd >= 0 && ctx->dec.jpeg.cpu == NULL && !ctx->dec.isFaulty && plyr->cfg.decoderPool && ctx->cfg.device != NULL){
+        STDecoderParked* dec = NULL;
+        //frames assembled in the OUTPUT buffers are moved before parking (next owner will overwrite them)
+        StreamContext_decBuffsUnbindAll_(ctx);
+        if(0 != Buffers_stop(&ctx->dec.dst, ctx->dec.fd)){
+            K_LOG_WARN("StreamContext_park, Buffers_stop(dst) failed: '%s'.\n", ctx->cfg.device);
+        } else if(0 != Buffers_stop(&ctx->dec.src, ctx->dec.fd)){
+            K_LOG_WARN("StreamContext_park, Buffers_stop(src) failed: '%s'.\n", ctx->cfg.device);
+        } else if(NULL == (dec = (STDecoderParked*)malloc(sizeof(STDecoderParked)))){
+            K_LOG_ERROR("StreamContext_park, malloc failed.\n");
+        } else {
+            DecoderParked_init(dec);
+            {
+                const int deviceLen = strlen(ctx->cfg.device);
+                dec->device = malloc(deviceLen + 1);
+                memcpy(dec->device, ctx->cfg.device, deviceLen + 1);
+            }
+            dec->srcPixFmt          = ctx->cfg.srcPixFmt;
+            dec->buffersAmmount     = ctx->cfg.buffersAmmount;
+            dec->planesPerBuffer    = ctx->cfg.planesPerBuffer;
+            dec->sizePerPlane       = ctx->cfg.sizePerPlane;
+            dec->dstPixFmt          = ctx->cfg.dstPixFmt;
+            //events subscription is kept
+            if(0 != Player_pollAutoRemove(plyr, ENPlayerPollFdType_Decoder, ctx, ctx->dec.fd)){
+                K_LOG_ERROR("StreamContext, Player_pollAutoRemove failed.\n");
+            }
+            Buffers_move(&dec->src, &ctx->dec.src);
+            Buffers_move(&dec->dst, &ctx->dec.dst);
+            dec->fd = ctx->dec.fd; ctx->dec.fd = -1; //consume
+            K_LOG_VERBOSE("StreamContext(%lld), decoder parked (%d src, %d dst buffers): '%s'.\n", (long long)ctx, dec->src.sz, dec->dst.sz, ctx->cfg.path);
+            if(0 != Player_decPoolAdd(plyr, dec)){
+                K_LOG_ERROR("StreamContext_park, Player_decPoolAdd failed.\n");
+                DecoderParked_release(dec);
+                free(dec);
+            }
+            dec = NULL;
+        }
+    }
+    //close (if not parked) and reset
+    return StreamContext_close(ctx, plyr);
+}
+
+int StreamContext_openParked_(STStreamContext* ctx, struct STPlayer_* plyr, struct STDecoderParked_* parked, const int fd, const int srcPixFmt, const int buffersAmmount, const int planesPerBuffer, const int sizePerPlane, const int print){
+    int r = -1;
+    Buffers_move(&ctx->dec.src, &parked->src);
+    Buffers_move(&ctx->dec.dst, &parked->dst);
+    //events queued while parked belong to the previous stream
+    {
+        struct v4l2_event ev;
+        int count = 0;
+        memset(&ev, 0, sizeof(ev));
+        while(count < 16 && 0 == v4l2_ioctl(fd, VIDIOC_DQEVENT, &ev)){
+            count++;
+        }
+        if(count > 0){
+            K_LOG_VERBOSE("StreamContext, %d parked-decoder events discarded.\n", count);
+        }
+    }
+    //src
+    if(parked->srcPixFmt == srcPixFmt && parked->buffersAmmount == buffersAmmount && parked->planesPerBuffer == planesPerBuffer && parked->sizePerPlane == sizePerPlane && ctx->dec.src.sz > 0){
+        ctx->dec.isWaitingForIDRFrame = 1;
+        r = 0;
+    } else {
+        //size differs (dst is released too, the src-fmt is set again)
+        plyr->decPool.stats.curSec.reallocs++;
+        if(ctx->dec.dst.sz > 0 && 0 != Buffers_allocBuffs(&ctx->dec.dst, fd, 0, 0)){
+            K_LOG_ERROR("StreamContext_openParked_, Buffers_allocBuffs(dst, 0) failed: '%s'.\n", parked->device);
+        } else if(ctx->dec.src.sz > 0 && 0 != Buffers_allocBuffs(&ctx->dec.src, fd, 0, 0)){
+            K_LOG_ERROR("StreamContext_openParked_, Buffers_allocBuffs(src, 0) failed: '%s'.\n", parked->device);
+        } else if(0 != Buffers_setFmt(&ctx->dec.src, fd, srcPixFmt, planesPerBuffer, sizePerPlane, 0 /*getCompositionRect*/, print)){
+            K_LOG_ERROR("Buffers_setFmt failed: '%s'.\n", parked->device);
+        } else if(0 != StreamContext_initAndPrepareSrc(ctx, fd, buffersAmmount, print)){
+            K_LOG_ERROR("StreamContext_initAndPrepareSrc(%d) failed: '%s'.\n", buffersAmmount, parked->device);
+        } else {
+            r = 0;
+        }
+    }
+    //revert
+    if(r != 0){
+        if(ctx->dec.dst.sz > 0 && 0 != Buffers_allocBuffs(&ctx->dec.dst, fd, 0, 0)){
+            K_LOG_WARN("StreamContext_openParked_, Buffers_allocBuffs(dst, 0) failed.\n");
+        }
+        if(ctx->dec.src.sz > 0 && 0 != Buffers_allocBuffs(&ctx->dec.src, fd, 0, 0)){
+            K_LOG_WARN("StreamContext_openParked_, Buffers_allocBuffs(src, 0) failed.\n");
+        }
+    }
+    return r;
+}
+
+//jpeg (cpu decoder, MJPEG streams when the device has no MJPEG support)
+
+#ifdef K_USE_LIBJPEG
+void JpegDec_errorExit_(j_common_ptr cinfo){
+    STJpegDec* dec = (STJpegDec*)cinfo->client_data;
+    char msg[JMSG_LENGTH_MAX];
+    (*cinfo->err->format_message)(cinfo, msg);
+    K_LOG_VERBOSE("JpegDec, error: '%s'.\n", msg);
+    longjmp(dec->jmp, 1);
+}
+
+void JpegDec_outputMessage_(j_common_ptr cinfo){
+    //warnings (like corrupted data) are not printed
+}
+#endif
+
+int StreamContext_jpegCpuOpen_(STStreamContext* ctx, const int dstPixFmt, int* fd){
+    int r = -1;
+#   ifdef K_USE_LIBJPEG
+    J_COLOR_SPACE colorSpace = JCS_UNKNOWN;
+    int bytesPerPx = 0;
+    switch(dstPixFmt){
+        case V4L2_PIX_FMT_RGB565:
+            colorSpace = JCS_RGB565;
+            bytesPerPx = 2;
+            break;
+#       ifdef V4L2_PIX_FMT_ABGR32
+        case V4L2_PIX_FMT_ABGR32:
+#       endif
+        case V4L2_PIX_FMT_BGR32:
+            colorSpace = JCS_EXT_BGRX; //'B, G, R, X' in memory
+            bytesPerPx = 4;
+            break;
+        default:
+            break;
+    }
+    if(colorSpace != JCS_UNKNOWN && ctx->dec.jpeg.cpu == NULL){
+        STJpegDec* dec = (STJpegDec*)malloc(sizeof(STJpegDec));
+        const int efd = (dec != NULL ? eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) : -1); //never signaled, polled in place of the device
+        if(efd < 0){
+            K_LOG_ERROR("StreamContext, jpeg, cpu decoder could not be created.\n");
+        } else {
+            memset(dec, 0, sizeof(*dec));
+            dec->cinfo.err = jpeg_std_error(&dec->jerr);
+            dec->cinfo.client_data = dec;
+            jpeg_create_decompress(&dec->cinfo);
+            dec->jerr.error_exit = JpegDec_errorExit_;
+            dec->jerr.output_message = JpegDec_outputMessage_;
+            dec->colorSpace = colorSpace;
+            dec->bytesPerPx = bytesPerPx;
+            //replace device
+            if(*fd >= 0){
+                v4l2_close(*fd);
+            }
+            *fd = efd;
+            ctx->dec.jpeg.cpu = dec; dec = NULL; //consume
+            K_LOG_VERBOSE("StreamContext, jpeg, cpu decoder created.\n");
+            r = 0;
+        }
+        if(dec != NULL){
+            free(dec);
+            dec = NULL;
+        }
+    }
+#   endif
+    return r;
+}
+
+void StreamContext_jpegCpuClose_(STStreamContext* ctx){
+#   ifdef K_USE_LIBJPEG
+    if(ctx->dec.jpeg.cpu != NULL){
+        jpeg_destroy_decompress(&ctx->dec.jpeg.cpu->cinfo);
+        free(ctx->dec.jpeg.cpu);
+        ctx->dec.jpeg.cpu = NULL;
+        //output buffer (heap)
+        if(ctx->dec.dst.arr != NULL){
+            int i; for(i = 0; i < ctx->dec.dst.sz; i++){
+                Buffer_release(&ctx->dec.dst.arr[i]);
+            }
+            free(ctx->dec.dst.arr);
+            ctx->dec.dst.arr = NULL;
+        }
+        ctx->dec.dst.sz = 0;
+        ctx->dec.dst.lastDequeued = NULL;
+        ctx->dec.dst.width = 0;
+        ctx->dec.dst.height = 0;
+    }
+#   endif
+}
+
+#ifdef K_USE_LIBJPEG
+//(Re)allocates the single output buffer by the image size, as a decoder's resolution change.
+STPlane* StreamContext_jpegCpuResize_(STStreamContext* ctx, struct STPlayer_* plyr, const int width, const int height, const int bytesPerLn){
+    STPlane* r = NULL;
+    STBuffer* buff = ctx->dec.dst.arr;
+    if(buff == NULL){
+        buff = (STBuffer*)malloc(sizeof(STBuffer));
+        if(buff != NULL){
+            Buffer_init(buff);
+            buff->planes = (STPlane*)malloc(sizeof(STPlane));
+            if(buff->planes == NULL){
+                free(buff);
+                buff = NULL;
+            } else {
+                Plane_init(&buff->planes[0]);
+                buff->planesSz = 1;
+            }
+        }
+        ctx->dec.dst.arr = buff;
+        ctx->dec.dst.sz = (buff != NULL ? 1 : 0);
+    }
+    if(buff != NULL){
+        STPlane* plane = &buff->planes[0];
+        const unsigned int length = (unsigned int)(bytesPerLn * height);
+        if(plane->length != length){
+            if(plane->dataPtr != NULL){
+                free(plane->dataPtr);
+                plane->dataPtr = NULL;
+            }
+            plane->length = 0;
+            plane->dataPtr = (unsigned char*)malloc(length);
+            if(plane->dataPtr != NULL){
+                plane->length = length;
+            }
+        }
+        if(plane->dataPtr != NULL){
+            plane->bytesPerLn = bytesPerLn;
+            plane->used = 0;
+            //
+            ctx->dec.dst.pixelformat = ctx->cfg.dstPixFmt;
+            ctx->dec.dst.width = width;
+            ctx->dec.dst.height = height;
+            ctx->dec.dst.composition.x = 0;
+            ctx->dec.dst.composition.y = 0;
+            ctx->dec.dst.composition.width = width;
+            ctx->dec.dst.composition.height = height;
+            ctx->dec.dst.lastDequeued = NULL;
+            K_LOG_INFO("StreamContext, jpeg, cpu decoding %dx%d: '%s'.\n", width, height, ctx->cfg.path);
+            //draw plan
+            if(ctx->drawPlan.lastPixelformat != ctx->dec.dst.pixelformat || ctx->drawPlan.lastCompRect.width != width || ctx->drawPlan.lastCompRect.height != height){
+                ctx->drawPlan.lastPixelformat = ctx->dec.dst.pixelformat;
+                ctx->drawPlan.lastCompRect = ctx->dec.dst.composition;
+                ctx->drawPlan.lastHeight = height;
+                if(0 != Player_organize(plyr)){
+                    K_LOG_ERROR("StreamContext, jpeg, Player_organize failed.\n");
+                }
+            }
+            r = plane;
+        }
+    }
+    return r;
+}
+#endif
+
+//Decodes the JPEG into the output buffer (scanlines are written directly into the plane).
+int StreamContext_jpegCpuDecode_(STStreamContext* ctx, struct STPlayer_* plyr, const unsigned char* data, const int dataSz){
+    int r = -1;
+#   ifdef K_USE_LIBJPEG
+    STJpegDec* dec = ctx->dec.jpeg.cpu;
+    struct jpeg_decompress_struct* cinfo = &dec->cinfo;
+    if(setjmp(dec->jmp) != 0){
+        //corrupted data
+        jpeg_abort_decompress(cinfo);
+        return -1;
+    }
+    jpeg_mem_src(cinfo, (unsigned char*)data, (unsigned long)dataSz);
+    if(jpeg_read_header(cinfo, TRUE) == JPEG_HEADER_OK){
+        cinfo->out_color_space = dec->colorSpace;
+        cinfo->dct_method = JDCT_IFAST;         //SIMD integer IDCT
+        cinfo->do_fancy_upsampling = FALSE;     //merged (SIMD) upsampling and color conversion
+        cinfo->dither_mode = JDITHER_NONE;
+        jpeg_start_decompress(cinfo);
+        {
+            const int width = (int)cinfo->output_width, height = (int)cinfo->output_height;
+            const int bytesPerLn = (((width * dec->bytesPerPx) + 3) / 4) * 4; //32-bits aligned lines (bitblit)
+            STPlane* plane = NULL;
+            if(ctx->dec.dst.arr != NULL && ctx->dec.dst.width == width && ctx->dec.dst.height == height){
+                plane = &ctx->dec.dst.arr[0].planes[0];
+            } else {
+                plane = StreamContext_jpegCpuResize_(ctx, plyr, width, height, bytesPerLn);
+            }
+            if(plane == NULL){
+                K_LOG_ERROR("StreamContext, jpeg, output buffer could not be allocated (%dx%d).\n", width, height);
+                jpeg_abort_decompress(cinfo);
+            } else {
+                while(cinfo->output_scanline < cinfo->output_height){
+                    JSAMPROW rows[4];
+                    int j, rowsCount = (int)(cinfo->output_height - cinfo->output_scanline);
+                    if(rowsCount > 4) rowsCount = 4;
+                    for(j = 0; j < rowsCount; j++){
+                        rows[j] = &plane->dataPtr[(cinfo->output_scanline + j) * bytesPerLn];
+                    }
+                    jpeg_read_scanlines(cinfo, rows, rowsCount);
+                }
+                jpeg_finish_decompress(cinfo);
+                plane->used = plane->length;
+                r = 0;
+            }
+        }
+    }
+#   endif
+    return r;
+}
+
+//Decodes the newest filled frame at the cpu; older ones are skipped (every JPEG is independent).
+void StreamContext_jpegCpuFeed_(STStreamContext* ctx, struct STPlayer_* plyr){
+    STVideoFrame* frame = NULL;
+    while(ctx->dec.fd >= 0 && !ctx->flushing.isActive && 0 == VideoFrames_pullFrameForRead(&ctx->frames.filled, &frame)){
+        if(VideoFrames_getFramesForReadCount(&ctx->frames.filled) > 0 || frame->accessUnit.isInvalid){
+            //newer available
+            plyr->stats.curSec.dec.got.skipped++;
+        } else {
+            ctx->dec.frames.foundCount++;
+            if(ctx->dec.frames.foundCount <= ctx->cfg.framesSkip){
+                K_LOG_INFO("StreamContext, skipping-fed frame (#%d/%d) (user-param 'framesSkip').\n", ctx->dec.frames.foundCount, ctx->cfg.framesSkip);
+            } else {
+                gettimeofday(&frame->state.times.proc.start, NULL);
+                ctx->dec.frames.fedCount++;
+                ctx->dec.framesInSinceOpen++;
+                if(ctx->dec.framesInSinceOpen == 1){
+                    ctx->dec.msFirstFrameFed = ctx->dec.msOpen;
+                }
+                ctx->dec.msWithoutFeedFrame = 0;
+                plyr->stats.curSec.dec.fed.count++;
+                if(0 != StreamContext_jpegCpuDecode_(ctx, plyr, (frame->buff.extPtr != NULL ? frame->buff.extPtr : frame->buff.ptr), frame->buff.use)){
+                    K_LOG_VERBOSE("StreamContext, jpeg, frame(#%d) could not be decoded: '%s'.\n", (frame->state.iSeq + 1), ctx->cfg.path);
+                    plyr->stats.curSec.dec.got.skipped++;
+                } else {
+                    long msToDecode;
+                    gettimeofday(&frame->state.times.proc.end, NULL);
+                    msToDecode = msBetweenTimevals(&frame->state.times.proc.start, &frame->state.times.proc.end);
+                    ctx->dec.dst.lastDequeued = &ctx->dec.dst.arr[0];
+                    ctx->dec.dst.msWithoutDequeuing = 0;
+                    ctx->dec.isWaitingForIDRFrame = 0;
+                    ctx->dec.framesOutSinceOpen++;
+                    if(ctx->dec.framesOutSinceOpen == 1){
+                        ctx->dec.msFirstFrameOut = ctx->dec.msOpen;
+                        K_LOG_VERBOSE("StreamContext, %ums + %ums to produce first decoded frame.\n", ctx->dec.msFirstFrameFed, (ctx->dec.msFirstFrameOut - ctx->dec.msFirstFrameFed));
+                    }
+                    //stats
+                    plyr->stats.curSec.dec.got.msSum += msToDecode;
+                    if(plyr->stats.curSec.dec.got.count == 0){
+                        plyr->stats.curSec.dec.got.msMin = msToDecode;
+                        plyr->stats.curSec.dec.got.msMax = msToDecode;
+                    } else {
+                        if(plyr->stats.curSec.dec.got.msMin > msToDecode) plyr->stats.curSec.dec.got.msMin = msToDecode;
+                        if(plyr->stats.curSec.dec.got.msMax < msToDecode) plyr->stats.curSec.dec.got.msMax = msToDecode;
+                    }
+                    plyr->stats.curSec.dec.got.count++;
+                    //flag framebuffers-grps where this frame will be used
+                    {
+                        int i; for(i = 0; i < plyr->fbs.grps.use; i++){
+                            STFramebuffsGrp* grp = &plyr->fbs.grps.arr[i];
+                            if(grp->pixFmt == ctx->drawPlan.lastPixelformat){
+                                if(0 == FramebuffsGrp_layoutFindStreamId(grp, ctx->streamId)){
+                                    //flag as dirty
+                                    grp->isSynced = 0;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        //reuse
+        if(0 != VideoFrames_pushFrameOwning(&ctx->frames.reusable, frame)){
+            K_LOG_ERROR("StreamContext, frame could not be returned to reusable.\n");
+            VideoFrame_release(frame);
+            free(frame);
+        }
+        frame = NULL;
+    }
 }
 
 //------------
@@ -6623,7 +11429,7 @@ int Buffers_getUnqueued(STBuffers* obj, STBuffer** dstBuff, STBuffer* ignoreThis
         //
         K_ASSERT(buffer->dbg.indexPlusOne == (buffer->index + 1))
         //
-        if(!buffer->isQueued && buffer != ignoreThis){
+        if(!buffer->isQueued && !buffer->isBound && buffer != ignoreThis){
             if(dstBuff != NULL){
                 *dstBuff = buffer;
             }
@@ -6893,6 +11699,25 @@ int Buffers_keepLastAsClone(STBuffers* obj, STBuffer* src){
     return r;
 }
 
+void Buffers_move(STBuffers* obj, STBuffers* src){
+    Buffers_release(obj);
+    *obj = *src;
+    //internal pointer to 'fm'
+#   ifdef K_USE_MPLANE
+    if(obj->mp != NULL){
+        obj->mp = &obj->fm.fmt.pix_mp;
+    }
+#   else
+    if(obj->sp != NULL){
+        obj->sp = &obj->fm.fmt.pix;
+    }
+#   endif
+    obj->lastDequeued = NULL;
+    obj->isLastDequeuedCloned = 0;
+    //ownership transfered
+    Buffers_init(src);
+}
+
 //
 
 int v4lDevice_queryCaps(int fd, const int print){
@@ -7077,206 +11902,1284 @@ int v4lDevice_queryCaps(int fd, const int print){
 #              endif
                 }
             }
-#       endif
+#       endif
+        }
+        r = 0;
+    }
+    return r;
+}
+
+int v4lDevice_queryControls(int fd, const int print){
+    int controlsTotal = 0;
+    int rr2 = 0;
+    //
+    //VIDIOC_QUERYCTRL vs VIDIOC_G_CTRL ?
+    {
+        //standard controls
+        unsigned int cid = V4L2_CID_BASE;
+        int reqsCountBase = 0, reqsCountPriv = 0;
+        struct v4l2_queryctrl ctrl;
+        memset(&ctrl, 0, sizeof(ctrl));
+        for(cid = V4L2_CID_BASE; cid < V4L2_CID_LASTP1; cid++){
+            ctrl.id = cid;
+            rr2 = v4l2_ioctl(fd, VIDIOC_QUERYCTRL, &ctrl);
+            if(rr2 == 0){
+                v4lDevice_controlAnalyze(fd, &ctrl, print);
+                controlsTotal++;
+            }
+            reqsCountBase++;
+        }
+        //private controls
+        {
+            unsigned int cid = V4L2_CID_PRIVATE_BASE;
+            rr2 = 0;
+            while(rr2 == 0){
+                ctrl.id = cid;
+                rr2 = v4l2_ioctl(fd, VIDIOC_QUERYCTRL, &ctrl);
+                if(rr2 == 0){
+                    v4lDevice_controlAnalyze(fd, &ctrl, print);
+                    controlsTotal++;
+                }
+                //next
+                cid++;
+                reqsCountPriv++;
+            }
+        }
+        if(print){
+            K_LOG_INFO("%d controls queried (%d standard, %d private requested).\n", controlsTotal, reqsCountBase, reqsCountPriv);
+        }
+    }
+    {
+        //standard controls
+        unsigned int cid = V4L2_CID_BASE;
+        struct v4l2_control ctrl;
+        memset(&ctrl, 0, sizeof(ctrl));
+        for(cid = V4L2_CID_BASE; cid < V4L2_CID_LASTP1; cid++){
+            ctrl.id = cid;
+            rr2 = v4l2_ioctl(fd, VIDIOC_G_CTRL, &ctrl);
+            if(rr2 == 0){
+                K_LOG_VERBOSE("Control %d value: %d.\n", cid, ctrl.value);
+                controlsTotal++;
+            }
+        }
+        //private controls
+        /*{
+            rr2 = 0; ctrl.id = V4L2_CID_PRIVATE_BASE;
+            while(rr2 == 0){
+                rr2 = v4l2_ioctl(fd, VIDIOC_G_CTRL, &ctrl);
+                if(rr2 == 0){
+                    K_LOG_INFO("Control %d value: %d.\n", ctrl.id, ctrl.value);
+                    controlsTotal++;
+                }
+                //next
+                ctrl.id++;
+            }
+        }*/
+        if(print){
+            K_LOG_INFO("%d controls goten.\n", controlsTotal);
+        }
+    }
+    return 0;
+}
+
+int v4lDevice_controlAnalyze(int fd, struct v4l2_queryctrl* ctrl, const int print){
+    if(print){
+        K_LOG_INFO("Control: '%s' (%d, +%d, %d).\n", ctrl->name, ctrl->minimum, ctrl->step, ctrl->maximum);
+        //type
+        switch(ctrl->type){
+            case V4L2_CTRL_TYPE_INTEGER: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_INTEGER.\n"); break;
+            case V4L2_CTRL_TYPE_BOOLEAN: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_BOOLEAN.\n"); break;
+            case V4L2_CTRL_TYPE_MENU: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_MENU.\n"); break;
+            case V4L2_CTRL_TYPE_INTEGER_MENU: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_INTEGER_MENU.\n"); break;
+            case V4L2_CTRL_TYPE_BITMASK: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_BITMASK.\n"); break;
+            case V4L2_CTRL_TYPE_BUTTON: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_BUTTON.\n"); break;
+            case V4L2_CTRL_TYPE_INTEGER64: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_INTEGER64.\n"); break;
+            case V4L2_CTRL_TYPE_STRING: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_STRING.\n"); break;
+            case V4L2_CTRL_TYPE_CTRL_CLASS: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_CTRL_CLASS.\n"); break;
+            case V4L2_CTRL_TYPE_U8: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_U8.\n"); break;
+            case V4L2_CTRL_TYPE_U16: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_U16.\n"); break;
+            case V4L2_CTRL_TYPE_U32: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_U32.\n"); break;
+            default: K_LOG_INFO("    Type: unknown.\n"); break;
+        }
+        //flags
+        if((ctrl->flags & V4L2_CTRL_FLAG_DISABLED)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_DISABLED.\n"); }
+        if((ctrl->flags & V4L2_CTRL_FLAG_GRABBED)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_GRABBED.\n"); }
+        if((ctrl->flags & V4L2_CTRL_FLAG_READ_ONLY)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_READ_ONLY.\n"); }
+        if((ctrl->flags & V4L2_CTRL_FLAG_UPDATE)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_UPDATE.\n"); }
+        if((ctrl->flags & V4L2_CTRL_FLAG_INACTIVE)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_INACTIVE.\n"); }
+        if((ctrl->flags & V4L2_CTRL_FLAG_SLIDER)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_SLIDER.\n"); }
+        if((ctrl->flags & V4L2_CTRL_FLAG_WRITE_ONLY)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_WRITE_ONLY.\n"); }
+        if((ctrl->flags & V4L2_CTRL_FLAG_VOLATILE)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_VOLATILE.\n"); }
+        if((ctrl->flags & V4L2_CTRL_FLAG_HAS_PAYLOAD)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_HAS_PAYLOAD.\n"); }
+        if((ctrl->flags & V4L2_CTRL_FLAG_EXECUTE_ON_WRITE)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_EXECUTE_ON_WRITE.\n"); }
+    }
+    //query control's menu
+    if ((ctrl->flags & V4L2_CTRL_FLAG_DISABLED) == 0 && ctrl->type == V4L2_CTRL_TYPE_MENU){
+        int i2; for(i2 = ctrl->minimum; i2 <= ctrl->maximum; i2++){
+            struct v4l2_querymenu mnu;
+            memset(&mnu, 0, sizeof(mnu));
+            //
+            mnu.id = ctrl->id;
+            mnu.index = i2;
+            //
+            int rr3 = v4l2_ioctl(fd, VIDIOC_QUERYMENU, &mnu);
+            if(rr3 == 0){
+                if(print){
+                    if(ctrl->type == V4L2_CTRL_TYPE_INTEGER){
+                        K_LOG_INFO("    Menu #%d: '%s' = %lld.\n", (i2 + 1), mnu.name, mnu.value);
+                    } else {
+                        K_LOG_INFO("    Menu #%d: '%s'.\n", (i2 + 1), mnu.name);
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+SOCKET netSocketConnectStart(const STNetAddr* hostAddr, const unsigned int port, const char* dbgServer, const char* dbgPath){
+    //connect
+    struct sockaddr_storage remoteAddr;
+    socklen_t remoteAddrSz = 0;
+    memset(&remoteAddr, 0, sizeof(remoteAddr));
+    if(hostAddr->family == AF_INET6){
+        struct sockaddr_in6* addr6 = (struct sockaddr_in6*)&remoteAddr;
+        addr6->sin6_family   = AF_INET6;
+        addr6->sin6_port     = (u_short)htons((u_short)port);
+        addr6->sin6_addr     = hostAddr->addr.v6;
+        remoteAddrSz = sizeof(*addr6);
+    } else {
+        struct sockaddr_in* addr4 = (struct sockaddr_in*)&remoteAddr;
+        addr4->sin_family    = AF_INET;
+        addr4->sin_port      = (u_short)htons((u_short)port);
+        addr4->sin_addr      = hostAddr->addr.v4;
+        remoteAddrSz = sizeof(*addr4);
+    }
+    //Create hnd (if necesary)
+    SOCKET sckt = socket(hostAddr->family, SOCK_STREAM, IPPROTO_TCP);
+    if(!sckt || sckt == INVALID_SOCKET){
+        K_LOG_ERROR("netSocketConnectStart, net, socket creation failed: '%s'.\n", dbgPath);
+    }
+    //config
+#   ifdef SO_NOSIGPIPE
+    if(sckt && sckt != INVALID_SOCKET){
+        int v = 1; //(noSIGPIPE ? 1 : 0);
+        if(setsockopt(sckt, SOL_SOCKET, SO_NOSIGPIPE, (const char*)&v, sizeof(v)) < 0){
+            K_LOG_ERROR("netSocketConnectStart, net, socket SO_NOSIGPIPE option failed: '%s'.\n", dbgPath);
+            close(sckt);
+            sckt = 0;
+        }
+    }
+#   endif
+    //non-block
+    if(sckt && sckt != INVALID_SOCKET){
+        int flags, nonBlocking = 1;
+        if ((flags = fcntl(sckt, F_GETFL, 0)) == -1){
+            K_LOG_ERROR("netSocketConnectStart, net, F_GETFL failed: '%s'.\n", dbgPath);
+            close(sckt);
+            sckt = 0;
+        } else {
+#           ifdef O_NONBLOCK
+            if(nonBlocking) flags |= O_NONBLOCK;
+            else flags &= ~O_NONBLOCK;
+#           endif
+#           ifdef O_NDELAY
+            if(nonBlocking) flags |= O_NDELAY;
+            else flags &= ~O_NDELAY;
+#           endif
+#           ifdef FNDELAY
+            if(nonBlocking) flags |= FNDELAY;
+            else flags &= ~FNDELAY;
+#           endif
+            if(fcntl(sckt, F_SETFL, flags) == -1){
+                K_LOG_ERROR("netSocketConnectStart, net, F_SETFL O_NONBLOCK option failed: '%s'.\n", dbgPath);
+                close(sckt);
+                sckt = 0;
+            }
+        }
+    }
+    //connect
+    if(sckt && sckt != INVALID_SOCKET){
+        //Connect (unlocked)
+        {
+            const int nret = connect(sckt, (struct sockaddr*)&remoteAddr, remoteAddrSz);
+            if (nret != 0){
+                //EINPROGRESS: first call; EALREADY: subsequent calls
+                if(!(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINPROGRESS)){
+                    K_LOG_ERROR("netSocketConnectStart, connect-start-failed to '%s:%d': '%s'.\n", dbgServer, port, dbgPath);
+                    close(sckt);
+                    sckt = 0;
+                } else {
+                    K_LOG_VERBOSE("netSocketConnectStart, net, connect-started to '%s:%d': '%s'.\n", dbgServer, port, dbgPath);
+                }
+            }
+        }
+    }
+    return (sckt == INVALID_SOCKET ? 0 : sckt);
+}
+
+SOCKET netSocketUdpBind(const STNetAddr* hostAddr, const unsigned int port, const char* dbgServer, const char* dbgPath){
+    const int isMulticast = (hostAddr->family == AF_INET6 ? IN6_IS_ADDR_MULTICAST(&hostAddr->addr.v6) : IN_MULTICAST(ntohl(hostAddr->addr.v4.s_addr)));
+    SOCKET sckt = socket(hostAddr->family, SOCK_DGRAM, IPPROTO_UDP);
+    if(!sckt || sckt == INVALID_SOCKET){
+        K_LOG_ERROR("netSocketUdpBind, net, socket creation failed: '%s'.\n", dbgPath);
+        sckt = 0;
+    }
+    //config (other streams or processes can listen the same group:port)
+    if(sckt){
+        int v = 1;
+        if(setsockopt(sckt, SOL_SOCKET, SO_REUSEADDR, (const char*)&v, sizeof(v)) < 0){
+            K_LOG_ERROR("netSocketUdpBind, net, socket SO_REUSEADDR option failed: '%s'.\n", dbgPath);
+            close(sckt);
+            sckt = 0;
+        }
+    }
+    //non-block
+    if(sckt){
+        const int flags = fcntl(sckt, F_GETFL, 0);
+        if(flags == -1 || fcntl(sckt, F_SETFL, flags | O_NONBLOCK) == -1){
+            K_LOG_ERROR("netSocketUdpBind, net, O_NONBLOCK option failed: '%s'.\n", dbgPath);
+            close(sckt);
+            sckt = 0;
+        }
+    }
+    //bind (to the group address if multicast, to filter other groups at the same port)
+    if(sckt){
+        struct sockaddr_storage addr;
+        socklen_t addrSz = 0;
+        memset(&addr, 0, sizeof(addr));
+        if(hostAddr->family == AF_INET6){
+            struct sockaddr_in6* addr6 = (struct sockaddr_in6*)&addr;
+            addr6->sin6_family      = AF_INET6;
+            addr6->sin6_port        = (u_short)htons((u_short)port);
+            addr6->sin6_addr        = (isMulticast ? hostAddr->addr.v6 : in6addr_any);
+            addrSz = sizeof(*addr6);
+        } else {
+            struct sockaddr_in* addr4 = (struct sockaddr_in*)&addr;
+            addr4->sin_family       = AF_INET;
+            addr4->sin_port         = (u_short)htons((u_short)port);
+            addr4->sin_addr.s_addr  = (isMulticast ? hostAddr->addr.v4.s_addr : htonl(INADDR_ANY));
+            addrSz = sizeof(*addr4);
+        }
+        if(bind(sckt, (struct sockaddr*)&addr, addrSz) != 0){
+            K_LOG_ERROR("netSocketUdpBind, net, bind failed to '%s:%d': '%s'.\n", dbgServer, port, dbgPath);
+            close(sckt);
+            sckt = 0;
+        }
+    }
+    //join
+    if(sckt && isMulticast && hostAddr->family == AF_INET6){
+        struct ipv6_mreq mreq6;
+        memset(&mreq6, 0, sizeof(mreq6));
+        mreq6.ipv6mr_multiaddr      = hostAddr->addr.v6;
+        mreq6.ipv6mr_interface      = 0; //default
+        if(setsockopt(sckt, IPPROTO_IPV6, IPV6_JOIN_GROUP, (const char*)&mreq6, sizeof(mreq6)) != 0){
+            K_LOG_ERROR("netSocketUdpBind, net, IPV6_JOIN_GROUP failed to '%s:%d': '%s'.\n", dbgServer, port, dbgPath);
+            close(sckt);
+            sckt = 0;
+        }
+    } else if(sckt && isMulticast){
+        struct ip_mreq mreq;
+        memset(&mreq, 0, sizeof(mreq));
+        mreq.imr_multiaddr          = hostAddr->addr.v4;
+        mreq.imr_interface.s_addr   = htonl(INADDR_ANY);
+        if(setsockopt(sckt, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char*)&mreq, sizeof(mreq)) != 0){
+            K_LOG_ERROR("netSocketUdpBind, net, IP_ADD_MEMBERSHIP failed to '%s:%d': '%s'.\n", dbgServer, port, dbgPath);
+            close(sckt);
+            sckt = 0;
+        }
+    }
+    if(sckt){
+        K_LOG_VERBOSE("netSocketUdpBind, net, listening%s at '%s:%d': '%s'.\n", (isMulticast ? " multicast" : ""), dbgServer, port, dbgPath);
+    }
+    return sckt;
+}
+
+long msBetweenTimevals(struct timeval* base, struct timeval* next){
+    if(base != next){
+        if(next == NULL){
+            return (base->tv_sec * 1000ULL) + (base->tv_usec / 1000ULL);
+        } else if(base == NULL){
+            return -((next->tv_sec * 1000ULL) + (next->tv_usec / 1000ULL));
+        } else if(base->tv_sec < next->tv_sec || (base->tv_sec == next->tv_sec && base->tv_usec <= next->tv_usec)){
+            //ahead
+            if(base->tv_sec == next->tv_sec){
+                return (next->tv_usec - base->tv_usec) / 1000ULL;
+            } else {
+                return ((next->tv_sec - base->tv_sec - 1) * 1000ULL) + (((1000000ULL - base->tv_usec) + (next->tv_usec)) / 1000ULL);
+            }
+        } else {
+            //backwards
+            if(base->tv_sec == next->tv_sec){
+                return -((base->tv_usec - next->tv_usec) / 1000ULL);
+            } else {
+                return -(((base->tv_sec - next->tv_sec - 1) * 1000ULL) + (((1000000ULL - next->tv_usec) + (base->tv_usec)) / 1000ULL));
+            }
+        }
+    }
+    return 0;
+}
+
+long msBetweenTimespecs(struct timespec* base, struct timespec* next){
+    if(base != next){
+        if(next == NULL){
+            return (base->tv_sec * 1000ULL) + (base->tv_nsec / 1000000ULL);
+        } else if(base == NULL){
+            return -((next->tv_sec * 1000ULL) + (next->tv_nsec / 1000000ULL));
+        } else if(base->tv_sec < next->tv_sec || (base->tv_sec == next->tv_sec && base->tv_nsec <= next->tv_nsec)){
+            //ahead
+            if(base->tv_sec == next->tv_sec){
+                return (next->tv_nsec - base->tv_nsec) / 1000000ULL;
+            } else {
+                return ((next->tv_sec - base->tv_sec - 1) * 1000ULL) + (((1000000000ULL - base->tv_nsec) + (next->tv_nsec)) / 1000000ULL);
+            }
+        } else {
+            //backwards
+            if(base->tv_sec == next->tv_sec){
+                return -((base->tv_nsec - next->tv_nsec) / 1000000ULL);
+            } else {
+                return -(((base->tv_sec - next->tv_sec - 1) * 1000ULL) + (((1000000000ULL - next->tv_nsec) + (base->tv_nsec)) / 1000000ULL));
+            }
+        }
+    }
+    return 0;
+}
+
+//Annex-B start-codes scanning
+
+const unsigned char* nalScanNonZero(const unsigned char* b, const unsigned char* bAfterEnd){
+#   if defined(K_USE_SIMD_NAL_SCAN) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    const uint8x16_t zero = vdupq_n_u8(0);
+    while((bAfterEnd - b) >= 32){
+        const uint8x16_t eq = vorrq_u8(vceqq_u8(vld1q_u8(b), zero), vceqq_u8(vld1q_u8(b + 16), zero));
+        if(vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0) != 0){
+            break; //zero inside these 32 bytes
+        }
+        b += 32;
+    }
+    while((bAfterEnd - b) >= 16){
+        //4 bits per byte
+        const uint64_t m = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vceqq_u8(vld1q_u8(b), zero)), 4)), 0);
+        if(m != 0){
+            return b + (__builtin_ctzll(m) >> 2);
+        }
+        b += 16;
+    }
+#   elif defined(K_USE_SIMD_NAL_SCAN) && defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    while((bAfterEnd - b) >= 32){
+        const int m0 = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)b), zero));
+        const int m1 = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(b + 16)), zero));
+        if((m0 | m1) != 0){
+            return b + (m0 != 0 ? __builtin_ctz(m0) : (16 + __builtin_ctz(m1)));
+        }
+        b += 32;
+    }
+    while((bAfterEnd - b) >= 16){
+        const int m = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)b), zero));
+        if(m != 0){
+            return b + __builtin_ctz(m);
+        }
+        b += 16;
+    }
+#   endif
+    //tail (or no simd)
+    {
+        const unsigned char* z = (const unsigned char*)memchr(b, 0x00, (size_t)(bAfterEnd - b));
+        return (z != NULL ? z : bAfterEnd);
+    }
+}
+
+const unsigned char* nalScanStartCode(const unsigned char* b, const unsigned char* bAfterEnd, int* zeroesSeqAccum){
+    int zeroes = *zeroesSeqAccum;
+    while(b < bAfterEnd){
+        if(zeroes == 0){
+            //non-zero bytes cannot end a header
+            b = nalScanNonZero(b, bAfterEnd);
+            if(b >= bAfterEnd){
+                break;
+            }
+        }
+        if(*b == 0x00){
+            zeroes++;
+        } else if(*b == 0x01 && zeroes >= 3){
+            *zeroesSeqAccum = zeroes;
+            return b;
+        } else {
+            zeroes = 0;
+        }
+        b++;
+    }
+    *zeroesSeqAccum = zeroes;
+    return bAfterEnd;
+}
+
+int nalsAreLengthPrefixed(const unsigned char* b, const unsigned long long sz, const int lenSz){
+    unsigned long long pos = 0;
+    int count = 0;
+    //Annex-B start code
+    if(sz >= 4 && b[0] == 0x00 && b[1] == 0x00 && (b[2] == 0x01 || (b[2] == 0x00 && b[3] == 0x01))){
+        return 0;
+    }
+    while(count < 8 && (pos + lenSz) < sz){
+        unsigned long long nalSz = 0;
+        int i; for(i = 0; i < lenSz; i++){
+            nalSz = (nalSz << 8) | b[pos + i];
+        }
+        if(nalSz == 0 || nalSz > (sz - pos - lenSz) || (b[pos + lenSz] & 0x80) != 0 /*forbidden_zero_bit*/){
+            return 0;
+        }
+        pos += lenSz + nalSz;
+        count++;
+    }
+    return (count > 0 ? 1 : 0);
+}
+
+//Scans the captured stream in recv-like reads with the per-byte loop (reference) and with the scanner; both must find the same headers.
+int nalScanBenchmark(const char* path){
+    int r = -1;
+    unsigned char* data = NULL;
+    long dataSz = 0;
+#   if defined(K_USE_SIMD_NAL_SCAN) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    const char* scannerName = "neon";
+#   elif defined(K_USE_SIMD_NAL_SCAN) && defined(__SSE2__)
+    const char* scannerName = "sse2";
+#   else
+    const char* scannerName = "memchr";
+#   endif
+    //load
+    {
+        FILE* f = fopen(path, "rb");
+        if(f == NULL){
+            K_LOG_ERROR("nalScanBenchmark, could not open: '%s'.\n", path);
+        } else {
+            if(fseek(f, 0, SEEK_END) == 0 && (dataSz = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0){
+                data = (unsigned char*)malloc(dataSz);
+                if(data != NULL && fread(data, 1, dataSz, f) != (size_t)dataSz){
+                    free(data);
+                    data = NULL;
+                }
+            }
+            fclose(f);
+            if(data == NULL){
+                K_LOG_ERROR("nalScanBenchmark, could not load: '%s'.\n", path);
+            }
         }
+    }
+    //scan
+    if(data != NULL){
+        const int readsSzs[] = { 1460, (64 * 1024) }; //a tcp segment (headers split often), a full ingest buffer
+        const int rounds = (int)((256L * 1024L * 1024L) / dataSz) + 1; //~256MB per method
+        int iSz;
         r = 0;
+        for(iSz = 0; iSz < (int)(sizeof(readsSzs) / sizeof(readsSzs[0])); iSz++){
+            unsigned long found[2] = { 0, 0 }, posSum[2] = { 0, 0 };
+            long ms[2] = { 0, 0 };
+            int m; for(m = 0; m < 2; m++){
+                struct timespec start, end;
+                int round, zeroes = 0;
+                clock_gettime(CLOCK_MONOTONIC, &start);
+                for(round = 0; round < rounds; round++){
+                    long pos = 0;
+                    while(pos < dataSz){
+                        const unsigned char* b = &data[pos];
+                        const unsigned char* bAfterEnd = &data[(dataSz - pos) < readsSzs[iSz] ? dataSz : (pos + readsSzs[iSz])];
+                        if(m == 0){
+                            //per-byte (reference)
+                            while(b < bAfterEnd){
+                                if(*b == 0x00){
+                                    zeroes++;
+                                } else {
+                                    if(*b == 0x01 && zeroes >= 3){
+                                        found[m]++;
+                                        posSum[m] += (unsigned long)(b - data);
+                                    }
+                                    zeroes = 0;
+                                }
+                                b++;
+                            }
+                        } else {
+                            //scanner
+                            while(b < bAfterEnd){
+                                b = nalScanStartCode(b, bAfterEnd, &zeroes);
+                                if(b < bAfterEnd){
+                                    found[m]++;
+                                    posSum[m] += (unsigned long)(b - data);
+                                    zeroes = 0;
+                                    b++;
+                                }
+                            }
+                        }
+                        pos = (long)(bAfterEnd - data);
+                    }
+                }
+                clock_gettime(CLOCK_MONOTONIC, &end);
+                ms[m] = msBetweenTimespecs(&start, &end);
+            }
+            K_LOG_INFO("nalScanBenchmark, %d-bytes reads, %d x %ldKB: per-byte %ldms (%ld MB/s), %s %ldms (%ld MB/s), %lu headers%s.\n"
+                       , readsSzs[iSz], rounds, (dataSz / 1024)
+                       , ms[0], (long)(((long long)dataSz * rounds / (1024 * 1024)) * 1000 / (ms[0] <= 0 ? 1 : ms[0]))
+                       , scannerName, ms[1], (long)(((long long)dataSz * rounds / (1024 * 1024)) * 1000 / (ms[1] <= 0 ? 1 : ms[1]))
+                       , (found[0] / rounds), (found[0] == found[1] && posSum[0] == posSum[1] ? "" : ", MISMATCH")
+                       );
+            if(found[0] != found[1] || posSum[0] != posSum[1]){
+                r = -1;
+            }
+        }
+        free(data);
+        data = NULL;
     }
     return r;
 }
 
-int v4lDevice_queryControls(int fd, const int print){
-    int controlsTotal = 0;
-    int rr2 = 0;
+int framesQueueBenchmark(const int backlog){
+    int r = -1;
+    STVideoFrame* frames = (backlog > 0 ? (STVideoFrame*)malloc(sizeof(STVideoFrame) * backlog) : NULL);
+    if(frames == NULL){
+        K_LOG_ERROR("framesQueueBenchmark, backlog of %d frames could not be allocated.\n", backlog);
+    } else {
+        const int rounds = (int)((1024L * 1024L) / backlog) + 1; //~1M frames per method
+        const long long opsCount = (long long)rounds * backlog * 2; //pushes and pulls
+        unsigned long long sum[2][2] = { { 0, 0 }, { 0, 0 } }; //[frames, states][array, ring]
+        long ms[2][2] = { { 0, 0 }, { 0, 0 } };
+        int m;
+        memset(frames, 0, sizeof(STVideoFrame) * backlog);
+        for(m = 0; m < 2; m++){
+            struct timespec start, end;
+            int round, i;
+            //frames (filled queue: pushed at the right, pulled from the left)
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            if(m == 0){
+                //shifting array, incremented by one (reference)
+                STVideoFrame** arr = NULL; int sz = 0, use = 0;
+                for(round = 0; round < rounds; round++){
+                    for(i = 0; i < backlog; i++){
+                        while(sz <= use){
+                            STVideoFrame** arrN = malloc(sizeof(STVideoFrame*) * (sz + 1));
+                            if(arr != NULL){
+                                if(use > 0){
+                                    memcpy(arrN, arr, sizeof(STVideoFrame*) * use);
+                                }
+                                free(arr);
+                            }
+                            arr = arrN;
+                            sz++;
+                        }
+                        arr[use++] = &frames[i];
+                    }
+                    for(i = 0; i < backlog; i++){
+                        STVideoFrame* f = arr[0];
+                        int j; use--;
+                        for(j = 0; j < use; j++){
+                            arr[j] = arr[j + 1];
+                        }
+                        sum[0][m] += (unsigned long long)(f - frames) * (i + 1);
+                    }
+                }
+                if(arr != NULL){
+                    free(arr);
+                    arr = NULL;
+                }
+            } else {
+                //ring
+                STVideoFrames q;
+                VideoFrames_init(&q);
+                for(round = 0; round < rounds; round++){
+                    for(i = 0; i < backlog; i++){
+                        VideoFrames_pushFrameOwning(&q, &frames[i]);
+                    }
+                    for(i = 0; i < backlog; i++){
+                        STVideoFrame* f = NULL;
+                        if(0 == VideoFrames_pullFrameForRead(&q, &f)){
+                            sum[0][m] += (unsigned long long)(f - frames) * (i + 1);
+                        }
+                    }
+                }
+                VideoFrames_release(&q);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            ms[0][m] = msBetweenTimespecs(&start, &end);
+            //fed-states (added as newest, removed up to the decoded one)
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            if(m == 0){
+                //array with newest at the left, incremented by one (reference)
+                STVideoFrameState* arr = NULL; int sz = 0, use = 0;
+                for(round = 0; round < rounds; round++){
+                    for(i = 0; i < backlog; i++){
+                        STVideoFrameState st;
+                        int j;
+                        VideoFrameState_init(&st);
+                        st.iSeq = ((unsigned long)round * backlog) + i;
+                        while(sz <= use){
+                            STVideoFrameState* arrN = malloc(sizeof(STVideoFrameState) * (sz + 1));
+                            if(arr != NULL){
+                                if(use > 0){
+                                    memcpy(arrN, arr, sizeof(STVideoFrameState) * use);
+                                }
+                                free(arr);
+                            }
+                            arr = arrN;
+                            sz++;
+                        }
+                        for(j = use; j > 0; j--){
+                            arr[j] = arr[j - 1];
+                        }
+                        use++;
+                        VideoFrameState_init(&arr[0]);
+                        VideoFrameState_clone(&arr[0], &st);
+                        VideoFrameState_release(&st);
+                    }
+                    for(i = 0; i < backlog; i++){
+                        const unsigned long iSeq = ((unsigned long)round * backlog) + i;
+                        while(use > 0 && arr[use - 1].iSeq <= iSeq){
+                            if(arr[use - 1].iSeq == iSeq){
+                                sum[1][m] += (unsigned long long)arr[use - 1].iSeq * (i + 1);
+                            }
+                            VideoFrameState_release(&arr[use - 1]);
+                            use--;
+                        }
+                    }
+                }
+                if(arr != NULL){
+                    free(arr);
+                    arr = NULL;
+                }
+            } else {
+                //ring
+                STVideoFrameStates q;
+                VideoFrameStates_init(&q);
+                for(round = 0; round < rounds; round++){
+                    for(i = 0; i < backlog; i++){
+                        STVideoFrameState st;
+                        VideoFrameState_init(&st);
+                        st.iSeq = ((unsigned long)round * backlog) + i;
+                        VideoFrameStates_addNewestCloning(&q, &st);
+                        VideoFrameState_release(&st);
+                    }
+                    for(i = 0; i < backlog; i++){
+                        STVideoFrameState st;
+                        VideoFrameState_init(&st);
+                        st.iSeq = 0;
+                        VideoFrameStates_getStateCloningAndRemoveOlder(&q, ((unsigned long)round * backlog) + i, &st, NULL);
+                        sum[1][m] += (unsigned long long)st.iSeq * (i + 1);
+                        VideoFrameState_release(&st);
+                    }
+                }
+                VideoFrameStates_empty(&q);
+                VideoFrameStates_release(&q);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            ms[1][m] = msBetweenTimespecs(&start, &end);
+        }
+        K_LOG_INFO("framesQueueBenchmark, %d-frames backlog x %d rounds: frames shifting-array %ldms (%lld ns/op), ring %ldms (%lld ns/op); fed-states shifting-array %ldms (%lld ns/op), ring %ldms (%lld ns/op)%s.\n"
+                   , backlog, rounds
+                   , ms[0][0], ((long long)ms[0][0] * 1000000LL / opsCount), ms[0][1], ((long long)ms[0][1] * 1000000LL / opsCount)
+                   , ms[1][0], ((long long)ms[1][0] * 1000000LL / opsCount), ms[1][1], ((long long)ms[1][1] * 1000000LL / opsCount)
+                   , (sum[0][0] == sum[0][1] && sum[1][0] == sum[1][1] ? "" : ", MISMATCH")
+                   );
+        r = (sum[0][0] == sum[0][1] && sum[1][0] == sum[1][1] ? 0 : -1);
+        free(frames);
+        frames = NULL;
+    }
+    return r;
+}
+
+
+
+/*
+//ENPlayerPollFdType
+
+typedef enum ENPlayerPollFdType_ {
+    ENPlayerPollFdType_Decoder = 0, //dec (decoder).fd
+    ENPlayerPollFdType_SrcSocket,   //net.socket
     //
-    //VIDIOC_QUERYCTRL vs VIDIOC_G_CTRL ?
-    {
-        //standard controls
-        unsigned int cid = V4L2_CID_BASE;
-        int reqsCountBase = 0, reqsCountPriv = 0;
-        struct v4l2_queryctrl ctrl;
-        memset(&ctrl, 0, sizeof(ctrl));
-        for(cid = V4L2_CID_BASE; cid < V4L2_CID_LASTP1; cid++){
-            ctrl.id = cid;
-            rr2 = v4l2_ioctl(fd, VIDIOC_QUERYCTRL, &ctrl);
-            if(rr2 == 0){
-                v4lDevice_controlAnalyze(fd, &ctrl, print);
-                controlsTotal++;
-            }
-            reqsCountBase++;
+    ENPlayerPollFdType_Count
+} ENPlayerPollFdType;
+
+typedef void (*PlayerPollCallback)(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, int revents);
+*/
+
+//STBitsReader
+
+void BitsReader_init(STBitsReader* obj, const unsigned char* buff, const int sz){
+    memset(obj, 0, sizeof(*obj));
+    obj->buff       = buff;
+    obj->sz         = sz;
+    obj->bitsLeft   = 8;
+}
+
+unsigned int BitsReader_u(STBitsReader* obj, const int bits){ //u(n), 32 bits max
+    unsigned int r = 0;
+    int i; for(i = 0; i < bits; i++){
+        if(obj->pos >= obj->sz){
+            obj->isOverflow = 1;
+            break;
         }
-        //private controls
-        {
-            unsigned int cid = V4L2_CID_PRIVATE_BASE;
-            rr2 = 0;
-            while(rr2 == 0){
-                ctrl.id = cid;
-                rr2 = v4l2_ioctl(fd, VIDIOC_QUERYCTRL, &ctrl);
-                if(rr2 == 0){
-                    v4lDevice_controlAnalyze(fd, &ctrl, print);
-                    controlsTotal++;
-                }
-                //next
-                cid++;
-                reqsCountPriv++;
+        r = (r << 1) | ((obj->buff[obj->pos] >> (obj->bitsLeft - 1)) & 0x1);
+        obj->bitsLeft--;
+        //next byte
+        if(obj->bitsLeft == 0){
+            obj->zeroes = (obj->buff[obj->pos] == 0x00 ? obj->zeroes + 1 : 0);
+            obj->bitsLeft = 8;
+            obj->pos++;
+            //emulation-prevention byte
+            if(obj->zeroes >= 2 && obj->pos < obj->sz && obj->buff[obj->pos] == 0x03){
+                obj->zeroes = 0;
+                obj->pos++;
             }
         }
-        if(print){
-            K_LOG_INFO("%d controls queried (%d standard, %d private requested).\n", controlsTotal, reqsCountBase, reqsCountPriv);
+    }
+    return r;
+}
+
+unsigned int BitsReader_ue(STBitsReader* obj){ //ue(v), exp-Golomb
+    int leadingZeroes = 0;
+    while(BitsReader_u(obj, 1) == 0 && !obj->isOverflow){
+        if(++leadingZeroes > 31){
+            obj->isOverflow = 1; //not valid
+            return 0;
+        }
+    }
+    if(obj->isOverflow){
+        return 0;
+    }
+    return (unsigned int)((1ULL << leadingZeroes) - 1) + BitsReader_u(obj, leadingZeroes);
+}
+
+int BitsReader_se(STBitsReader* obj){ //se(v), signed exp-Golomb
+    const unsigned int k = BitsReader_ue(obj);
+    return ((k & 0x1) ? (int)((k + 1) / 2) : -(int)(k / 2));
+}
+
+//STH264Sps
+//7.3.2.1.1 Sequence parameter set data syntax, E.1.1 VUI parameters syntax.
+
+void H264Sps_skipScalingList_(STBitsReader* br, const int sizeOfScalingList){
+    int lastScale = 8, nextScale = 8;
+    int j; for(j = 0; j < sizeOfScalingList && !br->isOverflow; j++){
+        if(nextScale != 0){
+            const int delta_scale = BitsReader_se(br);
+            nextScale = (lastScale + delta_scale + 256) % 256;
         }
+        lastScale = (nextScale == 0 ? lastScale : nextScale);
     }
+}
+
+void H264Sps_skipHrd_(STBitsReader* br){
+    const unsigned int cpb_cnt_minus1 = BitsReader_ue(br);
+    BitsReader_u(br, 4); //bit_rate_scale
+    BitsReader_u(br, 4); //cpb_size_scale
     {
-        //standard controls
-        unsigned int cid = V4L2_CID_BASE;
-        struct v4l2_control ctrl;
-        memset(&ctrl, 0, sizeof(ctrl));
-        for(cid = V4L2_CID_BASE; cid < V4L2_CID_LASTP1; cid++){
-            ctrl.id = cid;
-            rr2 = v4l2_ioctl(fd, VIDIOC_G_CTRL, &ctrl);
-            if(rr2 == 0){
-                K_LOG_VERBOSE("Control %d value: %d.\n", cid, ctrl.value);
-                controlsTotal++;
-            }
+        unsigned int i; for(i = 0; i <= cpb_cnt_minus1 && i < 32 && !br->isOverflow; i++){
+            BitsReader_ue(br); //bit_rate_value_minus1
+            BitsReader_ue(br); //cpb_size_value_minus1
+            BitsReader_u(br, 1); //cbr_flag
         }
-        //private controls
-        /*{
-            rr2 = 0; ctrl.id = V4L2_CID_PRIVATE_BASE;
-            while(rr2 == 0){
-                rr2 = v4l2_ioctl(fd, VIDIOC_G_CTRL, &ctrl);
-                if(rr2 == 0){
-                    K_LOG_INFO("Control %d value: %d.\n", ctrl.id, ctrl.value);
-                    controlsTotal++;
+    }
+    BitsReader_u(br, 20); //initial_cpb_removal_delay_length_minus1, cpb_removal_delay_length_minus1, dpb_output_delay_length_minus1, time_offset_length
+}
+
+int H264Sps_parse(STH264Sps* obj, const unsigned char* nal, const int nalSz){
+    int r = -1;
+    if(obj != NULL && nal != NULL && nalSz > 4 && (nal[0] & 0x1F) == 7 /*Sequence parameter set*/){
+        STBitsReader br;
+        STH264Sps sps;
+        int separate_colour_plane_flag = 0;
+        unsigned int pic_width_in_mbs_minus1 = 0, pic_height_in_map_units_minus1 = 0;
+        unsigned int crop_left = 0, crop_right = 0, crop_top = 0, crop_bottom = 0;
+        memset(&sps, 0, sizeof(sps));
+        sps.chroma_format_idc = 1;
+        sps.bit_depth_luma = 8;
+        sps.max_num_reorder_frames = -1;
+        sps.max_dec_frame_buffering = -1;
+        BitsReader_init(&br, &nal[1], (nalSz - 1));
+        sps.profile_idc         = BitsReader_u(&br, 8);
+        sps.constraint_flags    = BitsReader_u(&br, 8);
+        sps.level_idc           = BitsReader_u(&br, 8);
+        sps.seq_parameter_set_id = BitsReader_ue(&br);
+        if(sps.profile_idc == 100 || sps.profile_idc == 110 || sps.profile_idc == 122 || sps.profile_idc == 244 || sps.profile_idc == 44 || sps.profile_idc == 83 || sps.profile_idc == 86 || sps.profile_idc == 118 || sps.profile_idc == 128 || sps.profile_idc == 138 || sps.profile_idc == 139 || sps.profile_idc == 134 || sps.profile_idc == 135){
+            sps.chroma_format_idc = BitsReader_ue(&br);
+            if(sps.chroma_format_idc == 3){
+                separate_colour_plane_flag = sps.separate_colour_plane_flag = BitsReader_u(&br, 1);
+            }
+            sps.bit_depth_luma = 8 + BitsReader_ue(&br); //bit_depth_luma_minus8
+            BitsReader_ue(&br); //bit_depth_chroma_minus8
+            BitsReader_u(&br, 1); //qpprime_y_zero_transform_bypass_flag
+            if(BitsReader_u(&br, 1)){ //seq_scaling_matrix_present_flag
+                const int listsCount = (sps.chroma_format_idc != 3 ? 8 : 12);
+                int i; for(i = 0; i < listsCount && !br.isOverflow; i++){
+                    if(BitsReader_u(&br, 1)){ //seq_scaling_list_present_flag[i]
+                        H264Sps_skipScalingList_(&br, (i < 6 ? 16 : 64));
+                    }
+                }
+            }
+        }
+        sps.log2_max_frame_num = 4 + BitsReader_ue(&br); //log2_max_frame_num_minus4
+        {
+            const unsigned int pic_order_cnt_type = BitsReader_ue(&br);
+            sps.pic_order_cnt_type = (int)pic_order_cnt_type;
+            if(pic_order_cnt_type == 0){
+                sps.log2_max_pic_order_cnt_lsb = 4 + BitsReader_ue(&br); //log2_max_pic_order_cnt_lsb_minus4
+            } else if(pic_order_cnt_type == 1){
+                unsigned int i, num_ref_frames_in_pic_order_cnt_cycle;
+                sps.delta_pic_order_always_zero_flag = BitsReader_u(&br, 1);
+                BitsReader_se(&br); //offset_for_non_ref_pic
+                BitsReader_se(&br); //offset_for_top_to_bottom_field
+                num_ref_frames_in_pic_order_cnt_cycle = BitsReader_ue(&br);
+                for(i = 0; i < num_ref_frames_in_pic_order_cnt_cycle && i < 256 && !br.isOverflow; i++){
+                    BitsReader_se(&br); //offset_for_ref_frame[i]
+                }
+            }
+        }
+        sps.max_num_ref_frames = BitsReader_ue(&br);
+        BitsReader_u(&br, 1); //gaps_in_frame_num_value_allowed_flag
+        pic_width_in_mbs_minus1 = BitsReader_ue(&br);
+        pic_height_in_map_units_minus1 = BitsReader_ue(&br);
+        sps.frame_mbs_only_flag = BitsReader_u(&br, 1);
+        if(!sps.frame_mbs_only_flag){
+            BitsReader_u(&br, 1); //mb_adaptive_frame_field_flag
+        }
+        BitsReader_u(&br, 1); //direct_8x8_inference_flag
+        if(BitsReader_u(&br, 1)){ //frame_cropping_flag
+            crop_left   = BitsReader_ue(&br);
+            crop_right  = BitsReader_ue(&br);
+            crop_top    = BitsReader_ue(&br);
+            crop_bottom = BitsReader_ue(&br);
+        }
+        //geometry
+        if(!br.isOverflow && pic_width_in_mbs_minus1 < 1024 && pic_height_in_map_units_minus1 < 1024 && sps.seq_parameter_set_id < K_H264_SPS_MAX && sps.log2_max_frame_num <= 16 && sps.pic_order_cnt_type <= 2 && sps.log2_max_pic_order_cnt_lsb <= 16){
+            const int chromaArrayType = (separate_colour_plane_flag ? 0 : sps.chroma_format_idc);
+            const int cropUnitX = (chromaArrayType == 0 ? 1 : (sps.chroma_format_idc == 3 ? 1 : 2)); //SubWidthC
+            const int cropUnitY = (chromaArrayType == 0 ? 1 : (sps.chroma_format_idc == 1 ? 2 : 1)) * (2 - sps.frame_mbs_only_flag); //SubHeightC
+            sps.width   = (int)(pic_width_in_mbs_minus1 + 1) * 16;
+            sps.height  = (int)(pic_height_in_map_units_minus1 + 1) * 16 * (2 - sps.frame_mbs_only_flag);
+            if(crop_left < 4096 && crop_right < 4096 && crop_top < 4096 && crop_bottom < 4096){
+                sps.crop.x      = (int)crop_left * cropUnitX;
+                sps.crop.y      = (int)crop_top * cropUnitY;
+                sps.crop.width  = sps.width - (int)(crop_left + crop_right) * cropUnitX;
+                sps.crop.height = sps.height - (int)(crop_top + crop_bottom) * cropUnitY;
+            }
+            if(sps.crop.width > 0 && sps.crop.height > 0){
+                //vui (buffering hints, optional)
+                if(BitsReader_u(&br, 1)){ //vui_parameters_present_flag
+                    int nal_hrd_parameters_present_flag = 0, vcl_hrd_parameters_present_flag = 0;
+                    if(BitsReader_u(&br, 1)){ //aspect_ratio_info_present_flag
+                        if(BitsReader_u(&br, 8) == 255){ //aspect_ratio_idc == Extended_SAR
+                            BitsReader_u(&br, 32); //sar_width, sar_height
+                        }
+                    }
+                    if(BitsReader_u(&br, 1)){ //overscan_info_present_flag
+                        BitsReader_u(&br, 1); //overscan_appropriate_flag
+                    }
+                    if(BitsReader_u(&br, 1)){ //video_signal_type_present_flag
+                        BitsReader_u(&br, 4); //video_format, video_full_range_flag
+                        if(BitsReader_u(&br, 1)){ //colour_description_present_flag
+                            BitsReader_u(&br, 24); //colour_primaries, transfer_characteristics, matrix_coefficients
+                        }
+                    }
+                    if(BitsReader_u(&br, 1)){ //chroma_loc_info_present_flag
+                        BitsReader_ue(&br); //chroma_sample_loc_type_top_field
+                        BitsReader_ue(&br); //chroma_sample_loc_type_bottom_field
+                    }
+                    if(BitsReader_u(&br, 1)){ //timing_info_present_flag
+                        const unsigned int num_units_in_tick = BitsReader_u(&br, 32);
+                        const unsigned int time_scale = BitsReader_u(&br, 32);
+                        BitsReader_u(&br, 1); //fixed_frame_rate_flag
+                        if(!br.isOverflow && num_units_in_tick > 0 && time_scale > 0){
+                            sps.num_units_in_tick = num_units_in_tick;
+                            sps.time_scale = time_scale;
+                        }
+                    }
+                    if((nal_hrd_parameters_present_flag = BitsReader_u(&br, 1))){
+                        H264Sps_skipHrd_(&br);
+                    }
+                    if((vcl_hrd_parameters_present_flag = BitsReader_u(&br, 1))){
+                        H264Sps_skipHrd_(&br);
+                    }
+                    if(nal_hrd_parameters_present_flag || vcl_hrd_parameters_present_flag){
+                        BitsReader_u(&br, 1); //low_delay_hrd_flag
+                    }
+                    BitsReader_u(&br, 1); //pic_struct_present_flag
+                    if(BitsReader_u(&br, 1)){ //bitstream_restriction_flag
+                        int max_num_reorder_frames, max_dec_frame_buffering;
+                        BitsReader_u(&br, 1); //motion_vectors_over_pic_boundaries_flag
+                        BitsReader_ue(&br); //max_bytes_per_pic_denom
+                        BitsReader_ue(&br); //max_bits_per_mb_denom
+                        BitsReader_ue(&br); //log2_max_mv_length_horizontal
+                        BitsReader_ue(&br); //log2_max_mv_length_vertical
+                        max_num_reorder_frames = (int)BitsReader_ue(&br);
+                        max_dec_frame_buffering = (int)BitsReader_ue(&br);
+                        if(!br.isOverflow && max_num_reorder_frames <= 16 && max_dec_frame_buffering <= 16){
+                            sps.max_num_reorder_frames = max_num_reorder_frames;
+                            sps.max_dec_frame_buffering = max_dec_frame_buffering;
+                        }
+                    }
                 }
-                //next
-                ctrl.id++;
+                *obj = sps;
+                r = 0;
             }
-        }*/
-        if(print){
-            K_LOG_INFO("%d controls goten.\n", controlsTotal);
         }
     }
-    return 0;
+    return r;
 }
 
-int v4lDevice_controlAnalyze(int fd, struct v4l2_queryctrl* ctrl, const int print){
-    if(print){
-        K_LOG_INFO("Control: '%s' (%d, +%d, %d).\n", ctrl->name, ctrl->minimum, ctrl->step, ctrl->maximum);
-        //type
-        switch(ctrl->type){
-            case V4L2_CTRL_TYPE_INTEGER: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_INTEGER.\n"); break;
-            case V4L2_CTRL_TYPE_BOOLEAN: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_BOOLEAN.\n"); break;
-            case V4L2_CTRL_TYPE_MENU: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_MENU.\n"); break;
-            case V4L2_CTRL_TYPE_INTEGER_MENU: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_INTEGER_MENU.\n"); break;
-            case V4L2_CTRL_TYPE_BITMASK: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_BITMASK.\n"); break;
-            case V4L2_CTRL_TYPE_BUTTON: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_BUTTON.\n"); break;
-            case V4L2_CTRL_TYPE_INTEGER64: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_INTEGER64.\n"); break;
-            case V4L2_CTRL_TYPE_STRING: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_STRING.\n"); break;
-            case V4L2_CTRL_TYPE_CTRL_CLASS: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_CTRL_CLASS.\n"); break;
-            case V4L2_CTRL_TYPE_U8: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_U8.\n"); break;
-            case V4L2_CTRL_TYPE_U16: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_U16.\n"); break;
-            case V4L2_CTRL_TYPE_U32: K_LOG_INFO("    Type: V4L2_CTRL_TYPE_U32.\n"); break;
-            default: K_LOG_INFO("    Type: unknown.\n"); break;
+//STH264Pps
+//7.3.2.2 Picture parameter set RBSP syntax (only the fields before the slice groups).
+
+int H264Pps_parse(STH264Pps* obj, const unsigned char* nal, const int nalSz){
+    int r = -1;
+    if(obj != NULL && nal != NULL && nalSz > 1 && (nal[0] & 0x1F) == 8 /*Picture parameter set*/){
+        STBitsReader br;
+        STH264Pps pps;
+        memset(&pps, 0, sizeof(pps));
+        BitsReader_init(&br, &nal[1], (nalSz - 1));
+        pps.pic_parameter_set_id = BitsReader_ue(&br);
+        pps.seq_parameter_set_id = BitsReader_ue(&br);
+        BitsReader_u(&br, 1); //entropy_coding_mode_flag
+        pps.bottom_field_pic_order_in_frame_present_flag = BitsReader_u(&br, 1);
+        if(!br.isOverflow && pps.pic_parameter_set_id < K_H264_PPS_MAX && pps.seq_parameter_set_id < K_H264_SPS_MAX){
+            pps.isSet = 1;
+            *obj = pps;
+            r = 0;
         }
-        //flags
-        if((ctrl->flags & V4L2_CTRL_FLAG_DISABLED)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_DISABLED.\n"); }
-        if((ctrl->flags & V4L2_CTRL_FLAG_GRABBED)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_GRABBED.\n"); }
-        if((ctrl->flags & V4L2_CTRL_FLAG_READ_ONLY)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_READ_ONLY.\n"); }
-        if((ctrl->flags & V4L2_CTRL_FLAG_UPDATE)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_UPDATE.\n"); }
-        if((ctrl->flags & V4L2_CTRL_FLAG_INACTIVE)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_INACTIVE.\n"); }
-        if((ctrl->flags & V4L2_CTRL_FLAG_SLIDER)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_SLIDER.\n"); }
-        if((ctrl->flags & V4L2_CTRL_FLAG_WRITE_ONLY)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_WRITE_ONLY.\n"); }
-        if((ctrl->flags & V4L2_CTRL_FLAG_VOLATILE)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_VOLATILE.\n"); }
-        if((ctrl->flags & V4L2_CTRL_FLAG_HAS_PAYLOAD)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_HAS_PAYLOAD.\n"); }
-        if((ctrl->flags & V4L2_CTRL_FLAG_EXECUTE_ON_WRITE)) { K_LOG_INFO("    Flag: V4L2_CTRL_FLAG_EXECUTE_ON_WRITE.\n"); }
     }
-    //query control's menu
-    if ((ctrl->flags & V4L2_CTRL_FLAG_DISABLED) == 0 && ctrl->type == V4L2_CTRL_TYPE_MENU){
-        int i2; for(i2 = ctrl->minimum; i2 <= ctrl->maximum; i2++){
-            struct v4l2_querymenu mnu;
-            memset(&mnu, 0, sizeof(mnu));
-            //
-            mnu.id = ctrl->id;
-            mnu.index = i2;
-            //
-            int rr3 = v4l2_ioctl(fd, VIDIOC_QUERYMENU, &mnu);
-            if(rr3 == 0){
-                if(print){
-                    if(ctrl->type == V4L2_CTRL_TYPE_INTEGER){
-                        K_LOG_INFO("    Menu #%d: '%s' = %lld.\n", (i2 + 1), mnu.name, mnu.value);
-                    } else {
-                        K_LOG_INFO("    Menu #%d: '%s'.\n", (i2 + 1), mnu.name);
-                    }
-                }
+    return r;
+}
+
+//STH264SliceHdr
+//7.3.3 Slice header syntax (until the fields used to detect a new picture).
+
+int H264SliceHdr_parse(STH264SliceHdr* obj, const unsigned char* nal, const int nalSz, const STH264Sps* spss /*[K_H264_SPS_MAX]*/, const STH264Pps* ppss /*[K_H264_PPS_MAX]*/){
+    int r = -1;
+    if(obj != NULL && nal != NULL && nalSz > 1 && spss != NULL && ppss != NULL){
+        STBitsReader br;
+        STH264SliceHdr hdr;
+        const STH264Sps* sps = NULL;
+        const STH264Pps* pps = NULL;
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.nal_ref_idc = ((nal[0] >> 5) & 0x3);
+        hdr.nal_unit_type = (nal[0] & 0x1F);
+        BitsReader_init(&br, &nal[1], (nalSz - 1));
+        hdr.first_mb_in_slice = BitsReader_ue(&br);
+        hdr.slice_type = BitsReader_ue(&br);
+        hdr.pic_parameter_set_id = BitsReader_ue(&br);
+        if(!br.isOverflow && hdr.pic_parameter_set_id < K_H264_PPS_MAX && ppss[hdr.pic_parameter_set_id].isSet){
+            pps = &ppss[hdr.pic_parameter_set_id];
+            if(spss[pps->seq_parameter_set_id].width > 0){
+                sps = &spss[pps->seq_parameter_set_id];
+            }
+        }
+        if(sps != NULL){
+            hdr.pic_order_cnt_type = sps->pic_order_cnt_type;
+            if(sps->separate_colour_plane_flag){
+                BitsReader_u(&br, 2); //colour_plane_id
+            }
+            hdr.frame_num = BitsReader_u(&br, sps->log2_max_frame_num);
+            if(!sps->frame_mbs_only_flag){
+                hdr.field_pic_flag = BitsReader_u(&br, 1);
+                if(hdr.field_pic_flag){
+                    hdr.bottom_field_flag = BitsReader_u(&br, 1);
+                }
+            }
+            if(hdr.nal_unit_type == 5 /*IdrPicFlag*/){
+                hdr.idr_pic_id = BitsReader_ue(&br);
+            }
+            if(sps->pic_order_cnt_type == 0){
+                hdr.pic_order_cnt_lsb = BitsReader_u(&br, sps->log2_max_pic_order_cnt_lsb);
+                if(pps->bottom_field_pic_order_in_frame_present_flag && !hdr.field_pic_flag){
+                    hdr.delta_pic_order_cnt_bottom = BitsReader_se(&br);
+                }
+            }
+            if(sps->pic_order_cnt_type == 1 && !sps->delta_pic_order_always_zero_flag){
+                hdr.delta_pic_order_cnt[0] = BitsReader_se(&br);
+                if(pps->bottom_field_pic_order_in_frame_present_flag && !hdr.field_pic_flag){
+                    hdr.delta_pic_order_cnt[1] = BitsReader_se(&br);
+                }
+            }
+            if(!br.isOverflow){
+                *obj = hdr;
+                r = 0;
             }
         }
     }
+    return r;
+}
+
+int H264SliceHdr_isFirstOfNewPicture(const STH264SliceHdr* prev, const STH264SliceHdr* cur){
+    return (
+            cur->first_mb_in_slice == 0 //arbitrary slice order is not expected
+            || prev->frame_num != cur->frame_num
+            || prev->pic_parameter_set_id != cur->pic_parameter_set_id
+            || prev->field_pic_flag != cur->field_pic_flag
+            || (prev->field_pic_flag && prev->bottom_field_flag != cur->bottom_field_flag)
+            || (prev->nal_ref_idc != cur->nal_ref_idc && (prev->nal_ref_idc == 0 || cur->nal_ref_idc == 0))
+            || (prev->pic_order_cnt_type == 0 && cur->pic_order_cnt_type == 0 && (prev->pic_order_cnt_lsb != cur->pic_order_cnt_lsb || prev->delta_pic_order_cnt_bottom != cur->delta_pic_order_cnt_bottom))
+            || (prev->pic_order_cnt_type == 1 && cur->pic_order_cnt_type == 1 && (prev->delta_pic_order_cnt[0] != cur->delta_pic_order_cnt[0] || prev->delta_pic_order_cnt[1] != cur->delta_pic_order_cnt[1]))
+            || ((prev->nal_unit_type == 5) != (cur->nal_unit_type == 5))
+            || (prev->nal_unit_type == 5 && cur->nal_unit_type == 5 && prev->idr_pic_id != cur->idr_pic_id)
+            ) ? 1 : 0;
+}
+
+//STMp4Track
+//Video track's sample table (ISO BMFF 'moov', not fragmented), samples are length-prefixed NALs.
+
+#define MP4_BE16(P)     (((unsigned int)(P)[0] << 8) | (unsigned int)(P)[1])
+#define MP4_BE32(P)     (((unsigned int)(P)[0] << 24) | ((unsigned int)(P)[1] << 16) | ((unsigned int)(P)[2] << 8) | (unsigned int)(P)[3])
+#define MP4_BE64(P)     (((unsigned long long)MP4_BE32(P) << 32) | (unsigned long long)MP4_BE32((P) + 4))
+
+void Mp4Track_init(STMp4Track* obj){
+    memset(obj, 0, sizeof(*obj));
+}
+
+void Mp4Track_release(STMp4Track* obj){
+    if(obj->prms != NULL){
+        free(obj->prms);
+        obj->prms = NULL;
+    }
+    obj->prmsSz = 0;
+    if(obj->samples != NULL){
+        free(obj->samples);
+        obj->samples = NULL;
+    }
+    obj->samplesUse = 0;
+    obj->frameUs = 0;
+}
+
+int Mp4_boxNext_(const unsigned char* buff, const unsigned long long sz, unsigned long long* pos, const unsigned char** dstType, const unsigned char** dstBody, unsigned long long* dstBodySz){
+    int r = -1;
+    if((*pos + 8) <= sz){
+        const unsigned char* b = &buff[*pos];
+        unsigned long long boxSz = MP4_BE32(b), hdrSz = 8;
+        if(boxSz == 1){
+            //largesize
+            boxSz = ((*pos + 16) <= sz ? MP4_BE64(&b[8]) : 0);
+            hdrSz = 16;
+        } else if(boxSz == 0){
+            //to the end
+            boxSz = (sz - *pos);
+        }
+        if(boxSz >= hdrSz && boxSz <= (sz - *pos)){
+            *dstType = &b[4];
+            *dstBody = &b[hdrSz];
+            *dstBodySz = (boxSz - hdrSz);
+            *pos += boxSz;
+            r = 0;
+        }
+    }
+    return r;
+}
+
+const unsigned char* Mp4_boxFind_(const unsigned char* buff, const unsigned long long sz, const char* type, unsigned long long* dstBodySz){
+    unsigned long long pos = 0, bodySz = 0;
+    const unsigned char *bType = NULL, *body = NULL;
+    while(0 == Mp4_boxNext_(buff, sz, &pos, &bType, &body, &bodySz)){
+        if(memcmp(bType, type, 4) == 0){
+            *dstBodySz = bodySz;
+            return body;
+        }
+    }
+    return NULL;
+}
+
+int Mp4Track_prmsAdd_(STMp4Track* obj, const unsigned char* nal, const int nalSz){
+    unsigned char* prms = (unsigned char*)realloc(obj->prms, obj->prmsSz + 4 + nalSz);
+    if(prms == NULL){
+        return -1;
+    }
+    prms[obj->prmsSz + 0] = 0x00; prms[obj->prmsSz + 1] = 0x00; prms[obj->prmsSz + 2] = 0x00; prms[obj->prmsSz + 3] = 0x01;
+    memcpy(&prms[obj->prmsSz + 4], nal, nalSz);
+    obj->prms = prms;
+    obj->prmsSz += 4 + nalSz;
     return 0;
 }
 
-long msBetweenTimevals(struct timeval* base, struct timeval* next){
-    if(base != next){
-        if(next == NULL){
-            return (base->tv_sec * 1000ULL) + (base->tv_usec / 1000ULL);
-        } else if(base == NULL){
-            return -((next->tv_sec * 1000ULL) + (next->tv_usec / 1000ULL));
-        } else if(base->tv_sec < next->tv_sec || (base->tv_sec == next->tv_sec && base->tv_usec <= next->tv_usec)){
-            //ahead
-            if(base->tv_sec == next->tv_sec){
-                return (next->tv_usec - base->tv_usec) / 1000ULL;
-            } else {
-                return ((next->tv_sec - base->tv_sec - 1) * 1000ULL) + (((1000000ULL - base->tv_usec) + (next->tv_usec)) / 1000ULL);
+int Mp4Track_sampleHasPrms(const STMp4Track* obj, const unsigned char* smpl, const unsigned long smplSz){
+    unsigned long pos = 0;
+    while((pos + obj->lenSz) < smplSz){
+        unsigned long nalSz = 0;
+        int i; for(i = 0; i < obj->lenSz; i++){
+            nalSz = (nalSz << 8) | smpl[pos + i];
+        }
+        pos += obj->lenSz;
+        if(nalSz == 0 || nalSz > (smplSz - pos)){
+            break;
+        }
+        if(obj->pixFmt == V4L2_PIX_FMT_HEVC){
+            const int type = ((smpl[pos] >> 1) & 0x3F);
+            if(type >= 32 && type <= 34){ //VPS, SPS, PPS
+                return 1;
             }
         } else {
-            //backwards
-            if(base->tv_sec == next->tv_sec){
-                return -((base->tv_usec - next->tv_usec) / 1000ULL);
-            } else {
-                return -(((base->tv_sec - next->tv_sec - 1) * 1000ULL) + (((1000000ULL - next->tv_usec) + (base->tv_usec)) / 1000ULL));
+            const int type = (smpl[pos] & 0x1F);
+            if(type == 7 || type == 8){ //SPS, PPS
+                return 1;
             }
         }
+        pos += nalSz;
     }
     return 0;
 }
 
-long msBetweenTimespecs(struct timespec* base, struct timespec* next){
-    if(base != next){
-        if(next == NULL){
-            return (base->tv_sec * 1000ULL) + (base->tv_nsec / 1000000ULL);
-        } else if(base == NULL){
-            return -((next->tv_sec * 1000ULL) + (next->tv_nsec / 1000000ULL));
-        } else if(base->tv_sec < next->tv_sec || (base->tv_sec == next->tv_sec && base->tv_nsec <= next->tv_nsec)){
-            //ahead
-            if(base->tv_sec == next->tv_sec){
-                return (next->tv_nsec - base->tv_nsec) / 1000000ULL;
+int Mp4Track_parse(STMp4Track* obj, const unsigned char* buff, const unsigned long long sz){
+    int r = -1;
+    unsigned long long moovSz = 0, pos = 0, trakSz = 0;
+    const unsigned char* moov = Mp4_boxFind_(buff, sz, "moov", &moovSz);
+    const unsigned char *bType = NULL, *trak = NULL;
+    Mp4Track_release(obj);
+    while(r != 0 && moov != NULL && 0 == Mp4_boxNext_(moov, moovSz, &pos, &bType, &trak, &trakSz)){
+        unsigned long long mdiaSz = 0, hdlrSz = 0, mdhdSz = 0, minfSz = 0, stblSz = 0, stsdSz = 0, stszSz = 0, stscSz = 0, stcoSz = 0, stssSz = 0, entrySz = 0, cfgSz = 0;
+        const unsigned char *mdia = NULL, *hdlr = NULL, *mdhd = NULL, *minf = NULL, *stbl = NULL, *stsd = NULL, *stsz = NULL, *stsc = NULL, *stco = NULL, *stss = NULL, *entry = NULL, *cfg = NULL;
+        int isCo64 = 0;
+        if(memcmp(bType, "trak", 4) != 0) continue;
+        if((mdia = Mp4_boxFind_(trak, trakSz, "mdia", &mdiaSz)) == NULL) continue;
+        //video track
+        if((hdlr = Mp4_boxFind_(mdia, mdiaSz, "hdlr", &hdlrSz)) == NULL || hdlrSz < 12 || memcmp(&hdlr[8], "vide", 4) != 0) continue;
+        if((minf = Mp4_boxFind_(mdia, mdiaSz, "minf", &minfSz)) == NULL) continue;
+        if((stbl = Mp4_boxFind_(minf, minfSz, "stbl", &stblSz)) == NULL) continue;
+        if((stsd = Mp4_boxFind_(stbl, stblSz, "stsd", &stsdSz)) == NULL || stsdSz < 8) continue;
+        if((stsz = Mp4_boxFind_(stbl, stblSz, "stsz", &stszSz)) == NULL || stszSz < 12) continue;
+        if((stsc = Mp4_boxFind_(stbl, stblSz, "stsc", &stscSz)) == NULL || stscSz < 8) continue;
+        if((stco = Mp4_boxFind_(stbl, stblSz, "stco", &stcoSz)) == NULL){
+            if((stco = Mp4_boxFind_(stbl, stblSz, "co64", &stcoSz)) == NULL) continue;
+            isCo64 = 1;
+        }
+        if(stcoSz < 8) continue;
+        stss = Mp4_boxFind_(stbl, stblSz, "stss", &stssSz);
+        mdhd = Mp4_boxFind_(mdia, mdiaSz, "mdhd", &mdhdSz);
+        //sample entry (VisualSampleEntry fields are 78 bytes before its child boxes)
+        {
+            unsigned long long ePos = 0;
+            const unsigned char* eType = NULL;
+            if(0 != Mp4_boxNext_(&stsd[8], stsdSz - 8, &ePos, &eType, &entry, &entrySz) || entrySz < 78) continue;
+            if(memcmp(eType, "avc1", 4) == 0 || memcmp(eType, "avc3", 4) == 0){
+                obj->pixFmt = V4L2_PIX_FMT_H264;
+                cfg = Mp4_boxFind_(&entry[78], entrySz - 78, "avcC", &cfgSz);
+            } else if(memcmp(eType, "hvc1", 4) == 0 || memcmp(eType, "hev1", 4) == 0){
+                obj->pixFmt = V4L2_PIX_FMT_HEVC;
+                cfg = Mp4_boxFind_(&entry[78], entrySz - 78, "hvcC", &cfgSz);
             } else {
-                return ((next->tv_sec - base->tv_sec - 1) * 1000ULL) + (((1000000000ULL - base->tv_nsec) + (next->tv_nsec)) / 1000000ULL);
+                K_LOG_ERROR("Mp4Track, video sample entry '%c%c%c%c' not supported.\n", eType[0], eType[1], eType[2], eType[3]);
+                continue;
+            }
+        }
+        //decoder configuration (length-field size and parameter sets)
+        if(cfg == NULL) continue;
+        if(obj->pixFmt == V4L2_PIX_FMT_H264){
+            //avcC: version, profile, compatibility, level, lengthSizeMinusOne, numOfSequenceParameterSets, (u16 + SPS)..., numOfPictureParameterSets, (u16 + PPS)...
+            unsigned long long p = 6;
+            int set, i, count;
+            if(cfgSz < 7) continue;
+            obj->lenSz = (cfg[4] & 0x3) + 1;
+            count = (cfg[5] & 0x1F);
+            for(set = 0; set < 2; set++){
+                for(i = 0; i < count && (p + 2) <= cfgSz; i++){
+                    const unsigned int nalSz = MP4_BE16(&cfg[p]);
+                    if((p + 2 + nalSz) > cfgSz || 0 != Mp4Track_prmsAdd_(obj, &cfg[p + 2], (int)nalSz)) break;
+                    p += 2 + nalSz;
+                }
+                if(set == 0){
+                    count = (p < cfgSz ? cfg[p++] : 0);
+                }
             }
         } else {
-            //backwards
-            if(base->tv_sec == next->tv_sec){
-                return -((base->tv_nsec - next->tv_nsec) / 1000000ULL);
-            } else {
-                return -(((base->tv_sec - next->tv_sec - 1) * 1000ULL) + (((1000000000ULL - next->tv_nsec) + (base->tv_nsec)) / 1000000ULL));
+            //hvcC: 22 bytes (lengthSizeMinusOne at the last one), numOfArrays, (type, u16 numNalus, (u16 + NAL)...)...
+            unsigned long long p = 23;
+            int a, i, arrays;
+            if(cfgSz < 23) continue;
+            obj->lenSz = (cfg[21] & 0x3) + 1;
+            arrays = cfg[22];
+            for(a = 0; a < arrays && (p + 3) <= cfgSz; a++){
+                const int count = (int)MP4_BE16(&cfg[p + 1]);
+                p += 3;
+                for(i = 0; i < count && (p + 2) <= cfgSz; i++){
+                    const unsigned int nalSz = MP4_BE16(&cfg[p]);
+                    if((p + 2 + nalSz) > cfgSz || 0 != Mp4Track_prmsAdd_(obj, &cfg[p + 2], (int)nalSz)) break;
+                    p += 2 + nalSz;
+                }
+            }
+        }
+        if(obj->lenSz == 3){
+            K_LOG_ERROR("Mp4Track, 3-bytes NAL lengths not supported.\n");
+            Mp4Track_release(obj);
+            continue;
+        }
+        //samples: sizes (stsz), chunks (stsc + stco/co64) and the sync ones (stss)
+        {
+            const unsigned int sampleSz = MP4_BE32(&stsz[4]);
+            unsigned long long samplesCount = MP4_BE32(&stsz[8]);
+            const unsigned long long chunksCount = MP4_BE32(&stco[4]);
+            const unsigned long long stscCount = MP4_BE32(&stsc[4]);
+            //constant-size samples: no more than the file can hold (the ones beyond its end would be ignored anyway)
+            if(sampleSz != 0 && samplesCount > (sz / sampleSz)){
+                samplesCount = (sz / sampleSz);
+            }
+            if(samplesCount == 0 || samplesCount > (SIZE_MAX / sizeof(STMp4Sample)) || (sampleSz == 0 && (12 + samplesCount * 4) > stszSz) || (8 + chunksCount * (isCo64 ? 8 : 4)) > stcoSz || (8 + stscCount * 12) > stscSz){
+                Mp4Track_release(obj);
+                continue;
+            }
+            obj->samples = (STMp4Sample*)malloc(sizeof(STMp4Sample) * samplesCount);
+            if(obj->samples == NULL){
+                Mp4Track_release(obj);
+                continue;
             }
+            {
+                unsigned long long iSample = 0, e;
+                for(e = 0; e < stscCount && iSample < samplesCount; e++){
+                    const unsigned char* ent = &stsc[8 + e * 12];
+                    const unsigned long long firstChunk = MP4_BE32(ent);
+                    const unsigned long long lastChunk = ((e + 1) < stscCount ? (unsigned long long)MP4_BE32(&ent[12]) - 1 : chunksCount);
+                    const unsigned long long perChunk = MP4_BE32(&ent[4]);
+                    unsigned long long c;
+                    for(c = firstChunk; c >= 1 && c <= lastChunk && c <= chunksCount && iSample < samplesCount; c++){
+                        unsigned long long off = (isCo64 ? MP4_BE64(&stco[8 + (c - 1) * 8]) : MP4_BE32(&stco[8 + (c - 1) * 4])), k;
+                        for(k = 0; k < perChunk && iSample < samplesCount; k++){
+                            STMp4Sample* smpl = &obj->samples[iSample];
+                            smpl->off = off;
+                            smpl->sz = (sampleSz != 0 ? sampleSz : MP4_BE32(&stsz[12 + iSample * 4]));
+                            smpl->isSync = (stss == NULL ? 1 : 0);
+                            off += smpl->sz;
+                            iSample++;
+                        }
+                    }
+                }
+                //samples beyond the file's end (truncated recording) are ignored
+                for(e = 0; e < iSample && obj->samples[e].off <= sz && obj->samples[e].sz <= (sz - obj->samples[e].off); e++);
+                obj->samplesUse = (unsigned long)e;
+            }
+            if(stss != NULL && stssSz >= 8){
+                const unsigned long long count = MP4_BE32(&stss[4]);
+                unsigned long long i;
+                for(i = 0; i < count && (8 + (i + 1) * 4) <= stssSz; i++){
+                    const unsigned long long n = MP4_BE32(&stss[8 + i * 4]);
+                    if(n >= 1 && n <= obj->samplesUse){
+                        obj->samples[n - 1].isSync = 1;
+                    }
+                }
+            }
+            //mean sample duration (mdhd: version, flags, creation and modification times, timescale, duration)
+            if(mdhd != NULL && mdhdSz >= 20){
+                unsigned long long timescale = 0, duration = 0;
+                if(mdhd[0] == 1 && mdhdSz >= 32){
+                    timescale = MP4_BE32(&mdhd[20]);
+                    duration = MP4_BE64(&mdhd[24]);
+                } else if(mdhd[0] == 0 && mdhdSz >= 20){
+                    timescale = MP4_BE32(&mdhd[12]);
+                    duration = MP4_BE32(&mdhd[16]);
+                }
+                if(timescale > 0 && duration > 0 && duration != 0xFFFFFFFFULL){
+                    obj->frameUs = (unsigned long)((duration * 1000000ULL / timescale) / samplesCount);
+                }
+            }
+        }
+        if(obj->samplesUse > 0){
+            r = 0;
+        } else {
+            Mp4Track_release(obj);
         }
     }
-    return 0;
+    return r;
 }
 
-
-
-/*
-//ENPlayerPollFdType
-
-typedef enum ENPlayerPollFdType_ {
-    ENPlayerPollFdType_Decoder = 0, //dec (decoder).fd
-    ENPlayerPollFdType_SrcSocket,   //net.socket
-    //
-    ENPlayerPollFdType_Count
-} ENPlayerPollFdType;
-
-typedef void (*PlayerPollCallback)(void* userParam, struct STPlayer_* plyr, const ENPlayerPollFdType type, int revents);
-*/
-
 //STVideoFrameState
 //Allows to follow the timings of frames.
 
@@ -7330,6 +13233,7 @@ void VideoFrameStates_release(STVideoFrameStates* obj){
         free(obj->arr);
         obj->arr = NULL;
     }
+    obj->head = 0;
     obj->use = 0;
     obj->sz = 0;
 }
@@ -7337,10 +13241,10 @@ void VideoFrameStates_release(STVideoFrameStates* obj){
 //
 
 int VideoFrameStates_getStateCloningAndRemoveOlder(STVideoFrameStates* obj, const unsigned long iSeq, STVideoFrameState* dstState, int* dstOlderRemovedCount){
-    //remove from the right
+    //remove from the head (oldest)
     int olderRemovedCount = 0;
     while(obj->use > 0){
-        STVideoFrameState* st = &obj->arr[obj->use - 1];
+        STVideoFrameState* st = &obj->arr[obj->head];
         if(st->iSeq > iSeq){ //do not remove newer frames
             break;
         }
@@ -7350,6 +13254,7 @@ int VideoFrameStates_getStateCloningAndRemoveOlder(STVideoFrameStates* obj, cons
             olderRemovedCount++;
         }
         VideoFrameState_release(st);
+        obj->head = (obj->head + 1) & (obj->sz - 1);
         obj->use--;
     }
     if(dstOlderRemovedCount != NULL){
@@ -7359,49 +13264,160 @@ int VideoFrameStates_getStateCloningAndRemoveOlder(STVideoFrameStates* obj, cons
 }
 
 int VideoFrameStates_addNewestCloning(STVideoFrameStates* obj, const STVideoFrameState* state){
-    //increase buffer
-    while(obj->sz <= obj->use){
-        const int inc = 1; //increment
-        STVideoFrameState* arrN = malloc(sizeof(STVideoFrameState) * (obj->sz + inc));
+    //increase buffer (doubled, unwrapped to the start)
+    if(obj->sz <= obj->use){
+        const int szN = (obj->sz > 0 ? obj->sz * 2 : K_FRAMES_QUEUE_SZ_MIN);
+        STVideoFrameState* arrN = malloc(sizeof(STVideoFrameState) * szN);
         if(arrN == NULL){
             //alloc fail
             return -1;
         }
         if(obj->arr != NULL){
             if(obj->use > 0){
-                memcpy(arrN, obj->arr, sizeof(STVideoFrameState) * obj->use);
+                const int firstSz = (obj->sz - obj->head < obj->use ? obj->sz - obj->head : obj->use);
+                memcpy(arrN, &obj->arr[obj->head], sizeof(STVideoFrameState) * firstSz);
+                if(firstSz < obj->use){
+                    memcpy(&arrN[firstSz], obj->arr, sizeof(STVideoFrameState) * (obj->use - firstSz));
+                }
             }
             free(obj->arr);
         }
         obj->arr = arrN;
-        obj->sz += inc;
+        obj->head = 0;
+        obj->sz = szN;
     }
-    //create gap at the left
+    //add at the tail (newest)
     {
-        int i; for(i = obj->use; i > 0; i--){
-            obj->arr[i] = obj->arr[i - 1];
-        }
-        obj->use++;
-    }
-    //add
-    {
-        STVideoFrameState* st = &obj->arr[0];
+        STVideoFrameState* st = &obj->arr[(obj->head + obj->use) & (obj->sz - 1)];
         VideoFrameState_init(st);
         VideoFrameState_clone(st, state);
+        obj->use++;
     }
     return 0;
 }
 
 int VideoFrameStates_empty(STVideoFrameStates* obj){
     int i; for(i = 0; i < obj->use; i++){
-        STVideoFrameState* st = &obj->arr[i];
+        STVideoFrameState* st = &obj->arr[(obj->head + i) & (obj->sz - 1)];
         VideoFrameState_release(st);
     }
+    obj->head = 0;
     obj->use = 0;
     return 0;
 }
 
 
+//STBuffSlabs
+
+void BuffSlabs_init(STBuffSlabs* obj){
+    memset(obj, 0, sizeof(*obj));
+}
+
+void BuffSlabs_release(STBuffSlabs* obj){
+    int i; for(i = 0; i < K_BUFF_SLAB_CLASSES; i++){
+        if(obj->classes[i].given > 0){
+            K_LOG_WARN("BuffSlabs, %d blocks of %dKB not returned at release.\n", obj->classes[i].given, ((K_BUFF_SLAB_CLASS_MIN << i) / 1024));
+        }
+        if(obj->classes[i].cached != NULL){
+            int j; for(j = 0; j < obj->classes[i].cachedUse; j++){
+                free(obj->classes[i].cached[j]);
+            }
+            free(obj->classes[i].cached);
+            obj->classes[i].cached = NULL;
+        }
+        obj->classes[i].cachedUse = 0;
+        obj->classes[i].cachedSz = 0;
+    }
+    obj->bytesHeld = 0;
+}
+
+unsigned char* BuffSlabs_alloc(STBuffSlabs* obj, const int minSz, int* dstSz){ //block of the smallest size-class that fits (or 'minSz' if bigger than the biggest class)
+    unsigned char* r = NULL;
+    int iClass = 0, sz = K_BUFF_SLAB_CLASS_MIN;
+    while(sz < minSz && iClass < K_BUFF_SLAB_CLASSES){
+        sz *= 2;
+        iClass++;
+    }
+    if(iClass >= K_BUFF_SLAB_CLASSES){
+        //not cached
+        sz = minSz;
+        r = malloc(sz);
+        if(r != NULL){
+            obj->bytesHeld += sz;
+            obj->stats.curSec.mallocs++;
+        }
+    } else if(obj->classes[iClass].cachedUse > 0){
+        r = obj->classes[iClass].cached[--obj->classes[iClass].cachedUse];
+    } else {
+        r = malloc(sz);
+        if(r != NULL){
+            obj->bytesHeld += sz;
+            obj->stats.curSec.mallocs++;
+        }
+    }
+    if(r != NULL){
+        if(iClass < K_BUFF_SLAB_CLASSES){
+            obj->classes[iClass].given++;
+            if(obj->classes[iClass].givenMax < obj->classes[iClass].given){
+                obj->classes[iClass].givenMax = obj->classes[iClass].given;
+            }
+        }
+        obj->stats.curSec.allocs++;
+        if(dstSz != NULL){
+            *dstSz = sz;
+        }
+    }
+    return r;
+}
+
+void BuffSlabs_free(STBuffSlabs* obj, unsigned char* ptr, const int sz){ //cached if 'sz' is a size-class
+    int iClass = 0;
+    while(iClass < K_BUFF_SLAB_CLASSES && (K_BUFF_SLAB_CLASS_MIN << iClass) != sz){
+        iClass++;
+    }
+    if(iClass < K_BUFF_SLAB_CLASSES){
+        K_ASSERT(obj->classes[iClass].given > 0)
+        obj->classes[iClass].given--;
+        //resize arr
+        if(obj->classes[iClass].cachedUse >= obj->classes[iClass].cachedSz){
+            const int szN = obj->classes[iClass].cachedSz + 8;
+            unsigned char** arrN = malloc(sizeof(arrN[0]) * szN);
+            if(arrN != NULL){
+                if(obj->classes[iClass].cached != NULL){
+                    if(obj->classes[iClass].cachedUse > 0){
+                        memcpy(arrN, obj->classes[iClass].cached, sizeof(arrN[0]) * obj->classes[iClass].cachedUse);
+                    }
+                    free(obj->classes[iClass].cached);
+                }
+                obj->classes[iClass].cached = arrN;
+                obj->classes[iClass].cachedSz = szN;
+            }
+        }
+        //add
+        if(obj->classes[iClass].cachedUse < obj->classes[iClass].cachedSz){
+            obj->classes[iClass].cached[obj->classes[iClass].cachedUse++] = ptr;
+            ptr = NULL; //consume
+        }
+    }
+    //release (if not consumed)
+    if(ptr != NULL){
+        free(ptr);
+        obj->bytesHeld -= sz;
+    }
+}
+
+void BuffSlabs_trim(STBuffSlabs* obj){ //releases cached blocks over the high-water of the blocks given since previous call
+    int i; for(i = 0; i < K_BUFF_SLAB_CLASSES; i++){
+        const int keep = obj->classes[i].givenMax - obj->classes[i].given;
+        while(obj->classes[i].cachedUse > 0 && obj->classes[i].cachedUse > keep){
+            free(obj->classes[i].cached[--obj->classes[i].cachedUse]);
+            obj->bytesHeld -= (K_BUFF_SLAB_CLASS_MIN << i);
+        }
+        obj->classes[i].givenMax = obj->classes[i].given;
+    }
+    obj->secsSinceTrim = 0;
+}
+
 //STVideoFrame
 //In H264, an Access unit allways produces an output frame.
 //IDR = Instantaneous Decoding Refresh
@@ -7416,8 +13432,15 @@ void VideoFrame_release(STVideoFrame* obj){
     VideoFrameState_release(&obj->state);
     //buff
     {
+        if(obj->buff.decBuff != NULL){
+            VideoFrame_unbindDecBuff(obj, 0);
+        }
         if(obj->buff.ptr != NULL){
-            free(obj->buff.ptr);
+            if(obj->buff.slabs != NULL){
+                BuffSlabs_free(obj->buff.slabs, obj->buff.ptr, obj->buff.sz);
+            } else {
+                free(obj->buff.ptr);
+            }
             obj->buff.ptr = NULL;
         }
         obj->buff.use   = 0;
@@ -7435,31 +13458,67 @@ int VideoFrame_reset(STVideoFrame* obj){   //state is reseted and buffer 'use' i
     }
     //buff
     {
+        if(obj->buff.decBuff != NULL){
+            VideoFrame_unbindDecBuff(obj, 0);
+        }
         obj->buff.use = 0;
+        obj->buff.extPtr = NULL;
+        obj->buff.extPos = 0;
     }
     return  0;
 }
 
 int VideoFrame_copy(STVideoFrame* obj, const void* data, const int dataSz){
-    //increae buffer
-    while(obj->buff.sz < (obj->buff.use + dataSz)){
+    //plane is full, continue in the owned buffer
+    if(obj->buff.decBuff != NULL && obj->buff.sz < (obj->buff.use + dataSz)){
+        K_LOG_VERBOSE("VideoFrame_copy, frame(%d bytes) outgrew the OUTPUT plane(%d bytes), moved to own buffer.\n", (obj->buff.use + dataSz), obj->buff.sz);
+        if(0 != VideoFrame_unbindDecBuff(obj, 1)){
+            return -1;
+        }
+    }
+    //stats (growing to the exact size copies the payload at every overflow)
+    if(obj->buff.slabs != NULL && obj->buff.decBuff == NULL && obj->buff.szExact < (obj->buff.use + dataSz)){
+        obj->buff.slabs->stats.curSec.copyBytesExact += obj->buff.use;
+        obj->buff.szExact = (obj->buff.use + dataSz);
+    }
+    //increae buffer (geometric growth)
+    if(obj->buff.sz < (obj->buff.use + dataSz)){
+        unsigned char* readBuffN = NULL;
+        int szN = (obj->buff.sz * 2);
+        if(szN < (obj->buff.use + dataSz)){
+            szN = (obj->buff.use + dataSz);
+        }
+        if(szN < K_BUFF_SLAB_CLASS_MIN){
+            szN = K_BUFF_SLAB_CLASS_MIN;
+        }
         //create new buffer
-        unsigned char* readBuffN = malloc(obj->buff.use + dataSz);
+        if(obj->buff.slabs != NULL){
+            readBuffN = BuffSlabs_alloc(obj->buff.slabs, szN, &szN);
+        } else {
+            readBuffN = malloc(szN);
+        }
         if(readBuffN == NULL){
             K_LOG_INFO("VideoFrame_prepareForFill, malloc failed.\n");
             return -1;
         }
-        obj->buff.sz = obj->buff.use + dataSz;
         //old buffer
         if(obj->buff.ptr != NULL){
             //copy
             if(obj->buff.use > 0){
                 memcpy(readBuffN, obj->buff.ptr, obj->buff.use);
+                if(obj->buff.slabs != NULL){
+                    obj->buff.slabs->stats.curSec.copyBytes += obj->buff.use;
+                }
             }
             //free
-            free(obj->buff.ptr);
+            if(obj->buff.slabs != NULL){
+                BuffSlabs_free(obj->buff.slabs, obj->buff.ptr, obj->buff.sz);
+            } else {
+                free(obj->buff.ptr);
+            }
         }
         obj->buff.ptr = readBuffN;
+        obj->buff.sz = szN;
         K_LOG_VERBOSE("VideoFrame_prepareForFill, buff growth to %dKB.\n", (obj->buff.sz / 1024));
     }
     //copy data
@@ -7472,45 +13531,58 @@ int VideoFrame_copy(STVideoFrame* obj, const void* data, const int dataSz){
     return 0;
 }
 
+int VideoFrame_bindDecBuff(STVideoFrame* obj, STBuffer* buff){  //payload will be assembled in place on the buffer's first plane (current payload is moved there)
+    if(obj->buff.decBuff != NULL || obj->buff.extPtr != NULL){
+        return -1;
+    }
+    if(buff == NULL || buff->isQueued || buff->isBound || buff->planesSz <= 0 || buff->planes[0].dataPtr == NULL || buff->planes[0].length < obj->buff.use){
+        return -1;
+    }
+    if(obj->buff.use > 0){
+        memcpy(buff->planes[0].dataPtr, obj->buff.ptr, obj->buff.use);
+    }
+    obj->buff.ownPtr    = obj->buff.ptr;
+    obj->buff.ownSz     = obj->buff.sz;
+    obj->buff.ptr       = buff->planes[0].dataPtr;
+    obj->buff.sz        = buff->planes[0].length;
+    obj->buff.decBuff   = buff;
+    buff->isBound       = 1;
+    return 0;
+}
+
+int VideoFrame_unbindDecBuff(STVideoFrame* obj, const int keepPayload){  //returns to the owned buffer, copying the payload if required
+    int r = 0;
+    if(obj->buff.decBuff != NULL){
+        const unsigned char* pay = obj->buff.ptr;
+        const int paySz = obj->buff.use;
+        obj->buff.decBuff->isBound = 0;
+        obj->buff.decBuff   = NULL;
+        obj->buff.ptr       = obj->buff.ownPtr;
+        obj->buff.sz        = obj->buff.ownSz;
+        obj->buff.ownPtr    = NULL;
+        obj->buff.ownSz     = 0;
+        obj->buff.use       = 0;
+        if(keepPayload && paySz > 0){
+            r = VideoFrame_copy(obj, pay, paySz);
+        }
+    }
+    return r;
+}
+
 int VideoFrame_getNalsCount(const STVideoFrame* obj){
-    return  obj->accessUnit.nalsCountPerType[0]
-    + obj->accessUnit.nalsCountPerType[1]
-    + obj->accessUnit.nalsCountPerType[2]
-    + obj->accessUnit.nalsCountPerType[3]
-    + obj->accessUnit.nalsCountPerType[4]
-    + obj->accessUnit.nalsCountPerType[5]
-    + obj->accessUnit.nalsCountPerType[6]
-    + obj->accessUnit.nalsCountPerType[7]
-    + obj->accessUnit.nalsCountPerType[8]
-    + obj->accessUnit.nalsCountPerType[9]
-    + obj->accessUnit.nalsCountPerType[10]
-    + obj->accessUnit.nalsCountPerType[11]
-    + obj->accessUnit.nalsCountPerType[12]
-    + obj->accessUnit.nalsCountPerType[13]
-    + obj->accessUnit.nalsCountPerType[14]
-    + obj->accessUnit.nalsCountPerType[15]
-    + obj->accessUnit.nalsCountPerType[16]
-    + obj->accessUnit.nalsCountPerType[17]
-    + obj->accessUnit.nalsCountPerType[18]
-    + obj->accessUnit.nalsCountPerType[19]
-    + obj->accessUnit.nalsCountPerType[20]
-    + obj->accessUnit.nalsCountPerType[21]
-    + obj->accessUnit.nalsCountPerType[22]
-    + obj->accessUnit.nalsCountPerType[23]
-    + obj->accessUnit.nalsCountPerType[24]
-    + obj->accessUnit.nalsCountPerType[25]
-    + obj->accessUnit.nalsCountPerType[26]
-    + obj->accessUnit.nalsCountPerType[27]
-    + obj->accessUnit.nalsCountPerType[28]
-    + obj->accessUnit.nalsCountPerType[29]
-    + obj->accessUnit.nalsCountPerType[30]
-    + obj->accessUnit.nalsCountPerType[31];
-}
-
-int VideoFrame_getNalsCountOfGrp(const STVideoFrame* obj, const ENNalTypeGrp grp){
     int r = 0;
     int i; for(i = 0; i < sizeof(obj->accessUnit.nalsCountPerType) / sizeof(obj->accessUnit.nalsCountPerType[0]); i++){
-        if(obj->accessUnit.nalsCountPerType[i] > 0 && _naluDefs[i].grp == grp){
+        r += obj->accessUnit.nalsCountPerType[i];
+    }
+    return r;
+}
+
+int VideoFrame_getNalsCountOfGrp(const STVideoFrame* obj, const int srcPixFmt /*V4L2_PIX_FMT_H264 or V4L2_PIX_FMT_HEVC*/, const ENNalTypeGrp grp){
+    int r = 0;
+    const STNalTypeDesc* defs = (srcPixFmt == V4L2_PIX_FMT_HEVC ? _naluHevcDefs : _naluDefs);
+    const int defsSz = (srcPixFmt == V4L2_PIX_FMT_HEVC ? (sizeof(_naluHevcDefs) / sizeof(_naluHevcDefs[0])) : (sizeof(_naluDefs) / sizeof(_naluDefs[0])));
+    int i; for(i = 0; i < defsSz; i++){
+        if(obj->accessUnit.nalsCountPerType[i] > 0 && defs[i].grp == grp){
             r += obj->accessUnit.nalsCountPerType[i];
         }
     }
@@ -7644,13 +13716,14 @@ void VideoFrames_init(STVideoFrames* obj){
 void VideoFrames_release(STVideoFrames* obj){
     if(obj->arr != NULL){
         int i; for(i = 0; i < obj->use; i++){
-            STVideoFrame* f = obj->arr[i];
+            STVideoFrame* f = obj->arr[(obj->head + i) & (obj->sz - 1)];
             VideoFrame_release(f);
             free(f);
         }
         free(obj->arr);
         obj->arr = NULL;
     }
+    obj->head = 0;
     obj->use = 0;
     obj->sz = 0;
 }
@@ -7660,7 +13733,7 @@ int VideoFrames_pullFrameForFill(STVideoFrames* obj, STVideoFrame** dst){
     if(dst != NULL){
         //pull last
         if(obj->use > 0){
-            STVideoFrame* f = obj->arr[obj->use - 1];
+            STVideoFrame* f = obj->arr[(obj->head + obj->use - 1) & (obj->sz - 1)];
             //set
             VideoFrame_reset(f);
             f->state.iSeq = obj->iSeqPullNext++;
@@ -7673,6 +13746,7 @@ int VideoFrames_pullFrameForFill(STVideoFrames* obj, STVideoFrame** dst){
         {
             STVideoFrame* f = malloc(sizeof(STVideoFrame));
             VideoFrame_init(f);
+            f->buff.slabs = obj->slabs;
             //set
             VideoFrame_reset(f);
             f->state.iSeq = obj->iSeqPullNext++;
@@ -7693,41 +13767,48 @@ int VideoFrames_getFramesForReadCount(STVideoFrames* obj){ //peek from the left
 int VideoFrames_pullFrameForRead(STVideoFrames* obj, STVideoFrame** dst){
     if(dst != NULL && obj->use > 0){
         //pull first element
-        STVideoFrame* f = obj->arr[0];
-        //fill gap
+        STVideoFrame* f = obj->arr[obj->head];
+        obj->head = (obj->head + 1) & (obj->sz - 1);
         obj->use--;
-        {
-            int i; for(i = 0; i < obj->use; i++){
-                obj->arr[i] = obj->arr[i + 1];
-            }
-        }
         *dst = f;
         return 0;
     }
     return -1;
 }
 
+STVideoFrame* VideoFrames_peek(STVideoFrames* obj, const int idx){ //idx-th from the left (zero is the next to read), NULL if out of range
+    if(idx >= 0 && idx < obj->use){
+        return obj->arr[(obj->head + idx) & (obj->sz - 1)];
+    }
+    return NULL;
+}
+
 //add for future pull (reuse)
 int VideoFrames_pushFrameOwning(STVideoFrames* obj, STVideoFrame* src){
-    //increase buffer
-    while(obj->sz <= obj->use){
-        const int inc = 1; //increment
-        STVideoFrame** arrN = malloc(sizeof(STVideoFrame*) * (obj->sz + inc));
+    //increase buffer (doubled, unwrapped to the start)
+    if(obj->sz <= obj->use){
+        const int szN = (obj->sz > 0 ? obj->sz * 2 : K_FRAMES_QUEUE_SZ_MIN);
+        STVideoFrame** arrN = malloc(sizeof(STVideoFrame*) * szN);
         if(arrN == NULL){
             //alloc fail
             return -1;
         }
         if(obj->arr != NULL){
             if(obj->use > 0){
-                memcpy(arrN, obj->arr, sizeof(STVideoFrame*) * obj->use);
+                const int firstSz = (obj->sz - obj->head < obj->use ? obj->sz - obj->head : obj->use);
+                memcpy(arrN, &obj->arr[obj->head], sizeof(STVideoFrame*) * firstSz);
+                if(firstSz < obj->use){
+                    memcpy(&arrN[firstSz], obj->arr, sizeof(STVideoFrame*) * (obj->use - firstSz));
+                }
             }
             free(obj->arr);
         }
         obj->arr = arrN;
-        obj->sz += inc;
+        obj->head = 0;
+        obj->sz = szN;
     }
-    //add
-    obj->arr[obj->use] = src;
+    //add at the right
+    obj->arr[(obj->head + obj->use) & (obj->sz - 1)] = src;
     obj->use++;
     obj->iSeqPushNext++;
     //
@@ -8974,6 +15055,232 @@ int PrintedInfo_touch(STPrintedInfo* obj){  //updated 'last' time
     return 0;
 }
 
+//STDnsRecord
+//Server address resolution shared by all the streams of the same server.
+
+void DnsRecord_init(STDnsRecord* obj){
+    memset(obj, 0, sizeof(*obj));
+}
+
+void DnsRecord_release(STDnsRecord* obj){
+    if(obj->resolver != NULL){
+        //cancel or wait (the request can't be freed while in progress)
+        if(gai_cancel(obj->resolver) == EAI_NOTCANCELED){
+            const struct gaicb* const list[] = { obj->resolver };
+            while(gai_error(obj->resolver) == EAI_INPROGRESS){
+                gai_suspend(list, 1, NULL);
+            }
+        }
+        if(gai_error(obj->resolver) == 0 && obj->resolver->ar_result != NULL){
+            freeaddrinfo(obj->resolver->ar_result);
+            obj->resolver->ar_result = NULL;
+        }
+        free(obj->resolver);
+        obj->resolver = NULL;
+    }
+    if(obj->server != NULL){
+        free(obj->server);
+        obj->server = NULL;
+    }
+}
+
+//STNetPool
+//Per server:port warm (connected but not requested yet) connections.
+
+void NetPool_init(STNetPool* obj){
+    memset(obj, 0, sizeof(*obj));
+}
+
+void NetPool_release(STNetPool* obj, struct STPlayer_* plyr){
+    if(obj->conns.arr != NULL){
+        int i; for(i = 0; i < obj->conns.use; i++){
+            STNetPoolConn* conn = obj->conns.arr[i];
+            if(conn->socket > 0){
+                Player_pollAutoRemove(plyr, ENPlayerPollFdType_NetPoolConn, conn, conn->socket);
+                close(conn->socket);
+                conn->socket = 0;
+            }
+            free(conn);
+            obj->conns.arr[i] = NULL;
+        }
+        free(obj->conns.arr);
+        obj->conns.arr = NULL;
+    }
+    obj->conns.use = 0;
+    obj->conns.sz = 0;
+    if(obj->server != NULL){
+        free(obj->server);
+        obj->server = NULL;
+    }
+}
+
+//STDecoderParked
+//Opened decoder kept by the player for the next stream opening the same device.
+
+void DecoderParked_init(STDecoderParked* obj){
+    memset(obj, 0, sizeof(*obj));
+    obj->fd = -1;
+    Buffers_init(&obj->src);
+    Buffers_init(&obj->dst);
+}
+
+void DecoderParked_release(STDecoderParked* obj){
+    if(obj->fd >= 0){
+        //both sides were stopped when parked
+        if(obj->dst.sz > 0 && 0 != Buffers_allocBuffs(&obj->dst, obj->fd, 0, 0)){
+            K_LOG_WARN("DecoderParked, Buffers_allocBuffs(dst, 0) failed: '%s'.\n", obj->device);
+        }
+        if(obj->src.sz > 0 && 0 != Buffers_allocBuffs(&obj->src, obj->fd, 0, 0)){
+            K_LOG_WARN("DecoderParked, Buffers_allocBuffs(src, 0) failed: '%s'.\n", obj->device);
+        }
+        if(0 != StreamContext_eventsUnsubscribe(NULL, obj->fd)){
+            K_LOG_ERROR("DecoderParked, unsubscribe failed.\n");
+        }
+        v4l2_close(obj->fd);
+        obj->fd = -1;
+    }
+    Buffers_release(&obj->src);
+    Buffers_release(&obj->dst);
+    if(obj->device != NULL){
+        free(obj->device);
+        obj->device = NULL;
+    }
+}
+
+//STIoUring
+//Minimal io_uring (raw syscalls, no liburing dependency).
+
+#ifdef K_USE_IO_URING
+void IoUring_init(STIoUring* obj){
+    memset(obj, 0, sizeof(*obj));
+    obj->fd = -1;
+}
+
+void IoUring_release(STIoUring* obj){
+    if(obj->sq.sqes != NULL){
+        munmap(obj->sq.sqes, obj->sq.sqesSz);
+        obj->sq.sqes = NULL;
+    }
+    if(obj->cq.ring != NULL && obj->cq.ring != obj->sq.ring){
+        munmap(obj->cq.ring, obj->cq.ringSz);
+    }
+    obj->cq.ring = NULL;
+    if(obj->sq.ring != NULL){
+        munmap(obj->sq.ring, obj->sq.ringSz);
+        obj->sq.ring = NULL;
+    }
+    if(obj->fd >= 0){
+        close(obj->fd);
+        obj->fd = -1;
+    }
+}
+
+int IoUring_setup(STIoUring* obj, const unsigned entries){
+    int r = -1;
+    struct io_uring_params prms;
+    memset(&prms, 0, sizeof(prms));
+    IoUring_release(obj);
+    obj->fd = (int)syscall(__NR_io_uring_setup, entries, &prms);
+    if(obj->fd < 0){
+        K_LOG_ERROR("IoUring, io_uring_setup(%u) failed errno(%d).\n", entries, errno);
+        obj->fd = -1;
+    } else {
+        obj->features   = prms.features;
+        obj->sq.ringSz  = prms.sq_off.array + prms.sq_entries * sizeof(unsigned);
+        obj->cq.ringSz  = prms.cq_off.cqes + prms.cq_entries * sizeof(struct io_uring_cqe);
+        obj->sq.sqesSz  = prms.sq_entries * sizeof(struct io_uring_sqe);
+        if(prms.features & IORING_FEAT_SINGLE_MMAP){
+            if(obj->sq.ringSz < obj->cq.ringSz) obj->sq.ringSz = obj->cq.ringSz;
+            obj->cq.ringSz = obj->sq.ringSz;
+        }
+        obj->sq.ring = mmap(NULL, obj->sq.ringSz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, obj->fd, IORING_OFF_SQ_RING);
+        if(obj->sq.ring == MAP_FAILED){
+            K_LOG_ERROR("IoUring, sq-ring mmap failed errno(%d).\n", errno);
+            obj->sq.ring = NULL;
+        } else {
+            if(prms.features & IORING_FEAT_SINGLE_MMAP){
+                obj->cq.ring = obj->sq.ring;
+            } else {
+                obj->cq.ring = mmap(NULL, obj->cq.ringSz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, obj->fd, IORING_OFF_CQ_RING);
+                if(obj->cq.ring == MAP_FAILED){
+                    K_LOG_ERROR("IoUring, cq-ring mmap failed errno(%d).\n", errno);
+                    obj->cq.ring = NULL;
+                }
+            }
+            if(obj->cq.ring != NULL){
+                obj->sq.sqes = (struct io_uring_sqe*)mmap(NULL, obj->sq.sqesSz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, obj->fd, IORING_OFF_SQES);
+                if(obj->sq.sqes == MAP_FAILED){
+                    K_LOG_ERROR("IoUring, sqes mmap failed errno(%d).\n", errno);
+                    obj->sq.sqes = NULL;
+                } else {
+                    obj->sq.head    = (unsigned*)((char*)obj->sq.ring + prms.sq_off.head);
+                    obj->sq.tail    = (unsigned*)((char*)obj->sq.ring + prms.sq_off.tail);
+                    obj->sq.mask    = (unsigned*)((char*)obj->sq.ring + prms.sq_off.ring_mask);
+                    obj->sq.array   = (unsigned*)((char*)obj->sq.ring + prms.sq_off.array);
+                    obj->sq.entries = prms.sq_entries;
+                    obj->sq.tailLocal = *obj->sq.tail;
+                    obj->sq.toSubmit = 0;
+                    obj->cq.head    = (unsigned*)((char*)obj->cq.ring + prms.cq_off.head);
+                    obj->cq.tail    = (unsigned*)((char*)obj->cq.ring + prms.cq_off.tail);
+                    obj->cq.mask    = (unsigned*)((char*)obj->cq.ring + prms.cq_off.ring_mask);
+                    obj->cq.cqes    = (struct io_uring_cqe*)((char*)obj->cq.ring + prms.cq_off.cqes);
+                    r = 0;
+                }
+            }
+        }
+    }
+    if(r != 0){
+        IoUring_release(obj);
+    }
+    return r;
+}
+
+struct io_uring_sqe* IoUring_getSqe(STIoUring* obj){  //NULL if the submission-queue is full
+    struct io_uring_sqe* r = NULL;
+    const unsigned head = __atomic_load_n(obj->sq.head, __ATOMIC_ACQUIRE);
+    if((obj->sq.tailLocal - head) < obj->sq.entries){
+        const unsigned idx = (obj->sq.tailLocal & *obj->sq.mask);
+        r = &obj->sq.sqes[idx];
+        memset(r, 0, sizeof(*r));
+        obj->sq.array[idx] = idx;
+        obj->sq.tailLocal++;
+        obj->sq.toSubmit++;
+    }
+    return r;
+}
+
+int IoUring_submit(STIoUring* obj, const unsigned waitCompletions){ //returns the ammount of sqes consumed
+    int r = 0;
+    //publish filled sqes
+    __atomic_store_n(obj->sq.tail, obj->sq.tailLocal, __ATOMIC_RELEASE);
+    if(obj->sq.toSubmit > 0 || waitCompletions > 0){
+        const int rr = (int)syscall(__NR_io_uring_enter, obj->fd, obj->sq.toSubmit, waitCompletions, (waitCompletions > 0 ? IORING_ENTER_GETEVENTS : 0), NULL, 0);
+        if(rr < 0){
+            if(errno != EINTR && errno != EAGAIN && errno != EBUSY){
+                K_LOG_ERROR("IoUring, io_uring_enter failed errno(%d).\n", errno);
+                r = -1;
+            }
+        } else {
+            obj->sq.toSubmit -= ((unsigned)rr <= obj->sq.toSubmit ? (unsigned)rr : obj->sq.toSubmit);
+            r = rr;
+        }
+    }
+    return r;
+}
+
+struct io_uring_cqe* IoUring_peekCqe(STIoUring* obj){ //NULL if no completion is available
+    const unsigned head = *obj->cq.head;
+    if(head != __atomic_load_n(obj->cq.tail, __ATOMIC_ACQUIRE)){
+        return &obj->cq.cqes[head & *obj->cq.mask];
+    }
+    return NULL;
+}
+
+void IoUring_cqeSeen(STIoUring* obj){
+    __atomic_store_n(obj->cq.head, *obj->cq.head + 1, __ATOMIC_RELEASE);
+}
+#endif
+
 //error codes
 
 const STErrCode* _getErrCode(const int value){
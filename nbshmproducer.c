@@ -0,0 +1,317 @@
+//
+//  nbshmproducer.c
+//
+//  Reference producer for nbplayer's '--netProto shm' source.
+//  Loops an Annex-B h264 file into a shared-memory ring (memfd),
+//  handed to the player over a UNIX socket; one client at a time.
+//
+//  cc ./nbshmproducer.c -o nbshmproducer
+//  ./nbshmproducer /tmp/cam-01.sock ./cam-01.h264 [fps, default 25] [ringKBs, default 4096]
+//
+
+#define _GNU_SOURCE         //for memfd_create()
+
+#include <stdio.h>          //for printf
+#include <stdlib.h>         //for malloc, atoi
+#include <stdint.h>         //for uint32_t
+#include <string.h>         //for memset
+#include <unistd.h>         //for close, ftruncate, usleep
+#include <errno.h>          //for errno
+#include <signal.h>         //for signal(SIGPIPE)
+#include <time.h>           //for clock_gettime
+#include <sys/mman.h>       //for mmap, memfd_create
+#include <sys/socket.h>     //for socket, sendmsg
+#include <sys/un.h>         //for sockaddr_un
+
+//ring layout (must match nbplayer.c)
+
+#define K_SHM_RING_MAGIC            0x5253424E  //'NBSR'
+#define K_SHM_RING_VERSION          1
+#define K_SHM_RING_HDR_SZ           64          //records start at this offset (header in its own cache line)
+#define K_SHM_REC_PAD               0xFFFFFFFFu //record 'sz' value, next record is at ring start
+#define K_SHM_REC_FLAG_DISCONTINUITY 0x1        //producer dropped previous access units (ring was full)
+
+typedef struct STShmRingHdr_ {
+    uint32_t        magic;      //K_SHM_RING_MAGIC
+    uint32_t        version;    //K_SHM_RING_VERSION
+    uint32_t        dataSz;     //records area size, power of two
+    uint32_t        reserved;
+    uint64_t        head;       //bytes published by the producer (atomic, release)
+    uint64_t        tail;       //bytes released by the consumer (atomic, release)
+} STShmRingHdr;
+
+typedef struct STShmRecHdr_ {
+    uint32_t        sz;         //access unit size, or K_SHM_REC_PAD
+    uint32_t        nalTypes;   //bit-mask of NAL types contained
+    uint32_t        flags;      //K_SHM_REC_FLAG_*
+    uint32_t        reserved;
+} STShmRecHdr;
+
+//STAccessUnit (slice of the file)
+
+typedef struct STAccessUnit_ {
+    const unsigned char* ptr;
+    uint32_t        sz;
+    uint32_t        nalTypes;
+} STAccessUnit;
+
+//Splits the Annex-B buffer in access units (new unit at AUD, SPS, PPS or SEI, or at a slice with first_mb_in_slice=0, after a VCL NAL).
+int splitAccessUnits(const unsigned char* buff, const long sz, STAccessUnit** dstAUs){
+    int use = 0, size = 0, hasVcl = 0;
+    STAccessUnit* arr = NULL;
+    long i = 0, auStart = -1;
+    uint32_t nalTypes = 0;
+    while(i + 3 < sz){
+        if(buff[i] == 0 && buff[i + 1] == 0 && buff[i + 2] == 1){
+            const long scPos = (i > 0 && buff[i - 1] == 0 ? i - 1 : i);
+            const int type = (buff[i + 3] & 0x1F);
+            const int isVcl = (type == 1 || type == 5);
+            const int isFirstSlice = (isVcl && i + 4 < sz && (buff[i + 4] & 0x80) != 0); //ue(v) first_mb_in_slice == 0
+            if(auStart >= 0 && hasVcl && (type == 9 || type == 7 || type == 8 || type == 6 || isFirstSlice)){
+                //close current unit
+                if(use == size){
+                    STAccessUnit* arrN = (STAccessUnit*)realloc(arr, sizeof(STAccessUnit) * (size + 256));
+                    if(arrN == NULL){
+                        break;
+                    }
+                    arr = arrN;
+                    size += 256;
+                }
+                arr[use].ptr = &buff[auStart];
+                arr[use].sz = (uint32_t)(scPos - auStart);
+                arr[use].nalTypes = nalTypes;
+                use++;
+                auStart = -1;
+                hasVcl = 0;
+                nalTypes = 0;
+            }
+            if(auStart < 0){
+                auStart = scPos;
+            }
+            nalTypes |= (1u << type);
+            hasVcl |= isVcl;
+            i += 3;
+        } else {
+            i++;
+        }
+    }
+    //last unit
+    if(auStart >= 0 && hasVcl){
+        STAccessUnit* arrN = (STAccessUnit*)realloc(arr, sizeof(STAccessUnit) * (use + 1));
+        if(arrN != NULL){
+            arr = arrN;
+            arr[use].ptr = &buff[auStart];
+            arr[use].sz = (uint32_t)(sz - auStart);
+            arr[use].nalTypes = nalTypes;
+            use++;
+        }
+    }
+    *dstAUs = arr;
+    return use;
+}
+
+//Writes the unit as one contiguous record (padding to the ring start if needed) and publishes it.
+int ringPublish(STShmRingHdr* hdr, unsigned char* data, const STAccessUnit* au, const uint32_t flags){ //-1 = no space
+    const uint64_t recSz = ((sizeof(STShmRecHdr) + (uint64_t)au->sz + 15) & ~(uint64_t)15);
+    const uint64_t tail = __atomic_load_n(&hdr->tail, __ATOMIC_ACQUIRE);
+    uint64_t head = hdr->head; //only written by this process
+    uint64_t off = (head & (hdr->dataSz - 1)), pad = 0;
+    if(recSz > hdr->dataSz){
+        return -1;
+    }
+    if(off + recSz > hdr->dataSz){
+        pad = hdr->dataSz - off; //always >= sizeof(STShmRecHdr), records are 16-bytes aligned
+    }
+    if((head + pad + recSz - tail) > hdr->dataSz){
+        return -1;
+    }
+    if(pad > 0){
+        STShmRecHdr* rec = (STShmRecHdr*)&data[off];
+        rec->sz = K_SHM_REC_PAD;
+        head += pad;
+        off = 0;
+    }
+    {
+        STShmRecHdr* rec = (STShmRecHdr*)&data[off];
+        rec->sz = au->sz;
+        rec->nalTypes = au->nalTypes;
+        rec->flags = flags;
+        rec->reserved = 0;
+        memcpy(rec + 1, au->ptr, au->sz);
+    }
+    __atomic_store_n(&hdr->head, head + recSz, __ATOMIC_RELEASE);
+    return 0;
+}
+
+//Sends the ring to the client and publishes the units paced at 'fps' until the client disconnects.
+void serveClient(const int sckt, const STAccessUnit* aus, const int ausCount, const int fps, const uint32_t ringSz){
+    char req[256]; int reqUse = 0;
+    //request line ("NBSHM/1 <path>\n")
+    while(reqUse < (int)sizeof(req) - 1){
+        const ssize_t rcvd = recv(sckt, &req[reqUse], 1, 0);
+        if(rcvd <= 0 || req[reqUse] == '\n'){
+            break;
+        }
+        reqUse++;
+    }
+    req[reqUse] = '\0';
+    if(strncmp(req, "NBSHM/1 ", 8) != 0){
+        printf("nbshmproducer, unexpected request: '%s'.\n", req);
+        return;
+    }
+    printf("nbshmproducer, client requested: '%s'.\n", &req[8]);
+    {
+        const int fd = memfd_create("nbshm-ring", MFD_CLOEXEC);
+        const size_t mapSz = K_SHM_RING_HDR_SZ + ringSz;
+        unsigned char* map = MAP_FAILED;
+        if(fd < 0 || ftruncate(fd, mapSz) != 0 || (map = (unsigned char*)mmap(NULL, mapSz, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED){
+            printf("nbshmproducer, ring creation failed (errno %d).\n", errno);
+        } else {
+            STShmRingHdr* hdr = (STShmRingHdr*)map;
+            char ctrl[CMSG_SPACE(sizeof(int))];
+            struct iovec iov;
+            struct msghdr msg;
+            struct cmsghdr* cmsg;
+            memset(hdr, 0, K_SHM_RING_HDR_SZ);
+            hdr->magic = K_SHM_RING_MAGIC;
+            hdr->version = K_SHM_RING_VERSION;
+            hdr->dataSz = ringSz;
+            //send ring
+            iov.iov_base = "NBSR";
+            iov.iov_len = 4;
+            memset(&msg, 0, sizeof(msg));
+            memset(ctrl, 0, sizeof(ctrl));
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = ctrl;
+            msg.msg_controllen = sizeof(ctrl);
+            cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_RIGHTS;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+            memcpy(CMSG_DATA(cmsg), &fd, sizeof(fd));
+            if(sendmsg(sckt, &msg, MSG_NOSIGNAL) != 4){
+                printf("nbshmproducer, ring could not be sent (errno %d).\n", errno);
+            } else {
+                //publish
+                struct timespec next;
+                uint32_t flags = 0;
+                unsigned long published = 0, dropped = 0;
+                int i = 0, isConnected = 1;
+                clock_gettime(CLOCK_MONOTONIC, &next);
+                while(isConnected){
+                    const STAccessUnit* au = &aus[i];
+                    if(0 != ringPublish(hdr, &map[K_SHM_RING_HDR_SZ], au, flags)){
+                        //ring full (consumer behind), next published unit flags the gap
+                        flags = K_SHM_REC_FLAG_DISCONTINUITY;
+                        dropped++;
+                    } else {
+                        const char bell = 1;
+                        flags = 0;
+                        published++;
+                        //doorbell (EAGAIN is fine, consumer reads the head anyway)
+                        if(send(sckt, &bell, 1, MSG_DONTWAIT | MSG_NOSIGNAL) < 0 && errno != EAGAIN && errno != EWOULDBLOCK){
+                            isConnected = 0;
+                        }
+                    }
+                    if((published + dropped) % (unsigned long)(fps * 10) == 0){
+                        printf("nbshmproducer, %lu units published, %lu dropped.\n", published, dropped);
+                    }
+                    i = (i + 1) % ausCount;
+                    //pace
+                    next.tv_nsec += (1000000000L / fps);
+                    while(next.tv_nsec >= 1000000000L){
+                        next.tv_nsec -= 1000000000L;
+                        next.tv_sec++;
+                    }
+                    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+                    //client gone
+                    if(isConnected){
+                        char tmp;
+                        const ssize_t rcvd = recv(sckt, &tmp, 1, MSG_DONTWAIT | MSG_PEEK);
+                        if(rcvd == 0 || (rcvd < 0 && errno != EAGAIN && errno != EWOULDBLOCK)){
+                            isConnected = 0;
+                        }
+                    }
+                }
+                printf("nbshmproducer, client disconnected (%lu units published, %lu dropped).\n", published, dropped);
+            }
+            munmap(map, mapSz);
+        }
+        if(fd >= 0){
+            close(fd);
+        }
+    }
+}
+
+int main(int argc, char* argv[]){
+    const char* sockPath = (argc > 1 ? argv[1] : NULL);
+    const char* filePath = (argc > 2 ? argv[2] : NULL);
+    const int fps = (argc > 3 && atoi(argv[3]) > 0 ? atoi(argv[3]) : 25);
+    const int ringKBs = (argc > 4 && atoi(argv[4]) > 0 ? atoi(argv[4]) : 4096);
+    uint32_t ringSz = 4096;
+    unsigned char* buff = NULL;
+    long buffSz = 0;
+    STAccessUnit* aus = NULL;
+    int ausCount = 0, lstn = -1;
+    if(sockPath == NULL || filePath == NULL){
+        printf("Usage: %s socketPath file.h264 [fps] [ringKBs]\n", argv[0]);
+        return -1;
+    }
+    while(ringSz < (uint32_t)ringKBs * 1024 && ringSz < 0x40000000u){
+        ringSz *= 2; //power of two
+    }
+    signal(SIGPIPE, SIG_IGN);
+    //load file
+    {
+        FILE* f = fopen(filePath, "rb");
+        if(f == NULL){
+            printf("nbshmproducer, could not open: '%s'.\n", filePath);
+            return -1;
+        }
+        fseek(f, 0, SEEK_END);
+        buffSz = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        if(buffSz <= 0 || (buff = (unsigned char*)malloc(buffSz)) == NULL || fread(buff, 1, buffSz, f) != (size_t)buffSz){
+            printf("nbshmproducer, could not load: '%s'.\n", filePath);
+            fclose(f);
+            return -1;
+        }
+        fclose(f);
+    }
+    ausCount = splitAccessUnits(buff, buffSz, &aus);
+    if(ausCount <= 0){
+        printf("nbshmproducer, no access units found: '%s'.\n", filePath);
+        return -1;
+    }
+    printf("nbshmproducer, %d access units loaded from '%s', %u KBs ring, %d fps.\n", ausCount, filePath, (ringSz / 1024), fps);
+    //listen
+    {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, sockPath, sizeof(addr.sun_path) - 1);
+        unlink(sockPath);
+        if((lstn = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 || bind(lstn, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(lstn, 1) != 0){
+            printf("nbshmproducer, could not listen at: '%s'.\n", sockPath);
+            return -1;
+        }
+    }
+    //serve
+    while(1){
+        const int sckt = accept(lstn, NULL, NULL);
+        if(sckt < 0){
+            if(errno == EINTR){
+                continue;
+            }
+            break;
+        }
+        serveClient(sckt, aus, ausCount, fps, ringSz);
+        close(sckt);
+    }
+    close(lstn);
+    unlink(sockPath);
+    free(aus);
+    free(buff);
+    return 0;
+}